@@ -0,0 +1,149 @@
+#include "StdInclude.hpp"
+#include "ArcLengthTable.hpp"
+
+
+namespace IWXMVM::Components
+{
+    constexpr float DERIVATIVE_STEP = 0.25f;
+    constexpr float INTEGRATION_TOLERANCE = 0.01f;
+    constexpr int32_t MAX_INTEGRATION_DEPTH = 8;
+
+    float EvaluateSpeed(const MathUtils::KeyframeCurve& curve, float tick)
+    {
+        const auto before = curve.Evaluate(tick - DERIVATIVE_STEP).cameraData.position;
+        const auto after = curve.Evaluate(tick + DERIVATIVE_STEP).cameraData.position;
+        return glm::length(after - before) / (2.0f * DERIVATIVE_STEP);
+    }
+
+    // 5-point Gauss-Legendre quadrature of the campath speed over [a, b]
+    float IntegrateGaussLegendre(const MathUtils::KeyframeCurve& curve, float a, float b)
+    {
+        constexpr std::array<float, 5> NODES = {0.0f, -0.5384693101f, 0.5384693101f, -0.9061798459f, 0.9061798459f};
+        constexpr std::array<float, 5> WEIGHTS = {0.5688888889f, 0.4786286705f, 0.4786286705f, 0.2369268851f,
+                                                  0.2369268851f};
+
+        const auto halfLength = (b - a) * 0.5f;
+        const auto center = (a + b) * 0.5f;
+
+        float sum = 0.0f;
+        for (std::size_t i = 0; i < NODES.size(); i++)
+        {
+            sum += WEIGHTS[i] * EvaluateSpeed(curve, center + halfLength * NODES[i]);
+        }
+        return sum * halfLength;
+    }
+
+    float IntegrateAdaptive(const MathUtils::KeyframeCurve& curve, float a, float b, float whole, int32_t depth)
+    {
+        const auto mid = (a + b) * 0.5f;
+        const auto left = IntegrateGaussLegendre(curve, a, mid);
+        const auto right = IntegrateGaussLegendre(curve, mid, b);
+
+        if (depth <= 0 || std::abs(left + right - whole) <= INTEGRATION_TOLERANCE)
+            return left + right;
+
+        return IntegrateAdaptive(curve, a, mid, left, depth - 1) +
+               IntegrateAdaptive(curve, mid, b, right, depth - 1);
+    }
+
+    float IntegrateArcLength(const MathUtils::KeyframeCurve& curve, float a, float b)
+    {
+        if (b <= a)
+            return 0.0f;
+
+        return IntegrateAdaptive(curve, a, b, IntegrateGaussLegendre(curve, a, b),
+                                 MAX_INTEGRATION_DEPTH);
+    }
+
+    void ArcLengthTable::Update(const MathUtils::KeyframeCurve& curve)
+    {
+        const auto& keyframes = curve.GetKeyframes();
+
+        std::vector<NodeSignature> newNodes;
+        newNodes.reserve(keyframes.size());
+        for (const auto& node : keyframes)
+        {
+            newNodes.push_back({node.tick, node.value.cameraData.position, node.interpolation, node.bezierHandles});
+        }
+
+        // edits to other tracks also bump the keyframes version, but leave the campath untouched
+        if (newNodes == nodes)
+            return;
+
+        nodes = std::move(newNodes);
+        sampleTicks.clear();
+        sampleLengths.clear();
+
+        if (keyframes.size() < 2)
+            return;
+
+        const auto segmentCount = keyframes.size() - 1;
+        sampleTicks.reserve(segmentCount * SAMPLES_PER_SEGMENT + 1);
+        sampleLengths.reserve(segmentCount * SAMPLES_PER_SEGMENT + 1);
+
+        sampleTicks.push_back(static_cast<float>(keyframes.front().tick));
+        sampleLengths.push_back(0.0f);
+        for (std::size_t i = 0; i < segmentCount; i++)
+        {
+            const auto startTick = static_cast<float>(keyframes[i].tick);
+            const auto endTick = static_cast<float>(keyframes[i + 1].tick);
+            const auto step = (endTick - startTick) / SAMPLES_PER_SEGMENT;
+
+            for (int32_t s = 1; s <= SAMPLES_PER_SEGMENT; s++)
+            {
+                const auto a = startTick + step * (s - 1);
+                sampleTicks.push_back(a + step);
+                sampleLengths.push_back(sampleLengths.back() + IntegrateArcLength(curve, a, a + step));
+            }
+        }
+
+        LOG_DEBUG("Rebuilt campath arc length table ({} segments, length {:.1f})", segmentCount, GetTotalLength());
+    }
+
+    float ArcLengthTable::GetTickAtLength(const MathUtils::KeyframeCurve& curve, float length) const
+    {
+        if (sampleLengths.size() < 2)
+            return curve.IsEmpty() ? 0.0f : static_cast<float>(curve.GetKeyframes().front().tick);
+
+        if (length <= 0.0f)
+            return sampleTicks.front();
+        if (length >= sampleLengths.back())
+            return sampleTicks.back();
+
+        const auto it = std::upper_bound(sampleLengths.begin(), sampleLengths.end(), length);
+        const auto hi = static_cast<std::size_t>(std::distance(sampleLengths.begin(), it));
+        const auto lo = hi - 1;
+
+        const auto lengthRange = sampleLengths[hi] - sampleLengths[lo];
+        if (lengthRange <= 0.0f)
+            return sampleTicks[lo];
+
+        // linear guess within the bracket, refined by a single Newton step on the actual curve
+        const auto t = (length - sampleLengths[lo]) / lengthRange;
+        auto tick = glm::mix(sampleTicks[lo], sampleTicks[hi], t);
+
+        const auto speed = EvaluateSpeed(curve, tick);
+        if (speed > 0.0f)
+        {
+            const auto lengthAtTick =
+                sampleLengths[lo] + IntegrateGaussLegendre(curve, sampleTicks[lo], tick);
+            tick -= (lengthAtTick - length) / speed;
+        }
+
+        return std::clamp(tick, sampleTicks[lo], sampleTicks[hi]);
+    }
+
+    float ArcLengthTable::GetConstantSpeedTick(const MathUtils::KeyframeCurve& curve, float tick) const
+    {
+        if (sampleTicks.size() < 2)
+            return tick;
+
+        const auto startTick = sampleTicks.front();
+        const auto endTick = sampleTicks.back();
+        if (tick <= startTick || tick >= endTick)
+            return tick;
+
+        const auto progress = (tick - startTick) / (endTick - startTick);
+        return GetTickAtLength(curve, progress * GetTotalLength());
+    }
+}  // namespace IWXMVM::Components
@@ -0,0 +1,47 @@
+#pragma once
+#include "Types/Keyframe.hpp"
+#include "Utilities/KeyframeCurve.hpp"
+
+namespace IWXMVM::Components
+{
+    // Maps distance travelled along a campath to the tick at which the camera is at that distance, so a campath can be
+    // played back at constant speed regardless of node spacing
+    class ArcLengthTable
+    {
+       public:
+        // Rebuilds the table for the given campath curve, unless its nodes are the ones the table was built for. The
+        // cubic spline is global, so moving any node changes the length of every segment and the table is always
+        // rebuilt as a whole.
+        void Update(const MathUtils::KeyframeCurve& curve);
+
+        float GetTotalLength() const
+        {
+            return sampleLengths.empty() ? 0.0f : sampleLengths.back();
+        }
+
+        float GetTickAtLength(const MathUtils::KeyframeCurve& curve, float length) const;
+
+        // Maps a timeline tick to the tick the campath has to be evaluated at to move at constant speed
+        float GetConstantSpeedTick(const MathUtils::KeyframeCurve& curve, float tick) const;
+
+       private:
+        static constexpr int32_t SAMPLES_PER_SEGMENT = 8;
+
+        struct NodeSignature
+        {
+            uint32_t tick;
+            glm::vec3 position;
+            Types::InterpolationMode interpolation;
+            glm::vec4 bezierHandles;
+
+            bool operator==(const NodeSignature& other) const = default;
+        };
+
+        // The nodes the table was built for
+        std::vector<NodeSignature> nodes;
+
+        // Flattened (tick, cumulative length) pairs of all segments, searched with a binary search
+        std::vector<float> sampleTicks;
+        std::vector<float> sampleLengths;
+    };
+}  // namespace IWXMVM::Components
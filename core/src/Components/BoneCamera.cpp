@@ -3,6 +3,7 @@
 
 #include "Mod.hpp"
 #include "Events.hpp"
+#include "Components/EntityTable.hpp"
 #include "Components/FreeCamera.hpp"
 #include "Utilities/MathUtils.hpp"
 #include "UI/UIManager.hpp"
@@ -70,15 +71,14 @@ namespace IWXMVM::Components
         const auto selectedEntityId = entityId;
         const auto& boneData = Mod::GetGameInterface()->GetBoneData(selectedEntityId, selectedBoneName);
 
-        auto entities = Mod::GetGameInterface()->GetEntities();
-        auto selectedEntity = entities.at(selectedEntityId);
+        const auto& selectedEntity = EntityTable::GetEntity(selectedEntityId);
         if (!selectedEntity.isValid && selectedEntity.type == Types::EntityType::Player)
         {
-            for (const auto& entity : entities)
+            for (const auto* corpse : EntityTable::GetEntitiesOfType(Types::EntityType::Corpse))
             {
-                if (entity.type == Types::EntityType::Corpse && entity.clientNum == selectedEntityId)
+                if (corpse->clientNum == selectedEntityId)
                 {
-                    SetPositionFromBoneData(Mod::GetGameInterface()->GetBoneData(entity.id, selectedBoneName));
+                    SetPositionFromBoneData(Mod::GetGameInterface()->GetBoneData(corpse->id, selectedBoneName));
                     return;
                 }
             }
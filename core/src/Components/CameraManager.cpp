@@ -108,7 +108,7 @@ namespace IWXMVM::Components
                 {
                     previousActiveCameraIndex = activeCameraIndex;
                     activeCameraIndex = i;
-                    Events::Invoke(EventType::OnCameraChanged);
+                    Events::Invoke<EventType::OnCameraChanged>();
                     return;
                 }
             }
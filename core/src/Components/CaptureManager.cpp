@@ -6,7 +6,9 @@
 #include "Components/Rewinding.hpp"
 #include "Components/Playback.hpp"
 #include "Graphics/Graphics.hpp"
+#include "Utilities/DvarRegistry.hpp"
 #include "Utilities/PathUtils.hpp"
+#include "Utilities/Profiler.hpp"
 #include "D3D9.hpp"
 #include "Events.hpp"
 
@@ -46,19 +48,20 @@ namespace IWXMVM::Components
         }
     }
 
+    DvarRegistry::Dvar<std::int32_t> r_smp_backend("r_smp_backend");
+
     void CaptureManager::Initialize()
     {
         // Set r_smp_backend to 0. 
         // This should ensure that there are no separate threads for game logic and rendering
         // which frees us from having to do synchronizations for our recording code.
-        auto r_smp_backend = Mod::GetGameInterface()->GetDvar("r_smp_backend");
-        if (!r_smp_backend.has_value())
+        if (!r_smp_backend.IsResolved())
         {
             LOG_ERROR("Could not set r_smp_backend; dvar not found");
         }
         else
         {
-            r_smp_backend.value().value->int32 = false;
+            r_smp_backend.Set(0);
         }
 
         IDirect3DDevice9* device = D3D9::GetDevice();
@@ -120,6 +123,8 @@ namespace IWXMVM::Components
 
     void CaptureManager::CaptureFrame()
     {
+        PROFILE_ZONE("CaptureManager::CaptureFrame");
+
         framePrepared = false;
 
         FILE* outputPipe = pipe;
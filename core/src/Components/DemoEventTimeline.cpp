@@ -0,0 +1,83 @@
+#include "StdInclude.hpp"
+#include "DemoEventTimeline.hpp"
+
+#include <set>
+
+#include "Mod.hpp"
+#include "Events.hpp"
+
+namespace IWXMVM::Components::DemoEventTimeline
+{
+    struct CachedEvents
+    {
+        std::uintmax_t fileSize;
+        std::int64_t lastWriteTime;
+        std::shared_ptr<const std::vector<Types::DemoEvent>> events;
+    };
+
+    std::mutex eventsMutex;
+    std::map<std::filesystem::path, CachedEvents> cachedEvents;
+    std::set<std::filesystem::path> pendingPaths;
+    std::filesystem::path loadedDemoPath;
+
+    void Request(const std::filesystem::path& demoPath)
+    {
+        std::error_code error;
+        const auto fileSize = std::filesystem::file_size(demoPath, error);
+        if (error)
+            return;
+        const auto lastWriteTime = std::filesystem::last_write_time(demoPath, error).time_since_epoch().count();
+        if (error)
+            return;
+
+        {
+            std::lock_guard lock(eventsMutex);
+            const auto it = cachedEvents.find(demoPath);
+            if (it != cachedEvents.end() && it->second.fileSize == fileSize &&
+                it->second.lastWriteTime == lastWriteTime)
+            {
+                return;
+            }
+
+            if (!pendingPaths.insert(demoPath).second)
+                return;
+        }
+
+        std::thread([demoPath, fileSize, lastWriteTime] {
+            const auto start = std::chrono::steady_clock::now();
+            auto events = Mod::GetGameInterface()->ReadDemoEvents(demoPath);
+            std::sort(events.begin(), events.end(), [](const auto& a, const auto& b) { return a.tick < b.tick; });
+
+            LOG_DEBUG("Read {} events from {} in {} ms", events.size(), demoPath.filename().string(),
+                      std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start)
+                          .count());
+
+            std::lock_guard lock(eventsMutex);
+            cachedEvents[demoPath] = {fileSize, lastWriteTime,
+                                      std::make_shared<const std::vector<Types::DemoEvent>>(std::move(events))};
+            pendingPaths.erase(demoPath);
+        }).detach();
+    }
+
+    std::shared_ptr<const std::vector<Types::DemoEvent>> GetEvents()
+    {
+        std::lock_guard lock(eventsMutex);
+        const auto it = cachedEvents.find(loadedDemoPath);
+        if (it == cachedEvents.end())
+            return nullptr;
+
+        return it->second.events;
+    }
+
+    void Initialize()
+    {
+        Events::RegisterListener(EventType::PostDemoLoad, []() {
+            const auto demoPath = std::filesystem::path(Mod::GetGameInterface()->GetDemoInfo().path);
+            {
+                std::lock_guard lock(eventsMutex);
+                loadedDemoPath = demoPath;
+            }
+            Request(demoPath);
+        });
+    }
+}  // namespace IWXMVM::Components::DemoEventTimeline
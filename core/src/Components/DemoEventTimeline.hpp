@@ -0,0 +1,17 @@
+#pragma once
+#include "Types/DemoEvent.hpp"
+
+namespace IWXMVM::Components
+{
+    namespace DemoEventTimeline
+    {
+        // Reads the events of a demo on a worker thread, unless they are already cached for the file's current size
+        // and modification time
+        void Request(const std::filesystem::path& demoPath);
+
+        // Returns the events of the loaded demo sorted by tick, or nothing while they are still being read
+        std::shared_ptr<const std::vector<Types::DemoEvent>> GetEvents();
+
+        void Initialize();
+    }  // namespace DemoEventTimeline
+}  // namespace IWXMVM::Components
@@ -0,0 +1,234 @@
+#include "StdInclude.hpp"
+#include "DemoMetadataCache.hpp"
+
+#include <deque>
+
+#include "nlohmann/json.hpp"
+
+#include "Mod.hpp"
+#include "Events.hpp"
+#include "Utilities/PathUtils.hpp"
+
+namespace IWXMVM::Components::DemoMetadataCache
+{
+    constexpr std::string_view NODE_PATH = "path";
+    constexpr std::string_view NODE_FILE_SIZE = "fileSize";
+    constexpr std::string_view NODE_LAST_WRITE_TIME = "lastWriteTime";
+    constexpr std::string_view NODE_START_TICK = "startTick";
+    constexpr std::string_view NODE_END_TICK = "endTick";
+    constexpr std::string_view NODE_ARCHIVE_COUNT = "archiveCount";
+    constexpr std::string_view NODE_IS_COD4X = "isCoD4X";
+    constexpr std::string_view NODE_MAP_NAME = "mapName";
+    constexpr std::string_view NODE_DEMOS = "demos";
+
+    std::mutex cacheMutex;
+    std::mutex writeMutex;
+    std::unordered_map<std::string, Types::DemoMetadata> entries;
+    std::unordered_map<std::string, std::string> pendingMapNames;  // Of played demos that were not read yet
+    std::string playedDemoKey;
+    std::deque<std::filesystem::path> queue;
+    std::size_t activeWorkers = 0;
+    bool hasUnsavedEntries = false;
+    std::filesystem::path cachePath;
+
+    std::string GetKey(const std::filesystem::path& demoPath)
+    {
+        const auto path = demoPath.u8string();
+        return std::string(path.begin(), path.end());
+    }
+
+    void WriteCacheFile(const std::unordered_map<std::string, Types::DemoMetadata>& entriesToWrite)
+    {
+        using json = nlohmann::json;
+
+        std::lock_guard lock(writeMutex);
+
+        json demos = json::array();
+        for (const auto& [path, metadata] : entriesToWrite)
+        {
+            json demoObject;
+            demoObject[NODE_PATH] = path;
+            demoObject[NODE_FILE_SIZE] = metadata.fileSize;
+            demoObject[NODE_LAST_WRITE_TIME] = metadata.lastWriteTime;
+            demoObject[NODE_START_TICK] = metadata.startTick;
+            demoObject[NODE_END_TICK] = metadata.endTick;
+            demoObject[NODE_ARCHIVE_COUNT] = metadata.archiveCount;
+            demoObject[NODE_IS_COD4X] = metadata.isCoD4X;
+            demoObject[NODE_MAP_NAME] = metadata.mapName;
+            demos.push_back(demoObject);
+        }
+
+        json rootNode;
+        rootNode[NODE_DEMOS] = demos;
+
+        std::ofstream cacheFile(cachePath);
+        cacheFile << rootNode.dump();
+        cacheFile.close();
+    }
+
+    void ReadCacheFile()
+    {
+        using json = nlohmann::json;
+
+        std::ifstream cacheFile(cachePath);
+        if (!cacheFile.is_open())
+            return;
+
+        try
+        {
+            json rootNode = json::parse(cacheFile);
+            for (const auto& demoObject : rootNode.at(NODE_DEMOS))
+            {
+                Types::DemoMetadata metadata;
+                metadata.fileSize = demoObject.at(NODE_FILE_SIZE).get<std::uintmax_t>();
+                metadata.lastWriteTime = demoObject.at(NODE_LAST_WRITE_TIME).get<std::int64_t>();
+                metadata.startTick = demoObject.at(NODE_START_TICK).get<uint32_t>();
+                metadata.endTick = demoObject.at(NODE_END_TICK).get<uint32_t>();
+                metadata.archiveCount = demoObject.at(NODE_ARCHIVE_COUNT).get<uint32_t>();
+                metadata.isCoD4X = demoObject.at(NODE_IS_COD4X).get<bool>();
+                metadata.mapName = demoObject.value(NODE_MAP_NAME, std::string());
+                entries[demoObject.at(NODE_PATH).get<std::string>()] = metadata;
+            }
+
+            LOG_DEBUG("Read {} cached demo metadata entries", entries.size());
+        }
+        catch (const std::exception& e)
+        {
+            LOG_ERROR("Failed to parse demo metadata cache ({})", e.what());
+            entries.clear();
+        }
+    }
+
+    void RunWorker()
+    {
+        while (true)
+        {
+            std::filesystem::path demoPath;
+            {
+                std::unique_lock lock(cacheMutex);
+                if (queue.empty())
+                {
+                    if (--activeWorkers > 0 || !hasUnsavedEntries)
+                        return;
+
+                    // the last worker to finish persists the results of the whole batch
+                    hasUnsavedEntries = false;
+                    auto entriesToWrite = entries;
+                    lock.unlock();
+
+                    WriteCacheFile(entriesToWrite);
+                    LOG_DEBUG("Wrote {} demo metadata entries to cache", entriesToWrite.size());
+                    return;
+                }
+
+                demoPath = std::move(queue.front());
+                queue.pop_front();
+            }
+
+            std::error_code error;
+            const auto fileSize = std::filesystem::file_size(demoPath, error);
+            if (error)
+                continue;
+            const auto lastWriteTime = std::filesystem::last_write_time(demoPath, error).time_since_epoch().count();
+            if (error)
+                continue;
+
+            const auto key = GetKey(demoPath);
+            {
+                std::lock_guard lock(cacheMutex);
+                const auto it = entries.find(key);
+                if (it != entries.end() && it->second.fileSize == fileSize &&
+                    it->second.lastWriteTime == lastWriteTime)
+                {
+                    continue;
+                }
+            }
+
+            auto metadata = Mod::GetGameInterface()->ReadDemoMetadata(demoPath);
+            if (!metadata.has_value())
+                continue;
+
+            std::lock_guard lock(cacheMutex);
+            if (const auto mapName = pendingMapNames.find(key); mapName != pendingMapNames.end())
+            {
+                metadata->mapName = std::move(mapName->second);
+                pendingMapNames.erase(mapName);
+            }
+
+            entries[key] = std::move(metadata.value());
+            hasUnsavedEntries = true;
+        }
+    }
+
+    void Request(const std::vector<std::filesystem::path>& demoPaths)
+    {
+        const auto workerCount = std::max<std::size_t>(1, std::thread::hardware_concurrency());
+
+        std::lock_guard lock(cacheMutex);
+        queue.assign(demoPaths.begin(), demoPaths.end());
+
+        while (activeWorkers < std::min(workerCount, queue.size()))
+        {
+            activeWorkers++;
+            std::thread(RunWorker).detach();
+        }
+    }
+
+    std::optional<Types::DemoMetadata> Get(const std::filesystem::path& demoPath)
+    {
+        std::lock_guard lock(cacheMutex);
+        const auto it = entries.find(GetKey(demoPath));
+        if (it == entries.end())
+            return std::nullopt;
+
+        return it->second;
+    }
+
+    std::size_t GetPendingCount()
+    {
+        std::lock_guard lock(cacheMutex);
+        return queue.size() + activeWorkers;
+    }
+
+    void SetPlayedDemo(const std::filesystem::path& demoPath)
+    {
+        std::lock_guard lock(cacheMutex);
+        playedDemoKey = GetKey(demoPath);
+    }
+
+    void StorePlayedMapName()
+    {
+        const auto mapName = Mod::GetGameInterface()->GetDemoInfo().mapName;
+        if (mapName.empty())
+            return;
+
+        std::unique_lock lock(cacheMutex);
+        if (playedDemoKey.empty())
+            return;
+
+        const auto it = entries.find(playedDemoKey);
+        if (it == entries.end())
+        {
+            pendingMapNames[std::exchange(playedDemoKey, {})] = mapName;
+            return;
+        }
+
+        playedDemoKey.clear();
+        if (it->second.mapName == mapName)
+            return;
+
+        it->second.mapName = mapName;
+        auto entriesToWrite = entries;
+        lock.unlock();
+
+        WriteCacheFile(entriesToWrite);
+    }
+
+    void Initialize()
+    {
+        cachePath = PathUtils::GetIWXMVMPath() / "demo_metadata.json";
+        ReadCacheFile();
+
+        Events::RegisterListener(EventType::PostDemoLoad, StorePlayedMapName);
+    }
+}  // namespace IWXMVM::Components::DemoMetadataCache
@@ -0,0 +1,24 @@
+#pragma once
+#include "Types/DemoMetadata.hpp"
+
+namespace IWXMVM::Components
+{
+    namespace DemoMetadataCache
+    {
+        // Queues the demos to be read by the worker pool. Demos whose size and modification time match their cached
+        // entry are not read again. Replaces any demos still queued from a previous request.
+        void Request(const std::vector<std::filesystem::path>& demoPaths);
+
+        // Returns the cached metadata of a demo, or nothing if it has not been read yet
+        std::optional<Types::DemoMetadata> Get(const std::filesystem::path& demoPath);
+
+        // Number of demos that are queued or being read
+        std::size_t GetPendingCount();
+
+        // Remembers the demo that is about to be played, so its map name can be stored once the game has loaded it.
+        // The game itself only knows the copy in the temp cache it plays from.
+        void SetPlayedDemo(const std::filesystem::path& demoPath);
+
+        void Initialize();
+    }  // namespace DemoMetadataCache
+}  // namespace IWXMVM::Components
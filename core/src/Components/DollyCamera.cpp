@@ -4,6 +4,7 @@
 #include "Mod.hpp"
 #include "Components/Rewinding.hpp"
 #include "Components/Playback.hpp"
+#include "Components/FrameState.hpp"
 
 namespace IWXMVM::Components
 {
@@ -17,13 +18,31 @@ namespace IWXMVM::Components
             return;
 
         auto& keyframeManager = KeyframeManager::Get();
-        const auto& property = keyframeManager.GetProperty(Types::KeyframeablePropertyType::CampathCamera);
-
-        if (keyframeManager.GetKeyframes(property).empty())
+        const auto& curve = keyframeManager.GetCurve(Types::KeyframeablePropertyType::CampathCamera);
+        if (curve.IsEmpty())
             return;
 
-        const auto currentTick = Playback::GetTimelineTick();
-        const auto interpolatedValue = keyframeManager.Interpolate(property, currentTick);
+        const auto timelineTick = static_cast<float>(Playback::GetTimelineTick());
+
+        Types::KeyframeValue interpolatedValue;
+        if (useConstantSpeed)
+        {
+            if (arcLengthTableVersion != keyframeManager.GetKeyframesVersion())
+            {
+                arcLengthTable.Update(curve);
+                arcLengthTableVersion = keyframeManager.GetKeyframesVersion();
+            }
+
+            interpolatedValue = curve.Evaluate(arcLengthTable.GetConstantSpeedTick(curve, timelineTick));
+        }
+        else if (auto value = FrameState::GetValue(Types::KeyframeablePropertyType::CampathCamera); value.has_value())
+        {
+            interpolatedValue = value.value();
+        }
+        else
+        {
+            interpolatedValue = curve.Evaluate(timelineTick);
+        }
 
         this->GetPosition() = interpolatedValue.cameraData.position;
         this->GetRotation() = interpolatedValue.cameraData.rotation;
@@ -1,5 +1,6 @@
 #pragma once
 #include "Camera.hpp"
+#include "ArcLengthTable.hpp"
 
 namespace IWXMVM::Components
 {
@@ -9,9 +10,21 @@ namespace IWXMVM::Components
         DollyCamera()
         {
             this->mode = Camera::Mode::Dolly;
+            useConstantSpeed = false;
         }
 
         void Initialize() override;
         void Update() override;
+
+        bool& UseConstantSpeed()
+        {
+            return useConstantSpeed;
+        }
+
+       private:
+        bool useConstantSpeed;
+
+        ArcLengthTable arcLengthTable;
+        std::optional<uint32_t> arcLengthTableVersion;
     };
 }  // namespace IWXMVM::Components
\ No newline at end of file
@@ -0,0 +1,113 @@
+#include "StdInclude.hpp"
+#include "EntityTable.hpp"
+
+#include <bitset>
+
+#include "Mod.hpp"
+#include "Events.hpp"
+#include "Utilities/Profiler.hpp"
+
+namespace IWXMVM::Components::EntityTable
+{
+    struct TypeView
+    {
+        std::vector<const Types::Entity*> entities;
+        bool isStale = true;
+    };
+
+    std::array<Types::Entity, Types::MAX_ENTITIES> entities{};
+    std::array<Types::Entity, Types::MAX_ENTITIES> refreshedEntities{};
+    std::bitset<Types::MAX_ENTITIES> dirtyEntities;
+    std::array<TypeView, ENTITY_TYPE_COUNT> typeViews;
+    bool isStale = true;
+    std::uint64_t refreshCount = 0;
+
+    void Refresh()
+    {
+        PROFILE_ZONE("EntityTable::Refresh");
+
+        Mod::GetGameInterface()->GetEntities(refreshedEntities);
+        refreshCount++;
+        isStale = false;
+
+        dirtyEntities.reset();
+        for (std::size_t i = 0; i < entities.size(); i++)
+        {
+            if (entities[i] != refreshedEntities[i])
+            {
+                entities[i] = refreshedEntities[i];
+                dirtyEntities.set(i);
+            }
+        }
+
+        if (dirtyEntities.any())
+        {
+            for (auto& view : typeViews)
+                view.isStale = true;
+        }
+    }
+
+    void RefreshIfStale()
+    {
+        if (isStale)
+            Refresh();
+    }
+
+    std::span<const Types::Entity, Types::MAX_ENTITIES> GetEntities()
+    {
+        RefreshIfStale();
+        return entities;
+    }
+
+    const Types::Entity& GetEntity(int32_t id)
+    {
+        RefreshIfStale();
+        return entities.at(id);
+    }
+
+    bool IsDirty(int32_t id)
+    {
+        RefreshIfStale();
+        return dirtyEntities.test(id);
+    }
+
+    std::span<const Types::Entity* const> GetEntitiesOfType(Types::EntityType type)
+    {
+        RefreshIfStale();
+
+        auto& view = typeViews[static_cast<std::size_t>(type)];
+        if (view.isStale)
+        {
+            view.entities.clear();
+            for (const auto& entity : entities)
+            {
+                if (entity.type == type)
+                    view.entities.push_back(&entity);
+            }
+            view.isStale = false;
+        }
+
+        return view.entities;
+    }
+
+    void Invalidate()
+    {
+        isStale = true;
+    }
+
+    std::uint64_t GetRefreshCount()
+    {
+        return refreshCount;
+    }
+
+    void Initialize()
+    {
+        for (auto& view : typeViews)
+            view.entities.reserve(Types::MAX_ENTITIES);
+
+        // the UI reads entities before OnFrame is invoked, so a frame's snapshot is taken by whichever comes first
+        // and dropped once every OnFrame listener ran
+        Events::RegisterListener(EventType::OnFrame, Invalidate, std::numeric_limits<std::int32_t>::max());
+        Events::RegisterListener(EventType::PostDemoLoad, Invalidate, std::numeric_limits<std::int32_t>::min());
+    }
+}  // namespace IWXMVM::Components::EntityTable
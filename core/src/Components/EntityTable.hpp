@@ -0,0 +1,30 @@
+#pragma once
+#include "Types/Entity.hpp"
+
+namespace IWXMVM::Components
+{
+    namespace EntityTable
+    {
+        constexpr std::size_t ENTITY_TYPE_COUNT = magic_enum::enum_count<Types::EntityType>();
+
+        // All entities, indexed by id. They are read from the game on the first access of a frame, so every caller
+        // sees the same snapshot and the storage stays valid until the table is destroyed.
+        std::span<const Types::Entity, Types::MAX_ENTITIES> GetEntities();
+
+        const Types::Entity& GetEntity(int32_t id);
+
+        // True if the entity changed in the last refresh
+        bool IsDirty(int32_t id);
+
+        // Entities of one type, only filtered again once an entity changed, e.g. GetEntitiesOfType(EntityType::Corpse)
+        std::span<const Types::Entity* const> GetEntitiesOfType(Types::EntityType type);
+
+        // Makes the next access read the entities from the game again
+        void Invalidate();
+
+        // Number of times the entities were read from the game so far
+        std::uint64_t GetRefreshCount();
+
+        void Initialize();
+    }  // namespace EntityTable
+}  // namespace IWXMVM::Components
@@ -0,0 +1,64 @@
+#include "StdInclude.hpp"
+#include "FrameState.hpp"
+
+#include "Events.hpp"
+#include "KeyframeManager.hpp"
+#include "Playback.hpp"
+#include "Utilities/Profiler.hpp"
+
+namespace IWXMVM::Components::FrameState
+{
+    Values values;
+    std::optional<uint32_t> evaluatedKeyframesVersion;
+
+    void Update(uint32_t tick)
+    {
+        auto& keyframeManager = KeyframeManager::Get();
+        const auto keyframesVersion = keyframeManager.GetKeyframesVersion();
+
+        if (evaluatedKeyframesVersion == keyframesVersion && values.tick == tick)
+            return;
+
+        PROFILE_ZONE("FrameState::Update");
+
+        values.tick = tick;
+        evaluatedKeyframesVersion = keyframesVersion;
+
+        // curves are built whenever keyframes change, so this is one binary search per keyframed property. Evaluating
+        // all 16 properties takes well under a microsecond, which is less than handing them to worker threads costs
+        for (std::size_t i = 0; i < PROPERTY_COUNT; i++)
+        {
+            const auto& curve = keyframeManager.GetCurve(static_cast<Types::KeyframeablePropertyType>(i));
+            values.isKeyframed[i] = !curve.IsEmpty();
+            if (!curve.IsEmpty())
+                values.values[i] = curve.Evaluate(static_cast<float>(tick));
+        }
+    }
+
+    void Update()
+    {
+        Update(Playback::GetTimelineTick());
+    }
+
+    const Values& GetValues()
+    {
+        Update();
+        return values;
+    }
+
+    std::optional<Types::KeyframeValue> GetValue(Types::KeyframeablePropertyType propertyType)
+    {
+        const auto& currentValues = GetValues();
+        const auto index = static_cast<std::size_t>(propertyType);
+        if (!currentValues.isKeyframed[index])
+            return std::nullopt;
+
+        return currentValues.values[index];
+    }
+
+    void Initialize()
+    {
+        Events::RegisterListener<EventType::OnFrame>(
+            [](const Events::Payload<EventType::OnFrame>& frame) { Update(frame.tick); });
+    }
+}  // namespace IWXMVM::Components::FrameState
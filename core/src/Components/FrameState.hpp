@@ -0,0 +1,31 @@
+#pragma once
+#include "Types/Keyframe.hpp"
+#include "Types/KeyframeableProperty.hpp"
+
+namespace IWXMVM::Components
+{
+    namespace FrameState
+    {
+        constexpr std::size_t PROPERTY_COUNT = magic_enum::enum_count<Types::KeyframeablePropertyType>();
+
+        // Values of every keyframed property at the current timeline tick, indexed by KeyframeablePropertyType
+        struct Values
+        {
+            uint32_t tick = 0;
+            std::array<Types::KeyframeValue, PROPERTY_COUNT> values{};
+            std::array<bool, PROPERTY_COUNT> isKeyframed{};
+        };
+
+        // Re-evaluates all non-empty tracks, unless neither the timeline tick nor any keyframe changed since the last
+        // evaluation
+        void Update();
+        void Update(uint32_t tick);
+
+        const Values& GetValues();
+
+        // Returns the value of the property at the current timeline tick, or nothing if it has no keyframes
+        std::optional<Types::KeyframeValue> GetValue(Types::KeyframeablePropertyType propertyType);
+
+        void Initialize();
+    }  // namespace FrameState
+}  // namespace IWXMVM::Components
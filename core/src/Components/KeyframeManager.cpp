@@ -2,7 +2,6 @@
 #include "KeyframeManager.hpp"
 
 #include "Resources.hpp"
-#include "Utilities/MathUtils.hpp"
 #include "KeyframeSerializer.hpp"
 #include "../UI/Components/KeyframeEditor.hpp"
 #include "../UI/UIManager.hpp"
@@ -149,6 +148,7 @@ namespace IWXMVM::Components
         InitializeProperty(dofNearStart);
         InitializeProperty(dofNearEnd);
         InitializeProperty(dofBias);
+        MarkKeyframesChanged();
 
         static bool justLoadedDemo = false;
 
@@ -207,10 +207,34 @@ namespace IWXMVM::Components
         return !beginningTickMap.empty() || !beginningValueMap.empty();
     }
 
+    void KeyframeManager::MarkKeyframesChanged()
+    {
+        keyframesVersion++;
+
+        for (const auto& [property, track] : keyframes)
+        {
+            curves[static_cast<std::size_t>(property.type)].Build(property, track);
+        }
+    }
+
+    void KeyframeManager::MarkKeyframesChanged(const Types::KeyframeableProperty& property)
+    {
+        keyframesVersion++;
+        curves[static_cast<std::size_t>(property.type)].Build(property, keyframes[property]);
+    }
+
     void KeyframeManager::SortAndSaveKeyframes(std::vector<Types::Keyframe>& keyframes)
     {
         std::sort(keyframes.begin(), keyframes.end(), [](const auto& a, const auto& b) { return a.tick < b.tick; });
 
+        // callers pass one of the tracks, so only its curve has to be rebuilt
+        const auto track = std::find_if(this->keyframes.begin(), this->keyframes.end(),
+                                        [&keyframes](const auto& pair) { return &pair.second == &keyframes; });
+        if (track != this->keyframes.end())
+            MarkKeyframesChanged(track->first);
+        else
+            MarkKeyframesChanged();
+
         Components::KeyframeSerializer::WriteRecent();
     }
 
@@ -284,6 +308,15 @@ namespace IWXMVM::Components
         }
     }
 
+    void KeyframeManager::ReplaceKeyframes(Types::KeyframeableProperty property,
+                                           std::vector<Types::Keyframe> newKeyframes)
+    {
+        std::shared_ptr<ReplaceKeyframesAction> replaceAction =
+            std::make_shared<ReplaceKeyframesAction>(property, keyframes[property], newKeyframes);
+        replaceAction->DoAction();
+        AddActionToHistory(replaceAction);
+    }
+
     bool KeyframeManager::IsKeyframeTickBeingModified(Types::Keyframe& keyframe)
     {
         return beginningTickMap.find(keyframe.id) != beginningTickMap.end();
@@ -339,23 +372,25 @@ namespace IWXMVM::Components
         beginningValueMap.erase(keyframeToModify.id);
     }
 
+    void KeyframeManager::SetKeyframeInterpolation(Types::KeyframeableProperty property,
+                                                   Types::Keyframe& keyframeToModify,
+                                                   Types::InterpolationMode interpolation, glm::vec4 bezierHandles)
+    {
+        std::shared_ptr<ModifyInterpolationAction> modifyAction = std::make_shared<ModifyInterpolationAction>(
+            property, keyframeToModify.interpolation, interpolation, keyframeToModify.bezierHandles, bezierHandles,
+            keyframeToModify.id);
+        modifyAction->DoAction();
+        AddActionToHistory(modifyAction);
+    }
+
     Types::KeyframeValue KeyframeManager::Interpolate(const Types::KeyframeableProperty& property,
                                                       const std::vector<Types::Keyframe>& keyframes,
                                                       const float tick) const
     {
-        if (keyframes.empty())
-            return Types::KeyframeValue::GetDefaultValue(property.valueType);
-
-        if (tick < keyframes.front().tick)
-            return keyframes.front().value;
-        if (tick > keyframes.back().tick)
-            return keyframes.back().value;
-
-        // TODO: interpolation selection in the future
-        if (keyframes.size() < 4)
-            return LinearlyInterpolate(property.valueType, keyframes, tick);
-
-        return CubicInterpolate(property.valueType, keyframes, tick);
+        // tracks other than the live ones have no prebuilt curve
+        MathUtils::KeyframeCurve curve;
+        curve.Build(property, keyframes);
+        return curve.Evaluate(tick);
     }
 
     Types::KeyframeValue KeyframeManager::Interpolate(const Types::KeyframeableProperty& property,
@@ -367,8 +402,7 @@ namespace IWXMVM::Components
 
     Types::KeyframeValue KeyframeManager::Interpolate(const Types::KeyframeableProperty& property, const float tick) const
     {
-        const auto& keyframes = KeyframeManager::Get().GetKeyframes(property);
-        return Interpolate(property, keyframes, tick);
+        return GetCurve(property.type).Evaluate(tick);
     }
 
     Types::KeyframeValue KeyframeManager::Interpolate(const Types::KeyframeableProperty& property, const uint32_t tick) const 
@@ -376,86 +410,6 @@ namespace IWXMVM::Components
         return Interpolate(property, static_cast<float>(tick));
     }
 
-    Types::KeyframeValue KeyframeManager::CubicInterpolate(Types::KeyframeValueType valueType,
-                                                           const auto& keyframes,
-                                                           const float tick) const
-    {
-        switch (valueType)
-        {
-            case Types::KeyframeValueType::FloatingPoint:
-                return MathUtils::InterpolateCubicSpline(keyframes, 0, tick);
-            case Types::KeyframeValueType::Vector3:
-                return glm::vec3(
-                    MathUtils::InterpolateCubicSpline(keyframes, 0, tick),
-                    MathUtils::InterpolateCubicSpline(keyframes, 1, tick),
-                    MathUtils::InterpolateCubicSpline(keyframes, 2, tick)
-                );
-            case Types::KeyframeValueType::CameraData:
-            {
-                return Types::KeyframeValue(
-                    Types::CameraData(
-                        glm::vec3(
-                            MathUtils::InterpolateCubicSpline(keyframes, 0, tick),
-                            MathUtils::InterpolateCubicSpline(keyframes, 1, tick),
-                            MathUtils::InterpolateCubicSpline(keyframes, 2, tick)
-                        ),
-                        // TODO: do proper quaternion interpolation here
-                        glm::vec3(
-                            MathUtils::InterpolateCubicSpline(keyframes, 3, tick),
-                            MathUtils::InterpolateCubicSpline(keyframes, 4, tick),
-                            MathUtils::InterpolateCubicSpline(keyframes, 5, tick)
-                        ), 
-                        MathUtils::InterpolateCubicSpline(keyframes, 6, tick)
-                    )
-                );
-            }
-            default:
-                return Types::KeyframeValue(0.0f);
-        }
-    }
-
-    Types::KeyframeValue KeyframeManager::LinearlyInterpolate(Types::KeyframeValueType valueType, const auto& keyframes,
-                                                              const float tick) const
-    {
-        if (keyframes.size() == 1)
-            return keyframes.front().value;
-
-        std::int32_t p0Idx = 0, p1Idx = 1;
-        for (std::size_t i = 0; i < keyframes.size() - 1; i++)
-        {
-            if (tick >= keyframes[i].tick && tick <= keyframes[i + 1].tick)
-            {
-                p0Idx = i;
-                p1Idx = i + 1;
-                break;
-            }
-        }
-
-        assert(p0Idx != -1 || p1Idx != -1);
-        assert(keyframes[p0Idx].tick < keyframes[p1Idx].tick);
-        assert(p0Idx != p1Idx);
-
-        const auto& p0 = keyframes[p0Idx];
-        const auto& p1 = keyframes[p1Idx];
-
-        const float t = static_cast<float>(tick - p0.tick) / static_cast<float>(p1.tick - p0.tick);
-        switch (valueType)
-        {
-            case Types::KeyframeValueType::FloatingPoint:
-                return Types::KeyframeValue((1.0f - t) * p0.value.floatingPoint + t * p1.value.floatingPoint);
-            case Types::KeyframeValueType::Vector3:
-                return Types::KeyframeValue((1.0f - t) * p0.value.vector3 + t * p1.value.vector3);
-            case Types::KeyframeValueType::CameraData:
-                return Types::KeyframeValue(
-                    Types::CameraData((1.0f - t) * p0.value.cameraData.position + t * p1.value.cameraData.position,
-                                      (1.0f - t) * p0.value.cameraData.rotation + t * p1.value.cameraData.rotation,
-                                      (1.0f - t) * p0.value.cameraData.fov + t * p1.value.cameraData.fov));
-            default:
-                return Types::KeyframeValue(0.0f);
-        }
-    }
-
-
     void KeyframeManager::AddAction_Internal(std::deque<std::shared_ptr<KeyframeAction>>& actionQue, std::shared_ptr<KeyframeAction> action) const
     {
         while (actionQue.size() >= MAX_ACTIONHISTORY)
@@ -465,6 +419,7 @@ namespace IWXMVM::Components
 
     void KeyframeManager::AddActionToHistory(std::shared_ptr<KeyframeAction> action)
     {
+        MarkKeyframesChanged(action->property);
         if (nextActionWipeUndidHistory)
         {
             undidActionHistory.clear();
@@ -521,6 +476,21 @@ namespace IWXMVM::Components
         return std::make_unique<ModifyTickAndValueAction>(property,newTick,oldTick,newValue,oldValue,id);
     }
 
+    void KeyframeManager::ModifyInterpolationAction::DoAction() const
+    {
+        if (auto it = GetKeyframe(id); it != GetKeyframes().end())
+        {
+            it->interpolation = newInterpolation;
+            it->bezierHandles = newBezierHandles;
+        }
+    }
+
+    std::unique_ptr<KeyframeManager::KeyframeAction> KeyframeManager::ModifyInterpolationAction::GetUndoAction() const
+    {
+        return std::make_unique<ModifyInterpolationAction>(property, newInterpolation, oldInterpolation,
+                                                           newBezierHandles, oldBezierHandles, id);
+    }
+
     void KeyframeManager::RemoveKeyframesAction::DoAction() const
     {
         for (auto& keyframe : keyframes)
@@ -550,4 +520,14 @@ namespace IWXMVM::Components
         return std::make_unique<RemoveKeyframesAction>(property, keyframes);
     }
 
+    void KeyframeManager::ReplaceKeyframesAction::DoAction() const
+    {
+        GetKeyframes() = newKeyframes;
+    }
+
+    std::unique_ptr<KeyframeManager::KeyframeAction> KeyframeManager::ReplaceKeyframesAction::GetUndoAction() const
+    {
+        return std::make_unique<ReplaceKeyframesAction>(property, newKeyframes, oldKeyframes);
+    }
+
 }  // namespace IWXMVM::Components
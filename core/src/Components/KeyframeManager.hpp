@@ -1,6 +1,7 @@
 #pragma once
 #include "Types/Keyframe.hpp"
 #include "Types/KeyframeableProperty.hpp"
+#include "Utilities/KeyframeCurve.hpp"
 
 namespace IWXMVM::Components
 {
@@ -40,6 +41,8 @@ namespace IWXMVM::Components
         void RemoveKeyframe(Types::KeyframeableProperty property, size_t indexToRemove);
         void RemoveKeyframes(Types::KeyframeableProperty property, std::vector<Types::Keyframe> keyframesToRemove);
 
+        void ReplaceKeyframes(Types::KeyframeableProperty property, std::vector<Types::Keyframe> newKeyframes);
+
         bool IsKeyframeTickBeingModified(Types::Keyframe& keyframe);
 
         void BeginModifyingKeyframeTick(Types::Keyframe& keyframeToModify);
@@ -52,6 +55,9 @@ namespace IWXMVM::Components
 
         void EndModifyingKeyframeTickAndValue(Types::KeyframeableProperty property, Types::Keyframe& keyframeToModify);
 
+        void SetKeyframeInterpolation(Types::KeyframeableProperty property, Types::Keyframe& keyframeToModify,
+                                      Types::InterpolationMode interpolation, glm::vec4 bezierHandles);
+
         void ClearKeyframes();
         void ClearKeyframes(Types::KeyframeableProperty property);
 
@@ -69,14 +75,26 @@ namespace IWXMVM::Components
 
         void SortAndSaveKeyframes(std::vector<Types::Keyframe>& keyframes);
 
+        // Incremented whenever any keyframe is added, removed or modified, so derived data can be rebuilt lazily
+        uint32_t GetKeyframesVersion() const
+        {
+            return keyframesVersion;
+        }
+
+        // Rebuilds the curves of all tracks, or only the curve of the property's track if only that one changed. Must
+        // be called on the game thread after any change to the keyframes.
+        void MarkKeyframesChanged();
+        void MarkKeyframesChanged(const Types::KeyframeableProperty& property);
+
+        // Curve of the property's track as of the last MarkKeyframesChanged
+        const MathUtils::KeyframeCurve& GetCurve(Types::KeyframeablePropertyType propertyType) const
+        {
+            return curves[static_cast<std::size_t>(propertyType)];
+        }
+
        private:
         KeyframeManager(){}
 
-        Types::KeyframeValue CubicInterpolate(Types::KeyframeValueType valueType, const auto& keyframes,
-                                              const float tick) const;
-        Types::KeyframeValue LinearlyInterpolate(Types::KeyframeValueType valueType, const auto& keyframes,
-                                                 const float tick) const;
-
         struct KeyframeAction
         {
             Types::KeyframeableProperty property;
@@ -138,6 +156,23 @@ namespace IWXMVM::Components
             std::unique_ptr<KeyframeManager::KeyframeAction> GetUndoAction() const final;
         };
 
+        struct ModifyInterpolationAction : ModifyAction
+        {
+            Types::InterpolationMode oldInterpolation;
+            Types::InterpolationMode newInterpolation;
+            glm::vec4 oldBezierHandles;
+            glm::vec4 newBezierHandles;
+
+            ModifyInterpolationAction(const Types::KeyframeableProperty& prop, Types::InterpolationMode oInterpolation,
+                                      Types::InterpolationMode nInterpolation, glm::vec4 oBezierHandles,
+                                      glm::vec4 nBezierHandles, uint32_t keyframeID)
+                : ModifyAction(prop, keyframeID), oldInterpolation(oInterpolation), newInterpolation(nInterpolation),
+                  oldBezierHandles(oBezierHandles), newBezierHandles(nBezierHandles){}
+
+            void DoAction() const final;
+            std::unique_ptr<KeyframeManager::KeyframeAction> GetUndoAction() const final;
+        };
+
         struct ManyKeyframesAction : KeyframeAction
         {
             std::vector<Types::Keyframe> keyframes;
@@ -163,6 +198,18 @@ namespace IWXMVM::Components
             std::unique_ptr<KeyframeManager::KeyframeAction> GetUndoAction() const final;
         };
 
+        struct ReplaceKeyframesAction : KeyframeAction
+        {
+            std::vector<Types::Keyframe> oldKeyframes;
+            std::vector<Types::Keyframe> newKeyframes;
+            ReplaceKeyframesAction(const Types::KeyframeableProperty& prop, std::vector<Types::Keyframe> oKeyframes,
+                                   std::vector<Types::Keyframe> nKeyframes)
+                : KeyframeAction(prop), oldKeyframes(oKeyframes), newKeyframes(nKeyframes){}
+
+            void DoAction() const final;
+            std::unique_ptr<KeyframeManager::KeyframeAction> GetUndoAction() const final;
+        };
+
         void UseMostRecentAction(std::deque<std::shared_ptr<KeyframeAction>>& actions,
                                  const std::function<void(std::shared_ptr<KeyframeAction>)>& handleAction);
 
@@ -174,6 +221,11 @@ namespace IWXMVM::Components
         std::unordered_map<uint32_t, Types::KeyframeValue> beginningValueMap;
         const size_t MAX_ACTIONHISTORY = 25;
         bool nextActionWipeUndidHistory = false;
+        uint32_t keyframesVersion = 0;
+
+        // Indexed by KeyframeablePropertyType, only written by MarkKeyframesChanged so evaluation never mutates them
+        std::array<MathUtils::KeyframeCurve, magic_enum::enum_count<Types::KeyframeablePropertyType>()> curves;
+
         std::deque<std::shared_ptr<KeyframeAction>> undidActionHistory;
         std::deque<std::shared_ptr<KeyframeAction>> actionHistory;
     };
@@ -20,6 +20,8 @@ namespace IWXMVM::Components
     constexpr std::string_view NODE_VALUES = "values";
     constexpr std::string_view NODE_VALUE = "value";
     constexpr std::string_view NODE_KEYFRAMES = "keyframes";
+    constexpr std::string_view NODE_INTERPOLATION = "interpolation";
+    constexpr std::string_view NODE_BEZIER_HANDLES = "bezierHandles";
 
     void KeyframeSerializer::Write(std::filesystem::path path)
     {
@@ -63,6 +65,13 @@ namespace IWXMVM::Components
                 keyframeValueObject[NODE_VALUES] = keyframeValuesArray;
 
                 keyframeObject[NODE_VALUE] = keyframeValueObject;
+                keyframeObject[NODE_INTERPOLATION] = magic_enum::enum_name(k.interpolation);
+                if (k.interpolation == Types::InterpolationMode::Bezier)
+                {
+                    keyframeObject[NODE_BEZIER_HANDLES] = {k.bezierHandles.x, k.bezierHandles.y, k.bezierHandles.z,
+                                                           k.bezierHandles.w};
+                }
+
                 keyframeList.push_back(keyframeObject);
             }
 
@@ -103,86 +112,115 @@ namespace IWXMVM::Components
         }
     }
 
-    void KeyframeSerializer::Read(std::filesystem::path path, bool requireDemoMatch)
+    void ReadKeyframeFile(std::ifstream& file, bool requireDemoMatch)
     {
         using json = nlohmann::json;
 
-        std::ifstream file(path);
-        if (!file.is_open())
+        json rootNode = json::parse(file);
+
+        auto gameName = rootNode[NODE_GAME_NAME].get<std::string>();
+        auto currentGameName = magic_enum::enum_name(Mod::GetGameInterface()->GetGame());
+        if (gameName.compare(currentGameName) != 0)
         {
-            LOG_ERROR("Failed to read keyframe file at {}", path.string());
-            return;
+            LOG_WARN("Game of loaded keyframes file doesnt match current game!");
+            LOG_WARN("Expected: {0}", gameName);
+            LOG_WARN("Actual: {0}", currentGameName);
         }
 
-        try
+        auto demoName = rootNode[NODE_DEMO_NAME].get<std::string>();
+        auto currentDemoName = Mod::GetGameInterface()->GetDemoInfo().name;
+        if (demoName.compare(currentDemoName) != 0)
         {
-            json rootNode = json::parse(file);
-
-            auto gameName = rootNode[NODE_GAME_NAME].get<std::string>();
-            auto currentGameName = magic_enum::enum_name(Mod::GetGameInterface()->GetGame());
-            if (gameName.compare(currentGameName) != 0)
+            if (requireDemoMatch)
             {
-                LOG_WARN("Game of loaded keyframes file doesnt match current game!");
-                LOG_WARN("Expected: {0}", gameName);
-                LOG_WARN("Actual: {0}", currentGameName);
+                LOG_INFO("Not loading keyframes since this demo is not the previous demo");
+                return;
             }
 
-            auto demoName = rootNode[NODE_DEMO_NAME].get<std::string>();
-            auto currentDemoName = Mod::GetGameInterface()->GetDemoInfo().name;
-            if (demoName.compare(currentDemoName) != 0)
-            {
-                if (requireDemoMatch)
-                {
-                    LOG_INFO("Not loading keyframes since this demo is not the previous demo");
-                    return;
-                }
+            LOG_WARN("Demo names dont match {0} vs {1}", demoName, currentDemoName);
+            LOG_WARN("Expected: {0}", demoName);
+            LOG_WARN("Actual: {0}", currentDemoName);
+        }
 
-                LOG_WARN("Demo names dont match {0} vs {1}", demoName, currentDemoName);
-                LOG_WARN("Expected: {0}", demoName);
-                LOG_WARN("Actual: {0}", currentDemoName);
-            }
+        auto optFrozenTick = rootNode[NODE_FROZEN_TICK];
+        Components::Playback::HandleImportedFrozenTickLogic(
+            !optFrozenTick.is_null() ? std::optional{optFrozenTick.get<std::uint32_t>()} : std::nullopt);
 
-            auto optFrozenTick = rootNode[NODE_FROZEN_TICK];
-            Components::Playback::HandleImportedFrozenTickLogic(
-                !optFrozenTick.is_null() ? std::optional{optFrozenTick.get<std::uint32_t>()} : std::nullopt);
+        auto properties = rootNode[NODE_PROPERTIES];
+        for (json::iterator propertyObject = properties.begin(); propertyObject != properties.end();
+             ++propertyObject)
+        {
+            auto propertyName = (*propertyObject)[NODE_PROPERTY].get<std::string>();
 
-            auto properties = rootNode[NODE_PROPERTIES];
-            for (json::iterator propertyObject = properties.begin(); propertyObject != properties.end();
-                 ++propertyObject)
+            auto propertyType = magic_enum::enum_cast<Types::KeyframeablePropertyType>(propertyName);
+            if (!propertyType.has_value())
             {
-                auto propertyName = (*propertyObject)[NODE_PROPERTY].get<std::string>();
+                LOG_ERROR("Unknown property \"{0}\"", propertyName);
+                throw std::runtime_error("Unknown property encountered");
+            }
+            auto property = Components::KeyframeManager::Get().GetProperty(propertyType.value());
 
-                auto propertyType = magic_enum::enum_cast<Types::KeyframeablePropertyType>(propertyName);
-                if (!propertyType.has_value())
+            auto& keyframes = Components::KeyframeManager::Get().GetKeyframes(property);
+            for (json::iterator keyframe = propertyObject->at(NODE_KEYFRAMES).begin();
+                 keyframe != propertyObject->at(NODE_KEYFRAMES).end(); ++keyframe)
+            {
+                auto tick = keyframe->at(NODE_TICK).get<uint32_t>();
+                auto valueNode = keyframe->at(NODE_VALUE);
+                auto valueTypeName = valueNode[NODE_TYPE].get<std::string>();
+                auto valueType = magic_enum::enum_cast<Types::KeyframeValueType>(valueTypeName);
+                if (!valueType.has_value())
                 {
-                    LOG_ERROR("Unknown property \"{0}\"", propertyName);
-                    throw std::runtime_error("Unknown property encountered");
+                    LOG_ERROR("Unknown value type \"{0}\"", valueTypeName);
+                    throw std::runtime_error("Unknown value type encountered");
                 }
-                auto property = Components::KeyframeManager::Get().GetProperty(propertyType.value());
+                Types::KeyframeValue value = ReadValueOfType(valueType.value(), valueNode[NODE_VALUES]);
 
-                auto& keyframes = Components::KeyframeManager::Get().GetKeyframes(property);
-                for (json::iterator keyframe = propertyObject->at(NODE_KEYFRAMES).begin();
-                     keyframe != propertyObject->at(NODE_KEYFRAMES).end(); ++keyframe)
+                auto& k = keyframes.emplace_back(property, tick, Types::KeyframeValue(value));
+
+                // files written before per-segment interpolation modes existed have neither node
+                if (keyframe->contains(NODE_INTERPOLATION))
                 {
-                    auto tick = keyframe->at(NODE_TICK).get<uint32_t>();
-                    auto valueNode = keyframe->at(NODE_VALUE);
-                    auto valueTypeName = valueNode[NODE_TYPE].get<std::string>();
-                    auto valueType = magic_enum::enum_cast<Types::KeyframeValueType>(valueTypeName);
-                    if (!valueType.has_value())
+                    auto interpolationName = keyframe->at(NODE_INTERPOLATION).get<std::string>();
+                    auto interpolation = magic_enum::enum_cast<Types::InterpolationMode>(interpolationName);
+                    if (!interpolation.has_value() || interpolation.value() == Types::InterpolationMode::Count)
                     {
-                        LOG_ERROR("Unknown value type \"{0}\"", valueTypeName);
-                        throw std::runtime_error("Unknown value type encountered");
+                        // e.g. a file written by a newer version, the keyframe itself is still usable
+                        LOG_WARN("Unknown interpolation mode \"{0}\", falling back to {1}", interpolationName,
+                                 magic_enum::enum_name(Types::InterpolationMode::Cubic));
+                        interpolation = Types::InterpolationMode::Cubic;
                     }
-                    Types::KeyframeValue value = ReadValueOfType(valueType.value(), valueNode[NODE_VALUES]);
-
-                    keyframes.push_back(Types::Keyframe(property, tick, Types::KeyframeValue(value)));
+                    k.interpolation = interpolation.value();
+                }
+                if (keyframe->contains(NODE_BEZIER_HANDLES))
+                {
+                    auto handles = keyframe->at(NODE_BEZIER_HANDLES);
+                    k.bezierHandles = glm::vec4(handles[0].get<float>(), handles[1].get<float>(),
+                                                handles[2].get<float>(), handles[3].get<float>());
                 }
             }
         }
+    }
+
+    void KeyframeSerializer::Read(std::filesystem::path path, bool requireDemoMatch)
+    {
+        std::ifstream file(path);
+        if (!file.is_open())
+        {
+            LOG_ERROR("Failed to read keyframe file at {}", path.string());
+            return;
+        }
+
+        try
+        {
+            ReadKeyframeFile(file, requireDemoMatch);
+        }
         catch (const std::exception& e)
         {
             LOG_ERROR("Failed to parse keyframe file ({})", e.what());
         }
+
+        // a failed read may have added some keyframes already, so this has to run however reading ended
+        Components::KeyframeManager::Get().MarkKeyframesChanged();
     }
 
     std::filesystem::path GetRecentKeyframesPath()
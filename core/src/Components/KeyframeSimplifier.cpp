@@ -0,0 +1,142 @@
+#include "StdInclude.hpp"
+#include "KeyframeSimplifier.hpp"
+
+#include "KeyframeManager.hpp"
+#include "Events.hpp"
+#include "Utilities/KeyframeSimplification.hpp"
+
+namespace IWXMVM::Components::KeyframeSimplifier
+{
+    struct PendingSimplification
+    {
+        const Types::KeyframeableProperty* property;
+        std::vector<Types::Keyframe> sourceKeyframes;
+        std::vector<Types::Keyframe> simplifiedKeyframes;
+        Result result;
+    };
+
+    std::mutex pendingMutex;
+    std::optional<PendingSimplification> pendingSimplification;
+    std::optional<Result> lastResult;
+    std::atomic<bool> isSimplifying = false;
+
+    std::vector<Types::Keyframe> Simplify(const Types::KeyframeableProperty& property,
+                                          const std::vector<Types::Keyframe>& keyframes,
+                                          const std::vector<float>& tolerances, Result& result)
+    {
+        result.propertyType = property.type;
+        result.originalCount = keyframes.size();
+
+        auto simplifiedKeyframes = MathUtils::SimplifyKeyframes(property, keyframes, tolerances, result.maxErrors);
+        result.simplifiedCount = simplifiedKeyframes.size();
+        return simplifiedKeyframes;
+    }
+
+    bool IsSameKeyframe(const Types::KeyframeableProperty& property, const Types::Keyframe& a, const Types::Keyframe& b)
+    {
+        if (a.id != b.id || a.tick != b.tick || a.interpolation != b.interpolation ||
+            a.bezierHandles != b.bezierHandles)
+            return false;
+
+        for (uint32_t i = 0; i < static_cast<uint32_t>(property.GetValueCount()); i++)
+        {
+            if (a.value.GetByIndex(i) != b.value.GetByIndex(i))
+                return false;
+        }
+        return true;
+    }
+
+    void ApplySimplification(const Types::KeyframeableProperty& property,
+                             const std::vector<Types::Keyframe>& sourceKeyframes,
+                             std::vector<Types::Keyframe> simplifiedKeyframes, const Result& result)
+    {
+        auto& keyframeManager = KeyframeManager::Get();
+        const auto& currentKeyframes = keyframeManager.GetKeyframes(property);
+
+        // the track might have been edited while the worker was busy, in which case the result no longer applies. Any
+        // edit counts, a changed value or handle would be lost just the same as a moved keyframe.
+        const bool trackChanged =
+            currentKeyframes.size() != sourceKeyframes.size() ||
+            !std::equal(currentKeyframes.begin(), currentKeyframes.end(), sourceKeyframes.begin(),
+                        [&](const auto& a, const auto& b) { return IsSameKeyframe(property, a, b); });
+        if (trackChanged)
+        {
+            LOG_WARN("Keyframes of {} changed during simplification, discarding result", property.name);
+            return;
+        }
+
+        if (result.simplifiedCount < result.originalCount)
+        {
+            keyframeManager.ReplaceKeyframes(property, simplifiedKeyframes);
+            keyframeManager.SortAndSaveKeyframes(keyframeManager.GetKeyframes(property));
+        }
+
+        LOG_INFO("Simplified {} from {} to {} keyframes (max error {:.4f})", property.name, result.originalCount,
+                 result.simplifiedCount, *std::max_element(result.maxErrors.begin(), result.maxErrors.end()));
+
+        lastResult = result;
+    }
+
+    void SimplifyTrack(const Types::KeyframeableProperty& property, const std::vector<float>& tolerances)
+    {
+        if (isSimplifying.load())
+        {
+            LOG_WARN("Already simplifying a track");
+            return;
+        }
+
+        auto& keyframeManager = KeyframeManager::Get();
+        if (keyframeManager.AreKeyframesBeingModified())
+            return;
+
+        const auto& keyframes = keyframeManager.GetKeyframes(property);
+        if (keyframes.size() <= ASYNC_KEYFRAME_THRESHOLD)
+        {
+            Result result;
+            auto simplifiedKeyframes = Simplify(property, keyframes, tolerances, result);
+            ApplySimplification(property, std::vector(keyframes), simplifiedKeyframes, result);
+            return;
+        }
+
+        LOG_DEBUG("Simplifying {} keyframes of {} on a worker thread", keyframes.size(), property.name);
+        isSimplifying.store(true);
+        std::thread([&property, keyframes = std::vector(keyframes), tolerances] {
+            PendingSimplification pending{.property = &property, .sourceKeyframes = keyframes};
+            pending.simplifiedKeyframes = Simplify(property, keyframes, tolerances, pending.result);
+
+            std::lock_guard lock(pendingMutex);
+            pendingSimplification = std::move(pending);
+        }).detach();
+    }
+
+    bool IsSimplifying()
+    {
+        return isSimplifying.load();
+    }
+
+    std::optional<Result> GetLastResult()
+    {
+        return lastResult;
+    }
+
+    void Initialize()
+    {
+        Events::RegisterListener(EventType::OnFrame, []() {
+            std::optional<PendingSimplification> pending;
+            {
+                std::lock_guard lock(pendingMutex);
+                pending.swap(pendingSimplification);
+            }
+
+            if (!pending.has_value())
+                return;
+
+            // results are applied on the game thread so the worker never touches the live keyframes
+            ApplySimplification(*pending->property, pending->sourceKeyframes, pending->simplifiedKeyframes,
+                                pending->result);
+            isSimplifying.store(false);
+        });
+
+        Events::RegisterListener(EventType::PostDemoLoad, []() { lastResult.reset(); });
+    }
+}  // namespace IWXMVM::Components::KeyframeSimplifier
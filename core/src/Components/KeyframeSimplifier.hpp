@@ -0,0 +1,28 @@
+#pragma once
+#include "Types/Keyframe.hpp"
+#include "Types/KeyframeableProperty.hpp"
+
+namespace IWXMVM::Components
+{
+    namespace KeyframeSimplifier
+    {
+        struct Result
+        {
+            Types::KeyframeablePropertyType propertyType;
+            std::size_t originalCount = 0;
+            std::size_t simplifiedCount = 0;
+            std::vector<float> maxErrors;  // Largest absolute deviation from the original curve, per value index
+        };
+
+        // Tracks with more keyframes than this are simplified on a worker thread
+        constexpr std::size_t ASYNC_KEYFRAME_THRESHOLD = 32;
+
+        // Simplifies the property's track and replaces it as a single undoable action
+        void SimplifyTrack(const Types::KeyframeableProperty& property, const std::vector<float>& tolerances);
+
+        bool IsSimplifying();
+        std::optional<Result> GetLastResult();
+
+        void Initialize();
+    }  // namespace KeyframeSimplifier
+}  // namespace IWXMVM::Components
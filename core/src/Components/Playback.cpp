@@ -3,6 +3,7 @@
 
 #include "Mod.hpp"
 #include "Rewinding.hpp"
+#include "Utilities/DvarRegistry.hpp"
 
 namespace IWXMVM::Components::Playback
 {
@@ -10,6 +11,9 @@ namespace IWXMVM::Components::Playback
     uint32_t timelineTick = 0;
     std::optional<uint32_t> frozenTick = std::nullopt;
 
+    DvarRegistry::Dvar<float> timescale("timescale");
+    DvarRegistry::Dvar<std::int32_t> com_maxfps("com_maxfps");
+
     void TogglePaused()
     {
         isPlaybackPaused = !isPlaybackPaused;
@@ -174,50 +178,48 @@ namespace IWXMVM::Components::Playback
             return 0;
         }
 
-        const std::optional<Types::Dvar> timescale = Mod::GetGameInterface()->GetDvar("timescale");
-
         // we can use the original msec value when its value is greater than 1, and/or when timescale is equal or
         // greater than 1.0
-        if (gameMsec > 1 || !timescale.has_value() || timescale.value().value->floating_point >= 1.0f)
+        if (gameMsec > 1 || !timescale.IsResolved() || timescale.Get() >= 1.0f)
             return gameMsec;
 
-        const std::optional<Types::Dvar> com_maxfps = Mod::GetGameInterface()->GetDvar("com_maxfps");
-        if (!com_maxfps.has_value())
+        if (!com_maxfps.IsResolved())
             return gameMsec;
 
-        static float lastTimeScale = timescale.value().value->floating_point;
-        static std::int32_t lastMaxFps = com_maxfps.value().value->int32;
+        const auto currentTimeScale = timescale.Get();
+        const auto currentMaxFps = com_maxfps.Get();
+
+        static float lastTimeScale = currentTimeScale;
+        static std::int32_t lastMaxFps = currentMaxFps;
         static std::array<std::uint8_t, 1000> pattern{};
         static std::size_t patternIndex = 0;
 
         // below we're going to generate a pattern of interleaved 0s and 1s based on (imgui) frame times
         // we generate a new pattern each second, or whenever timescale or com_maxfps values changes
 
-        if (lastTimeScale != timescale.value().value->floating_point || lastMaxFps != com_maxfps.value().value->int32)
+        if (lastTimeScale != currentTimeScale || lastMaxFps != currentMaxFps)
         {
             // this branch ensures that any change to the timescale or max fps immediately changes the pattern
             float frameRate;
 
-            if (lastMaxFps >
-                com_maxfps.value().value->int32)  // max fps was decreased, imgui fps is potentially too high
-                frameRate = std::min(ImGui::GetIO().Framerate, static_cast<float>(com_maxfps.value().value->int32));
-            else if (lastMaxFps <
-                     com_maxfps.value().value->int32)  // max fps was increased, imgui fps is potentially too low
-                frameRate = std::max(ImGui::GetIO().Framerate, static_cast<float>(com_maxfps.value().value->int32));
+            if (lastMaxFps > currentMaxFps)  // max fps was decreased, imgui fps is potentially too high
+                frameRate = std::min(ImGui::GetIO().Framerate, static_cast<float>(currentMaxFps));
+            else if (lastMaxFps < currentMaxFps)  // max fps was increased, imgui fps is potentially too low
+                frameRate = std::max(ImGui::GetIO().Framerate, static_cast<float>(currentMaxFps));
             else
             {
-                assert(lastTimeScale != timescale.value().value->floating_point);
+                assert(lastTimeScale != currentTimeScale);
                 frameRate = ImGui::GetIO().Framerate;
             }
 
-            lastTimeScale = timescale.value().value->floating_point;
-            lastMaxFps = com_maxfps.value().value->int32;
+            lastTimeScale = currentTimeScale;
+            lastMaxFps = currentMaxFps;
             patternIndex = 0;
 
-            GeneratePattern(pattern, frameRate, timescale.value().value->floating_point);
+            GeneratePattern(pattern, frameRate, currentTimeScale);
         }
         else if (patternIndex % 1000 == 0)
-            GeneratePattern(pattern, ImGui::GetIO().Framerate, timescale.value().value->floating_point);
+            GeneratePattern(pattern, ImGui::GetIO().Framerate, currentTimeScale);
 
         // advance (1ms) or pause(0ms) based on the pattern
         return pattern[patternIndex++ % 1000];
@@ -2,24 +2,25 @@
 #include "Rendering.hpp"
 
 #include "Mod.hpp"
+#include "Utilities/DvarRegistry.hpp"
 
 namespace IWXMVM::Components::Rendering
 {
     std::atomic<Types::RenderingFlags> renderingFlags;
 
+    DvarRegistry::Dvar<std::uint32_t> r_clearcolor("r_clearcolor");
+    DvarRegistry::Dvar<std::int32_t> r_clear("r_clear");
+    DvarRegistry::Dvar<std::int32_t> cg_drawgun("cg_drawgun");
+
     void SetGreenscreenColor(uint32_t color)
     {
-        auto r_clearcolor = Mod::GetGameInterface()->GetDvar("r_clearcolor").value();
-        r_clearcolor.value->uint32 = color;
-
-        auto r_clear = Mod::GetGameInterface()->GetDvar("r_clear").value();
-        r_clear.value->int32 = 3; // 3 = "steady" - clear every frame with the specified color
+        r_clearcolor.Set(color);
+        r_clear.Set(3); // 3 = "steady" - clear every frame with the specified color
     }
 
     void SetDrawGun(bool drawGun)
     {
-		auto cg_drawgun = Mod::GetGameInterface()->GetDvar("cg_drawgun").value();
-		cg_drawgun.value->int32 = drawGun;
+		cg_drawgun.Set(drawGun);
 	}
 
     Types::RenderingFlags GetRenderingFlags()
@@ -4,6 +4,8 @@
 #include "Playback.hpp"
 #include "Mod.hpp"
 #include "Events.hpp"
+#include "Utilities/CompressedDemo.hpp"
+#include "Utilities/ReadAheadBuffer.hpp"
 
 namespace IWXMVM::Components::Rewinding
 {
@@ -26,12 +28,13 @@ namespace IWXMVM::Components::Rewinding
     enum class FilestreamState
     {
         Uninitialized,
-        InitializationFailed,
+        InitializationFailed,  // The game reads the demo itself, without rewinding
+        Unreadable,            // Compressed, so the game cannot read the demo itself either
         Initialized
     };
 
     FilestreamState filestreamState = FilestreamState::Uninitialized;
-    std::ifstream demoFile;
+    std::unique_ptr<ReadAheadBuffer> demoFile;
     uint32_t demoFileSize = 0;
     uint32_t demoFileOffset = 0;
     std::unique_ptr<InitialGamestate> initialGamestate;
@@ -46,10 +49,7 @@ namespace IWXMVM::Components::Rewinding
     {
         LOG_DEBUG("Closing file handle and resetting rewind data");
         filestreamState = FilestreamState::Uninitialized;
-        if (demoFile.is_open())
-        {
-            demoFile.close();
-        }
+        demoFile.reset();
         demoFileSize = 0;
         demoFileOffset = 0;
         initialGamestate.reset();
@@ -95,7 +95,7 @@ namespace IWXMVM::Components::Rewinding
 
         LOG_DEBUG("Rewound and time is now: {}", initialGamestate->serverTime);
         demoFileOffset = initialGamestate->fileOffset;
-        demoFile.seekg(demoFileOffset);
+        demoFile->Seek(demoFileOffset);
 
         auto addresses = Mod::GetGameInterface()->GetPlaybackDataAddresses();
         *reinterpret_cast<int*>(addresses.cl.parseEntitiesNum) = 0;
@@ -229,23 +229,34 @@ namespace IWXMVM::Components::Rewinding
         if (filestreamState == FilestreamState::Uninitialized)
         {
             auto demoPath = Mod::GetGameInterface()->GetDemoInfo().path;
-            demoFile.open(demoPath, std::ios::binary);
-            if (!demoFile.is_open())
+            // compressed demos are decompressed on the fly, so the offsets below always refer to the raw demo
+            auto demoStream = CompressedDemo::OpenDemo(demoPath);
+            if (!demoStream &&
+                (CompressedDemo::HasCompressedExtension(demoPath) || CompressedDemo::IsCompressed(demoPath)))
+            {
+                // the game's own file handle would hand out compressed bytes as demo messages
+                filestreamState = FilestreamState::Unreadable;
+                LOG_ERROR("Failed to decompress demo file: {}", demoPath);
+            }
+            else if (!demoStream)
             {
                 filestreamState = FilestreamState::InitializationFailed;
                 LOG_ERROR("Failed to open file stream for demo file: {}", demoPath);
             }
             else
             {
-                demoFile.seekg(0, std::ios::end);
-                demoFileSize = (uint32_t)demoFile.tellg();
-                demoFile.seekg(0, std::ios::beg);
+                // the game reads a few bytes at a time, which would otherwise block the frame on every disk access
+                demoFile = std::make_unique<ReadAheadBuffer>(std::move(demoStream));
+                demoFileSize = (uint32_t)demoFile->GetSize();
 
                 filestreamState = FilestreamState::Initialized;
                 LOG_DEBUG("Opened file stream for demo file: {}", demoPath);
             }
         }
 
+        // reading nothing makes the game end the demo as if it was truncated
+        if (filestreamState == FilestreamState::Unreadable)
+            return 0;
         if (filestreamState != FilestreamState::Initialized)
             return -1;
 
@@ -264,11 +275,11 @@ namespace IWXMVM::Components::Rewinding
             StoreCurrentGamestate(len);
         }
 
-        demoFile.read(reinterpret_cast<char*>(buffer), len);
+        demoFile->Read(buffer, len);
         demoFileOffset += len;
 
         // gets triggered when a demo is loaded when playing another demo!
-        assert(demoFileOffset == demoFile.tellg());
+        assert(demoFileOffset == demoFile->GetPosition());
 
         return len;
     }
@@ -8,6 +8,7 @@ namespace IWXMVM::Components
         bool IsRewinding();
         void RewindBy(std::int32_t ticks);
 
+        // Returns -1 if the game should read the demo through its own file handle instead
         int FS_Read(void* buffer, int len);
 
         void Initialize();
@@ -0,0 +1,96 @@
+#include "StdInclude.hpp"
+#include "VisualApplier.hpp"
+
+#include "Mod.hpp"
+#include "Events.hpp"
+
+namespace IWXMVM::Components::VisualApplier
+{
+    template <typename T>
+    struct VisualState
+    {
+        std::optional<T> queued;
+        std::optional<T> applied;  // What the game's dvars hold, as far as is known
+    };
+
+    VisualState<Types::Sun> sunState;
+    VisualState<Types::DoF> dofState;
+    VisualState<Types::Filmtweaks> filmtweaksState;
+
+    template <typename T, typename Setter>
+    void ApplyState(VisualState<T>& state, Setter setter)
+    {
+        if (!state.queued.has_value())
+            return;
+
+        const auto changedFields = state.applied.has_value()
+                                       ? FieldDiff::GetChangedFields(state.applied.value(), state.queued.value())
+                                       : FieldDiff::ALL_FIELDS;
+        if (changedFields != 0)
+        {
+            setter(state.queued.value(), changedFields);
+
+            // fields within the epsilon keep their old value, so slow changes still add up to a write eventually
+            if (state.applied.has_value())
+                FieldDiff::CopyFields(state.applied.value(), state.queued.value(), changedFields);
+            else
+                state.applied = state.queued;
+        }
+
+        state.queued.reset();
+    }
+
+    template <typename T>
+    void ResynchronizeState(VisualState<T>& state)
+    {
+        if (!state.queued.has_value())
+            state.queued = state.applied;
+        state.applied.reset();
+    }
+
+    void SetSun(const Types::Sun& sun)
+    {
+        sunState.queued = sun;
+    }
+
+    void SetDof(const Types::DoF& dof)
+    {
+        dofState.queued = dof;
+    }
+
+    void SetFilmtweaks(const Types::Filmtweaks& filmtweaks)
+    {
+        filmtweaksState.queued = filmtweaks;
+    }
+
+    void Apply()
+    {
+        auto* gameInterface = Mod::GetGameInterface();
+        ApplyState(sunState, [&](const auto& sun, auto changedFields) { gameInterface->SetSun(sun, changedFields); });
+        ApplyState(dofState, [&](const auto& dof, auto changedFields) { gameInterface->SetDof(dof, changedFields); });
+        ApplyState(filmtweaksState, [&](const auto& filmtweaks, auto changedFields) {
+            gameInterface->SetFilmtweaks(filmtweaks, changedFields);
+        });
+    }
+
+    void Reset()
+    {
+        sunState = {};
+        dofState = {};
+        filmtweaksState = {};
+    }
+
+    void Resynchronize()
+    {
+        ResynchronizeState(sunState);
+        ResynchronizeState(dofState);
+        ResynchronizeState(filmtweaksState);
+    }
+
+    void Initialize()
+    {
+        // before the menus queue the visuals for the new map
+        Events::RegisterListener(EventType::PostDemoLoad, Reset, Events::DEFAULT_PRIORITY - 1);
+        Events::RegisterListener(EventType::OnFrame, Apply, std::numeric_limits<std::int32_t>::max());
+    }
+}  // namespace IWXMVM::Components::VisualApplier
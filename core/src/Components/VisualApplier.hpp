@@ -0,0 +1,25 @@
+#pragma once
+#include "Types/Sun.hpp"
+#include "Types/Dof.hpp"
+#include "Types/Filmtweaks.hpp"
+
+namespace IWXMVM::Components::VisualApplier
+{
+    // Queues visuals to be applied, only the last ones queued before the next Apply are written
+    void SetSun(const Types::Sun& sun);
+    void SetDof(const Types::DoF& dof);
+    void SetFilmtweaks(const Types::Filmtweaks& filmtweaks);
+
+    // Writes the fields that differ from the last applied values. Runs once per frame, after every other OnFrame
+    // listener had the chance to queue visuals.
+    void Apply();
+
+    // Forgets what was applied and queued, as loading a map resets the game's visuals
+    void Reset();
+
+    // Queues the last applied visuals again, to be written in full. The game registers its renderer dvars again on
+    // vid_restart, which drops whatever was applied before.
+    void Resynchronize();
+
+    void Initialize();
+}  // namespace IWXMVM::Components::VisualApplier
@@ -4,12 +4,15 @@
 #include "MinHook.h"
 
 #include "Components/CaptureManager.hpp"
+#include "Components/VisualApplier.hpp"
 #include "Events.hpp"
 #include "Graphics/Graphics.hpp"
 #include "Utilities/PathUtils.hpp"
 #include "Mod.hpp"
 #include "UI/UIManager.hpp"
+#include "Utilities/DvarRegistry.hpp"
 #include "Utilities/HookManager.hpp"
+#include "Utilities/Profiler.hpp"
 
 namespace IWXMVM::D3D9
 {
@@ -119,6 +122,10 @@ namespace IWXMVM::D3D9
         gameHeight = pPresentationParameters->BackBufferHeight;
 
         device = *ppReturnedDeviceInterface;
+
+        // the device is recreated by vid_restart, which registers the renderer dvars again
+        DvarRegistry::Resolve();
+        Components::VisualApplier::Resynchronize();
         
         UI::UIManager::Get().Initialize(device, pPresentationParameters->hDeviceWindow);
         GFX::GraphicsManager::Get().Initialize();
@@ -169,6 +176,8 @@ namespace IWXMVM::D3D9
             return EndScene(pDevice);
         }
 
+        PROFILE_FRAME();
+
         if (!UI::UIManager::Get().IsInitialized())
         {
             device = pDevice;
@@ -3,18 +3,179 @@
 
 namespace IWXMVM::Events
 {
-    std::map<EventType, std::vector<std::function<void()>>> listeners;
+    struct Listener
+    {
+        std::uint32_t id;
+        int32_t priority;
+        // Only one of these is set. Listeners without payload are stored as they are, since wrapping them would cost
+        // a second indirect call on every invocation.
+        std::function<void()> function;
+        std::function<void(const void*)> payloadFunction;
+        std::source_location location;
+        bool isRemoved = false;
+
+        std::uint64_t callCount = 0;
+        std::chrono::nanoseconds lastDuration{};
+        std::chrono::nanoseconds totalDuration{};
+    };
+
+    struct EventListeners
+    {
+        std::vector<Listener> listeners;  // Sorted by priority
+
+        // Listeners can register and unregister while their event is invoked, which is applied once it returns
+        std::vector<Listener> pendingListeners;
+        bool hasRemovedListeners = false;
+        std::uint32_t invokeDepth = 0;
+    };
+
+    std::array<EventListeners, EVENT_TYPE_COUNT> events;
+    std::uint32_t nextListenerId = 1;
+    bool isProfilingEnabled = false;
+
+    EventListeners& GetEventListeners(EventType eventType)
+    {
+        return events[static_cast<std::size_t>(eventType)];
+    }
+
+    void InsertListener(std::vector<Listener>& listeners, Listener listener)
+    {
+        const auto position =
+            std::upper_bound(listeners.begin(), listeners.end(), listener.priority,
+                             [](int32_t priority, const Listener& other) { return priority < other.priority; });
+        listeners.insert(position, std::move(listener));
+    }
+
+    void ApplyPendingChanges(EventListeners& event)
+    {
+        if (event.invokeDepth > 0)
+            return;
+
+        if (event.hasRemovedListeners)
+        {
+            std::erase_if(event.listeners, [](const Listener& listener) { return listener.isRemoved; });
+            event.hasRemovedListeners = false;
+        }
+
+        for (auto& listener : event.pendingListeners)
+            InsertListener(event.listeners, std::move(listener));
+        event.pendingListeners.clear();
+    }
+
+    ListenerHandle AddListener(EventType eventType, Listener listener)
+    {
+        auto& event = GetEventListeners(eventType);
+        listener.id = nextListenerId++;
+
+        const ListenerHandle handle{eventType, listener.id};
+        event.pendingListeners.push_back(std::move(listener));
+        ApplyPendingChanges(event);
+
+        return handle;
+    }
+
+    ListenerHandle RegisterPayloadListener(EventType eventType, std::function<void(const void*)> function,
+                                           int32_t priority, std::source_location location)
+    {
+        return AddListener(eventType,
+                           {.priority = priority, .payloadFunction = std::move(function), .location = location});
+    }
 
-    void Invoke(const EventType eventType)
+    ListenerHandle RegisterListener(EventType eventType, std::function<void()> function, int32_t priority,
+                                    std::source_location location)
     {
-        for (const auto& function : listeners[eventType])
+        return AddListener(eventType, {.priority = priority, .function = std::move(function), .location = location});
+    }
+
+    void UnregisterListener(ListenerHandle handle)
+    {
+        auto& event = GetEventListeners(handle.eventType);
+        std::erase_if(event.pendingListeners, [&](const Listener& listener) { return listener.id == handle.id; });
+
+        for (auto& listener : event.listeners)
         {
-            function();
+            if (listener.id == handle.id)
+            {
+                listener.isRemoved = true;
+                event.hasRemovedListeners = true;
+            }
         }
+        ApplyPendingChanges(event);
+    }
+
+    void CallListener(const Listener& listener, const void* payload)
+    {
+        if (listener.function)
+            listener.function();
+        else
+            listener.payloadFunction(payload);
     }
 
-    void RegisterListener(const EventType eventType, const std::function<void()> function)
+    void InvokeListeners(EventType eventType, const void* payload)
     {
-        listeners[eventType].push_back(function);
+        // the vector is left alone until the outermost invocation returns, so iterating it stays valid even if a
+        // listener registers or unregisters one or invokes the event again
+        auto& event = GetEventListeners(eventType);
+        event.invokeDepth++;
+
+        try
+        {
+            for (std::size_t i = 0; i < event.listeners.size(); i++)
+            {
+                auto& listener = event.listeners[i];
+                if (listener.isRemoved)
+                    continue;
+
+                if (!isProfilingEnabled)
+                {
+                    CallListener(listener, payload);
+                    continue;
+                }
+
+                const auto start = std::chrono::steady_clock::now();
+                CallListener(listener, payload);
+                listener.lastDuration = std::chrono::steady_clock::now() - start;
+                listener.totalDuration += listener.lastDuration;
+                listener.callCount++;
+            }
+        }
+        catch (...)
+        {
+            event.invokeDepth--;
+            ApplyPendingChanges(event);
+            throw;
+        }
+
+        event.invokeDepth--;
+        ApplyPendingChanges(event);
+    }
+
+    void SetProfilingEnabled(bool enabled)
+    {
+        isProfilingEnabled = enabled;
+    }
+
+    bool IsProfilingEnabled()
+    {
+        return isProfilingEnabled;
+    }
+
+    std::vector<ListenerStats> GetListenerStats()
+    {
+        std::vector<ListenerStats> stats;
+        for (std::size_t i = 0; i < EVENT_TYPE_COUNT; i++)
+        {
+            for (const auto& listener : events[i].listeners)
+            {
+                if (listener.isRemoved)
+                    continue;
+
+                const auto fileName = std::filesystem::path(listener.location.file_name()).filename().string();
+                stats.push_back({static_cast<EventType>(i), std::format("{}:{}", fileName, listener.location.line()),
+                                 listener.priority, listener.callCount, listener.lastDuration,
+                                 listener.totalDuration});
+            }
+        }
+        return stats;
     }
-}  // namespace IWXMVM::Events
\ No newline at end of file
+}  // namespace IWXMVM::Events
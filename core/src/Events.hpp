@@ -1,4 +1,5 @@
 #pragma once
+#include <source_location>
 
 namespace IWXMVM
 {
@@ -14,7 +15,78 @@ namespace IWXMVM
 
     namespace Events
     {
-        void Invoke(EventType eventType);
-        void RegisterListener(EventType eventType, std::function<void()> function);
+        constexpr std::size_t EVENT_TYPE_COUNT = magic_enum::enum_count<EventType>();
+
+        // Data an event is invoked with, events without a specialization carry none
+        template <EventType eventType>
+        struct Payload
+        {
+        };
+
+        template <>
+        struct Payload<EventType::OnFrame>
+        {
+            std::uint64_t frameIndex;
+            float deltaTime;     // Seconds since the previous frame
+            std::uint32_t tick;  // Timeline tick the frame was started at
+        };
+
+        // Listeners of an event run in ascending priority, listeners with equal priority in registration order
+        constexpr int32_t DEFAULT_PRIORITY = 0;
+
+        struct ListenerHandle
+        {
+            EventType eventType;
+            std::uint32_t id;
+        };
+
+        struct ListenerStats
+        {
+            EventType eventType;
+            std::string name;  // Where the listener was registered
+            int32_t priority;
+            std::uint64_t callCount;
+            std::chrono::nanoseconds lastDuration;
+            std::chrono::nanoseconds totalDuration;
+        };
+
+        // Safe to call from a listener, the new listener is called from the next invocation on
+        ListenerHandle RegisterListener(EventType eventType, std::function<void()> function,
+                                        int32_t priority = DEFAULT_PRIORITY,
+                                        std::source_location location = std::source_location::current());
+
+        ListenerHandle RegisterPayloadListener(EventType eventType, std::function<void(const void*)> function,
+                                               int32_t priority, std::source_location location);
+
+        // Like RegisterListener, but the listener receives the payload its event is invoked with
+        template <EventType eventType>
+        ListenerHandle RegisterListener(std::function<void(const Payload<eventType>&)> function,
+                                        int32_t priority = DEFAULT_PRIORITY,
+                                        std::source_location location = std::source_location::current())
+        {
+            return RegisterPayloadListener(
+                eventType,
+                [function = std::move(function)](const void* payload) {
+                    function(*static_cast<const Payload<eventType>*>(payload));
+                },
+                priority, location);
+        }
+
+        // Safe to call from a listener, including for the listener itself. A listener unregistered while its event is
+        // invoked is not called again, not even by the rest of that invocation.
+        void UnregisterListener(ListenerHandle handle);
+
+        void InvokeListeners(EventType eventType, const void* payload);
+
+        template <EventType eventType>
+        void Invoke(const Payload<eventType>& payload = {})
+        {
+            InvokeListeners(eventType, &payload);
+        }
+
+        // Measures how long each listener takes. Off by default, as it reads the clock twice per listener call.
+        void SetProfilingEnabled(bool enabled);
+        bool IsProfilingEnabled();
+        std::vector<ListenerStats> GetListenerStats();
     }  // namespace Events
-}  // namespace IWXMVM
\ No newline at end of file
+}  // namespace IWXMVM
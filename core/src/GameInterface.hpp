@@ -6,6 +6,8 @@
 #include "Types/GameState.hpp"
 #include "Types/Game.hpp"
 #include "Types/DemoInfo.hpp"
+#include "Types/DemoMetadata.hpp"
+#include "Types/DemoEvent.hpp"
 #include "Types/MouseMode.hpp"
 #include "Types/Dvar.hpp"
 #include "Types/Sun.hpp"
@@ -17,6 +19,7 @@
 #include "Types/HudInfo.hpp"
 #include "Types/RenderingFlags.hpp"
 #include "Types/Features.hpp"
+#include "Utilities/FieldDiff.hpp"
 
 namespace IWXMVM
 {
@@ -62,6 +65,21 @@ namespace IWXMVM
         virtual Types::DemoInfo GetDemoInfo() = 0;
         virtual std::string_view GetDemoExtension() = 0;
 
+        // Must not touch game state, as this is called from worker threads
+        virtual std::optional<Types::DemoMetadata> ReadDemoMetadata(const std::filesystem::path& demoPath) = 0;
+        virtual std::vector<Types::DemoEvent> ReadDemoEvents(const std::filesystem::path& demoPath) = 0;
+
+        // Writes the demo at `demoPath` up to the server time `endServerTime` (see DemoInfo::startServerTime) to a new
+        // file, reporting the fraction read so far through `onProgress`. Gives up and removes the file when a stop is
+        // requested. Must not touch game state, as this is called from worker threads.
+        virtual bool WriteTrimmedDemo(const std::filesystem::path& demoPath, const std::filesystem::path& outputPath,
+                                      int32_t endServerTime, const std::function<void(float)>& onProgress,
+                                      std::stop_token stopToken) = 0;
+
+        // Logs any damage in a demo file and optionally writes a repaired copy next to it. Returns whether the demo
+        // is intact. Must not touch game state, as this is called from worker threads.
+        virtual bool CheckDemoIntegrity(const std::filesystem::path& demoPath, bool repair) = 0;
+
         virtual void PlayDemo(std::filesystem::path demoPath) = 0;
         virtual void Disconnect() = 0;
         virtual void Vid_Restart() = 0;
@@ -77,14 +95,16 @@ namespace IWXMVM
         virtual Types::DoF GetDof() = 0;
         virtual Types::Filmtweaks GetFilmtweaks() = 0;
         virtual Types::HudInfo GetHudInfo() = 0;
-        virtual void SetSun(Types::Sun) = 0;
-        virtual void SetDof(Types::DoF) = 0;
-        virtual void SetFilmtweaks(Types::Filmtweaks) = 0;
+        // Only the fields set in the mask are written, see Components::VisualApplier
+        virtual void SetSun(Types::Sun, FieldDiff::FieldMask changedFields = FieldDiff::ALL_FIELDS) = 0;
+        virtual void SetDof(Types::DoF, FieldDiff::FieldMask changedFields = FieldDiff::ALL_FIELDS) = 0;
+        virtual void SetFilmtweaks(Types::Filmtweaks, FieldDiff::FieldMask changedFields = FieldDiff::ALL_FIELDS) = 0;
         virtual void SetHudInfo(Types::HudInfo) = 0;
 
-        virtual std::vector<Types::Entity> GetEntities() = 0;
+        // Converts the first entities.size() cgame entities, see Components::EntityTable for cached access
+        virtual void GetEntities(std::span<Types::Entity> entities) = 0;
         virtual Types::BoneData GetBoneData(int32_t entityId, const std::string& name) = 0;
-        virtual constexpr std::vector<std::string> GetSupportedBoneNames() = 0;
+        virtual const std::vector<std::string>& GetSupportedBoneNames() = 0;
 
         // == things for rewinding ==
         virtual void CL_FirstSnapshot() = 0;
@@ -8,7 +8,9 @@
 #include "Input.hpp"
 #include "Mod.hpp"
 #include "Types/Vertex.hpp"
+#include "Utilities/DvarRegistry.hpp"
 #include "Utilities/MathUtils.hpp"
+#include "Utilities/Profiler.hpp"
 
 INCBIN_EXTERN(VERTEX_SHADER);
 INCBIN_EXTERN(PIXEL_SHADER);
@@ -241,6 +243,8 @@ namespace IWXMVM::GFX
         return view;
     }
 
+    DvarRegistry::Dvar<float> r_znear("r_znear");
+
     glm::mat4 GetProjectionMatrix()
     {
         const auto& camera = Components::CameraManager::Get().GetActiveCamera();
@@ -249,7 +253,7 @@ namespace IWXMVM::GFX
         const auto tanHalfFovX = glm::tan(glm::radians(camera->GetFov()) * 0.5f);
         const auto tanHalfFovY = tanHalfFovX * (1.0f / aspectRatio);
         const auto fovY = glm::atan(tanHalfFovY) * 2.0f;
-        const auto znear = Mod::GetGameInterface()->GetDvar("r_znear").value().value->floating_point;
+        const auto znear = r_znear.Get(4.0f);  // the game's default
 
         return glm::perspectiveLH_ZO(fovY, aspectRatio, znear, 100000.0f);
     }
@@ -754,6 +758,8 @@ namespace IWXMVM::GFX
 
     void GraphicsManager::Render()
     {
+        PROFILE_ZONE("GraphicsManager::Render");
+
         if (ImGui::GetMainViewport()->Size.x == 0.0f || ImGui::GetMainViewport()->Size.y == 0.0f)
         {
             return;
@@ -5,6 +5,7 @@
 #include "Version.hpp"
 #include "WindowsConsole.hpp"
 #include "Input.hpp"
+#include "Utilities/DvarRegistry.hpp"
 #include "Utilities/HookManager.hpp"
 #include "Utilities/PathUtils.hpp"
 #include "Utilities/MemoryUtils.hpp"
@@ -36,6 +37,7 @@ namespace IWXMVM
     {
         try
         {
+            const auto initializationStart = std::chrono::steady_clock::now();
             internalGameInterface = gameInterface;
 
             WindowsConsole::Open();
@@ -47,21 +49,30 @@ namespace IWXMVM
 
             LOG_DEBUG("Scanning signatures...");
             gameInterface->InitializeGameAddresses();
+            DvarRegistry::Initialize();
 
             LOG_DEBUG("Initializing components...");
             Configuration::Get().Initialize();
             Components::CameraManager::Get().Initialize();
             Components::CampathManager::Get().Initialize();
             Components::KeyframeManager::Get().Initialize();
+            Components::KeyframeSimplifier::Initialize();
+            Components::FrameState::Initialize();
+            Components::DemoMetadataCache::Initialize();
+            Components::DemoEventTimeline::Initialize();
             Components::Rewinding::Initialize();
             Components::Rendering::Initialize();
+            Components::VisualApplier::Initialize();
+            Components::EntityTable::Initialize();
 
             LOG_DEBUG("Installing game hooks and patches...");
             D3D9::Initialize();
             gameInterface->InstallHooksAndPatches();
             gameInterface->SetupEventListeners();
 
-            LOG_INFO("Initialized IWXMVM!");
+            const auto initializationTime = std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::steady_clock::now() - initializationStart);
+            LOG_INFO("Initialized IWXMVM in {} ms!", initializationTime.count());
 
             while (!ejectRequested.load())
                 std::this_thread::sleep_for(std::chrono::milliseconds(1));
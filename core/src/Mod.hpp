@@ -3,9 +3,15 @@
 #include "Components/CameraManager.hpp"
 #include "Components/CampathManager.hpp"
 #include "Components/KeyframeManager.hpp"
+#include "Components/KeyframeSimplifier.hpp"
+#include "Components/FrameState.hpp"
+#include "Components/DemoMetadataCache.hpp"
+#include "Components/DemoEventTimeline.hpp"
 #include "Components/CaptureManager.hpp"
 #include "Components/Rewinding.hpp"
 #include "Components/Rendering.hpp"
+#include "Components/VisualApplier.hpp"
+#include "Components/EntityTable.hpp"
 
 namespace IWXMVM
 {
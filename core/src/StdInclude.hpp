@@ -13,6 +13,7 @@
 #include <functional>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <numeric>
 #include <span>
 #include <string>
@@ -21,6 +22,7 @@
 #include <variant>
 #include <stack>
 #include <chrono>
+#include <thread>
 
 #include <initguid.h>
 #include <d3d9.h>
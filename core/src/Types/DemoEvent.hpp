@@ -0,0 +1,32 @@
+#pragma once
+
+namespace IWXMVM::Types
+{
+    // Only what can be told apart without decoding snapshots or server commands is reported. Kills, round ends and
+    // the like need the game's Huffman table, which is not available outside of it.
+    enum class DemoEventType
+    {
+        // The recorded view jumps further than a player can move between two client archives. This happens on
+        // respawns, when a spectator switches to another player and when a killcam starts or ends, which the
+        // archives alone cannot distinguish.
+        ViewCut,
+    };
+
+    static inline std::string_view ToString(DemoEventType type)
+    {
+        switch (type)
+        {
+            case DemoEventType::ViewCut:
+                return "View cut: respawn, spectator switch or killcam";
+            default:
+                return "Unknown Event";
+        }
+    }
+
+    // A moment of interest found by reading a demo file ahead of playback
+    struct DemoEvent
+    {
+        DemoEventType type;
+        uint32_t tick;  // Relative to the demo start, like DemoInfo::gameTick
+    };
+}  // namespace IWXMVM::Types
@@ -6,8 +6,10 @@ namespace IWXMVM::Types
     {
         std::string name;
         std::string path;
+        std::string mapName;
 
         uint32_t gameTick;
         uint32_t endTick;
+        uint32_t startServerTime;  // Server time of tick 0, ticks are relative to it
     };
 }  // namespace IWXMVM::Types
\ No newline at end of file
@@ -0,0 +1,30 @@
+#pragma once
+
+namespace IWXMVM::Types
+{
+    // Information about a demo file that can be read without loading it in-game
+    struct DemoMetadata
+    {
+        std::uintmax_t fileSize = 0;
+        std::int64_t lastWriteTime = 0;
+
+        uint32_t startTick = 0;
+        uint32_t endTick = 0;
+        uint32_t archiveCount = 0;
+        bool isCoD4X = false;
+
+        // The map is only sent in the compressed gamestate, so it is not read from the file. It is filled in once the
+        // demo has been played and stays empty until then.
+        std::string mapName;
+
+        bool HasBounds() const
+        {
+            return endTick > startTick;
+        }
+
+        uint32_t GetDuration() const
+        {
+            return HasBounds() ? endTick - startTick : 0;
+        }
+    };
+}  // namespace IWXMVM::Types
\ No newline at end of file
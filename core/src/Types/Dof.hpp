@@ -1,4 +1,5 @@
 #pragma once
+#include "Utilities/FieldDiff.hpp"
 
 namespace IWXMVM::Types
 {
@@ -13,4 +14,15 @@ namespace IWXMVM::Types
         float nearEnd;
         float bias;
     };
-}  // namespace IWXMVM::Types
\ No newline at end of file
+}  // namespace IWXMVM::Types
+
+namespace IWXMVM::FieldDiff
+{
+    template <>
+    struct Fields<Types::DoF>
+    {
+        static constexpr auto members =
+            std::make_tuple(&Types::DoF::enabled, &Types::DoF::farBlur, &Types::DoF::farStart, &Types::DoF::farEnd,
+                            &Types::DoF::nearBlur, &Types::DoF::nearStart, &Types::DoF::nearEnd, &Types::DoF::bias);
+    };
+}  // namespace IWXMVM::FieldDiff
\ No newline at end of file
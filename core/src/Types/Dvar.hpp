@@ -13,6 +13,7 @@ namespace IWXMVM::Types
         std::string_view name;
         union Value
         {
+            bool enabled;
             float floating_point;
             uint32_t uint32;
             int32_t int32;
@@ -20,6 +21,7 @@ namespace IWXMVM::Types
             const char* string;
             uint8_t color[4];
         }* value;
+        bool* modified = nullptr;  // Makes the game reapply the value, if it tracks changes to the dvar
     };
 
 }  // namespace IWXMVM::Types
\ No newline at end of file
@@ -4,6 +4,9 @@
 
 namespace IWXMVM::Types
 {
+    // Number of cgame entities exposed to core
+    constexpr std::size_t MAX_ENTITIES = 256;
+
     enum class EntityType
     {
         Unsupported,
@@ -21,7 +24,9 @@ namespace IWXMVM::Types
         int32_t clientNum; // associated client number
         bool isValid;
 
-        std::string ToString()
+        bool operator==(const Entity&) const = default;
+
+        std::string ToString() const
         {
             auto EntityTypeToString = [](Types::EntityType type) -> std::string {
                 switch (type)
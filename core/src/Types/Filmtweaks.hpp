@@ -1,5 +1,6 @@
 #pragma once
 #include "glm/vec3.hpp"
+#include "Utilities/FieldDiff.hpp"
 
 namespace IWXMVM::Types
 {
@@ -13,4 +14,16 @@ namespace IWXMVM::Types
         glm::vec3 tintDark;
         bool invert;
     };
-}  // namespace IWXMVM::Types
\ No newline at end of file
+}  // namespace IWXMVM::Types
+
+namespace IWXMVM::FieldDiff
+{
+    template <>
+    struct Fields<Types::Filmtweaks>
+    {
+        static constexpr auto members =
+            std::make_tuple(&Types::Filmtweaks::enabled, &Types::Filmtweaks::brightness, &Types::Filmtweaks::contrast,
+                            &Types::Filmtweaks::desaturation, &Types::Filmtweaks::tintLight,
+                            &Types::Filmtweaks::tintDark, &Types::Filmtweaks::invert);
+    };
+}  // namespace IWXMVM::FieldDiff
\ No newline at end of file
@@ -108,6 +108,20 @@ namespace IWXMVM::Types
 		}
     };
 
+    // Determines how the segment from a keyframe to the next one is interpolated
+    enum class InterpolationMode
+    {
+        Step,
+        Linear,
+        Cubic,  // falls back to linear on tracks with less than 4 keyframes
+        Bezier,
+        EaseInOut,
+        Count
+    };
+
+    // Control points (x1, y1, x2, y2) of the timing curve used by InterpolationMode::Bezier
+    const glm::vec4 DEFAULT_BEZIER_HANDLES(0.25f, 0.1f, 0.25f, 1.0f);
+
     struct Keyframe
     {
         std::reference_wrapper<const KeyframeableProperty> property;
@@ -115,6 +129,8 @@ namespace IWXMVM::Types
         std::int32_t id;
         std::uint32_t tick;
         KeyframeValue value;
+        InterpolationMode interpolation = InterpolationMode::Cubic;
+        glm::vec4 bezierHandles = DEFAULT_BEZIER_HANDLES;
 
         Keyframe(const KeyframeableProperty& property, std::uint32_t tick, KeyframeValue value)
             : id(nextId++), property(property), tick(tick), value(value)
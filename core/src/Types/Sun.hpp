@@ -1,5 +1,6 @@
 #pragma once
 #include "glm/vec3.hpp"
+#include "Utilities/FieldDiff.hpp"
 
 namespace IWXMVM::Types
 {
@@ -9,4 +10,14 @@ namespace IWXMVM::Types
         glm::vec3 direction;
         float brightness;
     };
-}  // namespace IWXMVM::Types
\ No newline at end of file
+}  // namespace IWXMVM::Types
+
+namespace IWXMVM::FieldDiff
+{
+    template <>
+    struct Fields<Types::Sun>
+    {
+        static constexpr auto members = std::make_tuple(&Types::Sun::color, &Types::Sun::direction,
+                                                        &Types::Sun::brightness);
+    };
+}  // namespace IWXMVM::FieldDiff
\ No newline at end of file
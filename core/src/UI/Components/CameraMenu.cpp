@@ -5,6 +5,7 @@
 #include "UI/UIManager.hpp"
 #include "UI/ImGuiEx/ImGuiExtensions.hpp"
 #include "Components/CameraManager.hpp"
+#include "Components/EntityTable.hpp"
 #include "Input.hpp"
 #include "Events.hpp"
 #include "Utilities/MathUtils.hpp"
@@ -46,7 +47,7 @@ namespace IWXMVM::UI
         auto boneCamera = static_cast<Components::BoneCamera*>(currentCamera.get());
         ImGui::SetCursorPosX(ImGui::GetWindowWidth() * columnPercent);
         ImGui::SetNextItemWidth(ImGui::GetWindowWidth() * (1.0f - columnPercent) - ImGui::GetStyle().WindowPadding.x);
-        auto entities = Mod::GetGameInterface()->GetEntities();
+        const auto entities = Components::EntityTable::GetEntities();
         if (ImGui::BeginCombo("##gameViewBoneCameraTargetCombo",
                               entities[boneCamera->GetEntityId()].ToString().c_str()))
         {
@@ -162,6 +163,25 @@ namespace IWXMVM::UI
         ImGui::TextWrapped("There are no settings for this camera mode!");
     }
 
+    // Interpolation is set per node, so the campath only has a single mode if every segment shares it
+    std::string_view GetCampathInterpolationLabel(const std::vector<Types::Keyframe>& campathNodes)
+    {
+        auto GetSegmentMode = [&](const Types::Keyframe& node) {
+            const auto isCubicFallback =
+                node.interpolation == Types::InterpolationMode::Cubic && campathNodes.size() < 4;
+            return isCubicFallback ? Types::InterpolationMode::Linear : node.interpolation;
+        };
+
+        // the last node starts no segment
+        const auto mode = GetSegmentMode(campathNodes.front());
+        for (std::size_t i = 1; i + 1 < campathNodes.size(); i++)
+        {
+            if (GetSegmentMode(campathNodes[i]) != mode)
+                return "Mixed";
+        }
+        return magic_enum::enum_name(mode);
+    }
+
     void DrawDollycamSettings()
     {
         auto columnPercent = 0.4f;
@@ -190,7 +210,17 @@ namespace IWXMVM::UI
         ImGui::SameLine();
         ImGui::SetCursorPosX(ImGui::GetWindowWidth() * columnPercent);
         ImGui::SetNextItemWidth(ImGui::GetWindowWidth() * (1.0f - columnPercent) - ImGui::GetStyle().WindowPadding.x);
-        ImGui::Text("%s", campathNodes.size() < 4 ? "Linear" : "Cubic");
+        ImGui::Text("%s", GetCampathInterpolationLabel(campathNodes).data());
+
+        auto dollyCamera =
+            static_cast<Components::DollyCamera*>(Components::CameraManager::Get().GetActiveCamera().get());
+
+        ImGui::AlignTextToFramePadding();
+        ImGui::Text("Constant Speed");
+        ImGui::SameLine();
+        ImGui::SetCursorPosX(ImGui::GetWindowWidth() * columnPercent);
+        ImGui::SetNextItemWidth(ImGui::GetWindowWidth() * (1.0f - columnPercent) - ImGui::GetStyle().WindowPadding.x);
+        ImGui::Checkbox("##dollyCameraConstantSpeed", &dollyCamera->UseConstantSpeed());
 
         ImGui::Dummy(ImVec2(0, 5));
 
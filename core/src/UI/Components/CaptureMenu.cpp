@@ -23,6 +23,76 @@ namespace IWXMVM::UI
     constexpr auto fieldLayoutPercentage = 0.4f;
     std::optional<int32_t> displayPassIndex = std::nullopt;
 
+    // A demo export running in the background, shared with the worker thread writing it
+    struct DemoExport
+    {
+        std::filesystem::path outputPath;
+        std::atomic<float> progress = 0.0f;
+        std::atomic<bool> isDone = false;
+        std::atomic<bool> succeeded = false;
+        double doneTime = 0.0;
+    };
+    std::shared_ptr<DemoExport> demoExport;
+    std::jthread demoExportThread;
+    constexpr auto demoExportNoticeSeconds = 5.0;
+
+    bool IsExportingDemo()
+    {
+        return demoExport && !demoExport->isDone;
+    }
+
+    void StartDemoExport(const std::filesystem::path& outputPath, uint32_t endTick)
+    {
+        demoExport = std::make_shared<DemoExport>();
+        demoExport->outputPath = outputPath;
+
+        // the demo's server times are only valid on this thread, the worker is handed the absolute end time
+        const auto demoInfo = Mod::GetGameInterface()->GetDemoInfo();
+        const auto endServerTime = static_cast<int32_t>(demoInfo.startServerTime + endTick);
+
+        // trimming reads the whole demo, which takes far longer than a frame for large demos. The previous export is
+        // done at this point, so replacing its thread does not block.
+        demoExportThread = std::jthread([state = demoExport, demoPath = demoInfo.path,
+                                         endServerTime](std::stop_token stopToken) {
+            const auto succeeded = Mod::GetGameInterface()->WriteTrimmedDemo(
+                demoPath, state->outputPath, endServerTime, [&state](float progress) { state->progress = progress; },
+                stopToken);
+            state->succeeded = succeeded;
+            state->isDone = true;
+        });
+    }
+
+    void DrawDemoExportNotice()
+    {
+        if (!demoExport || !demoExport->isDone)
+            return;
+
+        if (demoExport->doneTime == 0.0)
+            demoExport->doneTime = ImGui::GetTime();
+        if (ImGui::GetTime() - demoExport->doneTime > demoExportNoticeSeconds)
+        {
+            demoExport.reset();
+            return;
+        }
+
+        const auto viewport = ImGui::GetMainViewport();
+        const auto padding = ImGui::GetStyle().WindowPadding;
+        ImGui::SetNextWindowPos(ImVec2(viewport->WorkPos.x + viewport->WorkSize.x - padding.x,
+                                       viewport->WorkPos.y + viewport->WorkSize.y - padding.y),
+                                ImGuiCond_Always, ImVec2(1, 1));
+        ImGuiWindowFlags flags = ImGuiWindowFlags_NoDecoration | ImGuiWindowFlags_AlwaysAutoResize |
+                                 ImGuiWindowFlags_NoSavedSettings | ImGuiWindowFlags_NoFocusOnAppearing |
+                                 ImGuiWindowFlags_NoNav | ImGuiWindowFlags_NoMove;
+        if (ImGui::Begin("##demoExportNotice", NULL, flags))
+        {
+            if (demoExport->succeeded)
+                ImGui::Text(ICON_FA_CHECK "  Exported demo to %s", demoExport->outputPath.filename().string().c_str());
+            else
+                ImGui::Text(ICON_FA_TRIANGLE_EXCLAMATION "  Failed to export demo, see the console for details");
+        }
+        ImGui::End();
+    }
+
     std::optional<int32_t> CaptureMenu::GetDisplayPassIndex() const
     {
         return displayPassIndex;
@@ -165,6 +235,8 @@ namespace IWXMVM::UI
     {
         using namespace Components;
 
+        DrawDemoExportNotice();
+
         ImGuiWindowFlags flags = ImGuiWindowFlags_NoScrollbar | ImGuiWindowFlags_NoResize | ImGuiWindowFlags_NoTitleBar;
         if (ImGui::Begin("Capture", NULL, flags))
         {
@@ -200,6 +272,31 @@ namespace IWXMVM::UI
             ImGui::SetNextItemWidth(halfWidth);
             ImGui::DragInt("##endTickInput", (int32_t*)&captureSettings.endTick, 10, captureSettings.startTick, endTick);
 
+            ImGui::SetCursorPosX(ImGui::GetWindowWidth() * fieldLayoutPercentage);
+            if (IsExportingDemo())
+            {
+                ImGui::PushStyleColor(ImGuiCol_PlotHistogram, ImGui::GetColorU32(ImGuiCol_Button));
+                ImGui::ProgressBar(demoExport->progress, ImVec2(halfWidth * 2 + ImGui::GetStyle().ItemSpacing.x, 0),
+                                   "Exporting demo...");
+                ImGui::PopStyleColor();
+            }
+            else
+            {
+                if (ImGui::Button(ICON_FA_SCISSORS " Export Demo Until End Tick"))
+                {
+                    auto path = PathUtils::OpenFileDialog(true, OFN_EXPLORER | OFN_PATHMUSTEXIST | OFN_OVERWRITEPROMPT,
+                                                          "Demo (*.dm_1)\0*.dm_1\0", "dm_1");
+                    if (path.has_value())
+                        StartDemoExport(path.value(), captureSettings.endTick);
+                }
+                if (ImGui::BeginItemTooltip())
+                {
+                    ImGui::TextUnformatted("Writes a copy of the demo that ends at the end tick.");
+                    ImGui::TextUnformatted("The start is kept, as every snapshot is stored relative to earlier ones.");
+                    ImGui::EndTooltip();
+                }
+            }
+
             ImGui::AlignTextToFramePadding();
             ImGui::Text("Output Format");
             ImGui::SameLine();
@@ -426,5 +523,9 @@ namespace IWXMVM::UI
 
     void CaptureMenu::Release()
     {
+        // the export gives up at its next client archive and removes the partial file
+        demoExportThread.request_stop();
+        if (demoExportThread.joinable())
+            demoExportThread.join();
     }
 }  // namespace IWXMVM::UI
\ No newline at end of file
@@ -3,11 +3,13 @@
 
 #include "Mod.hpp"
 #include "Components/CameraManager.hpp"
+#include "Components/DemoEventTimeline.hpp"
 #include "Components/Playback.hpp"
 #include "Components/Rewinding.hpp"
 #include "UI/ImGuiEx/ImGuiExtensions.hpp"
 #include "UI/UIImage.hpp"
 #include "UI/UIManager.hpp"
+#include "Utilities/DvarRegistry.hpp"
 #include "Input.hpp"
 #include "Components/Playback.hpp"
 
@@ -15,7 +17,7 @@ namespace IWXMVM::UI
 {
     float playbackSpeed;
 
-    std::optional<Types::Dvar> timescale;
+    DvarRegistry::Dvar<float> timescale("timescale");
 
     void ControlBar::Initialize()
     {
@@ -94,21 +96,17 @@ namespace IWXMVM::UI
 
         if (Input::BindDown(Action::PlaybackFaster))
         {
-            float& fTimescale = timescale.value().value->floating_point;
-
-            if (const auto it = std::upper_bound(TIMESCALE_STEPS.begin(), TIMESCALE_STEPS.end(), fTimescale);
+            if (const auto it = std::upper_bound(TIMESCALE_STEPS.begin(), TIMESCALE_STEPS.end(), timescale.Get());
                 it != TIMESCALE_STEPS.end())
-                fTimescale = *it;
+                timescale.Set(*it);
         }
 
         if (Input::BindDown(Action::PlaybackSlower))
         {
-            float& fTimescale = timescale.value().value->floating_point;
-
-            if (const auto it = std::upper_bound(TIMESCALE_STEPS.rbegin(), TIMESCALE_STEPS.rend(), fTimescale,
+            if (const auto it = std::upper_bound(TIMESCALE_STEPS.rbegin(), TIMESCALE_STEPS.rend(), timescale.Get(),
                                                  std::greater<float>());
                 it != TIMESCALE_STEPS.rend())
-                fTimescale = *it;
+                timescale.Set(*it);
         }
 
         if (Input::BindDown(Action::PlaybackSkipForward))
@@ -309,6 +307,46 @@ namespace IWXMVM::UI
         }
     }
 
+    void ControlBar::DrawEventMarkers(int32_t displayStartTick, int32_t displayEndTick, float progressBarX,
+                                      float progressBarWidth, ImVec2 pauseButtonSize, uint32_t currentTick)
+    {
+        const auto events = Components::DemoEventTimeline::GetEvents();
+        if (!events || displayEndTick <= displayStartTick)
+            return;
+
+        const float tickRange = static_cast<float>(displayEndTick - displayStartTick);
+        const auto markerSize = ImGui::GetFontSize() * 0.3f;
+        const auto markerBottom = GetPosition().y + GetSize().y / 2 - pauseButtonSize.y / 2 - 1;
+        const auto markerTop = markerBottom - markerSize * 2;
+        const auto mousePos = ImGui::GetMousePos();
+        auto drawList = ImGui::GetWindowDrawList();
+
+        // events are sorted by tick, so only the ones in the displayed range are visited
+        auto it = std::lower_bound(events->begin(), events->end(), displayStartTick,
+                                   [](const auto& event, int32_t tick) { return std::cmp_less(event.tick, tick); });
+        for (; it != events->end() && std::cmp_less_equal(it->tick, displayEndTick); ++it)
+        {
+            const auto percentage = static_cast<float>(it->tick - displayStartTick) / tickRange;
+            const auto x = GetPosition().x + progressBarX + percentage * progressBarWidth;
+            const bool isHovered = std::abs(mousePos.x - x) <= markerSize && mousePos.y >= markerTop &&
+                                   mousePos.y <= markerBottom;
+
+            const auto color = ImGui::GetColorU32(isHovered ? ImGuiCol_SliderGrabActive : ImGuiCol_SliderGrab);
+            drawList->AddTriangleFilled(ImVec2(x - markerSize, markerTop), ImVec2(x + markerSize, markerTop),
+                                        ImVec2(x, markerBottom), color);
+
+            if (!isHovered)
+                continue;
+
+            ImGui::SetTooltip("%s (tick %u)", Types::ToString(it->type).data(), it->tick);
+            if (ImGui::IsMouseClicked(ImGuiMouseButton_Left) && !Components::Rewinding::IsRewinding())
+            {
+                Components::Playback::SetTickDelta(static_cast<int32_t>(it->tick) - static_cast<int32_t>(currentTick),
+                                                   true);
+            }
+        }
+    }
+
     void ControlBar::Render()
     {
         if (Mod::GetGameInterface()->GetGameState() == Types::GameState::MainMenu)
@@ -319,11 +357,8 @@ namespace IWXMVM::UI
         if (Mod::GetGameInterface()->GetGameState() != Types::GameState::InDemo)
             return;
 
-        if (!timescale.has_value())
-        {
-            timescale = Mod::GetGameInterface()->GetDvar("timescale");
+        if (!timescale.IsResolved())
             return;
-        }
 
         HandlePlaybackInput();
 
@@ -380,11 +415,13 @@ namespace IWXMVM::UI
             ImGui::SetNextItemWidth(playbackSpeedSliderWidth - buttonSize.x - ImGui::GetFontSize() * 0.8f);
             ImGui::SetCursorPosX(padding.x + 2 * buttonSize.x + 2 * ImGui::GetFontSize() * 0.8f);
             ImGui::SetCursorPosY(GetSize().y / 2 - buttonSize.y / 2);
-            ImGuiEx::TimescaleSlider("##1", &timescale.value().value->floating_point, 
+            auto timescaleValue = timescale.Get();
+            if (ImGuiEx::TimescaleSlider("##1", &timescaleValue, 
                 Components::Playback::TIMESCALE_STEPS.front(),
                 Components::Playback::TIMESCALE_STEPS.back(),
                 "%.3f",
-                ImGuiSliderFlags_Logarithmic | ImGuiSliderFlags_NoInput);
+                ImGuiSliderFlags_Logarithmic | ImGuiSliderFlags_NoInput))
+                timescale.Set(timescaleValue);
 
             const auto demoInfo = Mod::GetGameInterface()->GetDemoInfo();
             const auto currentTick = Components::Playback::GetTimelineTick();
@@ -402,6 +439,8 @@ namespace IWXMVM::UI
                 const auto [displayStartTick, displayEndTick] = keyframeEditor->GetDisplayTickRange();
 
                 DrawCaptureRangeIndicators(displayStartTick, displayEndTick, progressBarX, progressBarWidth, buttonSize);
+                DrawEventMarkers(displayStartTick, displayEndTick, progressBarX, progressBarWidth, buttonSize,
+                                 currentTick);
 
                 ImGui::SetNextItemWidth(progressBarWidth);
                 static uint32_t tickValue{};
@@ -19,6 +19,8 @@ namespace IWXMVM::UI
                                        uint32_t* captureSettingsTargetTick, bool* draggingTimeframe);
         void DrawCaptureRangeIndicators(int32_t displayStartTick, int32_t displayEndTick, float progressBarX,
                                         float progressBarWidth, ImVec2 pauseButtonSize);
+        void DrawEventMarkers(int32_t displayStartTick, int32_t displayEndTick, float progressBarX,
+                              float progressBarWidth, ImVec2 pauseButtonSize, uint32_t currentTick);
 
         bool draggingStartTimeframe = false;
         bool draggingEndTimeframe = false;
@@ -1,10 +1,13 @@
 #include "StdInclude.hpp"
 #include "DebugPanel.hpp"
 
+#include "Components/EntityTable.hpp"
 #include "Components/Playback.hpp"
 #include "Utilities/HookManager.hpp"
+#include "Utilities/PathUtils.hpp"
 #include "UI/UIManager.hpp"
 #include "Mod.hpp"
+#include "Events.hpp"
 
 namespace IWXMVM::UI
 {
@@ -33,12 +36,184 @@ namespace IWXMVM::UI
 
             auto& camera = Components::CameraManager::Get().GetActiveCamera();
             ImGui::Text("Camera: %f %f %f", camera->GetPosition().x, camera->GetPosition().y, camera->GetPosition().z);
+            ImGui::Text("Entity Table Refreshes: %llu", Components::EntityTable::GetRefreshCount());
             if (ImGui::Button("Eject"))
                 Mod::RequestEject();
+
+            RenderEventListenerStats();
+            RenderProfiler();
             ImGui::End();
         }
     }
 
+    void DebugPanel::RenderEventListenerStats()
+    {
+        if (!ImGui::CollapsingHeader("Event Listeners"))
+            return;
+
+        auto isProfilingEnabled = Events::IsProfilingEnabled();
+        if (ImGui::Checkbox("Profile listeners", &isProfilingEnabled))
+            Events::SetProfilingEnabled(isProfilingEnabled);
+
+        if (!ImGui::BeginTable("##debugPanelEventListeners", 5, ImGuiTableFlags_RowBg | ImGuiTableFlags_SizingFixedFit))
+            return;
+
+        ImGui::TableSetupColumn("Event");
+        ImGui::TableSetupColumn("Listener");
+        ImGui::TableSetupColumn("Priority");
+        ImGui::TableSetupColumn("Last (ms)");
+        ImGui::TableSetupColumn("Average (ms)");
+        ImGui::TableHeadersRow();
+
+        using Milliseconds = std::chrono::duration<double, std::milli>;
+        for (const auto& stats : Events::GetListenerStats())
+        {
+            const auto average =
+                stats.callCount > 0 ? Milliseconds(stats.totalDuration).count() / stats.callCount : 0.0;
+
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn();
+            ImGui::Text("%s", magic_enum::enum_name(stats.eventType).data());
+            ImGui::TableNextColumn();
+            ImGui::Text("%s", stats.name.c_str());
+            ImGui::TableNextColumn();
+            ImGui::Text("%d", stats.priority);
+            ImGui::TableNextColumn();
+            ImGui::Text("%.3f", Milliseconds(stats.lastDuration).count());
+            ImGui::TableNextColumn();
+            ImGui::Text("%.3f", average);
+        }
+        ImGui::EndTable();
+    }
+
+    void DebugPanel::RenderProfiler()
+    {
+        if (!ImGui::CollapsingHeader("Profiler"))
+            return;
+
+        auto isRecording = Profiler::IsRecording();
+        if (ImGui::Checkbox("Record", &isRecording))
+            Profiler::SetRecording(isRecording);
+        ImGui::SameLine();
+        ImGui::Checkbox("Pause view", &isProfilerViewPaused);
+        ImGui::SameLine();
+        if (ImGui::Button("Export trace"))
+        {
+            auto path = PathUtils::OpenFileDialog(true, OFN_EXPLORER | OFN_PATHMUSTEXIST | OFN_OVERWRITEPROMPT,
+                                                  "Chrome trace (*.json)\0*.json\0", "json");
+            if (path.has_value() && Profiler::ExportChromeTrace(path.value()))
+                LOG_INFO("Wrote profiler trace to {}", path.value().string());
+        }
+
+        if (!isProfilerViewPaused)
+            UpdateProfilerView();
+
+        RenderFlameGraph();
+        RenderZoneStats();
+    }
+
+    void DebugPanel::UpdateProfilerView()
+    {
+        // stats are averaged over a couple of frames, as single frames are too noisy to read
+        constexpr std::size_t ZONE_STATS_FRAME_COUNT = 120;
+
+        const auto frames = Profiler::GetFrames();
+        if (frames.empty())
+            return;
+
+        profiledFrame = frames.back();
+        profiledFrameZones = Profiler::CollectZones(profiledFrame.start, profiledFrame.end);
+
+        zoneStatsFrameCount = std::min(frames.size(), ZONE_STATS_FRAME_COUNT);
+        const auto firstFrame = frames[frames.size() - zoneStatsFrameCount];
+        const auto zones = Profiler::CollectZones(firstFrame.start, profiledFrame.end);
+        zoneStats = Profiler::GetZoneStats(zones);
+    }
+
+    void DebugPanel::RenderFlameGraph()
+    {
+        using Milliseconds = std::chrono::duration<double, std::milli>;
+
+        const auto frameDuration = std::chrono::nanoseconds(profiledFrame.end - profiledFrame.start);
+        ImGui::Text("Frame: %.3f ms", Milliseconds(frameDuration).count());
+        if (profiledFrameZones.empty() || frameDuration.count() <= 0)
+            return;
+
+        // each thread gets as many rows as its zones are nested
+        std::map<std::uint32_t, std::uint32_t> threadRowCounts;
+        for (const auto& zone : profiledFrameZones)
+            threadRowCounts[zone.threadId] = std::max(threadRowCounts[zone.threadId], zone.depth + 1);
+
+        const auto rowHeight = ImGui::GetTextLineHeightWithSpacing();
+        const auto threadSpacing = rowHeight / 2;
+
+        std::map<std::uint32_t, float> threadOffsets;
+        float height = 0;
+        for (const auto& [threadId, threadRowCount] : threadRowCounts)
+        {
+            threadOffsets[threadId] = height;
+            height += rowHeight * threadRowCount + threadSpacing;
+        }
+
+        const auto size = ImVec2(ImGui::GetFontSize() * 40, height - threadSpacing);
+        const auto origin = ImGui::GetCursorScreenPos();
+        ImGui::InvisibleButton("##debugPanelFlameGraph", size);
+        const auto isHovered = ImGui::IsItemHovered();
+
+        auto* drawList = ImGui::GetWindowDrawList();
+        drawList->PushClipRect(origin, origin + size, true);
+        for (const auto& zone : profiledFrameZones)
+        {
+            const auto y = origin.y + threadOffsets[zone.threadId] + rowHeight * zone.depth;
+
+            const auto start = static_cast<float>(zone.start - profiledFrame.start) / frameDuration.count();
+            const auto end = static_cast<float>(zone.end - profiledFrame.start) / frameDuration.count();
+            const auto min = ImVec2(origin.x + start * size.x, y);
+            const auto max = ImVec2(std::max(origin.x + end * size.x, min.x + 1), y + rowHeight - 1);
+
+            const auto hue = static_cast<float>(std::hash<std::string_view>{}(zone.name) % 360) / 360.0f;
+            drawList->AddRectFilled(min, max, ImColor::HSV(hue, 0.5f, 0.7f));
+            drawList->PushClipRect(min, max, true);
+            drawList->AddText(min + ImGui::GetStyle().FramePadding / 2, IM_COL32_WHITE, zone.name);
+            drawList->PopClipRect();
+
+            if (isHovered && ImGui::IsMouseHoveringRect(min, max))
+            {
+                ImGui::SetTooltip("%s\nThread %u\n%.3f ms", zone.name, zone.threadId,
+                                  Milliseconds(std::chrono::nanoseconds(zone.end - zone.start)).count());
+            }
+        }
+        drawList->PopClipRect();
+    }
+
+    void DebugPanel::RenderZoneStats()
+    {
+        if (!ImGui::BeginTable("##debugPanelZoneStats", 4, ImGuiTableFlags_RowBg | ImGuiTableFlags_SizingFixedFit))
+            return;
+
+        ImGui::TableSetupColumn("Zone");
+        ImGui::TableSetupColumn("Calls / frame");
+        ImGui::TableSetupColumn("Time / frame (ms)");
+        ImGui::TableSetupColumn("Max (ms)");
+        ImGui::TableHeadersRow();
+
+        using Milliseconds = std::chrono::duration<double, std::milli>;
+        const auto frameCount = static_cast<double>(std::max<std::size_t>(zoneStatsFrameCount, 1));
+        for (const auto& stats : zoneStats)
+        {
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn();
+            ImGui::Text("%.*s", static_cast<int>(stats.name.size()), stats.name.data());
+            ImGui::TableNextColumn();
+            ImGui::Text("%.1f", stats.callCount / frameCount);
+            ImGui::TableNextColumn();
+            ImGui::Text("%.3f", Milliseconds(std::chrono::nanoseconds(stats.totalDuration)).count() / frameCount);
+            ImGui::TableNextColumn();
+            ImGui::Text("%.3f", Milliseconds(std::chrono::nanoseconds(stats.maxDuration)).count());
+        }
+        ImGui::EndTable();
+    }
+
     void DebugPanel::Release()
     {
     }
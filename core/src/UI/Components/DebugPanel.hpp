@@ -1,6 +1,8 @@
 #pragma once
 #include "UI/UIComponent.hpp"
 
+#include "Utilities/Profiler.hpp"
+
 namespace IWXMVM::UI
 {
     class DebugPanel : public UIComponent
@@ -11,5 +13,16 @@ namespace IWXMVM::UI
 
        private:
         void Initialize() final;
+        void RenderEventListenerStats();
+        void RenderProfiler();
+        void UpdateProfilerView();
+        void RenderFlameGraph();
+        void RenderZoneStats();
+
+        bool isProfilerViewPaused = false;
+        Profiler::Frame profiledFrame{};
+        std::vector<Profiler::Zone> profiledFrameZones;
+        std::vector<Profiler::ZoneStats> zoneStats;
+        std::size_t zoneStatsFrameCount = 0;
     };
 }  // namespace IWXMVM::UI
\ No newline at end of file
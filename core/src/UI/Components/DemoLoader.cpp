@@ -4,190 +4,121 @@
 #include "Mod.hpp"
 #include "UI/UIManager.hpp"
 #include "Utilities/PathUtils.hpp"
+#include "Utilities/CompressedDemo.hpp"
+#include "Utilities/DirectoryCache.hpp"
 #include "Resources.hpp"
 #include "Configuration/PreferencesConfiguration.hpp"
 
+#include <execution>
+
 namespace IWXMVM::UI
 {
-    template <bool caseSensitive, typename T>
-        requires std::is_same_v<T, std::string_view> || std::is_same_v<T, std::wstring_view>
-    bool CompareNaturally(const T lhs, const T rhs)
-    {
-        auto IsDigit = [](auto c) { return std::iswdigit(c); };
-
-        auto ToUpper = [](auto c) {
-            if constexpr (caseSensitive)
-                return c;
-            else
-                return std::towupper(c);
-        };
-
-        auto StringToUint = [](const auto* str, auto* output, std::size_t* endPtr = nullptr) {
-            try
-            {
-                *output = std::stoull(str, endPtr);
-                return true;
-            }
-            catch (...)
-            {
-                return false;
-            }
-        };
-
-        for (auto lhsItr = lhs.begin(), rhsItr = rhs.begin(); lhsItr != lhs.end() && rhsItr != rhs.end();)
-        {
-            if (IsDigit(*lhsItr) && IsDigit(*rhsItr))
-            {
-                std::uint64_t lhsNum = 0;
-                std::uint64_t rhsNum = 0;
-                std::size_t lhsDigitCount = 0;
-                std::size_t rhsDigitCount = 0;
-
-                // when sorting a container, move the 'unparsable' string_view to end of container if string-to-uint
-                // throws an exception
-                if (!StringToUint(std::addressof(*lhsItr), &lhsNum, &lhsDigitCount))
-                    return false;
-                if (!StringToUint(std::addressof(*rhsItr), &rhsNum, &rhsDigitCount))
-                    return true;
-
-                if (lhsNum != rhsNum)
-                    return lhsNum < rhsNum;
-
-                assert(lhsDigitCount == std::distance(lhsItr, std::find_if_not(lhsItr, lhs.end(), IsDigit)));
-                assert(rhsDigitCount == std::distance(rhsItr, std::find_if_not(rhsItr, rhs.end(), IsDigit)));
-
-                lhsItr += lhsDigitCount;
-                rhsItr += rhsDigitCount;
-            }
-            else
-            {
-                if (ToUpper(*lhsItr) != ToUpper(*rhsItr))
-                    return *lhsItr < *rhsItr;
-
-                ++lhsItr;
-                ++rhsItr;
-            }
-        }
-
-        return lhs.length() < rhs.length();
-    }
-
-    void SortDemoPaths(const auto demos)
+    bool IsFileDemo(const std::filesystem::path& file)
     {
-        std::sort(demos.begin(), demos.end(), [&](const auto& lhs, const auto& rhs) {
-            const std::size_t extLength = Mod::GetGameInterface()->GetDemoExtension().length();
-            const std::size_t dirLength = demos.front().parent_path().native().length();
-            const std::size_t lhsLength = lhs.native().length();
-            const std::size_t rhsLength = rhs.native().length();
-
-            assert(lhsLength > dirLength + extLength + 1 && rhsLength > dirLength + extLength + 1);
-
-            const auto* lhsFileNamePtr = lhs.c_str() + dirLength + 1;
-            const auto* rhsFileNamePtr = rhs.c_str() + dirLength + 1;
-            const std::size_t lhsSvLength = lhsLength - dirLength - extLength - 1;
-            const std::size_t rhsSvLength = rhsLength - dirLength - extLength - 1;
-
-            using StringView = std::wstring_view;
-            return CompareNaturally<false>(StringView{lhsFileNamePtr, lhsSvLength},
-                                           StringView{rhsFileNamePtr, rhsSvLength});
-        });
+        // compressed demos carry the game's extension in front of their own
+        const auto demoFile = CompressedDemo::HasCompressedExtension(file) ? file.stem() : file;
+        return demoFile.extension().compare(Mod::GetGameInterface()->GetDemoExtension())
+                   ? false
+                   : true;  // .compare() == 0 => strings are equal
     }
 
-    void SortDemoDirectories(const auto directories, auto GetPath)
+    std::size_t GetDemoSuffixLength(const std::filesystem::path& demo)
     {
-        std::sort(directories.begin(), directories.end(), [&](const auto& lhs, const auto& rhs) {
-            const auto& lhsPath = GetPath(lhs);
-            const auto& rhsPath = GetPath(rhs);
-
-            const std::size_t parentDirLength = GetPath(directories.front()).parent_path().native().length();
-            const std::size_t lhsLength = lhsPath.native().length();
-            const std::size_t rhsLength = rhsPath.native().length();
-
-            assert(lhsLength > parentDirLength + 1 && rhsLength > parentDirLength + 1);
-
-            const auto* lhsDirPtr = lhsPath.c_str() + parentDirLength + 1;
-            const auto* rhsDirNamePtr = rhsPath.c_str() + parentDirLength + 1;
-            const std::size_t lhsSvLength = lhsLength - parentDirLength - 1;
-            const std::size_t rhsSvLength = rhsLength - parentDirLength - 1;
-
-            using StringView = std::wstring_view;
-            return CompareNaturally<false>(StringView{lhsDirPtr, lhsSvLength}, StringView{rhsDirNamePtr, rhsSvLength});
-        });
+        const auto extensionLength = Mod::GetGameInterface()->GetDemoExtension().length();
+        return CompressedDemo::HasCompressedExtension(demo) ? extensionLength + CompressedDemo::EXTENSION.length()
+                                                            : extensionLength;
     }
 
-    bool IsFileDemo(const std::filesystem::path& file)
+    // Validates the demos on all cores without blocking the UI, each demo logs its own issues
+    void CheckDemosInBackground(std::vector<std::filesystem::path> demos, bool repair)
     {
-        return file.extension().compare(Mod::GetGameInterface()->GetDemoExtension())
-                   ? false
-                   : true;  // .compare() == 0 => strings are equal
+        std::thread([demos = std::move(demos), repair] {
+            const auto start = std::chrono::steady_clock::now();
+            std::atomic<std::size_t> damagedCount = 0;
+            std::for_each(std::execution::par, demos.begin(), demos.end(), [&](const auto& demo) {
+                if (!Mod::GetGameInterface()->CheckDemoIntegrity(demo, repair))
+                    damagedCount++;
+            });
+
+            LOG_INFO("Checked {} demos in {} ms, {} are damaged", demos.size(),
+                     std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start)
+                         .count(),
+                     damagedCount.load());
+        }).detach();
     }
 
-    void DemoLoader::AddPathsToSearch(const std::vector<std::filesystem::path>& dirs)
+    void DemoLoader::AddPathsToSearch(SearchResult& result, const std::vector<std::filesystem::path>& dirs)
     {
         for (const auto& dir : dirs)
         {
             if (std::filesystem::exists(dir))
             {
                 DemoDirectory searchPath = {.path = dir};
-                demoDirectories.push_back(searchPath);
+                result.demoDirectories.push_back(searchPath);
             }
         }
-        searchPaths = std::make_pair(0, demoDirectories.size());
+        result.searchPaths = std::make_pair(0, result.demoDirectories.size());
     }
 
-    void DemoLoader::SearchDir(std::size_t dirIdx)
+    bool DemoLoader::SearchDir(SearchResult& result, std::size_t dirIdx, const std::stop_token& stopToken)
     {
+        if (stopToken.stop_requested())
+            return false;
+
         auto tempDir = std::string(DEMO_TEMP_DIRECTORY);
-        if (demoDirectories[dirIdx].path.wstring().find(std::wstring(tempDir.begin(), tempDir.end())) != std::string::npos)
+        if (result.demoDirectories[dirIdx].path.wstring().find(std::wstring(tempDir.begin(), tempDir.end())) !=
+            std::string::npos)
         {
-            demoDirectories[dirIdx].relevant = false;
-            return;
+            result.demoDirectories[dirIdx].relevant = false;
+            return true;
         }
 
-        auto subdirsStartIdx = demoDirectories.size();
-        auto demosStartIdx = demoPaths.size();
+        const auto& listing = directoryCache->List(result.demoDirectories[dirIdx].path);
 
-        for (const auto& entry : std::filesystem::directory_iterator(demoDirectories[dirIdx].path))
+        auto subdirsStartIdx = result.demoDirectories.size();
+        auto demosStartIdx = result.demoPaths.size();
+
+        for (const auto& subdirPath : listing.subdirectories)
         {
-            if (entry.is_directory())
-            {
-                DemoDirectory subdir = {.path = entry.path(), .parentIdx = dirIdx};
-                demoDirectories.push_back(subdir);
-            }
-            else if (IsFileDemo(entry.path()))
-            {
-                demoPaths.push_back(entry.path());
-            }
+            DemoDirectory subdir = {.path = subdirPath, .parentIdx = dirIdx};
+            result.demoDirectories.push_back(subdir);
         }
+        result.demoPaths.insert(result.demoPaths.end(), listing.files.begin(), listing.files.end());
 
-        SortDemoPaths(std::span{(demoPaths.begin() + demosStartIdx), demoPaths.end()});
-        SortDemoDirectories(std::span{(demoDirectories.begin() + subdirsStartIdx), demoDirectories.end()},
-                            [](const DemoDirectory& data) -> const std::filesystem::path& { return data.path; });
-
-        demoDirectories[dirIdx].demos = std::make_pair(demosStartIdx, demoPaths.size());
-        if (demoDirectories[dirIdx].demos.first != demoDirectories[dirIdx].demos.second)
+        result.demoDirectories[dirIdx].demos = std::make_pair(demosStartIdx, result.demoPaths.size());
+        if (result.demoDirectories[dirIdx].demos.first != result.demoDirectories[dirIdx].demos.second)
         {
-            demoDirectories[dirIdx].relevant = true;
+            result.demoDirectories[dirIdx].relevant = true;
         }
 
-        demoDirectories[dirIdx].subdirectories = std::make_pair(subdirsStartIdx, demoDirectories.size());
-        for (auto i = demoDirectories[dirIdx].subdirectories.first; i < demoDirectories[dirIdx].subdirectories.second;
-             i++)
+        result.demoDirectories[dirIdx].subdirectories = std::make_pair(subdirsStartIdx, result.demoDirectories.size());
+        for (auto i = result.demoDirectories[dirIdx].subdirectories.first;
+             i < result.demoDirectories[dirIdx].subdirectories.second; i++)
         {
-            SearchDir(i);
+            if (!SearchDir(result, i, stopToken))
+                return false;
         }
+
+        return true;
     }
 
-    void DemoLoader::Search()
+    bool DemoLoader::Search(SearchResult& result, const std::stop_token& stopToken)
     {
-        for (auto i = searchPaths.first; i < searchPaths.second; i++)
+        directoryCache->BeginWalk();
+
+        for (auto i = result.searchPaths.first; i < result.searchPaths.second; i++)
         {
-            SearchDir(i);
+            if (!SearchDir(result, i, stopToken))
+                return false;
         }
+
+        directoryCache->EndWalk();
+        return true;
     }
 
-    void DemoLoader::MarkDirsRelevancy()
+    void DemoLoader::MarkDirsRelevancy(SearchResult& result)
     {
+        auto& demoDirectories = result.demoDirectories;
         for (auto it = demoDirectories.rbegin(); it != demoDirectories.rend(); it++)
         {
             std::size_t vecIdx = std::abs(it - demoDirectories.rend() + 1);
@@ -208,50 +139,121 @@ namespace IWXMVM::UI
 
     void DemoLoader::FindAllDemos()
     {
-        if (isScanningDemoPaths.load())
-			return;
-
         LOG_DEBUG("Searching for demo files...");
-        isScanningDemoPaths.store(true);
-        std::thread([&] { 
-            demoDirectories.clear();
-            demoPaths.clear();
 
-            auto searchPaths = std::vector(PreferencesConfiguration::Get().additionalDemoSearchDirectories);
-            searchPaths.push_back(PathUtils::GetCurrentGameDirectory());
+        auto searchPaths = std::vector(PreferencesConfiguration::Get().additionalDemoSearchDirectories);
+        searchPaths.push_back(PathUtils::GetCurrentGameDirectory());
+
+        // the previous search is cancelled and handed to the new one, which waits for it to stop before touching the
+        // directory cache. Joining it here would stall the UI thread until its current directory listing finishes.
+        auto previousSearchThread = std::move(searchThread);
+        previousSearchThread.request_stop();
 
-            AddPathsToSearch(searchPaths);
-            Search();
+        const auto searchId = ++requestedSearchId;
+        searchThread = std::jthread([this, searchId, searchPaths = std::move(searchPaths),
+                                     previousSearchThread = std::move(previousSearchThread)](
+                                        std::stop_token stopToken) mutable {
+            if (previousSearchThread.joinable())
+                previousSearchThread.join();
+
+            SearchResult result;
+            AddPathsToSearch(result, searchPaths);
+            if (!Search(result, stopToken))
+            {
+                LOG_DEBUG("Demo search was cancelled");
+                return;
+            }
 
             // 'demoDirectories' and 'demoPaths' are complete here, but we still need to find out the relevancy of each
             // directory
-            MarkDirsRelevancy();
+            MarkDirsRelevancy(result);
 
-            LOG_DEBUG("Found {0} demo files", demoPaths.size());
+            LOG_DEBUG("Found {0} demo files", result.demoPaths.size());
 
-            isScanningDemoPaths.store(false);            
-        }).detach();
+            BuildSearchIndex(result);
+
+            Components::DemoMetadataCache::Request(result.demoPaths);
+
+            std::lock_guard lock(searchResultMutex);
+            pendingSearchResult = std::move(result);
+            completedSearchId.store(searchId);
+        });
     }
 
-    bool DemoLoader::DemoFilter(const std::u8string& demoFileName)
+    void DemoLoader::BuildSearchIndex(SearchResult& result)
     {
-        // TODO: possibly make filter more advanced, add features like "" for exact search etc
-        bool keepDemo = true;
-        std::u8string lowerDemoFileName = demoFileName;
-        std::transform(lowerDemoFileName.begin(), lowerDemoFileName.end(), lowerDemoFileName.begin(),
-                       ::tolower);
-        for (auto& word : searchBarTextSplit)
+        std::vector<std::string> documents;
+        documents.reserve(result.demoPaths.size());
+        for (const auto& demoPath : result.demoPaths)
         {
-            std::transform(word.begin(), word.end(), word.begin(), ::tolower);
-            if (lowerDemoFileName.find(word) == std::u8string::npos)
+            const auto fileName = demoPath.filename().u8string();
+            auto document = std::string(fileName.begin(), fileName.end() - GetDemoSuffixLength(demoPath));
+
+            // the map of demos played in earlier sessions is cached, so it is searchable as well
+            if (const auto metadata = Components::DemoMetadataCache::Get(demoPath);
+                metadata.has_value() && !metadata->mapName.empty())
             {
-                keepDemo = false;
-                break;
+                document += " " + metadata->mapName;
             }
+
+            documents.push_back(std::move(document));
         }
-        return keepDemo;
+
+        result.searchIndex.Build(documents);
+    }
+
+    void DemoLoader::ApplySearchResult()
+    {
+        std::lock_guard lock(searchResultMutex);
+        if (!pendingSearchResult.has_value())
+            return;
+
+        searchPaths = pendingSearchResult->searchPaths;
+        demoDirectories = std::move(pendingSearchResult->demoDirectories);
+        demoPaths = std::move(pendingSearchResult->demoPaths);
+        searchIndex = std::move(pendingSearchResult->searchIndex);
+        pendingSearchResult.reset();
+        hasSearchResult = true;
+
+        UpdateSearchMatches();
     }
 
+    void DemoLoader::UpdateSearchMatches()
+    {
+        cachedfilteredDemos.clear();
+        demoSearchScores.assign(demoPaths.size(), 0.0f);
+
+        const auto matches = searchIndex.Query(searchBarText);
+        for (const auto& match : matches)
+        {
+            demoSearchScores[match.document] = match.score;
+        }
+        searchMatchCount = matches.size();
+    }
+
+    void DemoLoader::RenderDemoMetadata(const std::filesystem::path& demo)
+    {
+        const auto metadata = Components::DemoMetadataCache::Get(demo);
+        if (!metadata.has_value())
+            return;
+
+        std::string details;
+        if (!metadata->mapName.empty())
+            details += metadata->mapName + " ";
+        if (metadata->HasBounds())
+        {
+            const auto seconds = metadata->GetDuration() / 1000;
+            details += std::format("{}:{:02} ", seconds / 60, seconds % 60);
+        }
+        if (metadata->isCoD4X)
+            details += "CoD4X";
+
+        if (details.empty())
+            return;
+
+        ImGui::SameLine();
+        ImGui::TextDisabled("%s", details.c_str());
+    }
 
     void DemoLoader::RenderDemos(const std::vector<std::filesystem::path>& demos)
     {
@@ -265,9 +267,11 @@ namespace IWXMVM::UI
                 try
                 {
                     auto demoName = demos[i].filename().string();
+                    const bool isCompressed = CompressedDemo::HasCompressedExtension(demos[i]);
+                    const auto playedName = isCompressed ? demos[i].stem().string() : demoName;
 
                     if (Mod::GetGameInterface()->GetGameState() == Types::GameState::InDemo &&
-                        Mod::GetGameInterface()->GetDemoInfo().name == demoName)
+                        Mod::GetGameInterface()->GetDemoInfo().name == playedName)
                     {
                         if (ImGui::Button(std::format(ICON_FA_STOP " STOP##{0}", demoName).c_str(),
                                           ImVec2(ImGui::GetFontSize() * 4, ImGui::GetFontSize() * 1.5f)))
@@ -280,6 +284,7 @@ namespace IWXMVM::UI
                         if (ImGui::Button(std::format(ICON_FA_PLAY " PLAY##{0}", demoName).c_str(),
                                           ImVec2(ImGui::GetFontSize() * 4, ImGui::GetFontSize() * 1.5f)))
                         {
+                            Components::DemoMetadataCache::SetPlayedDemo(demos[i]);
                             Mod::GetGameInterface()->PlayDemo(demos[i]);
                         }
                     }
@@ -287,6 +292,25 @@ namespace IWXMVM::UI
                     ImGui::SameLine();
 
                     ImGui::Text("%s", demoName.c_str());
+
+                    if (ImGui::BeginPopupContextItem(std::format("##demoContextMenu{0}", demoName).c_str()))
+                    {
+                        if (ImGui::Selectable(isCompressed ? "Decompress" : "Compress"))
+                        {
+                            std::thread([demo = demos[i]] { CompressedDemo::ConvertDemos({demo}); }).detach();
+                        }
+                        if (ImGui::Selectable("Check integrity"))
+                        {
+                            CheckDemosInBackground({demos[i]}, false);
+                        }
+                        if (ImGui::Selectable("Repair"))
+                        {
+                            CheckDemosInBackground({demos[i]}, true);
+                        }
+                        ImGui::EndPopup();
+                    }
+
+                    RenderDemoMetadata(demos[i]);
                 }
                 catch (std::exception&)
                 {
@@ -310,23 +334,26 @@ namespace IWXMVM::UI
             return;
         }
 
-        std::vector<std::filesystem::path> filteredDemos;
+        std::vector<std::size_t> filteredDemoIndices;
         for (std::size_t i = demos.first; i < demos.second; i++)
         {
-            try
+            if (searchBarText.empty() || demoSearchScores[i] > 0.0f)
             {
-                if (searchBarText.empty() || DemoFilter(demoPaths[i].filename().u8string()))
-                {
-                    filteredDemos.push_back(demoPaths[i]);
-                }
-            }
-            catch (std::exception&)
-            {
-                LOG_ERROR("Error filtering demoPath");
-                // catching errors just in case
+                filteredDemoIndices.push_back(i);
             }
         }
-        totalCachedFilteredDemosCount += filteredDemos.size();
+
+        // best matches first, otherwise the directory's natural order is kept
+        std::stable_sort(filteredDemoIndices.begin(), filteredDemoIndices.end(), [&](std::size_t lhs, std::size_t rhs) {
+            return demoSearchScores[lhs] > demoSearchScores[rhs];
+        });
+
+        std::vector<std::filesystem::path> filteredDemos;
+        filteredDemos.reserve(filteredDemoIndices.size());
+        for (const auto i : filteredDemoIndices)
+        {
+            filteredDemos.push_back(demoPaths[i]);
+        }
         cachedfilteredDemos[demos] = filteredDemos;
         RenderDemos(filteredDemos);
     }
@@ -336,8 +363,40 @@ namespace IWXMVM::UI
     {
         try
         {
-            if (ImGui::TreeNodeEx(dir.path.filename().string().c_str(),
-                                  searchBarText.empty() ? ImGuiTreeNodeFlags_None : ImGuiTreeNodeFlags_DefaultOpen))
+            const auto isOpen =
+                ImGui::TreeNodeEx(dir.path.filename().string().c_str(),
+                                  searchBarText.empty() ? ImGuiTreeNodeFlags_None : ImGuiTreeNodeFlags_DefaultOpen);
+
+            if (ImGui::BeginPopupContextItem())
+            {
+                // raw and compressed demos are converted in opposite directions, each on all cores
+                for (const bool compress : {true, false})
+                {
+                    if (!ImGui::Selectable(compress ? "Compress all demos" : "Decompress all demos"))
+                        continue;
+
+                    std::vector<std::filesystem::path> demosToConvert;
+                    for (auto i = dir.demos.first; i < dir.demos.second; i++)
+                    {
+                        if (CompressedDemo::HasCompressedExtension(demoPaths[i]) != compress)
+                            demosToConvert.push_back(demoPaths[i]);
+                    }
+                    std::thread([demosToConvert] { CompressedDemo::ConvertDemos(demosToConvert); }).detach();
+                }
+
+                for (const bool repair : {false, true})
+                {
+                    if (ImGui::Selectable(repair ? "Repair all demos" : "Check all demos"))
+                    {
+                        CheckDemosInBackground(std::vector(demoPaths.begin() + dir.demos.first,
+                                                           demoPaths.begin() + dir.demos.second),
+                                               repair);
+                    }
+                }
+                ImGui::EndPopup();
+            }
+
+            if (isOpen)
             {
                 for (auto i = dir.subdirectories.first; i < dir.subdirectories.second; i++)
                 {
@@ -361,19 +420,6 @@ namespace IWXMVM::UI
 		}
     }
 
-    void DemoLoader::RecacheSearchBarTextSplit()
-    {
-        searchBarTextSplit.clear();
-
-        std::stringstream ss(searchBarText);
-        std::string token;
-
-        while (std::getline(ss, token, ' '))
-        {
-            searchBarTextSplit.push_back(std::u8string(token.begin(), token.end()));
-        }
-    }
-
     void DemoLoader::RenderSearchBar()
     {
         int flags = ImGuiInputTextFlags_CallbackResize;
@@ -408,9 +454,7 @@ namespace IWXMVM::UI
 
         if (lastSearchBarText != searchBarText)
         {
-            RecacheSearchBarTextSplit();
-            cachedfilteredDemos.clear();
-            totalCachedFilteredDemosCount = 0;
+            UpdateSearchMatches();
             lastSearchBarText = searchBarText;
         }
     }
@@ -447,6 +491,12 @@ namespace IWXMVM::UI
 
     void DemoLoader::Initialize()
     {
+        directoryCache.emplace(IsFileDemo, [](const std::filesystem::path& demo) {
+            auto fileName = demo.filename().native();
+            fileName.resize(fileName.length() - GetDemoSuffixLength(demo));
+            return fileName;
+        });
+
         FindAllDemos();
     }
 
@@ -458,7 +508,9 @@ namespace IWXMVM::UI
         {
             ImGui::AlignTextToFramePadding();
 
-            if (isScanningDemoPaths.load())
+            ApplySearchResult();
+
+            if (!hasSearchResult)
             {
                 ImGui::Text("Searching for demo files...");
             }
@@ -466,7 +518,18 @@ namespace IWXMVM::UI
             {
                 ImGui::AlignTextToFramePadding();
                 ImGui::Text("%d demos found!",
-                            searchBarText.empty() ? demoPaths.size() : totalCachedFilteredDemosCount);
+                            searchBarText.empty() ? demoPaths.size() : searchMatchCount);
+
+                if (requestedSearchId != completedSearchId.load())
+                {
+                    ImGui::SameLine();
+                    ImGui::TextDisabled("(refreshing)");
+                }
+                else if (const auto pendingCount = Components::DemoMetadataCache::GetPendingCount(); pendingCount > 0)
+                {
+                    ImGui::SameLine();
+                    ImGui::TextDisabled("(reading %zu)", pendingCount);
+                }
                 ImGui::SameLine();
 
                 auto addPathButtonLabel = std::string(ICON_FA_FOLDER_OPEN " Add path");
@@ -514,5 +577,7 @@ namespace IWXMVM::UI
 
     void DemoLoader::Release()
     {
+        // the next search waits for this one to stop, so there is no need to block on it here
+        searchThread.request_stop();
     }
 }  // namespace IWXMVM::UI
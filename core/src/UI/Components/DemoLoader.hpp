@@ -1,5 +1,7 @@
 #pragma once
 #include "UI/UIComponent.hpp"
+#include "Utilities/DirectoryCache.hpp"
+#include "Utilities/FuzzySearchIndex.hpp"
 
 namespace IWXMVM::UI
 {
@@ -23,18 +25,29 @@ namespace IWXMVM::UI
             bool relevant;                         // Does this directory ever reach a demo down the line?
         };
 
+        struct SearchResult
+        {
+            std::pair<std::size_t, std::size_t> searchPaths;
+            std::vector<DemoDirectory> demoDirectories;
+            std::vector<std::filesystem::path> demoPaths;
+            FuzzySearchIndex searchIndex;  // Indexes the demo names in 'demoPaths' order
+        };
+
         void Initialize() final;
-        void AddPathsToSearch(const std::vector<std::filesystem::path>& dirs);
-        void SearchDir(std::size_t dirIdx);  // Recursive search function
-        void Search();
-        void MarkDirsRelevancy();
+        void AddPathsToSearch(SearchResult& result, const std::vector<std::filesystem::path>& dirs);
+        bool SearchDir(SearchResult& result, std::size_t dirIdx,
+                       const std::stop_token& stopToken);  // Recursive search function
+        bool Search(SearchResult& result, const std::stop_token& stopToken);
+        void MarkDirsRelevancy(SearchResult& result);
         void FindAllDemos();
+        void BuildSearchIndex(SearchResult& result);
+        void ApplySearchResult();
+        void UpdateSearchMatches();
 
+        void RenderDemoMetadata(const std::filesystem::path& demo);
         void RenderDemos(const std::vector<std::filesystem::path>& demos);
-        bool DemoFilter(const std::u8string& demoFileName);
         void FilteredRenderDemos(const std::pair<std::size_t, std::size_t>& demos);
         void RenderDir(const DemoDirectory& dir);  // Recursive render function
-        void RecacheSearchBarTextSplit();
         void RenderSearchBar();
         void RenderSearchPaths();
 
@@ -42,11 +55,22 @@ namespace IWXMVM::UI
                                                           // of search paths in the 'demoDirectories' vector
         std::vector<DemoDirectory> demoDirectories;
         std::vector<std::filesystem::path> demoPaths; // Path to every demo found
-        std::atomic<bool> isScanningDemoPaths;
+        bool hasSearchResult = false;
+
+        // Searches run on 'searchThread' and hand their result over to the UI thread through 'pendingSearchResult'.
+        // Each search waits for the one it replaced to stop, so only one search at a time touches the directory cache.
+        std::jthread searchThread;
+        std::mutex searchResultMutex;
+        std::optional<SearchResult> pendingSearchResult;
+        uint32_t requestedSearchId = 0;
+        std::atomic<uint32_t> completedSearchId = 0;
+        std::optional<DirectoryCache> directoryCache;  // Lists demo files, created with the component
 
         std::string searchBarText;
         std::string lastSearchBarText;
-        std::vector<std::u8string> searchBarTextSplit;
+        FuzzySearchIndex searchIndex;
+        std::vector<float> demoSearchScores;  // Score of each demo in 'demoPaths' for the current search, 0 if no match
+        std::size_t searchMatchCount = 0;
         struct cachedfilteredDemos_pairhash
         {
             size_t operator()(const std::pair<size_t, size_t>& p) const
@@ -57,6 +81,5 @@ namespace IWXMVM::UI
             }
         };
         std::unordered_map<std::pair<size_t, size_t>, std::vector<std::filesystem::path>, cachedfilteredDemos_pairhash> cachedfilteredDemos;
-        std::size_t totalCachedFilteredDemosCount;
     };
 }  // namespace IWXMVM::UI
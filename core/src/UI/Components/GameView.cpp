@@ -421,7 +421,7 @@ namespace IWXMVM::UI
             ImGui::Image((void*)texture, textureSize); 
         }
 
-        Events::Invoke(EventType::OnRenderGameView);
+        Events::Invoke<EventType::OnRenderGameView>();
         if (Mod::GetGameInterface()->GetGameState() == Types::GameState::InDemo)
         {
             DrawGizmoControls();
@@ -9,8 +9,10 @@
 #include "UI/ImGuiEx/ImGuiExtensions.hpp"
 #include "Mod.hpp"
 #include "Input.hpp"
+#include "Components/DemoEventTimeline.hpp"
 #include "Components/KeyframeManager.hpp"
 #include "Components/KeyframeSerializer.hpp"
+#include "Components/KeyframeSimplifier.hpp"
 #include "Components/Rewinding.hpp"
 #include "Components/Playback.hpp"
 #include "Events.hpp"
@@ -19,6 +21,7 @@
 namespace IWXMVM::UI
 {
     std::map<Types::KeyframeablePropertyType, std::vector<ImVec2>> verticalZoomRanges;
+    std::map<Types::KeyframeablePropertyType, std::vector<float>> simplifyTolerances;
 
     std::tuple<int32_t, int32_t> KeyframeEditor::GetDisplayTickRange() const
     {
@@ -192,7 +195,9 @@ namespace IWXMVM::UI
 
         ImGuiEx::DemoProgressBarLines(frame_bb, *currentTick, displayStartTick, displayEndTick, demoLength, frozenTick);
 
-        bool isAnyKeyframeHovered = false;
+        // markers count as keyframes here, so clicking one does not zoom or add a keyframe
+        bool isAnyKeyframeHovered =
+            DrawEventMarkers(frame_bb.Min, frame_bb.Max, displayStartTick, displayEndTick, *currentTick);
 
         const auto textSize = CalcTextSize(ICON_FA_DIAMOND);
         for (auto it = keyframes.begin(); it != keyframes.end();)
@@ -426,7 +431,9 @@ namespace IWXMVM::UI
 
         ImGuiEx::DemoProgressBarLines(frame_bb, *currentTick, displayStartTick, displayEndTick, demoLength, frozenTick);
 
-        bool isAnyKeyframeHovered = false;
+        // markers count as keyframes here, so clicking one does not zoom or add a keyframe
+        bool isAnyKeyframeHovered =
+            DrawEventMarkers(frame_bb.Min, frame_bb.Max, displayStartTick, displayEndTick, *currentTick);
 
         const auto textSize = CalcTextSize(ICON_FA_DIAMOND);
 
@@ -440,7 +447,7 @@ namespace IWXMVM::UI
 
             for (auto tick = displayStartTick; tick <= displayEndTick; tick += EVALUATION_DISTANCE)
             {
-                auto value = Components::KeyframeManager::Get().Interpolate(property, keyframes, tick);
+                auto value = Components::KeyframeManager::Get().Interpolate(property, tick);
                 auto position =
                     GetPositionForKeyframe(frame_bb, Types::Keyframe(property, tick, value), displayStartTick,
                                            displayEndTick, valueBoundaries, keyframeValueIndex);
@@ -561,6 +568,59 @@ namespace IWXMVM::UI
                     }
                 }
 
+                ImGui::Text("Interpolation:");
+
+                ImGui::SetNextItemWidth(ImGui::GetFontSize() * 6.0f);
+                if (ImGui::BeginCombo("##interpolationCombo", magic_enum::enum_name(k.interpolation).data()))
+                {
+                    for (auto m = 0; m < (int)Types::InterpolationMode::Count; m++)
+                    {
+                        const auto mode = (Types::InterpolationMode)m;
+                        bool isSelected = k.interpolation == mode;
+                        if (ImGui::Selectable(magic_enum::enum_name(mode).data(), isSelected) && !isSelected)
+                        {
+                            Components::KeyframeManager::Get().SetKeyframeInterpolation(property, k, mode,
+                                                                                        k.bezierHandles);
+                            Components::KeyframeManager::Get().SortAndSaveKeyframes(keyframes);
+                        }
+
+                        if (isSelected)
+                        {
+                            ImGui::SetItemDefaultFocus();
+                        }
+                    }
+                    ImGui::EndCombo();
+                }
+
+                if (k.interpolation == Types::InterpolationMode::Bezier)
+                {
+                    // handles are dragged in place and committed as a single undoable action once released
+                    static glm::vec4 handlesBeforeEdit;
+
+                    ImGui::SetNextItemWidth(ImGui::GetFontSize() * 12.0f);
+                    if (ImGui::DragFloat4("##bezierHandles", glm::value_ptr(k.bezierHandles), 0.01f, -1.0f, 2.0f,
+                                          "%.2f"))
+                    {
+                        k.bezierHandles.x = glm::clamp(k.bezierHandles.x, 0.0f, 1.0f);
+                        k.bezierHandles.z = glm::clamp(k.bezierHandles.z, 0.0f, 1.0f);
+                        Components::KeyframeManager::Get().SortAndSaveKeyframes(keyframes);
+                    }
+
+                    if (ImGui::IsItemActivated())
+                    {
+                        handlesBeforeEdit = k.bezierHandles;
+                    }
+
+                    if (ImGui::IsItemDeactivatedAfterEdit())
+                    {
+                        const auto newHandles = k.bezierHandles;
+                        k.bezierHandles = handlesBeforeEdit;
+                        Components::KeyframeManager::Get().SetKeyframeInterpolation(property, k, k.interpolation,
+                                                                                    newHandles);
+                        Components::KeyframeManager::Get().SortAndSaveKeyframes(keyframes);
+                    }
+                }
+
                 if (ImGui::IsKeyPressed(ImGuiKey_Enter))
                 {
                     ImGui::CloseCurrentPopup();
@@ -618,9 +678,55 @@ namespace IWXMVM::UI
             for (int i = 0; i < pair.first.GetValueCount(); i++)
                 verticalZoomRanges[pair.first.type][i] =
                     ImVec2(std::get<0>(pair.first.defaultValueRange), std::get<1>(pair.first.defaultValueRange));
+
+            auto [rangeLow, rangeHigh] = pair.first.defaultValueRange;
+            simplifyTolerances[pair.first.type] =
+                std::vector<float>(pair.first.GetValueCount(), (rangeHigh - rangeLow) * 0.001f);
         }
     }
 
+    bool KeyframeEditor::DrawEventMarkers(const ImVec2 rectMin, const ImVec2 rectMax, uint32_t displayStartTick,
+                                          uint32_t displayEndTick, uint32_t currentTick)
+    {
+        const auto events = Components::DemoEventTimeline::GetEvents();
+        if (!events || displayEndTick <= displayStartTick)
+            return false;
+
+        const float tickRange = static_cast<float>(displayEndTick - displayStartTick);
+        const auto markerSize = ImGui::GetFontSize() * 0.25f;
+        const auto mousePos = ImGui::GetMousePos();
+        auto drawList = ImGui::GetWindowDrawList();
+        bool isAnyMarkerHovered = false;
+
+        auto it = std::lower_bound(events->begin(), events->end(), displayStartTick,
+                                   [](const auto& event, uint32_t tick) { return event.tick < tick; });
+        for (; it != events->end() && it->tick <= displayEndTick; ++it)
+        {
+            const auto percentage = static_cast<float>(it->tick - displayStartTick) / tickRange;
+            const auto x = rectMin.x + percentage * (rectMax.x - rectMin.x);
+            const bool isHovered = std::abs(mousePos.x - x) <= markerSize && mousePos.y >= rectMin.y &&
+                                   mousePos.y <= rectMin.y + markerSize * 2;
+
+            const auto color = ImGui::GetColorU32(isHovered ? ImGuiCol_SliderGrabActive : ImGuiCol_SliderGrab);
+            drawList->AddTriangleFilled(ImVec2(x - markerSize, rectMin.y), ImVec2(x + markerSize, rectMin.y),
+                                        ImVec2(x, rectMin.y + markerSize * 2), color);
+
+            if (!isHovered)
+                continue;
+
+            isAnyMarkerHovered = true;
+            ImGui::SetTooltip("%s (tick %u)", Types::ToString(it->type).data(), it->tick);
+            if (ImGui::IsMouseClicked(ImGuiMouseButton_Left) && !selectedKeyframeId.has_value() &&
+                !Components::Rewinding::IsRewinding())
+            {
+                Components::Playback::SetTickDelta(static_cast<int32_t>(it->tick) - static_cast<int32_t>(currentTick),
+                                                   true);
+            }
+        }
+
+        return isAnyMarkerHovered;
+    }
+
     bool KeyframeEditor::DrawKeyframeSlider(const Types::KeyframeableProperty& property)
     {
         auto demoInfo = Mod::GetGameInterface()->GetDemoInfo();
@@ -726,6 +832,50 @@ namespace IWXMVM::UI
         }
     }
 
+    void DrawSimplifyPopup(const Types::KeyframeableProperty& property, const char* popupLabel)
+    {
+        if (!ImGui::BeginPopup(popupLabel))
+            return;
+
+        ImGui::Text("Simplify keyframes");
+        ImGui::Separator();
+
+        auto& tolerances = simplifyTolerances.at(property.type);
+        for (int i = 0; i < property.GetValueCount(); i++)
+        {
+            ImGui::SetNextItemWidth(ImGui::GetFontSize() * 6.0f);
+            ImGui::DragFloat(std::format("{} tolerance##simplifyTolerance{}", 
+                                         Types::KeyframeValue::GetValueIndexName(property.valueType, i), i).c_str(),
+                             &tolerances[i], 0.001f, 0.0f, KEYFRAME_MAX_VALUE, "%.3f");
+        }
+
+        const auto isSimplifying = Components::KeyframeSimplifier::IsSimplifying();
+        if (isSimplifying)
+            ImGui::BeginDisabled();
+
+        if (ImGui::Button(ICON_FA_WAND_MAGIC_SPARKLES " Simplify"))
+        {
+            Components::KeyframeSimplifier::SimplifyTrack(property, tolerances);
+        }
+
+        if (isSimplifying)
+        {
+            ImGui::EndDisabled();
+            ImGui::SameLine();
+            ImGui::Text("Simplifying...");
+        }
+
+        auto lastResult = Components::KeyframeSimplifier::GetLastResult();
+        if (lastResult.has_value() && lastResult->propertyType == property.type)
+        {
+            ImGui::Text("%zu -> %zu keyframes, max error %.4f", lastResult->originalCount,
+                        lastResult->simplifiedCount,
+                        *std::max_element(lastResult->maxErrors.begin(), lastResult->maxErrors.end()));
+        }
+
+        ImGui::EndPopup();
+    }
+
     constexpr auto CLEAR_KEYFRAMES_POPUP_LABEL = "Are you sure?##clearKeyframes";
     void KeyframeEditor::DrawMiscButtons(ImVec2 padding, bool hasKeyframes)
     {
@@ -833,8 +983,7 @@ namespace IWXMVM::UI
 
                             ImGui::SetCursorPosY(startY + CURVE_EDITOR_LANE_HEIGHT / 8);
                             ImGui::SetCursorPosX(ImGui::GetCursorPosX() + padding.x);
-                            auto value =
-                                Components::KeyframeManager::Get().Interpolate(property, keyframes, currentTick);
+                            auto value = Components::KeyframeManager::Get().Interpolate(property, currentTick);
                             ImGui::Text(Types::KeyframeValue::GetValueIndexName(property.valueType, i).data());
 
                             if (disableValueInput)
@@ -858,7 +1007,10 @@ namespace IWXMVM::UI
                         }
                     }
 
-                    auto progressBarWidth = GetSize().x - firstColumnSize - GetSize().x * 0.05f - padding.x * 2;
+                    const auto propertyButtonSize =
+                        ImGui::GetTextLineHeight() + ImGui::GetStyle().FramePadding.y * 2.0f;
+                    auto progressBarWidth = GetSize().x - firstColumnSize - GetSize().x * 0.05f - padding.x * 2 -
+                                            propertyButtonSize - ImGui::GetStyle().ItemSpacing.x;
                     ImGui::SetNextItemWidth(progressBarWidth);
                     ImGui::TableSetColumnIndex(1);
                     wasInnerAreaHovered = DrawKeyframeSlider(property) || wasInnerAreaHovered;
@@ -866,13 +1018,27 @@ namespace IWXMVM::UI
                     ImGui::SameLine();
                     ImGui::PushStyleColor(ImGuiCol_ButtonHovered, ImVec4(1, 0.1f, 0.1f, 1));
                     if (ImGui::Button(std::format(ICON_FA_TRASH "##deleteProperty{}Button", property.name).c_str(), 
-                                      ImVec2(1, 1) * (ImGui::GetTextLineHeight() + ImGui::GetStyle().FramePadding.y * 2.0f)))
+                                      ImVec2(1, 1) * propertyButtonSize))
                     {
                         Components::KeyframeManager::Get().ClearKeyframes(property);
                         propertyVisible[property] = false;
                     }
                     ImGui::PopStyleColor();
 
+                    const auto simplifyPopupLabel = std::format("##simplifyProperty{}Popup", property.name);
+                    const auto disableSimplify = keyframes.size() <= 2;
+                    ImGui::SameLine();
+                    if (disableSimplify)
+                        ImGui::BeginDisabled();
+                    if (ImGui::Button(std::format(ICON_FA_WAND_MAGIC_SPARKLES "##simplifyProperty{}Button", property.name).c_str(),
+                                      ImVec2(1, 1) * propertyButtonSize))
+                    {
+                        ImGui::OpenPopup(simplifyPopupLabel.c_str());
+                    }
+                    if (disableSimplify)
+                        ImGui::EndDisabled();
+                    DrawSimplifyPopup(property, simplifyPopupLabel.c_str());
+
                     if (showCurve)
                     {
                         wasInnerAreaHovered = DrawCurveEditor(property, progressBarWidth) || wasInnerAreaHovered;
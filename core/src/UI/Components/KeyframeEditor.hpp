@@ -35,6 +35,11 @@ namespace IWXMVM::UI
                                         std::optional<uint32_t> frozenTick);
         bool DrawKeyframeSlider(const Types::KeyframeableProperty& property);
 
+        // Marks the demo's events along the top of a keyframe lane, clicking one seeks to it. Returns whether a marker
+        // is hovered.
+        bool DrawEventMarkers(const ImVec2 rectMin, const ImVec2 rectMax, uint32_t displayStartTick,
+                              uint32_t displayEndTick, uint32_t currentTick);
+
         void DrawMiscButtons(ImVec2 padding, bool hasKeyframes);
 
         int32_t displayStartTick, displayEndTick;
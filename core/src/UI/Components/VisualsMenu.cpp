@@ -2,6 +2,7 @@
 #include "VisualsMenu.hpp"
 #include "Mod.hpp"
 
+#include "Components/VisualApplier.hpp"
 #include "UI/UIManager.hpp"
 #include "UI/ImGuiEx/KeyframeableControls.hpp"
 #include "Events.hpp"
@@ -384,19 +385,19 @@ namespace IWXMVM::UI
 
     void VisualsMenu::UpdateDof()
     {
-        Mod::GetGameInterface()->SetDof(visuals.dof);
+        Components::VisualApplier::SetDof(visuals.dof);
     }
 
     void VisualsMenu::UpdateSun()
     {
         IWXMVM::Types::Sun sunSettings = {glm::make_vec3(visuals.sunColor), glm::make_vec3(visuals.sunDirection),
                                           visuals.sunBrightness};
-        Mod::GetGameInterface()->SetSun(sunSettings);
+        Components::VisualApplier::SetSun(sunSettings);
     }
 
     void VisualsMenu::UpdateFilmtweaks()
     {
-        Mod::GetGameInterface()->SetFilmtweaks(visuals.filmtweaks);
+        Components::VisualApplier::SetFilmtweaks(visuals.filmtweaks);
     }
 
     void VisualsMenu::UpdateHudInfo()
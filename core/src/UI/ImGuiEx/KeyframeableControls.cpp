@@ -1,6 +1,7 @@
 #include "StdInclude.hpp"
 #include "KeyframeableControls.hpp"
 
+#include "Components/FrameState.hpp"
 #include "Components/KeyframeManager.hpp"
 #include "Components/Playback.hpp"
 #include "Mod.hpp"
@@ -17,6 +18,17 @@ namespace ImGuiEx::Keyframeable
         }
     }
 
+    IWXMVM::Types::KeyframeValue GetCurrentValue(const IWXMVM::Types::KeyframeableProperty& property)
+    {
+        using namespace IWXMVM;
+
+        // the cached frame state is preferred, but never assume it holds the property
+        if (auto value = Components::FrameState::GetValue(property.type); value.has_value())
+            return value.value();
+
+        return Components::KeyframeManager::Get().Interpolate(property, Components::Playback::GetTimelineTick());
+    }
+
     void DrawKeyframeButton(const char* label, bool drawButton, std::function<void()> AddKeyframe)
     {
         ImGui::PushStyleVar(ImGuiStyleVar_DisabledAlpha, 0.0f);
@@ -42,9 +54,9 @@ namespace ImGuiEx::Keyframeable
         if (property.valueType != Types::KeyframeValueType::FloatingPoint)
             throw std::invalid_argument("Property is not a floating point value");
 
-        const auto& keyframes = keyframeManager.GetKeyframes(property);
+        const auto& curve = keyframeManager.GetCurve(propertyType);
         DrawKeyframeButton(std::format("##{0}{1}KeyframeButton", label, magic_enum::enum_name(propertyType)).c_str(),
-                           keyframes.empty(), [&]() {
+                           curve.IsEmpty(), [&]() {
                 keyframeManager.AddKeyframe(
                     property,
                     Types::Keyframe(property, Components::Playback::GetTimelineTick(), *v));
@@ -57,13 +69,13 @@ namespace ImGuiEx::Keyframeable
 
         const auto labelText = std::format("##{0}{1}Label", label, magic_enum::enum_name(propertyType));
         bool result = true;
-        if (keyframes.empty())
+        if (curve.IsEmpty())
         {
             result = ImGui::SliderFloat(labelText.c_str(), v, v_min, v_max);
         }
         else
         {
-            auto interpolatedValue = keyframeManager.Interpolate(property, Components::Playback::GetTimelineTick());
+            auto interpolatedValue = GetCurrentValue(property);
 
             *v = interpolatedValue.floatingPoint;
 
@@ -87,9 +99,9 @@ namespace ImGuiEx::Keyframeable
         if (property.valueType != Types::KeyframeValueType::Vector3)
             throw std::invalid_argument("Property is not a vector3 value");
 
-        const auto& keyframes = keyframeManager.GetKeyframes(property);
+        const auto& curve = keyframeManager.GetCurve(propertyType);
         DrawKeyframeButton(std::format("##{0}{1}KeyframeButton", label, magic_enum::enum_name(propertyType)).c_str(),
-                           keyframes.empty(), [&]() {
+                           curve.IsEmpty(), [&]() {
                                keyframeManager.AddKeyframe(
                                    property, Types::Keyframe(property, Components::Playback::GetTimelineTick(),
                                                    glm::vec3(v[0], v[1], v[2])));
@@ -103,13 +115,13 @@ namespace ImGuiEx::Keyframeable
 
         const auto labelText = std::format("##{0}{1}Label", label, magic_enum::enum_name(propertyType));
         bool result = true;
-        if (keyframes.empty())
+        if (curve.IsEmpty())
         {
             result = ImGui::SliderFloat3(labelText.c_str(), v, v_min, v_max);
         }
         else
         {
-            auto interpolatedValue = keyframeManager.Interpolate(property, Components::Playback::GetTimelineTick());
+            auto interpolatedValue = GetCurrentValue(property);
 
             v[0] = interpolatedValue.vector3.x;
             v[1] = interpolatedValue.vector3.y;
@@ -134,8 +146,8 @@ namespace ImGuiEx::Keyframeable
         if (property.valueType != Types::KeyframeValueType::Vector3)
             throw std::invalid_argument("Property is not a vector3 value");
 
-        const auto& keyframes = keyframeManager.GetKeyframes(property);
-        DrawKeyframeButton(label, keyframes.empty(), [&]() {
+        const auto& curve = keyframeManager.GetCurve(propertyType);
+        DrawKeyframeButton(label, curve.IsEmpty(), [&]() {
             keyframeManager.AddKeyframe(property, Types::Keyframe(property, Components::Playback::GetTimelineTick(),
                                           glm::vec3(col[0], col[1], col[2])));
         });
@@ -146,13 +158,13 @@ namespace ImGuiEx::Keyframeable
         ImGui::SetCursorPosX(ImGui::GetWindowWidth() * 0.4f);
         ImGui::SetNextItemWidth(ImGui::GetWindowWidth() * 0.6f - ImGui::GetStyle().WindowPadding.x);
         bool result = true;
-        if (keyframes.empty())
+        if (curve.IsEmpty())
         {
             result = ImGui::ColorEdit3(std::format("##{0}", label).c_str(), col);
         }
         else
         {
-            auto interpolatedValue = keyframeManager.Interpolate(property, Components::Playback::GetTimelineTick());
+            auto interpolatedValue = GetCurrentValue(property);
 
             col[0] = interpolatedValue.vector3.x;
             col[1] = interpolatedValue.vector3.y;
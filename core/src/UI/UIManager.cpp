@@ -8,7 +8,9 @@
 #include "Resources.hpp"
 #include "Input.hpp"
 #include "Components/CameraManager.hpp"
+#include "Components/Playback.hpp"
 #include "Utilities/MathUtils.hpp"
+#include "Utilities/Profiler.hpp"
 #include "UI/TaskbarProgress.hpp"
 
 namespace IWXMVM::UI
@@ -37,6 +39,8 @@ namespace IWXMVM::UI
 
     void UIManager::RunImGuiFrame()
     {
+        PROFILE_ZONE("UIManager::RunImGuiFrame");
+
         try
         {
             ImGui_ImplDX9_NewFrame();
@@ -90,7 +94,8 @@ namespace IWXMVM::UI
                 GetUIComponent(Component::DebugPanel)->Render();
             }
 
-            Events::Invoke(EventType::OnFrame);
+            Events::Invoke<EventType::OnFrame>(
+                {frameIndex++, ImGui::GetIO().DeltaTime, Components::Playback::GetTimelineTick()});
 
             ImGui::EndFrame();
             ImGui::Render();
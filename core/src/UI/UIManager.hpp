@@ -151,6 +151,8 @@ namespace IWXMVM::UI
         bool showImGuiDemo = false;
         bool showDebugPanel = false;
 
+        std::uint64_t frameIndex = 0;
+
         WNDPROC originalGameWndProc = nullptr;
     };
 }  // namespace IWXMVM::UI
\ No newline at end of file
@@ -0,0 +1,434 @@
+#include "StdInclude.hpp"
+#include "CompressedDemo.hpp"
+
+#include <execution>
+
+#pragma comment(lib, "Cabinet.lib")
+
+namespace IWXMVM::CompressedDemo
+{
+    constexpr std::array<char, 4> MAGIC = {'I', 'W', 'X', 'Z'};
+    constexpr uint32_t FORMAT_VERSION = 1;
+
+    // Frames are processed in batches, which bounds memory use while still giving every core a frame to work on
+    constexpr std::size_t FRAMES_PER_BATCH = 64;
+
+    struct FileHeader
+    {
+        std::array<char, 4> magic;
+        uint32_t version;
+        uint32_t frameSize;
+        uint32_t frameCount;
+        std::uint64_t size;
+        std::uint64_t indexOffset;
+    };
+    static_assert(sizeof(FileHeader) == 32);
+
+    // Mirrors DecompressingBuffer::Frame, which is private
+    struct FrameIndexEntry
+    {
+        std::uint64_t offset;
+        uint32_t compressedSize;
+        uint32_t size;
+    };
+    static_assert(sizeof(FrameIndexEntry) == 16);
+
+    std::vector<FrameIndexEntry> ReadFrameIndex(std::ifstream& file, FileHeader& header)
+    {
+        file.seekg(0, std::ios::end);
+        const auto fileSize = static_cast<std::uint64_t>(file.tellg());
+        file.seekg(0, std::ios::beg);
+
+        file.read(reinterpret_cast<char*>(&header), sizeof(header));
+        if (!file || header.magic != MAGIC)
+            throw std::runtime_error("not a compressed demo");
+        if (header.version != FORMAT_VERSION)
+            throw std::runtime_error(std::format("unsupported compressed demo version {}", header.version));
+        if (header.frameSize == 0 ||
+            header.indexOffset + static_cast<std::uint64_t>(header.frameCount) * sizeof(FrameIndexEntry) > fileSize)
+        {
+            throw std::runtime_error("corrupt compressed demo header");
+        }
+
+        std::vector<FrameIndexEntry> frames(header.frameCount);
+        file.seekg(static_cast<std::streamoff>(header.indexOffset));
+        file.read(reinterpret_cast<char*>(frames.data()), frames.size() * sizeof(FrameIndexEntry));
+        if (!file)
+            throw std::runtime_error("truncated compressed demo index");
+
+        // every frame but the last one is full, which is what lets an offset be mapped to its frame by division
+        std::uint64_t totalSize = 0;
+        for (std::size_t i = 0; i < frames.size(); i++)
+        {
+            const auto& frame = frames[i];
+            if ((i + 1 < frames.size() && frame.size != header.frameSize) || frame.size > header.frameSize ||
+                frame.offset + frame.compressedSize > header.indexOffset)
+            {
+                throw std::runtime_error("corrupt compressed demo index");
+            }
+            totalSize += frame.size;
+        }
+
+        if (totalSize != header.size)
+            throw std::runtime_error("corrupt compressed demo index");
+
+        return frames;
+    }
+
+    // Returns an empty buffer on failure, since this runs inside parallel algorithms that must not throw
+    std::vector<char> CompressFrame(const std::vector<char>& data)
+    {
+        COMPRESSOR_HANDLE compressor = nullptr;
+        if (!CreateCompressor(COMPRESS_ALGORITHM_XPRESS_HUFF, nullptr, &compressor))
+            return {};
+
+        std::vector<char> compressed;
+        SIZE_T compressedSize = 0;
+
+        // the first call only reports the required buffer size. The Windows functions are qualified, as the demo level
+        // Compress and Decompress below would hide them.
+        ::Compress(compressor, data.data(), data.size(), nullptr, 0, &compressedSize);
+        compressed.resize(compressedSize);
+        if (!::Compress(compressor, data.data(), data.size(), compressed.data(), compressed.size(), &compressedSize))
+            compressed.clear();
+        else
+            compressed.resize(compressedSize);
+
+        CloseCompressor(compressor);
+        return compressed;
+    }
+
+    bool DecompressFrame(DECOMPRESSOR_HANDLE decompressor, const std::vector<char>& compressed, std::vector<char>& data,
+                         uint32_t size)
+    {
+        data.resize(size);
+
+        SIZE_T decompressedSize = 0;
+        return ::Decompress(decompressor, compressed.data(), compressed.size(), data.data(), data.size(),
+                            &decompressedSize) &&
+               decompressedSize == size;
+    }
+
+    DecompressingBuffer::DecompressingBuffer(const std::filesystem::path& path) : file(path, std::ios::binary)
+    {
+        if (!file.is_open())
+            throw std::runtime_error("failed to open compressed demo");
+
+        FileHeader header;
+        for (const auto& entry : ReadFrameIndex(file, header))
+        {
+            frames.push_back({entry.offset, entry.compressedSize, entry.size});
+        }
+        size = header.size;
+        frameSize = header.frameSize;
+
+        if (!CreateDecompressor(COMPRESS_ALGORITHM_XPRESS_HUFF, nullptr, &decompressor))
+            throw std::runtime_error("failed to create decompressor");
+    }
+
+    DecompressingBuffer::~DecompressingBuffer()
+    {
+        if (decompressor)
+            CloseDecompressor(decompressor);
+    }
+
+    std::uint64_t DecompressingBuffer::GetPosition() const
+    {
+        if (eback() == nullptr)
+            return pendingPosition;
+
+        return static_cast<std::uint64_t>(loadedFrameIndex) * frameSize + (gptr() - eback());
+    }
+
+    bool DecompressingBuffer::LoadFrame(std::size_t frameIndex)
+    {
+        if (frameIndex == loadedFrameIndex)
+            return true;
+
+        loadedFrameIndex = std::numeric_limits<std::size_t>::max();
+
+        const auto& entry = frames[frameIndex];
+        compressedFrame.resize(entry.compressedSize);
+        file.clear();
+        file.seekg(static_cast<std::streamoff>(entry.offset));
+        file.read(compressedFrame.data(), compressedFrame.size());
+        if (!file || !DecompressFrame(decompressor, compressedFrame, frame, entry.size))
+        {
+            LOG_ERROR("Failed to decompress demo frame {}", frameIndex);
+            return false;
+        }
+
+        loadedFrameIndex = frameIndex;
+        return true;
+    }
+
+    DecompressingBuffer::int_type DecompressingBuffer::underflow()
+    {
+        if (gptr() < egptr())
+            return traits_type::to_int_type(*gptr());
+
+        const auto position = GetPosition();
+        if (position >= size)
+            return traits_type::eof();
+
+        const auto frameIndex = static_cast<std::size_t>(position / frameSize);
+        if (!LoadFrame(frameIndex))
+        {
+            setg(nullptr, nullptr, nullptr);
+            pendingPosition = position;
+            return traits_type::eof();
+        }
+
+        const auto offsetInFrame = position - static_cast<std::uint64_t>(frameIndex) * frameSize;
+        setg(frame.data(), frame.data() + offsetInFrame, frame.data() + frame.size());
+        return traits_type::to_int_type(*gptr());
+    }
+
+    DecompressingBuffer::pos_type DecompressingBuffer::seekoff(off_type offset, std::ios_base::seekdir direction,
+                                                               std::ios_base::openmode mode)
+    {
+        off_type base = 0;
+        if (direction == std::ios_base::cur)
+            base = static_cast<off_type>(GetPosition());
+        else if (direction == std::ios_base::end)
+            base = static_cast<off_type>(size);
+
+        return seekpos(pos_type(base + offset), mode);
+    }
+
+    DecompressingBuffer::pos_type DecompressingBuffer::seekpos(pos_type position, std::ios_base::openmode mode)
+    {
+        const auto target = static_cast<off_type>(position);
+        if (!(mode & std::ios_base::in) || target < 0 || static_cast<std::uint64_t>(target) > size)
+            return pos_type(off_type(-1));
+
+        // seeks within the loaded frame, like the ones after reading a message header, only move the read pointer
+        const auto frameStart = static_cast<off_type>(loadedFrameIndex) * frameSize;
+        if (eback() != nullptr && target >= frameStart && target < frameStart + static_cast<off_type>(frame.size()))
+        {
+            setg(eback(), eback() + (target - frameStart), egptr());
+        }
+        else
+        {
+            setg(nullptr, nullptr, nullptr);
+            pendingPosition = static_cast<std::uint64_t>(target);
+        }
+
+        return position;
+    }
+
+    class DecompressingStream : public std::istream
+    {
+       public:
+        explicit DecompressingStream(const std::filesystem::path& path) : std::istream(nullptr), buffer(path)
+        {
+            rdbuf(&buffer);
+        }
+
+       private:
+        DecompressingBuffer buffer;
+    };
+
+    bool HasCompressedExtension(const std::filesystem::path& path)
+    {
+        return path.extension() == EXTENSION;
+    }
+
+    bool StartsWithMagic(std::istream& stream)
+    {
+        std::array<char, 4> magic{};
+        stream.read(magic.data(), magic.size());
+        return stream.gcount() == static_cast<std::streamsize>(magic.size()) && magic == MAGIC;
+    }
+
+    bool IsCompressed(const std::filesystem::path& path)
+    {
+        std::ifstream file(path, std::ios::binary);
+        return file.is_open() && StartsWithMagic(file);
+    }
+
+    std::unique_ptr<std::istream> OpenDemo(const std::filesystem::path& path)
+    {
+        auto file = std::make_unique<std::ifstream>(path, std::ios::binary);
+        if (!file->is_open())
+            return nullptr;
+
+        if (!StartsWithMagic(*file))
+        {
+            file->clear();
+            file->seekg(0, std::ios::beg);
+            return file;
+        }
+
+        try
+        {
+            return std::make_unique<DecompressingStream>(path);
+        }
+        catch (const std::runtime_error& e)
+        {
+            LOG_ERROR("Failed to open compressed demo {}: {}", path.string(), e.what());
+            return nullptr;
+        }
+    }
+
+    void Compress(const std::filesystem::path& inputPath, const std::filesystem::path& outputPath)
+    {
+        std::ifstream input(inputPath, std::ios::binary);
+        if (!input.is_open())
+            throw std::runtime_error("failed to open demo");
+
+        // written next to the target first, so an interrupted conversion never leaves a broken demo behind
+        auto tempPath = outputPath;
+        tempPath += ".tmp";
+        std::ofstream output(tempPath, std::ios::binary | std::ios::trunc);
+        if (!output.is_open())
+            throw std::runtime_error("failed to create compressed demo");
+
+        FileHeader header{MAGIC, FORMAT_VERSION, FRAME_SIZE, 0, 0, 0};
+        output.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+        std::vector<FrameIndexEntry> frames;
+        std::vector<std::vector<char>> rawFrames(FRAMES_PER_BATCH);
+        std::vector<std::vector<char>> compressedFrames(FRAMES_PER_BATCH);
+        std::uint64_t offset = sizeof(header);
+
+        while (true)
+        {
+            std::size_t batchSize = 0;
+            for (; batchSize < FRAMES_PER_BATCH; batchSize++)
+            {
+                auto& rawFrame = rawFrames[batchSize];
+                rawFrame.resize(FRAME_SIZE);
+                input.read(rawFrame.data(), rawFrame.size());
+                rawFrame.resize(static_cast<std::size_t>(input.gcount()));
+                if (rawFrame.empty())
+                    break;
+            }
+
+            std::for_each(std::execution::par, rawFrames.begin(), rawFrames.begin() + batchSize,
+                          [&](const std::vector<char>& rawFrame) {
+                              compressedFrames[&rawFrame - rawFrames.data()] = CompressFrame(rawFrame);
+                          });
+
+            for (std::size_t i = 0; i < batchSize; i++)
+            {
+                if (compressedFrames[i].empty())
+                    throw std::runtime_error("failed to compress demo frame");
+
+                const auto compressedSize = static_cast<uint32_t>(compressedFrames[i].size());
+                frames.push_back({offset, compressedSize, static_cast<uint32_t>(rawFrames[i].size())});
+                output.write(compressedFrames[i].data(), compressedSize);
+                offset += compressedSize;
+                header.size += rawFrames[i].size();
+            }
+
+            if (batchSize < FRAMES_PER_BATCH)
+                break;
+        }
+
+        header.frameCount = static_cast<uint32_t>(frames.size());
+        header.indexOffset = offset;
+        output.write(reinterpret_cast<const char*>(frames.data()), frames.size() * sizeof(FrameIndexEntry));
+        output.seekp(0);
+        output.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        output.close();
+
+        if (!output)
+            throw std::runtime_error("failed to write compressed demo");
+
+        std::filesystem::rename(tempPath, outputPath);
+    }
+
+    void Decompress(const std::filesystem::path& inputPath, const std::filesystem::path& outputPath)
+    {
+        std::ifstream input(inputPath, std::ios::binary);
+        if (!input.is_open())
+            throw std::runtime_error("failed to open compressed demo");
+
+        FileHeader header;
+        const auto frames = ReadFrameIndex(input, header);
+
+        auto tempPath = outputPath;
+        tempPath += ".tmp";
+        std::ofstream output(tempPath, std::ios::binary | std::ios::trunc);
+        if (!output.is_open())
+            throw std::runtime_error("failed to create demo");
+
+        std::vector<std::vector<char>> compressedFrames(FRAMES_PER_BATCH);
+        std::vector<std::vector<char>> rawFrames(FRAMES_PER_BATCH);
+        std::vector<uint8_t> succeeded(FRAMES_PER_BATCH);
+
+        for (std::size_t batchStart = 0; batchStart < frames.size(); batchStart += FRAMES_PER_BATCH)
+        {
+            const auto batchSize = std::min(FRAMES_PER_BATCH, frames.size() - batchStart);
+            for (std::size_t i = 0; i < batchSize; i++)
+            {
+                const auto& entry = frames[batchStart + i];
+                compressedFrames[i].resize(entry.compressedSize);
+                input.seekg(static_cast<std::streamoff>(entry.offset));
+                input.read(compressedFrames[i].data(), entry.compressedSize);
+            }
+
+            if (!input)
+                throw std::runtime_error("truncated compressed demo");
+
+            std::vector<std::size_t> indices(batchSize);
+            std::iota(indices.begin(), indices.end(), 0);
+            std::for_each(std::execution::par, indices.begin(), indices.end(), [&](std::size_t i) {
+                DECOMPRESSOR_HANDLE decompressor = nullptr;
+                succeeded[i] = CreateDecompressor(COMPRESS_ALGORITHM_XPRESS_HUFF, nullptr, &decompressor) &&
+                               DecompressFrame(decompressor, compressedFrames[i], rawFrames[i],
+                                               frames[batchStart + i].size);
+                if (decompressor)
+                    CloseDecompressor(decompressor);
+            });
+
+            for (std::size_t i = 0; i < batchSize; i++)
+            {
+                if (!succeeded[i])
+                    throw std::runtime_error("failed to decompress demo frame");
+
+                output.write(rawFrames[i].data(), rawFrames[i].size());
+            }
+        }
+
+        output.close();
+        if (!output)
+            throw std::runtime_error("failed to write demo");
+
+        std::filesystem::rename(tempPath, outputPath);
+    }
+
+    void ConvertDemos(const std::vector<std::filesystem::path>& demoPaths)
+    {
+        for (const auto& demoPath : demoPaths)
+        {
+            const auto start = std::chrono::steady_clock::now();
+            const bool isCompressed = HasCompressedExtension(demoPath);
+
+            auto outputPath = demoPath;
+            if (isCompressed)
+                outputPath.replace_extension();
+            else
+                outputPath += EXTENSION;
+
+            try
+            {
+                if (isCompressed)
+                    Decompress(demoPath, outputPath);
+                else
+                    Compress(demoPath, outputPath);
+
+                LOG_INFO("{} {} ({} to {} bytes) in {} ms", isCompressed ? "Decompressed" : "Compressed",
+                         demoPath.filename().string(), std::filesystem::file_size(demoPath),
+                         std::filesystem::file_size(outputPath),
+                         std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start)
+                             .count());
+            }
+            catch (const std::exception& e)
+            {
+                LOG_ERROR("Failed to convert demo {}: {}", demoPath.string(), e.what());
+            }
+        }
+    }
+}  // namespace IWXMVM::CompressedDemo
@@ -0,0 +1,71 @@
+#pragma once
+#include <compressapi.h>
+
+namespace IWXMVM::CompressedDemo
+{
+    // Compressed demos keep their original name with this appended, e.g. "match.dm_1.xpz"
+    constexpr std::string_view EXTENSION = ".xpz";
+
+    // Demos are compressed in independent frames of this size, so any offset can be reached by decompressing a
+    // single frame
+    constexpr uint32_t FRAME_SIZE = 1024 * 1024;
+
+    // Reads a compressed demo as if it was the raw file. The most recently decompressed frame is kept, so the many
+    // small reads of demo playback only decompress every frame once, and a seek costs at most one frame.
+    class DecompressingBuffer : public std::streambuf
+    {
+       public:
+        // Throws std::runtime_error if the file is not a compressed demo
+        explicit DecompressingBuffer(const std::filesystem::path& path);
+        ~DecompressingBuffer() override;
+
+        DecompressingBuffer(const DecompressingBuffer&) = delete;
+        DecompressingBuffer& operator=(const DecompressingBuffer&) = delete;
+
+       protected:
+        int_type underflow() override;
+        pos_type seekoff(off_type offset, std::ios_base::seekdir direction, std::ios_base::openmode mode) override;
+        pos_type seekpos(pos_type position, std::ios_base::openmode mode) override;
+
+       private:
+        struct Frame
+        {
+            std::uint64_t offset;
+            uint32_t compressedSize;
+            uint32_t size;
+        };
+
+        std::uint64_t GetPosition() const;
+        bool LoadFrame(std::size_t frameIndex);
+
+        std::ifstream file;
+        std::vector<Frame> frames;
+        std::uint64_t size = 0;
+        uint32_t frameSize = 0;
+        DECOMPRESSOR_HANDLE decompressor = nullptr;
+
+        std::vector<char> compressedFrame;
+        std::vector<char> frame;
+        std::size_t loadedFrameIndex = std::numeric_limits<std::size_t>::max();
+
+        // Read position while no frame is in the get area, e.g. right after a seek
+        std::uint64_t pendingPosition = 0;
+    };
+
+    bool HasCompressedExtension(const std::filesystem::path& path);
+
+    // Whether the file starts like a compressed demo, whatever its name
+    bool IsCompressed(const std::filesystem::path& path);
+
+    // Opens a demo for reading, decompressing it on the fly if it is compressed. Compressed demos are recognized by
+    // their contents rather than their name, so a compressed demo still works after being renamed to the game's
+    // extension. Returns nullptr if the file could not be opened.
+    std::unique_ptr<std::istream> OpenDemo(const std::filesystem::path& path);
+
+    // Both throw std::runtime_error on failure and use all cores for the frames of a demo
+    void Compress(const std::filesystem::path& inputPath, const std::filesystem::path& outputPath);
+    void Decompress(const std::filesystem::path& inputPath, const std::filesystem::path& outputPath);
+
+    // Compresses raw demos and decompresses compressed ones next to the originals, which are kept
+    void ConvertDemos(const std::vector<std::filesystem::path>& demoPaths);
+}  // namespace IWXMVM::CompressedDemo
@@ -0,0 +1,83 @@
+#include "StdInclude.hpp"
+#include "CubicSpline.hpp"
+
+namespace IWXMVM::MathUtils
+{
+    // Copyright (c) by NUMERICAL RECIPES IN C: THE ART OF SCIENTIFIC COMPUTING (ISBN 0-521-43108-5)
+    // Modified. Thank you to dtugend for finding this!
+    void CubicSpline::Build(const std::vector<Types::Keyframe>& keyframes, uint32_t valueIndex)
+    {
+        const auto n = keyframes.size();
+
+        ticks.resize(n);
+        values.resize(n);
+        secondDerivatives.resize(n);
+        for (std::size_t i = 0; i < n; i++)
+        {
+            ticks[i] = static_cast<float>(keyframes[i].tick);
+            values[i] = keyframes[i].value.GetByIndex(valueIndex);
+        }
+
+        if (n < 2)
+        {
+            std::fill(secondDerivatives.begin(), secondDerivatives.end(), 0.0f);
+            return;
+        }
+
+        auto& y2 = secondDerivatives;
+        std::vector<float> u(n);
+
+        y2[0] = -0.5f;
+        u[0] = (3.0f / (ticks[1] - ticks[0])) * ((values[1] - values[0]) / (ticks[1] - ticks[0]));
+
+        for (std::size_t i = 1; i <= n - 2; i++)
+        {
+            const auto prevTick = ticks[i - 1];
+            const auto prevValue = values[i - 1];
+            const auto currTick = ticks[i];
+            const auto currValue = values[i];
+            const auto nextTick = ticks[i + 1];
+            const auto nextValue = values[i + 1];
+
+            auto sig = (currTick - prevTick) / (nextTick - prevTick);
+            auto p = sig * y2[i - 1] + 2.0f;
+            y2[i] = (sig - 1.0f) / p;
+            u[i] = (nextValue - currValue) / (nextTick - currTick) - (currValue - prevValue) / (currTick - prevTick);
+            u[i] = (6.0f * u[i] / (nextTick - prevTick) - sig * u[i - 1]) / p;
+        }
+
+        auto qn = 0.5f;
+        auto un = (3.0f / (ticks[n - 1] - ticks[n - 2])) *
+                  (0.0f - (values[n - 1] - values[n - 2]) / (ticks[n - 1] - ticks[n - 2]));
+
+        y2[n - 1] = (un - qn * u[n - 2]) / (qn * y2[n - 2] + 1.0f);
+
+        for (std::size_t k = n - 1; k-- > 0;)
+            y2[k] = y2[k] * y2[k + 1] + u[k];
+    }
+
+    float CubicSpline::Evaluate(float tick) const
+    {
+        if (ticks.empty())
+            return 0.0f;
+        if (ticks.size() == 1 || tick <= ticks.front())
+            return values.front();
+        if (tick >= ticks.back())
+            return values.back();
+
+        const auto it = std::upper_bound(ticks.begin(), ticks.end(), tick);
+        return EvaluateSegment(static_cast<std::size_t>(std::distance(ticks.begin(), it)) - 1, tick);
+    }
+
+    float CubicSpline::EvaluateSegment(std::size_t index, float tick) const
+    {
+        const auto klo = index;
+        const auto khi = index + 1;
+
+        auto h = ticks[khi] - ticks[klo];
+        auto a = (ticks[khi] - tick) / h;
+        auto b = (tick - ticks[klo]) / h;
+        return a * values[klo] + b * values[khi] +
+               ((a * a * a - a) * secondDerivatives[klo] + (b * b * b - b) * secondDerivatives[khi]) * (h * h) / 6.0f;
+    }
+}  // namespace IWXMVM::MathUtils
@@ -0,0 +1,28 @@
+#pragma once
+#include "Types/Keyframe.hpp"
+
+namespace IWXMVM::MathUtils
+{
+    // Cubic spline through one value index of a keyframe track. The second derivatives are solved once in Build, so
+    // evaluating the spline is a binary search and a single polynomial, independent of the number of nodes.
+    class CubicSpline
+    {
+       public:
+        void Build(const std::vector<Types::Keyframe>& keyframes, uint32_t valueIndex);
+
+        float Evaluate(float tick) const;
+
+        // Evaluates the segment from node `index` to node `index + 1`, for callers that already located the segment
+        float EvaluateSegment(std::size_t index, float tick) const;
+
+        bool IsEmpty() const
+        {
+            return ticks.empty();
+        }
+
+       private:
+        std::vector<float> ticks;
+        std::vector<float> values;
+        std::vector<float> secondDerivatives;
+    };
+}  // namespace IWXMVM::MathUtils
@@ -0,0 +1,296 @@
+#include "StdInclude.hpp"
+#include "DemoTempCache.hpp"
+
+#include "nlohmann/json.hpp"
+
+namespace IWXMVM::DemoTempCache
+{
+    constexpr std::string_view NODE_ENTRIES = "entries";
+    constexpr std::string_view NODE_HASH = "hash";
+    constexpr std::string_view NODE_FILE_NAME = "fileName";
+    constexpr std::string_view NODE_SOURCE_PATH = "sourcePath";
+    constexpr std::string_view NODE_FILE_SIZE = "fileSize";
+    constexpr std::string_view NODE_SOURCE_LAST_WRITE_TIME = "sourceLastWriteTime";
+    constexpr std::string_view NODE_CACHED_LAST_WRITE_TIME = "cachedLastWriteTime";
+    constexpr std::string_view NODE_IS_HARD_LINK = "isHardLink";
+    constexpr std::string_view NODE_LAST_USED = "lastUsed";
+
+    constexpr std::string_view INDEX_FILE_NAME = "index.json";
+
+    struct CacheEntry
+    {
+        std::string hash;
+        std::string fileName;
+        std::string sourcePath;
+        std::uintmax_t fileSize = 0;
+        std::int64_t sourceLastWriteTime = 0;
+        std::int64_t cachedLastWriteTime = 0;
+        bool isHardLink = false;
+        std::int64_t lastUsed = 0;
+    };
+
+    std::string GetPathKey(const std::filesystem::path& path)
+    {
+        const auto u8Path = path.u8string();
+        return std::string(u8Path.begin(), u8Path.end());
+    }
+
+    std::int64_t GetLastWriteTime(const std::filesystem::path& path)
+    {
+        return std::filesystem::last_write_time(path).time_since_epoch().count();
+    }
+
+    // 64-bit FNV-1a over the file contents
+    std::string HashDemoFile(const std::filesystem::path& path)
+    {
+        constexpr std::size_t CHUNK_SIZE = 1024 * 1024;
+
+        std::ifstream file(path, std::ios::binary);
+        if (!file.is_open())
+        {
+            throw std::filesystem::filesystem_error("failed to open demo for hashing", path,
+                                                    std::make_error_code(std::errc::io_error));
+        }
+
+        std::uint64_t hash = 0xcbf29ce484222325;
+        std::vector<char> buffer(CHUNK_SIZE);
+        while (file)
+        {
+            file.read(buffer.data(), buffer.size());
+            const auto count = static_cast<std::size_t>(file.gcount());
+            for (std::size_t i = 0; i < count; i++)
+            {
+                hash ^= static_cast<uint8_t>(buffer[i]);
+                hash *= 0x100000001b3;
+            }
+        }
+
+        return std::format("{:016x}", hash);
+    }
+
+    std::vector<CacheEntry> ReadIndex(const std::filesystem::path& indexPath)
+    {
+        using json = nlohmann::json;
+
+        std::vector<CacheEntry> entries;
+
+        std::ifstream indexFile(indexPath);
+        if (!indexFile.is_open())
+            return entries;
+
+        try
+        {
+            json rootNode = json::parse(indexFile);
+            for (const auto& entryObject : rootNode.at(NODE_ENTRIES))
+            {
+                CacheEntry entry;
+                entry.hash = entryObject.at(NODE_HASH).get<std::string>();
+                entry.fileName = entryObject.at(NODE_FILE_NAME).get<std::string>();
+                entry.sourcePath = entryObject.at(NODE_SOURCE_PATH).get<std::string>();
+                entry.fileSize = entryObject.at(NODE_FILE_SIZE).get<std::uintmax_t>();
+                entry.sourceLastWriteTime = entryObject.at(NODE_SOURCE_LAST_WRITE_TIME).get<std::int64_t>();
+                entry.cachedLastWriteTime = entryObject.at(NODE_CACHED_LAST_WRITE_TIME).get<std::int64_t>();
+                entry.isHardLink = entryObject.at(NODE_IS_HARD_LINK).get<bool>();
+                entry.lastUsed = entryObject.at(NODE_LAST_USED).get<std::int64_t>();
+                entries.push_back(std::move(entry));
+            }
+        }
+        catch (const std::exception& e)
+        {
+            LOG_ERROR("Failed to parse demo cache index ({})", e.what());
+            entries.clear();
+        }
+
+        return entries;
+    }
+
+    void WriteIndex(const std::filesystem::path& indexPath, const std::vector<CacheEntry>& entries)
+    {
+        using json = nlohmann::json;
+
+        json entryNodes = json::array();
+        for (const auto& entry : entries)
+        {
+            json entryObject;
+            entryObject[NODE_HASH] = entry.hash;
+            entryObject[NODE_FILE_NAME] = entry.fileName;
+            entryObject[NODE_SOURCE_PATH] = entry.sourcePath;
+            entryObject[NODE_FILE_SIZE] = entry.fileSize;
+            entryObject[NODE_SOURCE_LAST_WRITE_TIME] = entry.sourceLastWriteTime;
+            entryObject[NODE_CACHED_LAST_WRITE_TIME] = entry.cachedLastWriteTime;
+            entryObject[NODE_IS_HARD_LINK] = entry.isHardLink;
+            entryObject[NODE_LAST_USED] = entry.lastUsed;
+            entryNodes.push_back(entryObject);
+        }
+
+        json rootNode;
+        rootNode[NODE_ENTRIES] = entryNodes;
+
+        std::ofstream indexFile(indexPath);
+        indexFile << rootNode.dump();
+        indexFile.close();
+    }
+
+    std::filesystem::path GetCachedPath(const std::filesystem::path& tempDirectory, const CacheEntry& entry)
+    {
+        return tempDirectory / entry.hash / entry.fileName;
+    }
+
+    // A hardlinked demo that was modified in place changes along with its source, which shows in its timestamp
+    bool IsEntryIntact(const std::filesystem::path& tempDirectory, const CacheEntry& entry)
+    {
+        std::error_code error;
+        const auto cachedPath = GetCachedPath(tempDirectory, entry);
+        const auto fileSize = std::filesystem::file_size(cachedPath, error);
+        const auto lastWriteTime = std::filesystem::last_write_time(cachedPath, error).time_since_epoch().count();
+        return !error && fileSize == entry.fileSize && lastWriteTime == entry.cachedLastWriteTime;
+    }
+
+    // A hardlink stops sharing its data once the source is deleted, or replaced by a program that saves to a new
+    // file. The cached file then holds the only copy and its source path no longer leads to it.
+    bool IsSourceLinked(const std::filesystem::path& tempDirectory, const CacheEntry& entry)
+    {
+        std::error_code error;
+        const auto sourcePath = std::filesystem::path(std::u8string(entry.sourcePath.begin(), entry.sourcePath.end()));
+        return std::filesystem::equivalent(sourcePath, GetCachedPath(tempDirectory, entry), error) && !error;
+    }
+
+    // Copies always take up space, hardlinks only once nothing else links to the file anymore
+    bool TakesUpSpace(const std::filesystem::path& tempDirectory, const CacheEntry& entry)
+    {
+        if (!entry.isHardLink)
+            return true;
+
+        std::error_code error;
+        const auto linkCount = std::filesystem::hard_link_count(GetCachedPath(tempDirectory, entry), error);
+        return error || linkCount <= 1;
+    }
+
+    bool RemoveEntryFiles(const std::filesystem::path& tempDirectory, const std::string& hash)
+    {
+        // fails while the game still has the demo open, in which case it is retried on the next load
+        std::error_code error;
+        std::filesystem::remove_all(tempDirectory / hash, error);
+        return !error;
+    }
+
+    // Removes broken entries, hardlinks whose source is gone, directories that are not in the index, copies left over
+    // from before the cache existed and finally the least recently used entries that take up space until the cache fits
+    // into `maxCachedBytes`
+    void CleanUp(const std::filesystem::path& tempDirectory, std::vector<CacheEntry>& entries,
+                 const std::string& currentHash, std::uintmax_t maxCachedBytes)
+    {
+        std::erase_if(entries, [&](const CacheEntry& entry) {
+            const bool isOrphanedLink =
+                entry.isHardLink && entry.hash != currentHash && !IsSourceLinked(tempDirectory, entry);
+            const bool isStale = !IsEntryIntact(tempDirectory, entry) || isOrphanedLink;
+            return isStale && RemoveEntryFiles(tempDirectory, entry.hash);
+        });
+
+        std::error_code error;
+        std::vector<std::filesystem::directory_entry> children;
+        for (const auto& child : std::filesystem::directory_iterator(tempDirectory, error))
+            children.push_back(child);
+
+        for (const auto& child : children)
+        {
+            const auto name = child.path().filename().string();
+            const bool isIndexed = std::any_of(entries.begin(), entries.end(),
+                                               [&](const CacheEntry& entry) { return entry.hash == name; });
+            if (child.is_directory() && !isIndexed)
+                RemoveEntryFiles(tempDirectory, name);
+            else if (child.is_regular_file() && name != INDEX_FILE_NAME)
+                std::filesystem::remove(child.path(), error);
+        }
+
+        std::sort(entries.begin(), entries.end(),
+                  [](const CacheEntry& a, const CacheEntry& b) { return a.lastUsed > b.lastUsed; });
+
+        std::uintmax_t cachedBytes = 0;
+        std::erase_if(entries, [&](const CacheEntry& entry) {
+            if (!TakesUpSpace(tempDirectory, entry))
+                return false;
+
+            cachedBytes += entry.fileSize;
+            if (cachedBytes <= maxCachedBytes || entry.hash == currentHash)
+                return false;
+
+            LOG_DEBUG("Evicting {} from the demo cache", entry.fileName);
+            return RemoveEntryFiles(tempDirectory, entry.hash);
+        });
+    }
+
+    std::filesystem::path Prepare(const std::filesystem::path& demoPath, const std::filesystem::path& tempDirectory,
+                                  const std::string& fileName, std::uintmax_t maxCachedBytes)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        const auto indexPath = tempDirectory / INDEX_FILE_NAME;
+        const auto sourceKey = GetPathKey(demoPath);
+        const auto fileSize = std::filesystem::file_size(demoPath);
+        const auto sourceLastWriteTime = GetLastWriteTime(demoPath);
+
+        auto entries = ReadIndex(indexPath);
+
+        auto IsUsable = [&](const CacheEntry& entry) {
+            return entry.fileSize == fileSize && entry.fileName == fileName && IsEntryIntact(tempDirectory, entry);
+        };
+
+        // the hash only has to be computed when the source changed since it was last cached
+        auto it = std::find_if(entries.begin(), entries.end(), [&](const CacheEntry& entry) {
+            return entry.sourcePath == sourceKey && entry.sourceLastWriteTime == sourceLastWriteTime && IsUsable(entry);
+        });
+
+        std::string_view method = "reused";
+        if (it == entries.end())
+        {
+            const auto hash = HashDemoFile(demoPath);
+            it = std::find_if(entries.begin(), entries.end(),
+                              [&](const CacheEntry& entry) { return entry.hash == hash && IsUsable(entry); });
+
+            if (it == entries.end())
+            {
+                std::erase_if(entries, [&](const CacheEntry& entry) { return entry.hash == hash; });
+                std::filesystem::remove_all(tempDirectory / hash);
+                std::filesystem::create_directories(tempDirectory / hash);
+
+                CacheEntry entry{.hash = hash,
+                                 .fileName = fileName,
+                                 .sourcePath = sourceKey,
+                                 .fileSize = fileSize,
+                                 .sourceLastWriteTime = sourceLastWriteTime,
+                                 .cachedLastWriteTime = 0,
+                                 .isHardLink = false,
+                                 .lastUsed = 0};
+                const auto cachedPath = GetCachedPath(tempDirectory, entry);
+
+                std::error_code linkError;
+                std::filesystem::create_hard_link(demoPath, cachedPath, linkError);
+                entry.isHardLink = !linkError;
+                if (!entry.isHardLink)
+                    std::filesystem::copy_file(demoPath, cachedPath);
+
+                entry.cachedLastWriteTime = GetLastWriteTime(cachedPath);
+                method = entry.isHardLink ? "linked" : "copied";
+
+                entries.push_back(std::move(entry));
+                it = std::prev(entries.end());
+            }
+
+            it->sourcePath = sourceKey;
+            it->sourceLastWriteTime = sourceLastWriteTime;
+        }
+
+        it->lastUsed = std::chrono::system_clock::now().time_since_epoch().count();
+        const auto hash = it->hash;
+        const auto cachedPath = GetCachedPath(tempDirectory, *it);
+
+        CleanUp(tempDirectory, entries, hash, maxCachedBytes);
+        WriteIndex(indexPath, entries);
+
+        LOG_DEBUG("Prepared demo {} ({}) in {} ms", fileName, method,
+                  std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start)
+                      .count());
+
+        return cachedPath;
+    }
+}  // namespace IWXMVM::DemoTempCache
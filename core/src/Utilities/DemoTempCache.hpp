@@ -0,0 +1,14 @@
+#pragma once
+
+namespace IWXMVM::DemoTempCache
+{
+    // Upper bound for the size of the demos in the cache. Hardlinked demos are only counted once the cache holds the
+    // last link to them, i.e. when their source was deleted or replaced.
+    constexpr std::uintmax_t MAX_CACHED_BYTES = 2ull * 1024 * 1024 * 1024;
+
+    // Makes a demo available inside `tempDirectory` and returns the path of the cached file. Demos are stored in a
+    // directory named after their content hash, so an unchanged demo is never copied twice. New demos are hardlinked
+    // where the filesystem allows it and copied otherwise. Throws std::filesystem::filesystem_error on failure.
+    std::filesystem::path Prepare(const std::filesystem::path& demoPath, const std::filesystem::path& tempDirectory,
+                                  const std::string& fileName, std::uintmax_t maxCachedBytes = MAX_CACHED_BYTES);
+}  // namespace IWXMVM::DemoTempCache
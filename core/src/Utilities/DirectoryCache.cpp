@@ -0,0 +1,136 @@
+#include "StdInclude.hpp"
+#include "DirectoryCache.hpp"
+
+namespace IWXMVM
+{
+    // Sorts names case-insensitively, comparing runs of digits by their numeric value ("demo2" < "demo10"). Each
+    // name is tokenized once, so the sort itself does not have to parse any numbers.
+    struct NaturalSortKey
+    {
+        using Character = std::filesystem::path::value_type;
+
+        struct Token
+        {
+            wint_t character;      // Uppercased character, or the first digit of a number
+            std::uint64_t number;  // Value of the digit run this token stands for, if the character is a digit
+        };
+
+        std::vector<Token> tokens;
+
+        explicit NaturalSortKey(std::basic_string_view<Character> name)
+        {
+            tokens.reserve(name.length());
+            for (std::size_t i = 0; i < name.length();)
+            {
+                if (!std::iswdigit(name[i]))
+                {
+                    tokens.push_back({std::towupper(name[i]), 0});
+                    i++;
+                    continue;
+                }
+
+                std::uint64_t number = 0;
+                const auto first = name[i];
+                for (; i < name.length() && std::iswdigit(name[i]); i++)
+                {
+                    const auto digit = static_cast<std::uint64_t>(name[i] - '0');
+                    number = number > (std::numeric_limits<std::uint64_t>::max() - digit) / 10
+                                 ? std::numeric_limits<std::uint64_t>::max()
+                                 : number * 10 + digit;
+                }
+                tokens.push_back({static_cast<wint_t>(first), number});
+            }
+        }
+
+        bool operator<(const NaturalSortKey& other) const
+        {
+            return std::lexicographical_compare(
+                tokens.begin(), tokens.end(), other.tokens.begin(), other.tokens.end(),
+                [](const Token& lhs, const Token& rhs) {
+                    if (std::iswdigit(lhs.character) && std::iswdigit(rhs.character))
+                        return lhs.number < rhs.number;
+                    return lhs.character < rhs.character;
+                });
+        }
+    };
+
+    void SortNaturally(std::vector<std::filesystem::path>& paths, auto GetName)
+    {
+        std::vector<std::pair<NaturalSortKey, std::filesystem::path>> keyedPaths;
+        keyedPaths.reserve(paths.size());
+        for (auto& path : paths)
+        {
+            auto key = NaturalSortKey(GetName(path));
+            keyedPaths.emplace_back(std::move(key), std::move(path));
+        }
+
+        std::sort(keyedPaths.begin(), keyedPaths.end(),
+                  [](const auto& lhs, const auto& rhs) { return lhs.first < rhs.first; });
+
+        for (std::size_t i = 0; i < paths.size(); i++)
+        {
+            paths[i] = std::move(keyedPaths[i].second);
+        }
+    }
+
+    DirectoryCache::DirectoryCache(FileFilter isListedFile, SortNameGetter getSortName)
+        : isListedFile(std::move(isListedFile)), getSortName(std::move(getSortName))
+    {
+    }
+
+    void DirectoryCache::BeginWalk()
+    {
+        visitedDirectories.clear();
+    }
+
+    void DirectoryCache::EndWalk()
+    {
+        // forget directories that were removed or are no longer below the walked paths
+        std::erase_if(listings, [&](const auto& entry) { return !visitedDirectories.contains(entry.first); });
+    }
+
+    const DirectoryCache::Listing& DirectoryCache::List(const std::filesystem::path& path)
+    {
+        visitedDirectories.insert(path.native());
+
+        std::error_code error;
+        const auto lastWriteTime = std::filesystem::last_write_time(path, error);
+        if (!error)
+        {
+            const auto it = listings.find(path.native());
+            if (it != listings.end() && it->second.lastWriteTime == lastWriteTime)
+                return it->second;
+        }
+
+        Listing listing = {.lastWriteTime = lastWriteTime};
+        bool isComplete = !error;
+
+        for (const auto& entry : std::filesystem::directory_iterator(path, error))
+        {
+            if (entry.is_directory(error))
+            {
+                listing.subdirectories.push_back(entry.path());
+            }
+            else if (isListedFile(entry.path()))
+            {
+                listing.files.push_back(entry.path());
+            }
+        }
+        isComplete = isComplete && !error;
+
+        SortNaturally(listing.files, getSortName);
+        SortNaturally(listing.subdirectories,
+                      [](const std::filesystem::path& dir) { return dir.filename().native(); });
+
+        // a listing that could not be read completely, or whose modification time is unknown, cannot be validated
+        // later, so it is only handed to the caller and read again by the next walk
+        if (!isComplete)
+        {
+            listings.erase(path.native());
+            uncachedListing = std::move(listing);
+            return uncachedListing;
+        }
+
+        return listings[path.native()] = std::move(listing);
+    }
+}  // namespace IWXMVM
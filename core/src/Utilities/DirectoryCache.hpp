@@ -0,0 +1,45 @@
+#pragma once
+
+namespace IWXMVM
+{
+    // Remembers the listings of a directory tree, so walking it again only reads the directories that changed. A
+    // directory's modification time changes whenever an entry is added, removed or renamed in it, so a listing is
+    // reused as long as that time is unchanged. Listings are sorted naturally, comparing runs of digits by their value.
+    class DirectoryCache
+    {
+       public:
+        struct Listing
+        {
+            std::filesystem::file_time_type lastWriteTime;
+            std::vector<std::filesystem::path> subdirectories;  // Naturally sorted by name
+            std::vector<std::filesystem::path> files;           // Naturally sorted by their sort name
+        };
+
+        using FileFilter = std::function<bool(const std::filesystem::path&)>;
+        using SortNameGetter = std::function<std::filesystem::path::string_type(const std::filesystem::path&)>;
+
+        // Only files accepted by `isListedFile` are listed, and they are sorted by what `getSortName` returns for them
+        DirectoryCache(FileFilter isListedFile, SortNameGetter getSortName);
+
+        // Starts a walk over the tree. Listings of directories that are not listed again until the walk ends are
+        // forgotten, so a cancelled walk must not be ended.
+        void BeginWalk();
+        void EndWalk();
+
+        // The returned listing is valid until the next call
+        const Listing& List(const std::filesystem::path& path);
+
+        std::size_t GetCachedCount() const
+        {
+            return listings.size();
+        }
+
+       private:
+        FileFilter isListedFile;
+        SortNameGetter getSortName;
+
+        std::unordered_map<std::filesystem::path::string_type, Listing> listings;
+        Listing uncachedListing;  // Listing of the last directory that could not be read completely
+        std::unordered_set<std::filesystem::path::string_type> visitedDirectories;
+    };
+}  // namespace IWXMVM
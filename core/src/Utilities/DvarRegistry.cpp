@@ -0,0 +1,50 @@
+#include "StdInclude.hpp"
+#include "DvarRegistry.hpp"
+
+#include "Mod.hpp"
+#include "Events.hpp"
+
+namespace IWXMVM::DvarRegistry
+{
+    std::uint64_t lookupCount = 0;
+
+    // Handles are globals in other translation units, so the list must exist before the first one is constructed
+    std::vector<DvarHandle*>& GetHandles()
+    {
+        static std::vector<DvarHandle*> handles;
+        return handles;
+    }
+
+    DvarHandle::DvarHandle(std::string_view name) : name(name)
+    {
+        GetHandles().push_back(this);
+    }
+
+    void Resolve()
+    {
+        std::size_t resolvedCount = 0;
+        for (auto* handle : GetHandles())
+        {
+            handle->dvar = Mod::GetGameInterface()->GetDvar(handle->name);
+            lookupCount++;
+
+            if (handle->dvar.has_value())
+                resolvedCount++;
+        }
+
+        LOG_DEBUG("Resolved {} of {} dvars", resolvedCount, GetHandles().size());
+    }
+
+    void Initialize()
+    {
+        Resolve();
+
+        // cgame dvars are only registered once a map is loaded, so this has to run before any other listener
+        Events::RegisterListener(EventType::PostDemoLoad, Resolve, std::numeric_limits<std::int32_t>::min());
+    }
+
+    std::uint64_t GetLookupCount()
+    {
+        return lookupCount;
+    }
+}  // namespace IWXMVM::DvarRegistry
@@ -0,0 +1,104 @@
+#pragma once
+#include "Types/Dvar.hpp"
+
+namespace IWXMVM::DvarRegistry
+{
+    // A dvar that is looked up once instead of by name on every access. Handles must have static storage duration,
+    // as they register themselves and are resolved together.
+    class DvarHandle
+    {
+       public:
+        explicit DvarHandle(std::string_view name);
+
+        DvarHandle(const DvarHandle&) = delete;
+        DvarHandle& operator=(const DvarHandle&) = delete;
+
+        std::string_view GetName() const
+        {
+            return name;
+        }
+
+        // False if the game had not registered the dvar when handles were last resolved
+        bool IsResolved() const
+        {
+            return dvar.has_value();
+        }
+
+        // Makes the game reapply the value, for dvars it only reads when they were changed
+        void MarkModified() const
+        {
+            if (dvar.has_value() && dvar->modified)
+                *dvar->modified = true;
+        }
+
+       protected:
+        std::string_view name;
+        std::optional<Types::Dvar> dvar;
+
+        friend void Resolve();
+    };
+
+    template <typename T>
+    class Dvar : public DvarHandle
+    {
+       public:
+        using DvarHandle::DvarHandle;
+
+        // Returns the fallback if the dvar is not resolved
+        T Get(T fallback = {}) const
+        {
+            if (!dvar.has_value())
+                return fallback;
+
+            const auto& value = *dvar->value;
+            if constexpr (std::is_same_v<T, bool>)
+                return value.enabled;
+            else if constexpr (std::is_same_v<T, float>)
+                return value.floating_point;
+            else if constexpr (std::is_same_v<T, std::int32_t>)
+                return value.int32;
+            else if constexpr (std::is_same_v<T, std::uint32_t>)
+                return value.uint32;
+            else if constexpr (std::is_same_v<T, const char*>)
+                return value.string;
+            else if constexpr (std::is_same_v<T, glm::vec3>)
+                return glm::make_vec3(value.vector);
+            else if constexpr (std::is_same_v<T, glm::vec4>)
+                return glm::make_vec4(value.vector);
+            else
+                static_assert(sizeof(T) == 0, "Unsupported dvar type");
+        }
+
+        // Does nothing if the dvar is not resolved
+        void Set(T newValue) const
+        {
+            if (!dvar.has_value())
+                return;
+
+            auto& value = *dvar->value;
+            if constexpr (std::is_same_v<T, bool>)
+                value.enabled = newValue;
+            else if constexpr (std::is_same_v<T, float>)
+                value.floating_point = newValue;
+            else if constexpr (std::is_same_v<T, std::int32_t>)
+                value.int32 = newValue;
+            else if constexpr (std::is_same_v<T, std::uint32_t>)
+                value.uint32 = newValue;
+            else if constexpr (std::is_same_v<T, const char*>)
+                value.string = newValue;
+            else if constexpr (std::is_same_v<T, glm::vec3> || std::is_same_v<T, glm::vec4>)
+                std::copy_n(glm::value_ptr(newValue), T::length(), value.vector);
+            else
+                static_assert(sizeof(T) == 0, "Unsupported dvar type");
+        }
+    };
+
+    // Resolves all handles, and again whenever a map is loaded or the renderer is restarted
+    void Initialize();
+
+    // Looks up all handles by name, dvars the game has not registered yet stay unresolved until the next time
+    void Resolve();
+
+    // Number of lookups by name made for handles so far
+    std::uint64_t GetLookupCount();
+}  // namespace IWXMVM::DvarRegistry
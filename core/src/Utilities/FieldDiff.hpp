@@ -0,0 +1,94 @@
+#pragma once
+
+namespace IWXMVM::FieldDiff
+{
+    // Bit i is set if the i-th member listed in Fields<T>::members changed
+    using FieldMask = std::uint32_t;
+    constexpr FieldMask ALL_FIELDS = ~FieldMask{0};
+
+    // Float differences up to this are not considered a change
+    constexpr float EPSILON = 1e-4f;
+
+    // Specialize with `static constexpr auto members = std::make_tuple(&T::a, &T::b, ...);`
+    template <typename T>
+    struct Fields;
+
+    template <typename T>
+    struct MemberClass;
+
+    template <typename C, typename V>
+    struct MemberClass<V C::*>
+    {
+        using type = C;
+    };
+
+    template <typename V>
+    bool IsValueChanged(const V& previous, const V& current)
+    {
+        if constexpr (std::is_floating_point_v<V>)
+            return std::abs(previous - current) > EPSILON;
+        else if constexpr (std::is_same_v<V, glm::vec3>)
+            return glm::any(glm::greaterThan(glm::abs(previous - current), glm::vec3(EPSILON)));
+        else
+            return previous != current;
+    }
+
+    template <typename T>
+    FieldMask GetChangedFields(const T& previous, const T& current)
+    {
+        static_assert(std::tuple_size_v<decltype(Fields<T>::members)> <= sizeof(FieldMask) * 8);
+
+        return std::apply(
+            [&](const auto... members) {
+                FieldMask mask = 0;
+                FieldMask bit = 1;
+                ((mask |= IsValueChanged(previous.*members, current.*members) ? bit : 0, bit <<= 1), ...);
+                return mask;
+            },
+            Fields<T>::members);
+    }
+
+    // Copies only the fields set in the mask
+    template <typename T>
+    void CopyFields(T& destination, const T& source, FieldMask mask)
+    {
+        std::apply(
+            [&](const auto... members) {
+                FieldMask bit = 1;
+                (((mask & bit) ? void(destination.*members = source.*members) : void(), bit <<= 1), ...);
+            },
+            Fields<T>::members);
+    }
+
+    template <auto member>
+    constexpr FieldMask GetFieldBit()
+    {
+        using T = typename MemberClass<decltype(member)>::type;
+
+        const auto bit = std::apply(
+            [](const auto... members) {
+                FieldMask result = 0;
+                FieldMask bit = 1;
+                (
+                    [&](auto other) {
+                        if constexpr (std::is_same_v<decltype(member), decltype(other)>)
+                            result |= (member == other) ? bit : 0;
+                        bit <<= 1;
+                    }(members),
+                    ...);
+                return result;
+            },
+            Fields<T>::members);
+
+        return bit;
+    }
+
+    // e.g. IsFieldChanged<&Types::Sun::color>(mask)
+    template <auto member>
+    bool IsFieldChanged(FieldMask mask)
+    {
+        constexpr auto bit = GetFieldBit<member>();
+        static_assert(bit != 0, "Member is not listed in Fields<T>::members");
+        return (mask & bit) != 0;
+    }
+}  // namespace IWXMVM::FieldDiff
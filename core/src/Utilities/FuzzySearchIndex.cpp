@@ -0,0 +1,256 @@
+#include "StdInclude.hpp"
+#include "FuzzySearchIndex.hpp"
+
+namespace IWXMVM
+{
+    std::string NormalizeSearchText(std::string_view text)
+    {
+        std::string normalized(text);
+        std::transform(normalized.begin(), normalized.end(), normalized.begin(), [](char c) {
+            return (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+        });
+        return normalized;
+    }
+
+    uint32_t GetNgram(std::string_view text, std::size_t offset, std::size_t length)
+    {
+        // the length goes into the otherwise unused top byte, so n-grams of different lengths never collide
+        uint32_t ngram = static_cast<uint32_t>(length) << 24;
+        for (std::size_t i = 0; i < length; i++)
+        {
+            ngram |= static_cast<uint32_t>(static_cast<uint8_t>(text[offset + i])) << (i * 8);
+        }
+        return ngram;
+    }
+
+    void GetUniqueNgrams(std::string_view text, std::size_t length, std::vector<uint32_t>& ngrams)
+    {
+        ngrams.clear();
+        for (std::size_t i = 0; i + length <= text.length(); i++)
+        {
+            ngrams.push_back(GetNgram(text, i, length));
+        }
+
+        std::sort(ngrams.begin(), ngrams.end());
+        ngrams.erase(std::unique(ngrams.begin(), ngrams.end()), ngrams.end());
+    }
+
+    bool IsWordStart(std::string_view text, std::size_t position)
+    {
+        return position == 0 || !std::isalnum(static_cast<uint8_t>(text[position - 1]));
+    }
+
+    // Like GetUniqueNgrams, but flags every n-gram whose first occurrence starts a word
+    void GetUniqueNgramPostings(std::string_view text, std::size_t length, std::vector<uint64_t>& ngrams)
+    {
+        // the position goes into the low bits, so sorting puts the first occurrence of every n-gram first
+        ngrams.clear();
+        for (std::size_t i = 0; i + length <= text.length(); i++)
+        {
+            ngrams.push_back(static_cast<uint64_t>(GetNgram(text, i, length)) << 32 | i);
+        }
+
+        std::sort(ngrams.begin(), ngrams.end());
+        ngrams.erase(std::unique(ngrams.begin(), ngrams.end(), [](auto a, auto b) { return a >> 32 == b >> 32; }),
+                     ngrams.end());
+
+        for (auto& ngram : ngrams)
+        {
+            const auto position = static_cast<std::size_t>(ngram & 0xFFFFFFFF);
+            ngram = (ngram >> 32) << 32 | (IsWordStart(text, position) ? 1 : 0);
+        }
+    }
+
+    std::size_t FuzzySearchIndex::GetShortPostingIndex(uint32_t ngram)
+    {
+        // unigrams come first, followed by bigrams
+        return (ngram >> 24) == 1 ? (ngram & 0xFF) : 256 + (ngram & 0xFFFF);
+    }
+
+    const std::vector<uint32_t>* FuzzySearchIndex::FindPostings(uint32_t ngram) const
+    {
+        if ((ngram >> 24) < MAX_NGRAM_LENGTH)
+            return &shortPostings[GetShortPostingIndex(ngram)];
+
+        const auto it = trigramPostings.find(ngram);
+        return it != trigramPostings.end() ? &it->second : nullptr;
+    }
+
+    void FuzzySearchIndex::Build(const std::vector<std::string>& newDocuments)
+    {
+        documents.clear();
+        shortPostings.assign(SHORT_POSTING_COUNT, {});
+        trigramPostings.clear();
+        documents.reserve(newDocuments.size());
+
+        std::vector<uint64_t> ngrams;
+        for (uint32_t i = 0; i < newDocuments.size(); i++)
+        {
+            documents.push_back(NormalizeSearchText(newDocuments[i]));
+            for (std::size_t length = 1; length <= MAX_NGRAM_LENGTH; length++)
+            {
+                GetUniqueNgramPostings(documents.back(), length, ngrams);
+                for (const auto entry : ngrams)
+                {
+                    const auto ngram = static_cast<uint32_t>(entry >> 32);
+                    const auto posting = (entry & 1) ? (i | WORD_START_POSTING) : i;
+                    if (length < MAX_NGRAM_LENGTH)
+                        shortPostings[GetShortPostingIndex(ngram)].push_back(posting);
+                    else
+                        trigramPostings[ngram].push_back(posting);
+                }
+            }
+        }
+    }
+
+    std::vector<FuzzySearchIndex::Match> FuzzySearchIndex::Query(std::string_view query) const
+    {
+        std::vector<std::string_view> words;
+        const auto normalizedQuery = NormalizeSearchText(query);
+        for (std::size_t start = 0; start < normalizedQuery.length();)
+        {
+            const auto end = std::min(normalizedQuery.find(' ', start), normalizedQuery.length());
+            if (end > start)
+                words.push_back(std::string_view(normalizedQuery).substr(start, end - start));
+            start = end + 1;
+        }
+
+        // an index that was never built has no posting lists to look n-grams up in
+        std::vector<Match> matches;
+        if (words.empty() || documents.empty())
+            return matches;
+
+        // long words go first, since their posting lists narrow the candidates down the most
+        std::stable_sort(words.begin(), words.end(),
+                         [](const auto& a, const auto& b) { return a.length() > b.length(); });
+
+        // a document can only contain the word if it contains every n-gram of it, so the substring search is skipped
+        // for all other candidates
+        auto ScoreWord = [&](std::string_view word, uint32_t document, float ngramFraction) {
+            const auto position = ngramFraction < 1.0f ? std::string::npos : documents[document].find(word);
+            if (position == std::string::npos)
+            {
+                const bool isFuzzy = word.length() >= MAX_NGRAM_LENGTH && ngramFraction >= FUZZY_MATCH_THRESHOLD;
+                return isFuzzy ? ngramFraction : 0.0f;
+            }
+
+            // exact occurrences beat fuzzy ones, and occurrences at the start of a word beat those in the middle
+            return IsWordStart(documents[document], position) ? 2.0f : 1.5f;
+        };
+
+        std::vector<uint32_t> candidates;
+        std::vector<float> scores;
+        std::vector<uint16_t> ngramCounts;
+
+        for (std::size_t w = 0; w < words.size(); w++)
+        {
+            const auto word = words[w];
+            std::vector<uint32_t> ngrams;
+            GetUniqueNgrams(word, std::min(word.length(), MAX_NGRAM_LENGTH), ngrams);
+
+            // a word of up to three characters is its own n-gram, so its posting list holds exactly the documents
+            // that contain it, along with whether they contain it at the start of a word
+            if (word.length() <= MAX_NGRAM_LENGTH)
+            {
+                const auto* postings = FindPostings(ngrams.front());
+                if (!postings)
+                    return matches;
+
+                auto GetScore = [](uint32_t posting) { return (posting & WORD_START_POSTING) ? 2.0f : 1.5f; };
+
+                if (w == 0)
+                {
+                    candidates.reserve(postings->size());
+                    scores.reserve(postings->size());
+                    for (const auto posting : *postings)
+                    {
+                        candidates.push_back(posting & ~WORD_START_POSTING);
+                        scores.push_back(GetScore(posting));
+                    }
+                    continue;
+                }
+
+                // candidates and postings are both sorted by document
+                std::size_t kept = 0;
+                auto posting = postings->begin();
+                for (std::size_t c = 0; c < candidates.size(); c++)
+                {
+                    while (posting != postings->end() && (*posting & ~WORD_START_POSTING) < candidates[c])
+                        ++posting;
+                    if (posting == postings->end())
+                        break;
+                    if ((*posting & ~WORD_START_POSTING) != candidates[c])
+                        continue;
+
+                    candidates[kept] = candidates[c];
+                    scores[kept] = scores[c] + GetScore(*posting);
+                    kept++;
+                }
+                candidates.resize(kept);
+                scores.resize(kept);
+
+                if (candidates.empty())
+                    break;
+                continue;
+            }
+
+            // a longer word needs at least this many of its trigrams in a document to match it fuzzily
+            std::size_t minNgramCount = 1;
+            while (static_cast<float>(minNgramCount) / ngrams.size() < FUZZY_MATCH_THRESHOLD)
+                minNgramCount++;
+
+            auto CountNgrams = [&](auto OnDocument) {
+                for (const auto ngram : ngrams)
+                {
+                    if (const auto* documentList = FindPostings(ngram))
+                    {
+                        for (const auto posting : *documentList)
+                            OnDocument(posting & ~WORD_START_POSTING);
+                    }
+                }
+            };
+
+            // the first word selects the candidates, the remaining ones can only narrow them down. Documents that do
+            // not share enough trigrams with the first word never become candidates.
+            if (ngramCounts.empty())
+                ngramCounts.assign(documents.size(), 0);
+            CountNgrams([&](uint32_t document) {
+                if (++ngramCounts[document] == minNgramCount && w == 0)
+                    candidates.push_back(document);
+            });
+
+            if (w == 0)
+            {
+                std::sort(candidates.begin(), candidates.end());
+                scores.resize(candidates.size(), 0.0f);
+            }
+
+            std::size_t kept = 0;
+            for (std::size_t c = 0; c < candidates.size(); c++)
+            {
+                const auto ngramFraction = static_cast<float>(ngramCounts[candidates[c]]) / ngrams.size();
+                if (const auto score = ScoreWord(word, candidates[c], ngramFraction); score > 0.0f)
+                {
+                    candidates[kept] = candidates[c];
+                    scores[kept] = scores[c] + score;
+                    kept++;
+                }
+            }
+            candidates.resize(kept);
+            scores.resize(kept);
+
+            CountNgrams([&](uint32_t document) { ngramCounts[document] = 0; });
+
+            if (candidates.empty())
+                break;
+        }
+
+        matches.reserve(candidates.size());
+        for (std::size_t c = 0; c < candidates.size(); c++)
+        {
+            matches.push_back({candidates[c], scores[c]});
+        }
+
+        return matches;
+    }
+}  // namespace IWXMVM
@@ -0,0 +1,50 @@
+#pragma once
+
+namespace IWXMVM
+{
+    // Ranked fuzzy search over a fixed set of short strings, such as demo file names. Every document is normalized to
+    // lowercase once and indexed by its n-grams of up to three characters, so a query only touches the documents that
+    // share n-grams with it, even when a word is shorter than three characters.
+    class FuzzySearchIndex
+    {
+       public:
+        struct Match
+        {
+            uint32_t document;
+            float score;
+        };
+
+        // A query word of at least three characters also matches documents that contain this fraction of its
+        // trigrams, which tolerates small typos in longer words
+        static constexpr float FUZZY_MATCH_THRESHOLD = 0.6f;
+
+        static constexpr std::size_t MAX_NGRAM_LENGTH = 3;
+
+        void Build(const std::vector<std::string>& documents);
+
+        // Returns the documents matching every space-separated word of the query, in the order they were indexed in
+        // and not by score. Higher scores are better matches. The demo loader keeps its directory order and only looks
+        // up the score of each demo, and ranking every match of a one letter query would cost more than finding them.
+        std::vector<Match> Query(std::string_view query) const;
+
+        std::size_t GetDocumentCount() const
+        {
+            return documents.size();
+        }
+
+       private:
+        // Unigrams and bigrams are few enough to be indexed directly, which keeps them out of the hash map
+        static constexpr std::size_t SHORT_POSTING_COUNT = 256 + 256 * 256;
+
+        static std::size_t GetShortPostingIndex(uint32_t ngram);
+        const std::vector<uint32_t>* FindPostings(uint32_t ngram) const;
+
+        // Posting lists hold the sorted indices of the documents containing an n-gram. Postings of documents whose
+        // first occurrence of the n-gram starts a word are flagged with this bit.
+        static constexpr uint32_t WORD_START_POSTING = 1u << 31;
+
+        std::vector<std::string> documents;
+        std::vector<std::vector<uint32_t>> shortPostings;
+        std::unordered_map<uint32_t, std::vector<uint32_t>> trigramPostings;
+    };
+}  // namespace IWXMVM
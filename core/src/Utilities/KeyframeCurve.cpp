@@ -0,0 +1,155 @@
+#include "StdInclude.hpp"
+#include "KeyframeCurve.hpp"
+
+namespace IWXMVM::MathUtils
+{
+    // Cubic segments fall back to linear interpolation on tracks with less nodes than this
+    constexpr std::size_t MIN_CUBIC_KEYFRAMES = 4;
+
+    float EaseSegmentProgress(Types::InterpolationMode interpolation, const glm::vec4& bezierHandles, float t)
+    {
+        if (interpolation == Types::InterpolationMode::EaseInOut)
+            return t * t * (3.0f - 2.0f * t);
+
+        // cubic bezier timing curve through (0, 0), (x1, y1), (x2, y2), (1, 1); solve x(u) = t, then return y(u)
+        auto Bezier = [](float p1, float p2, float u) {
+            const auto v = 1.0f - u;
+            return 3.0f * v * v * u * p1 + 3.0f * v * u * u * p2 + u * u * u;
+        };
+        auto BezierDerivative = [](float p1, float p2, float u) {
+            const auto v = 1.0f - u;
+            return 3.0f * v * v * p1 + 6.0f * v * u * (p2 - p1) + 3.0f * u * u * (1.0f - p2);
+        };
+
+        auto u = t;
+        for (int32_t i = 0; i < 8; i++)
+        {
+            const auto derivative = BezierDerivative(bezierHandles.x, bezierHandles.z, u);
+            if (std::abs(derivative) < 1e-6f)
+                break;
+            u = glm::clamp(u - (Bezier(bezierHandles.x, bezierHandles.z, u) - t) / derivative, 0.0f, 1.0f);
+        }
+        return Bezier(bezierHandles.y, bezierHandles.w, u);
+    }
+
+    template <Types::KeyframeValueType ValueType>
+    constexpr uint32_t GetValueCount()
+    {
+        if constexpr (ValueType == Types::KeyframeValueType::FloatingPoint)
+            return 1;
+        else if constexpr (ValueType == Types::KeyframeValueType::Vector3)
+            return 3;
+        else
+            return 7;
+    }
+
+    void KeyframeCurve::Build(const Types::KeyframeableProperty& property,
+                              const std::vector<Types::Keyframe>& keyframes)
+    {
+        valueType = property.valueType;
+        this->keyframes = keyframes;
+        std::stable_sort(this->keyframes.begin(), this->keyframes.end(),
+                         [](const auto& a, const auto& b) { return a.tick < b.tick; });
+
+        splines.clear();
+        rotationSpline = {};
+
+        if (this->keyframes.size() >= MIN_CUBIC_KEYFRAMES)
+        {
+            const auto valueCount = static_cast<uint32_t>(property.GetValueCount());
+            splines.resize(valueCount);
+            for (uint32_t i = 0; i < valueCount; i++)
+            {
+                // pitch, yaw and roll are interpolated on the unit sphere
+                if (valueType == Types::KeyframeValueType::CameraData && i >= 3 && i <= 5)
+                    continue;
+
+                splines[i].Build(this->keyframes, i);
+            }
+        }
+
+        if (valueType == Types::KeyframeValueType::CameraData)
+            rotationSpline.Build(this->keyframes);
+    }
+
+    template <Types::InterpolationMode Mode, Types::KeyframeValueType ValueType>
+    Types::KeyframeValue KeyframeCurve::EvaluateSegment(std::size_t index, const float tick) const
+    {
+        const auto& p0 = keyframes[index];
+        const auto& p1 = keyframes[index + 1];
+
+        if constexpr (Mode == Types::InterpolationMode::Step)
+        {
+            return p0.value;
+        }
+        else
+        {
+            auto t = (tick - p0.tick) / static_cast<float>(p1.tick - p0.tick);
+            if constexpr (Mode == Types::InterpolationMode::Bezier || Mode == Types::InterpolationMode::EaseInOut)
+                t = EaseSegmentProgress(Mode, p0.bezierHandles, t);
+
+            const auto segmentTick = glm::mix(static_cast<float>(p0.tick), static_cast<float>(p1.tick), t);
+            const bool cubic = Mode == Types::InterpolationMode::Cubic && !splines.empty();
+
+            auto EvaluateChannel = [&](uint32_t valueIndex) {
+                if (cubic)
+                    return splines[valueIndex].EvaluateSegment(index, segmentTick);
+                return glm::mix(p0.value.GetByIndex(valueIndex), p1.value.GetByIndex(valueIndex), t);
+            };
+
+            Types::KeyframeValue result;
+            if constexpr (ValueType == Types::KeyframeValueType::CameraData)
+            {
+                result.cameraData.position = glm::vec3(EvaluateChannel(0), EvaluateChannel(1), EvaluateChannel(2));
+                result.cameraData.rotation = rotationSpline.Evaluate(segmentTick, cubic);
+                result.cameraData.fov = EvaluateChannel(6);
+            }
+            else
+            {
+                for (uint32_t i = 0; i < GetValueCount<ValueType>(); i++)
+                {
+                    result.SetByIndex(i, EvaluateChannel(i));
+                }
+            }
+            return result;
+        }
+    }
+
+    template <Types::InterpolationMode Mode>
+    constexpr KeyframeCurve::SegmentEvaluators KeyframeCurve::MakeSegmentEvaluators()
+    {
+        return {
+            &KeyframeCurve::EvaluateSegment<Mode, Types::KeyframeValueType::FloatingPoint>,
+            &KeyframeCurve::EvaluateSegment<Mode, Types::KeyframeValueType::Vector3>,
+            &KeyframeCurve::EvaluateSegment<Mode, Types::KeyframeValueType::CameraData>,
+        };
+    }
+
+    const std::array<KeyframeCurve::SegmentEvaluators, static_cast<std::size_t>(Types::InterpolationMode::Count)>
+        KeyframeCurve::segmentEvaluators = {
+            MakeSegmentEvaluators<Types::InterpolationMode::Step>(),
+            MakeSegmentEvaluators<Types::InterpolationMode::Linear>(),
+            MakeSegmentEvaluators<Types::InterpolationMode::Cubic>(),
+            MakeSegmentEvaluators<Types::InterpolationMode::Bezier>(),
+            MakeSegmentEvaluators<Types::InterpolationMode::EaseInOut>(),
+    };
+
+    Types::KeyframeValue KeyframeCurve::Evaluate(float tick) const
+    {
+        if (keyframes.empty())
+            return Types::KeyframeValue::GetDefaultValue(valueType);
+
+        if (tick <= keyframes.front().tick)
+            return keyframes.front().value;
+        if (tick >= keyframes.back().tick)
+            return keyframes.back().value;
+
+        const auto it = std::upper_bound(keyframes.begin(), keyframes.end(), tick,
+                                         [](float tick, const auto& keyframe) { return tick < keyframe.tick; });
+        const auto index = static_cast<std::size_t>(std::distance(keyframes.begin(), it)) - 1;
+
+        const auto evaluator = segmentEvaluators[static_cast<std::size_t>(keyframes[index].interpolation)]
+                                                [static_cast<std::size_t>(valueType)];
+        return (this->*evaluator)(index, tick);
+    }
+}  // namespace IWXMVM::MathUtils
@@ -0,0 +1,54 @@
+#pragma once
+#include "Types/Keyframe.hpp"
+#include "Types/KeyframeableProperty.hpp"
+#include "Utilities/CubicSpline.hpp"
+#include "Utilities/QuaternionSpline.hpp"
+
+namespace IWXMVM::MathUtils
+{
+    // Evaluates a keyframe track with the interpolation mode of each segment. Everything that depends on the whole
+    // track (the cubic splines of each value index and the rotation spline) is built once in Build, after which
+    // Evaluate is const and only reads, so a curve can be evaluated from several threads at once.
+    class KeyframeCurve
+    {
+       public:
+        void Build(const Types::KeyframeableProperty& property, const std::vector<Types::Keyframe>& keyframes);
+
+        // Returns the default value of the value type if the curve has no keyframes
+        Types::KeyframeValue Evaluate(float tick) const;
+
+        const std::vector<Types::Keyframe>& GetKeyframes() const
+        {
+            return keyframes;
+        }
+
+        bool IsEmpty() const
+        {
+            return keyframes.empty();
+        }
+
+       private:
+        // Evaluates the segment from keyframes[index] to keyframes[index + 1]. Instantiated once per interpolation mode
+        // and value type, so evaluation only does a single table lookup instead of switching per channel.
+        template <Types::InterpolationMode Mode, Types::KeyframeValueType ValueType>
+        Types::KeyframeValue EvaluateSegment(std::size_t index, const float tick) const;
+
+        using SegmentEvaluator = Types::KeyframeValue (KeyframeCurve::*)(std::size_t, const float) const;
+        using SegmentEvaluators = std::array<SegmentEvaluator, magic_enum::enum_count<Types::KeyframeValueType>()>;
+
+        template <Types::InterpolationMode Mode>
+        static constexpr SegmentEvaluators MakeSegmentEvaluators();
+
+        // Indexed by [InterpolationMode][KeyframeValueType]
+        static const std::array<SegmentEvaluators, static_cast<std::size_t>(Types::InterpolationMode::Count)>
+            segmentEvaluators;
+
+        Types::KeyframeValueType valueType = Types::KeyframeValueType::FloatingPoint;
+        std::vector<Types::Keyframe> keyframes;
+
+        // One spline per value index, only built for tracks long enough to be interpolated cubically. The rotation of
+        // camera data goes through the quaternion spline instead.
+        std::vector<CubicSpline> splines;
+        QuaternionSpline rotationSpline;
+    };
+}  // namespace IWXMVM::MathUtils
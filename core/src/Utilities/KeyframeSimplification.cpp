@@ -0,0 +1,127 @@
+#include "StdInclude.hpp"
+#include "KeyframeSimplification.hpp"
+
+#include "Utilities/KeyframeCurve.hpp"
+
+namespace IWXMVM::MathUtils
+{
+    std::vector<Types::Keyframe> SimplifyKeyframes(const Types::KeyframeableProperty& property,
+                                                   const std::vector<Types::Keyframe>& keyframes,
+                                                   const std::vector<float>& tolerances, std::vector<float>& maxErrors)
+    {
+        const auto valueCount = static_cast<uint32_t>(property.GetValueCount());
+        const auto n = keyframes.size();
+
+        maxErrors = std::vector<float>(valueCount, 0.0f);
+
+        if (n <= 2 || tolerances.size() < valueCount)
+            return keyframes;
+
+        // The curve is sampled at every keyframe and halfway in between. An error found at a sample is blamed on the
+        // closest keyframe around it that is not part of the fit yet, since adding that one is what pulls the curve
+        // back. With irregular spacing that keyframe can lie several keyframes away from the sample.
+        struct Sample
+        {
+            float tick;
+            std::size_t keyframeIndex;  // The keyframe at or right before the sample
+            Types::KeyframeValue originalValue;
+        };
+
+        KeyframeCurve originalCurve;
+        originalCurve.Build(property, keyframes);
+
+        std::vector<Sample> samples;
+        samples.reserve(n * 2);
+        for (std::size_t i = 0; i < n; i++)
+        {
+            const auto tick = static_cast<float>(keyframes[i].tick);
+            samples.push_back({tick, i, keyframes[i].value});
+
+            if (i + 1 < n)
+            {
+                const auto midTick = (tick + static_cast<float>(keyframes[i + 1].tick)) * 0.5f;
+                samples.push_back({midTick, i, originalCurve.Evaluate(midTick)});
+            }
+        }
+
+        std::vector<bool> selected(n, false);
+        selected.front() = selected.back() = true;
+
+        // nearest unselected keyframe at or before and at or after each index, rebuilt every iteration
+        constexpr auto NONE = std::numeric_limits<std::size_t>::max();
+        std::vector<std::size_t> previousUnselected(n);
+        std::vector<std::size_t> nextUnselected(n);
+
+        // each candidate is built once and then sampled, so an iteration costs O(n log n) regardless of track length
+        std::vector<Types::Keyframe> candidate;
+        KeyframeCurve candidateCurve;
+        while (true)
+        {
+            candidate.clear();
+            for (std::size_t i = 0; i < n; i++)
+            {
+                if (selected[i])
+                    candidate.push_back(keyframes[i]);
+            }
+            candidateCurve.Build(property, candidate);
+
+            // every keyframe is kept, so the curve is the original one
+            if (candidate.size() == n)
+            {
+                std::fill(maxErrors.begin(), maxErrors.end(), 0.0f);
+                break;
+            }
+
+            for (std::size_t i = 0; i < n; i++)
+                previousUnselected[i] = !selected[i] ? i : (i > 0 ? previousUnselected[i - 1] : NONE);
+            for (std::size_t i = n; i-- > 0;)
+                nextUnselected[i] = !selected[i] ? i : (i + 1 < n ? nextUnselected[i + 1] : NONE);
+
+            float worstNormalizedError = 0.0f;
+            std::optional<std::size_t> worstKeyframeIndex;
+            std::fill(maxErrors.begin(), maxErrors.end(), 0.0f);
+
+            for (const auto& sample : samples)
+            {
+                const auto value = candidateCurve.Evaluate(sample.tick);
+
+                float normalizedError = 0.0f;
+                for (uint32_t v = 0; v < valueCount; v++)
+                {
+                    const auto error = std::abs(value.GetByIndex(v) - sample.originalValue.GetByIndex(v));
+                    maxErrors[v] = std::max(maxErrors[v], error);
+                    const auto tolerance = tolerances[v];
+                    if (tolerance > 0.0f)
+                        normalizedError = std::max(normalizedError, error / tolerance);
+                    else if (error > 0.0f)
+                        normalizedError = std::numeric_limits<float>::max();
+                }
+
+                if (normalizedError <= 1.0f || normalizedError <= worstNormalizedError)
+                    continue;
+
+                // a sample halfway between keyframes looks for the next one from the keyframe after it
+                const auto before = previousUnselected[sample.keyframeIndex];
+                const auto afterIndex =
+                    sample.tick > static_cast<float>(keyframes[sample.keyframeIndex].tick) ? sample.keyframeIndex + 1
+                                                                                            : sample.keyframeIndex;
+                const auto after = nextUnselected[afterIndex];
+
+                auto distance = [&](std::size_t index) {
+                    return index == NONE ? std::numeric_limits<float>::max()
+                                         : std::abs(static_cast<float>(keyframes[index].tick) - sample.tick);
+                };
+
+                worstNormalizedError = normalizedError;
+                worstKeyframeIndex = distance(before) <= distance(after) ? before : after;
+            }
+
+            if (!worstKeyframeIndex.has_value())
+                break;
+
+            selected[worstKeyframeIndex.value()] = true;
+        }
+
+        return candidate;
+    }
+}  // namespace IWXMVM::MathUtils
@@ -0,0 +1,15 @@
+#pragma once
+#include "Types/Keyframe.hpp"
+#include "Types/KeyframeableProperty.hpp"
+
+namespace IWXMVM::MathUtils
+{
+    // Picks a subset of `keyframes` whose curve stays within `tolerances` (one per value index) of the original curve at
+    // every keyframe and halfway between neighbouring keyframes. Keyframes are added greedily where the error is
+    // largest, so the subset is small but not necessarily the smallest. `maxErrors` receives the largest
+    // absolute deviation of the result, per value index. Only works on its arguments, so it is safe to call from any
+    // thread.
+    std::vector<Types::Keyframe> SimplifyKeyframes(const Types::KeyframeableProperty& property,
+                                                   const std::vector<Types::Keyframe>& keyframes,
+                                                   const std::vector<float>& tolerances, std::vector<float>& maxErrors);
+}  // namespace IWXMVM::MathUtils
@@ -39,76 +39,4 @@ namespace IWXMVM::MathUtils
 
         return std::make_optional(ImVec2(proj.x, proj.y));
     }
-
-    // Copyright (c) by NUMERICAL RECIPES IN C: THE ART OF SCIENTIFIC COMPUTING (ISBN 0-521-43108-5)
-    // Modified. Thank you to dtugend for finding this!
-    float MathUtils::InterpolateCubicSpline(const std::vector<Types::Keyframe>& keyframes, uint32_t valueIndex, float tick)
-    {
-        const size_t n = keyframes.size();
-        if (n < 2)
-            throw std::exception("Not enough keyframes to interpolate");
-
-        constexpr int32_t MAX_NODES = 256;
-        if (keyframes.size() > MAX_NODES)
-        {
-            LOG_WARN("Exceeded maximum number of keyframes ({})", MAX_NODES);
-            return keyframes.back().value.GetByIndex(valueIndex);
-        }
-
-        float ticks[MAX_NODES];
-        float values[MAX_NODES];
-        for (size_t i = 0; i < n; i++)
-        {
-            ticks[i] = static_cast<float>(keyframes[i].tick);
-            values[i] = keyframes[i].value.GetByIndex(valueIndex);
-        }
-
-        float y2[MAX_NODES];  // second derivatives
-        float u[MAX_NODES];
-
-        y2[0] = -0.5f;
-        u[0] = (3.0f / (ticks[1] - ticks[0])) * ((values[1] - values[0]) / (ticks[1] - ticks[0]));
-
-        for (size_t i = 1; i <= n - 2; i++)
-        {
-            const auto prevTick = ticks[i - 1];
-            const auto prevValue = values[i - 1];
-            const auto currTick = ticks[i];
-            const auto currValue = values[i];
-            const auto nextTick = ticks[i + 1];
-            const auto nextValue = values[i + 1];
-
-            auto sig = (currTick - prevTick) / (nextTick - prevTick);
-            auto p = sig * y2[i - 1] + 2.0f;
-            y2[i] = (sig - 1.0f) / p;
-            u[i] = (nextValue - currValue) / (nextTick - currTick) - (currValue - prevValue) / (currTick - prevTick);
-            u[i] = (6.0f * u[i] / (nextTick - prevTick) - sig * u[i - 1]) / p;
-        }
-
-        auto qn = 0.5f;
-        auto un = (3.0f / (ticks[n - 1] - ticks[n - 2])) *
-                  (0.0f - (values[n - 1] - values[n - 2]) / (ticks[n - 1] - ticks[n - 2]));
-
-        y2[n - 1] = (un - qn * u[n - 2]) / (qn * y2[n - 2] + 1.0f);
-
-        for (int k = n - 2; k >= 0; k--)
-            y2[k] = y2[k] * y2[k + 1] + u[k];
-
-        int klo = 0;
-        int khi = n - 1;
-        while (khi - klo > 1)
-        {
-            int k = (khi + klo) >> 1;
-            if (ticks[k] > tick)
-                khi = k;
-            else
-                klo = k;
-        }
-        auto h = ticks[khi] - ticks[klo];
-        auto a = (ticks[khi] - tick) / h;
-        auto b = (tick - ticks[klo]) / h;
-        return a * values[klo] + b * values[khi] +
-               ((a * a * a - a) * y2[klo] + (b * b * b - b) * y2[khi]) * (h * h) / 6.0f;
-    }
-
 }  // namespace IWXMVM::MathUtils
\ No newline at end of file
@@ -0,0 +1,196 @@
+#include "StdInclude.hpp"
+#include "PatternScanner.hpp"
+
+#include <execution>
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__SSE2__)
+#include <emmintrin.h>
+#define IWXMVM_PATTERN_SCANNER_SSE2
+#endif
+
+namespace IWXMVM
+{
+    // Every n-th byte pair of the image is counted to rank anchors, which is plenty to tell rare pairs from common ones
+    constexpr std::size_t ANCHOR_SAMPLE_STRIDE = 61;
+
+    PatternScanner::PatternScanner(std::vector<Pattern> patterns, std::span<const std::uint8_t> image)
+        : patterns(std::move(patterns))
+    {
+        std::vector<std::uint32_t> pairCounts(ANCHOR_KEY_COUNT, 0);
+        for (std::size_t i = 0; i + 1 < image.size(); i += ANCHOR_SAMPLE_STRIDE)
+            pairCounts[GetAnchorKey(&image[i])]++;
+
+        std::vector<std::pair<std::uint32_t, Anchor>> keyedAnchors;
+        keyedAnchors.reserve(this->patterns.size());
+
+        for (std::size_t i = 0; i < this->patterns.size(); i++)
+        {
+            const auto& pattern = this->patterns[i];
+
+            std::optional<std::pair<std::uint32_t, std::size_t>> best;
+            for (std::size_t j = 0; j + 1 < pattern.size; j++)
+            {
+                if (!pattern.mask[j] || !pattern.mask[j + 1])
+                    continue;
+
+                const auto key = GetAnchorKey(&pattern.bytes[j]);
+                if (!best.has_value() || pairCounts[key] < pairCounts[best->first])
+                    best = std::make_pair(key, j);
+            }
+
+            if (!best.has_value())
+                throw std::invalid_argument("Pattern has no two consecutive non-wildcard bytes.");
+
+            keyedAnchors.emplace_back(best->first,
+                                      Anchor{static_cast<std::uint32_t>(i), static_cast<std::uint32_t>(best->second)});
+        }
+
+        // stable, so patterns sharing an anchor are verified in the order they were given
+        std::stable_sort(keyedAnchors.begin(), keyedAnchors.end(),
+                         [](const auto& a, const auto& b) { return a.first < b.first; });
+
+        anchors.reserve(keyedAnchors.size());
+        anchorStarts.assign(ANCHOR_KEY_COUNT + 1, 0);
+        anchorBitmap.assign(ANCHOR_KEY_COUNT / 64, 0);
+
+        for (const auto& [key, anchor] : keyedAnchors)
+        {
+            anchors.push_back(anchor);
+            anchorStarts[key + 1]++;
+            anchorBitmap[key / 64] |= 1ull << (key % 64);
+        }
+
+        for (std::size_t key = 0; key < ANCHOR_KEY_COUNT; key++)
+            anchorStarts[key + 1] += anchorStarts[key];
+    }
+
+    bool PatternScanner::MatchesAt(const Pattern& pattern, std::span<const std::uint8_t> image, std::size_t offset)
+    {
+        if (offset > image.size() || image.size() - offset < pattern.size)
+            return false;
+
+        const auto* data = image.data() + offset;
+        const auto available = image.size() - offset;
+        std::size_t i = 0;
+
+#ifdef IWXMVM_PATTERN_SCANNER_SSE2
+        // the padding is masked out, but it may only be read while it is still inside the image
+        const auto zero = _mm_setzero_si128();
+        for (; i + VECTOR_SIZE <= pattern.bytes.size() && i + VECTOR_SIZE <= available; i += VECTOR_SIZE)
+        {
+            const auto imageBytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+            const auto patternBytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pattern.bytes.data() + i));
+            const auto mask = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pattern.mask.data() + i));
+
+            const auto difference = _mm_and_si128(_mm_xor_si128(imageBytes, patternBytes), mask);
+            if (_mm_movemask_epi8(_mm_cmpeq_epi8(difference, zero)) != 0xFFFF)
+                return false;
+        }
+#endif
+
+        for (; i < pattern.size; i++)
+        {
+            if ((data[i] ^ pattern.bytes[i]) & pattern.mask[i])
+                return false;
+        }
+        return true;
+    }
+
+    void PatternScanner::ScanChunk(std::span<const std::uint8_t> image, std::size_t begin, std::size_t end,
+                                   std::vector<std::atomic<std::size_t>>& firstMatches) const
+    {
+        // patterns already found before this chunk cannot match any lower in it, so a chunk past the first match of
+        // every pattern is skipped entirely
+        std::size_t remaining = 0;
+        for (const auto& firstMatch : firstMatches)
+            remaining += firstMatch.load(std::memory_order_relaxed) > begin ? 1 : 0;
+
+        for (std::size_t position = begin; remaining > 0 && position < end && position + 1 < image.size(); position++)
+        {
+            const auto key = GetAnchorKey(&image[position]);
+            if ((anchorBitmap[key / 64] & (1ull << (key % 64))) == 0)
+                continue;
+
+            for (auto i = anchorStarts[key]; i < anchorStarts[key + 1]; i++)
+            {
+                const auto& anchor = anchors[i];
+                if (position < anchor.offset)
+                    continue;
+
+                // positions are visited in order, so a match of a pattern is only worth verifying if no chunk has
+                // found a lower one yet
+                const auto start = position - anchor.offset;
+                auto& firstMatch = firstMatches[anchor.pattern];
+                auto currentMatch = firstMatch.load(std::memory_order_relaxed);
+                if (currentMatch <= start || !MatchesAt(patterns[anchor.pattern], image, start))
+                    continue;
+
+                while (start < currentMatch &&
+                       !firstMatch.compare_exchange_weak(currentMatch, start, std::memory_order_relaxed))
+                {
+                }
+                remaining--;
+            }
+        }
+    }
+
+    std::vector<std::optional<std::size_t>> PatternScanner::FindFirstMatches(std::span<const std::uint8_t> image) const
+    {
+        std::vector<std::atomic<std::size_t>> firstMatches(patterns.size());
+        for (auto& firstMatch : firstMatches)
+            firstMatch.store(NO_MATCH);
+
+        std::vector<std::size_t> chunkStarts;
+        for (std::size_t chunkStart = 0; chunkStart < image.size(); chunkStart += CHUNK_SIZE)
+            chunkStarts.push_back(chunkStart);
+
+        std::for_each(std::execution::par, chunkStarts.begin(), chunkStarts.end(), [&](std::size_t chunkStart) {
+            ScanChunk(image, chunkStart, std::min(chunkStart + CHUNK_SIZE, image.size()), firstMatches);
+        });
+
+        std::vector<std::optional<std::size_t>> matches(patterns.size());
+        for (std::size_t i = 0; i < patterns.size(); i++)
+        {
+            if (const auto firstMatch = firstMatches[i].load(); firstMatch != NO_MATCH)
+                matches[i] = firstMatch;
+        }
+        return matches;
+    }
+
+    PatternScanner::KnownOffsetMatches PatternScanner::FindFirstMatches(
+        std::vector<Pattern> patterns, std::span<const std::optional<std::size_t>> knownOffsets,
+        std::span<const std::uint8_t> image)
+    {
+        if (knownOffsets.size() != patterns.size())
+            throw std::invalid_argument("Known offsets do not match the patterns.");
+
+        KnownOffsetMatches result;
+        result.matches.resize(patterns.size());
+
+        std::vector<Pattern> scannedPatterns;
+        std::vector<std::size_t> scannedIndices;
+        for (std::size_t i = 0; i < patterns.size(); i++)
+        {
+            if (knownOffsets[i].has_value() && MatchesAt(patterns[i], image, knownOffsets[i].value()))
+            {
+                result.matches[i] = knownOffsets[i];
+                result.knownCount++;
+            }
+            else
+            {
+                scannedPatterns.push_back(patterns[i]);
+                scannedIndices.push_back(i);
+            }
+        }
+
+        if (scannedPatterns.empty())
+            return result;
+
+        const auto scannedMatches = PatternScanner(std::move(scannedPatterns), image).FindFirstMatches(image);
+        for (std::size_t j = 0; j < scannedIndices.size(); j++)
+            result.matches[scannedIndices[j]] = scannedMatches[j];
+
+        result.scannedCount = scannedIndices.size();
+        return result;
+    }
+}  // namespace IWXMVM
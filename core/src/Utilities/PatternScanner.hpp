@@ -0,0 +1,85 @@
+#pragma once
+
+namespace IWXMVM
+{
+    // Finds the first occurrence of many byte patterns with wildcards in a single pass over an image. Each pattern is
+    // anchored on its rarest pair of consecutive non-wildcard bytes, and candidates are only verified at positions
+    // where an anchor occurs, so the cost of a scan barely depends on the number of patterns.
+    class PatternScanner
+    {
+       public:
+        static constexpr std::uint16_t WILDCARD = UINT8_MAX + 1;
+
+        // Patterns are compared this many bytes at a time, their byte and mask arrays are padded to a multiple of it
+        static constexpr std::size_t VECTOR_SIZE = 16;
+
+        struct Pattern
+        {
+            std::span<const std::uint8_t> bytes;  // Wildcards and padding are 0
+            std::span<const std::uint8_t> mask;   // 0xFF for known bytes, 0 for wildcards and padding
+            std::size_t size;
+        };
+
+        static constexpr std::size_t GetPaddedSize(std::size_t size)
+        {
+            return (size + VECTOR_SIZE - 1) / VECTOR_SIZE * VECTOR_SIZE;
+        }
+
+        // `image` is sampled to estimate how common each byte pair is. Throws std::invalid_argument for a pattern
+        // without two consecutive non-wildcard bytes.
+        PatternScanner(std::vector<Pattern> patterns, std::span<const std::uint8_t> image);
+
+        // The image is split into chunks of this size that are scanned in parallel. A match belongs to the chunk its
+        // anchor is in and may extend into the next chunk, so matches across chunk borders are not lost.
+        static constexpr std::size_t CHUNK_SIZE = 256 * 1024;
+
+        // Returns the offset of the first match of each pattern, in the order the patterns were given. The result
+        // does not depend on the number of threads, the lowest offset always wins.
+        std::vector<std::optional<std::size_t>> FindFirstMatches(std::span<const std::uint8_t> image) const;
+
+        // Compares VECTOR_SIZE bytes at a time with SSE2 where available, the remaining bytes one at a time
+        static bool MatchesAt(const Pattern& pattern, std::span<const std::uint8_t> image, std::size_t offset);
+
+        struct KnownOffsetMatches
+        {
+            std::vector<std::optional<std::size_t>> matches;  // In the order the patterns were given
+            std::size_t knownCount = 0;                       // Patterns that matched at their known offset
+            std::size_t scannedCount = 0;                     // Patterns the image had to be scanned for
+        };
+
+        // Finds the first matches like FindFirstMatches, but a pattern with a known offset, e.g. from an earlier scan
+        // of the same image, is only checked there with MatchesAt. The image is only scanned for the patterns without
+        // a known offset and those that no longer match at theirs. Throws std::invalid_argument if `knownOffsets` is
+        // not as long as `patterns`.
+        static KnownOffsetMatches FindFirstMatches(std::vector<Pattern> patterns,
+                                                   std::span<const std::optional<std::size_t>> knownOffsets,
+                                                   std::span<const std::uint8_t> image);
+
+       private:
+        static constexpr std::size_t ANCHOR_KEY_COUNT = 1 << 16;
+
+        struct Anchor
+        {
+            std::uint32_t pattern;
+            std::uint32_t offset;  // Position of the anchor pair within the pattern
+        };
+
+        static constexpr std::size_t NO_MATCH = std::numeric_limits<std::size_t>::max();
+
+        void ScanChunk(std::span<const std::uint8_t> image, std::size_t begin, std::size_t end,
+                       std::vector<std::atomic<std::size_t>>& firstMatches) const;
+
+        static std::uint32_t GetAnchorKey(const std::uint8_t* data)
+        {
+            return data[0] | (static_cast<std::uint32_t>(data[1]) << 8);
+        }
+
+        std::vector<Pattern> patterns;
+
+        // Anchors grouped by key, the anchors of key k are [anchorStarts[k], anchorStarts[k + 1]). The bitmap tells
+        // whether a key has any anchors without touching the larger offset table.
+        std::vector<Anchor> anchors;
+        std::vector<std::uint32_t> anchorStarts;
+        std::vector<std::uint64_t> anchorBitmap;
+    };
+}  // namespace IWXMVM
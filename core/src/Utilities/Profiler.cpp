@@ -0,0 +1,226 @@
+#include "StdInclude.hpp"
+#include "Profiler.hpp"
+
+#include "nlohmann/json.hpp"
+
+namespace IWXMVM::Profiler
+{
+    constexpr std::string_view NODE_TRACE_EVENTS = "traceEvents";
+    constexpr std::string_view NODE_DISPLAY_TIME_UNIT = "displayTimeUnit";
+    constexpr std::string_view NODE_NAME = "name";
+    constexpr std::string_view NODE_PHASE = "ph";
+    constexpr std::string_view NODE_TIMESTAMP = "ts";
+    constexpr std::string_view NODE_DURATION = "dur";
+    constexpr std::string_view NODE_PROCESS_ID = "pid";
+    constexpr std::string_view NODE_THREAD_ID = "tid";
+    constexpr std::string_view NODE_ARGS = "args";
+
+    struct ThreadBuffer
+    {
+        std::array<Zone, ZONE_BUFFER_SIZE> zones;
+        // Only written by the owning thread, readers use it to tell which zones are complete
+        std::atomic<std::uint64_t> writeIndex = 0;
+        std::uint32_t threadId;
+        std::uint32_t depth = 0;
+    };
+
+    std::atomic<bool> isRecording = true;
+
+    // Buffers are never freed, so zones of threads that have exited can still be collected
+    std::mutex threadBuffersMutex;
+    std::vector<std::unique_ptr<ThreadBuffer>> threadBuffers;
+
+    std::array<std::uint64_t, FRAME_HISTORY_SIZE> frameStarts;
+    std::uint64_t frameCount = 0;
+
+    ThreadBuffer* CreateThreadBuffer()
+    {
+        std::lock_guard lock(threadBuffersMutex);
+        auto& buffer = threadBuffers.emplace_back(std::make_unique<ThreadBuffer>());
+        buffer->threadId = static_cast<std::uint32_t>(threadBuffers.size());
+        return buffer.get();
+    }
+
+    ThreadBuffer& GetThreadBuffer()
+    {
+        thread_local ThreadBuffer* buffer = CreateThreadBuffer();
+        return *buffer;
+    }
+
+    std::uint64_t GetTimestamp()
+    {
+        return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                              std::chrono::steady_clock::now().time_since_epoch())
+                                              .count());
+    }
+
+    void SetRecording(bool recording)
+    {
+        isRecording.store(recording, std::memory_order_relaxed);
+    }
+
+    bool IsRecording()
+    {
+        return isRecording.load(std::memory_order_relaxed);
+    }
+
+    void BeginZone()
+    {
+        GetThreadBuffer().depth++;
+    }
+
+    void EndZone(const char* name, std::uint64_t start)
+    {
+        const auto end = GetTimestamp();
+
+        auto& buffer = GetThreadBuffer();
+        buffer.depth--;
+
+        const auto index = buffer.writeIndex.load(std::memory_order_relaxed);
+        buffer.zones[index % ZONE_BUFFER_SIZE] = {name, start, end, buffer.depth, buffer.threadId};
+        buffer.writeIndex.store(index + 1, std::memory_order_release);
+    }
+
+    void MarkFrame()
+    {
+        frameStarts[frameCount % FRAME_HISTORY_SIZE] = GetTimestamp();
+        frameCount++;
+    }
+
+    std::vector<Frame> GetFrames()
+    {
+        std::vector<Frame> frames;
+        const auto firstFrame = frameCount > FRAME_HISTORY_SIZE ? frameCount - FRAME_HISTORY_SIZE : 0;
+        for (auto i = firstFrame; i + 1 < frameCount; i++)
+            frames.push_back({frameStarts[i % FRAME_HISTORY_SIZE], frameStarts[(i + 1) % FRAME_HISTORY_SIZE]});
+        return frames;
+    }
+
+    void CopyZones(const ThreadBuffer& buffer, std::uint64_t start, std::uint64_t end, std::vector<Zone>& zones)
+    {
+        const auto writeIndex = buffer.writeIndex.load(std::memory_order_acquire);
+        const auto firstIndex = writeIndex > ZONE_BUFFER_SIZE ? writeIndex - ZONE_BUFFER_SIZE : 0;
+
+        const auto copyStart = zones.size();
+        std::vector<std::uint64_t> indices;
+        for (auto i = firstIndex; i < writeIndex; i++)
+        {
+            const auto& zone = buffer.zones[i % ZONE_BUFFER_SIZE];
+            if (zone.start >= start && zone.start < end)
+            {
+                zones.push_back(zone);
+                indices.push_back(i);
+            }
+        }
+
+        // the owning thread keeps writing while zones are copied, so drop those it may have overwritten meanwhile
+        const auto newWriteIndex = buffer.writeIndex.load(std::memory_order_acquire);
+        const auto firstValidIndex = newWriteIndex > ZONE_BUFFER_SIZE ? newWriteIndex - ZONE_BUFFER_SIZE : 0;
+
+        std::size_t validCount = copyStart;
+        for (std::size_t i = 0; i < indices.size(); i++)
+        {
+            if (indices[i] >= firstValidIndex)
+                zones[validCount++] = zones[copyStart + i];
+        }
+        zones.resize(validCount);
+
+        // zones are written when they end, so parents follow their children
+        std::sort(zones.begin() + copyStart, zones.end(), [](const Zone& a, const Zone& b) {
+            return a.start != b.start ? a.start < b.start : a.depth < b.depth;
+        });
+    }
+
+    std::vector<Zone> CollectZones(std::uint64_t start, std::uint64_t end)
+    {
+        std::vector<Zone> zones;
+
+        std::lock_guard lock(threadBuffersMutex);
+        for (const auto& buffer : threadBuffers)
+            CopyZones(*buffer, start, end, zones);
+
+        return zones;
+    }
+
+    std::vector<ZoneStats> GetZoneStats(std::span<const Zone> zones)
+    {
+        // the same literal can have different addresses in different translation units, so zones are compared by name
+        std::map<std::string_view, ZoneStats> statsByName;
+        for (const auto& zone : zones)
+        {
+            auto& stats = statsByName.try_emplace(zone.name, ZoneStats{zone.name, 0, 0, 0}).first->second;
+            const auto duration = zone.end - zone.start;
+
+            stats.callCount++;
+            stats.totalDuration += duration;
+            stats.maxDuration = std::max(stats.maxDuration, duration);
+        }
+
+        std::vector<ZoneStats> stats;
+        for (const auto& [name, zoneStats] : statsByName)
+            stats.push_back(zoneStats);
+
+        std::sort(stats.begin(), stats.end(),
+                  [](const ZoneStats& a, const ZoneStats& b) { return a.totalDuration > b.totalDuration; });
+        return stats;
+    }
+
+    void ExportChromeTrace(std::ostream& stream)
+    {
+        using json = nlohmann::json;
+
+        const auto zones = CollectZones(0, std::numeric_limits<std::uint64_t>::max());
+
+        // timestamps are relative to the first zone, as the steady clock epoch is arbitrary
+        std::uint64_t firstStart = std::numeric_limits<std::uint64_t>::max();
+        for (const auto& zone : zones)
+            firstStart = std::min(firstStart, zone.start);
+
+        json eventArray = json::array();
+        std::vector<std::uint32_t> threadIds;
+        for (const auto& zone : zones)
+        {
+            // complete events, in microseconds
+            json eventObject;
+            eventObject[NODE_NAME] = zone.name;
+            eventObject[NODE_PHASE] = "X";
+            eventObject[NODE_TIMESTAMP] = static_cast<double>(zone.start - firstStart) / 1000.0;
+            eventObject[NODE_DURATION] = static_cast<double>(zone.end - zone.start) / 1000.0;
+            eventObject[NODE_PROCESS_ID] = 1;
+            eventObject[NODE_THREAD_ID] = zone.threadId;
+            eventArray.push_back(eventObject);
+
+            if (threadIds.empty() || threadIds.back() != zone.threadId)
+                threadIds.push_back(zone.threadId);
+        }
+
+        for (const auto threadId : threadIds)
+        {
+            json metadataObject;
+            metadataObject[NODE_NAME] = "thread_name";
+            metadataObject[NODE_PHASE] = "M";
+            metadataObject[NODE_PROCESS_ID] = 1;
+            metadataObject[NODE_THREAD_ID] = threadId;
+            metadataObject[NODE_ARGS][NODE_NAME] = std::format("Thread {}", threadId);
+            eventArray.push_back(metadataObject);
+        }
+
+        json rootNode;
+        rootNode[NODE_TRACE_EVENTS] = eventArray;
+        rootNode[NODE_DISPLAY_TIME_UNIT] = "ms";
+        stream << rootNode.dump();
+    }
+
+    bool ExportChromeTrace(const std::filesystem::path& path)
+    {
+        std::ofstream file(path);
+        if (!file.is_open())
+        {
+            LOG_ERROR("Failed to write profiler trace {}", path.string());
+            return false;
+        }
+
+        ExportChromeTrace(file);
+        return true;
+    }
+}  // namespace IWXMVM::Profiler
@@ -0,0 +1,95 @@
+#pragma once
+
+// Remove to compile all profiler zones out
+#define IWXMVM_PROFILER
+
+#ifdef IWXMVM_PROFILER
+#define PROFILER_CONCAT_INNER(a, b) a##b
+#define PROFILER_CONCAT(a, b) PROFILER_CONCAT_INNER(a, b)
+// Times the rest of the enclosing scope. The name must be a string literal, as only the pointer is recorded.
+#define PROFILE_ZONE(name) const IWXMVM::Profiler::ScopedZone PROFILER_CONCAT(profilerZone, __LINE__)(name)
+#define PROFILE_FRAME() IWXMVM::Profiler::MarkFrame()
+#else
+#define PROFILE_ZONE(name)
+#define PROFILE_FRAME()
+#endif
+
+namespace IWXMVM::Profiler
+{
+    // Zones are recorded into a ring buffer per thread, so the oldest zones of a busy thread are overwritten first
+    constexpr std::size_t ZONE_BUFFER_SIZE = 8192;
+    constexpr std::size_t FRAME_HISTORY_SIZE = 256;
+
+    struct Zone
+    {
+        const char* name;
+        std::uint64_t start;  // Nanoseconds on the steady clock
+        std::uint64_t end;
+        std::uint32_t depth;  // Number of zones the zone is nested in on its thread
+        std::uint32_t threadId;
+    };
+
+    struct Frame
+    {
+        std::uint64_t start;
+        std::uint64_t end;
+    };
+
+    struct ZoneStats
+    {
+        std::string_view name;
+        std::uint64_t callCount;
+        std::uint64_t totalDuration;  // Nanoseconds
+        std::uint64_t maxDuration;
+    };
+
+    void SetRecording(bool recording);
+    bool IsRecording();
+
+    void BeginZone();
+    void EndZone(const char* name, std::uint64_t start);
+    std::uint64_t GetTimestamp();
+
+    class ScopedZone
+    {
+       public:
+        explicit ScopedZone(const char* name) : name(name), isActive(IsRecording())
+        {
+            if (isActive)
+            {
+                BeginZone();
+                start = GetTimestamp();
+            }
+        }
+
+        ~ScopedZone()
+        {
+            if (isActive)
+                EndZone(name, start);
+        }
+
+        ScopedZone(const ScopedZone&) = delete;
+        ScopedZone& operator=(const ScopedZone&) = delete;
+
+       private:
+        const char* name;
+        std::uint64_t start = 0;
+        bool isActive;
+    };
+
+    // Starts a new frame, zones are attributed to the frame they started in. Only call from the render thread.
+    void MarkFrame();
+
+    // Completed frames, oldest first
+    std::vector<Frame> GetFrames();
+
+    // Zones of all threads that started within the range, ordered by thread and start time
+    std::vector<Zone> CollectZones(std::uint64_t start, std::uint64_t end);
+
+    // Sums up zones by name, ordered by total duration
+    std::vector<ZoneStats> GetZoneStats(std::span<const Zone> zones);
+
+    // Writes all recorded zones in the Chrome trace event format, as read by chrome://tracing and Perfetto
+    void ExportChromeTrace(std::ostream& stream);
+    bool ExportChromeTrace(const std::filesystem::path& path);
+}  // namespace IWXMVM::Profiler
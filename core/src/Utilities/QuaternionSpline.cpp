@@ -0,0 +1,89 @@
+#include "StdInclude.hpp"
+#include "QuaternionSpline.hpp"
+
+#include "glm/gtx/quaternion.hpp"
+
+namespace IWXMVM::MathUtils
+{
+    glm::quat QuaternionFromAngles(glm::vec3 eulerAngles)
+    {
+        // pitch around Y, yaw around Z, roll around X, matching ForwardVectorFromAngles
+        const auto pitch = glm::angleAxis(glm::radians(eulerAngles[0]), glm::vec3(0, 1, 0));
+        const auto yaw = glm::angleAxis(glm::radians(eulerAngles[1]), glm::vec3(0, 0, 1));
+        const auto roll = glm::angleAxis(glm::radians(eulerAngles[2]), glm::vec3(1, 0, 0));
+        return yaw * pitch * roll;
+    }
+
+    glm::vec3 AnglesFromQuaternion(glm::quat rotation)
+    {
+        const auto forward = rotation * glm::vec3(1, 0, 0);
+        const auto left = rotation * glm::vec3(0, 1, 0);
+        const auto up = rotation * glm::vec3(0, 0, 1);
+
+        const auto pitch = std::atan2(-forward.z, std::sqrt(forward.x * forward.x + forward.y * forward.y));
+        const auto yaw = std::atan2(forward.y, forward.x);
+        const auto roll = std::atan2(left.z, up.z);
+        return glm::vec3(glm::degrees(pitch), glm::degrees(yaw), glm::degrees(roll));
+    }
+
+    float UnwrapAngle(float angle, float reference)
+    {
+        return angle + 360.0f * std::round((reference - angle) / 360.0f);
+    }
+
+    void QuaternionSpline::Build(const std::vector<Types::Keyframe>& keyframes)
+    {
+        ticks.clear();
+        angles.clear();
+        rotations.clear();
+        controlPoints.clear();
+
+        for (const auto& keyframe : keyframes)
+        {
+            auto rotation = QuaternionFromAngles(keyframe.value.cameraData.rotation);
+
+            // keep consecutive rotations in the same hemisphere so each segment takes the short way around
+            if (!rotations.empty() && glm::dot(rotations.back(), rotation) < 0.0f)
+                rotation = -rotation;
+
+            ticks.push_back(static_cast<float>(keyframe.tick));
+            angles.push_back(keyframe.value.cameraData.rotation);
+            rotations.push_back(rotation);
+        }
+
+        controlPoints.resize(rotations.size());
+        for (std::size_t i = 0; i < rotations.size(); i++)
+        {
+            if (i == 0 || i == rotations.size() - 1)
+                controlPoints[i] = rotations[i];
+            else
+                controlPoints[i] = glm::intermediate(rotations[i - 1], rotations[i], rotations[i + 1]);
+        }
+    }
+
+    glm::vec3 QuaternionSpline::Evaluate(float tick, bool cubic) const
+    {
+        if (ticks.empty())
+            return glm::vec3(0.0f);
+
+        if (ticks.size() == 1 || tick <= ticks.front())
+            return angles.front();
+        if (tick >= ticks.back())
+            return angles.back();
+
+        const auto it = std::upper_bound(ticks.begin(), ticks.end(), tick);
+        const auto i = static_cast<std::size_t>(std::distance(ticks.begin(), it)) - 1;
+
+        const auto t = (tick - ticks[i]) / (ticks[i + 1] - ticks[i]);
+        const auto rotation = cubic ? glm::squad(rotations[i], rotations[i + 1], controlPoints[i], controlPoints[i + 1], t)
+                                    : glm::slerp(rotations[i], rotations[i + 1], t);
+
+        auto result = AnglesFromQuaternion(rotation);
+        const auto reference = glm::mix(angles[i], angles[i + 1], t);
+        for (int32_t axis = 0; axis < 3; axis++)
+        {
+            result[axis] = UnwrapAngle(result[axis], reference[axis]);
+        }
+        return result;
+    }
+}  // namespace IWXMVM::MathUtils
\ No newline at end of file
@@ -0,0 +1,30 @@
+#pragma once
+#include "Types/Keyframe.hpp"
+
+namespace IWXMVM::MathUtils
+{
+    glm::quat QuaternionFromAngles(glm::vec3 eulerAngles);
+    glm::vec3 AnglesFromQuaternion(glm::quat rotation);
+
+    // Interpolates campath rotations on the unit sphere. Squad control points are solved once in Build, so evaluating
+    // the spline only takes a binary search and three slerps.
+    class QuaternionSpline
+    {
+       public:
+        void Build(const std::vector<Types::Keyframe>& keyframes);
+
+        // Returns the rotation as euler angles, unwrapped to stay close to the keyframed euler values
+        glm::vec3 Evaluate(float tick, bool cubic) const;
+
+        bool IsEmpty() const
+        {
+            return ticks.empty();
+        }
+
+       private:
+        std::vector<float> ticks;
+        std::vector<glm::vec3> angles;
+        std::vector<glm::quat> rotations;
+        std::vector<glm::quat> controlPoints;
+    };
+}  // namespace IWXMVM::MathUtils
\ No newline at end of file
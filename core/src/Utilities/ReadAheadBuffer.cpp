@@ -0,0 +1,118 @@
+#include "StdInclude.hpp"
+#include "ReadAheadBuffer.hpp"
+
+namespace IWXMVM
+{
+    ReadAheadBuffer::ReadAheadBuffer(std::unique_ptr<std::istream> source, std::size_t capacity)
+        : source(std::move(source)), ring(std::max(capacity, CHUNK_SIZE))
+    {
+        this->source->seekg(0, std::ios::end);
+        size = static_cast<std::uint64_t>(this->source->tellg());
+        this->source->seekg(0, std::ios::beg);
+
+        worker = std::jthread([this](std::stop_token stopToken) { RunWorker(stopToken); });
+    }
+
+    std::size_t ReadAheadBuffer::Read(void* destination, std::size_t count)
+    {
+        auto output = static_cast<char*>(destination);
+        std::size_t totalRead = 0;
+
+        std::unique_lock lock(mutex);
+        while (totalRead < count)
+        {
+            dataAvailable.wait(lock, [&] { return windowEnd > windowStart || (reachedEnd && !hasPendingSeek); });
+            if (windowEnd == windowStart)
+                break;
+
+            // copy up to the end of the ring at most, a wrapped window is handled by the next iteration
+            const auto ringOffset = static_cast<std::size_t>(windowStart % ring.size());
+            const auto available = static_cast<std::size_t>(windowEnd - windowStart);
+            const auto copyCount = std::min({count - totalRead, available, ring.size() - ringOffset});
+
+            std::memcpy(output + totalRead, ring.data() + ringOffset, copyCount);
+            windowStart += copyCount;
+            totalRead += copyCount;
+
+            spaceAvailable.notify_one();
+        }
+
+        return totalRead;
+    }
+
+    void ReadAheadBuffer::Seek(std::uint64_t position)
+    {
+        std::lock_guard lock(mutex);
+        if (position >= windowStart && position <= windowEnd)
+        {
+            windowStart = position;
+        }
+        else
+        {
+            generation++;
+            windowStart = windowEnd = position;
+            reachedEnd = false;
+            hasPendingSeek = true;
+        }
+
+        spaceAvailable.notify_one();
+    }
+
+    std::uint64_t ReadAheadBuffer::GetPosition()
+    {
+        std::lock_guard lock(mutex);
+        return windowStart;
+    }
+
+    void ReadAheadBuffer::RunWorker(std::stop_token stopToken)
+    {
+        std::vector<char> chunk(CHUNK_SIZE);
+
+        std::unique_lock lock(mutex);
+        while (!stopToken.stop_requested())
+        {
+            const bool canRead = spaceAvailable.wait(lock, stopToken, [&] {
+                return hasPendingSeek || (!reachedEnd && windowEnd - windowStart + CHUNK_SIZE <= ring.size());
+            });
+            if (!canRead)
+                break;
+
+            const auto chunkGeneration = generation;
+            const auto readPosition = windowEnd;
+            const bool seek = hasPendingSeek;
+            hasPendingSeek = false;
+
+            // the source is only ever touched by this thread, so it can be read without holding the lock
+            lock.unlock();
+
+            if (seek)
+            {
+                source->clear();
+                source->seekg(static_cast<std::streamoff>(readPosition));
+            }
+
+            source->read(chunk.data(), chunk.size());
+            const auto readCount = static_cast<std::size_t>(source->gcount());
+
+            lock.lock();
+
+            // a seek came in while reading, so this chunk belongs to a window that no longer exists
+            if (chunkGeneration != generation)
+                continue;
+
+            for (std::size_t copied = 0; copied < readCount;)
+            {
+                const auto ringOffset = static_cast<std::size_t>(windowEnd % ring.size());
+                const auto copyCount = std::min(readCount - copied, ring.size() - ringOffset);
+                std::memcpy(ring.data() + ringOffset, chunk.data() + copied, copyCount);
+                windowEnd += copyCount;
+                copied += copyCount;
+            }
+
+            if (readCount < chunk.size())
+                reachedEnd = true;
+
+            dataAvailable.notify_all();
+        }
+    }
+}  // namespace IWXMVM
@@ -0,0 +1,53 @@
+#pragma once
+#include <condition_variable>
+
+namespace IWXMVM
+{
+    // Reads a stream ahead on a background thread into a ring buffer, so sequential reads are served from memory
+    // instead of blocking on the disk. Reads return exactly the bytes a direct read of the source would, regardless of
+    // how far ahead the worker happens to be. A seek within the buffered window only skips ahead; any other seek
+    // discards the window and restarts reading ahead from the new position.
+    class ReadAheadBuffer
+    {
+       public:
+        static constexpr std::size_t DEFAULT_CAPACITY = 8 * 1024 * 1024;
+        static constexpr std::size_t CHUNK_SIZE = 256 * 1024;
+
+        explicit ReadAheadBuffer(std::unique_ptr<std::istream> source, std::size_t capacity = DEFAULT_CAPACITY);
+
+        // Blocks until `count` bytes are available or the end of the source is reached, returns the number read
+        std::size_t Read(void* destination, std::size_t count);
+        void Seek(std::uint64_t position);
+
+        std::uint64_t GetPosition();
+
+        std::uint64_t GetSize() const
+        {
+            return size;
+        }
+
+       private:
+        void RunWorker(std::stop_token stopToken);
+
+        std::unique_ptr<std::istream> source;
+        std::uint64_t size = 0;
+
+        std::mutex mutex;
+        std::condition_variable_any dataAvailable;
+        std::condition_variable_any spaceAvailable;
+
+        // Byte at stream position p is stored at ring[p % ring.size()]. [windowStart, windowEnd) has been read from
+        // the source but not consumed yet.
+        std::vector<char> ring;
+        std::uint64_t windowStart = 0;
+        std::uint64_t windowEnd = 0;
+        bool reachedEnd = false;
+
+        // Incremented by every seek that discards the window, so the worker can drop a chunk read before it
+        uint64_t generation = 0;
+        bool hasPendingSeek = false;
+
+        // Declared last so the worker starts after, and is joined before, everything it uses
+        std::jthread worker;
+    };
+}  // namespace IWXMVM
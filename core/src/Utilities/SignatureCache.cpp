@@ -0,0 +1,131 @@
+#include "StdInclude.hpp"
+#include "SignatureCache.hpp"
+
+#include "nlohmann/json.hpp"
+
+#include "Utilities/PathUtils.hpp"
+
+namespace IWXMVM::SignatureCache
+{
+    constexpr std::string_view NODE_MODULES = "modules";
+    constexpr std::string_view NODE_IDENTITY = "identity";
+    constexpr std::string_view NODE_OFFSETS = "offsets";
+
+    constexpr std::string_view CACHE_FILE_NAME = "signature_cache.json";
+
+    // Hashing the whole code section would cost about as much as scanning it
+    constexpr std::size_t CODE_SAMPLE_COUNT = 64;
+    constexpr std::size_t CODE_SAMPLE_SIZE = 64;
+
+    std::filesystem::path GetCachePath()
+    {
+        return PathUtils::GetIWXMVMPath() / CACHE_FILE_NAME;
+    }
+
+    void HashBytes(std::uint64_t& hash, const void* data, std::size_t size)
+    {
+        const auto* bytes = static_cast<const std::uint8_t*>(data);
+        for (std::size_t i = 0; i < size; i++)
+        {
+            hash ^= bytes[i];
+            hash *= 0x100000001b3;
+        }
+    }
+
+    std::optional<std::string> GetModuleIdentity(std::span<const std::uint8_t> image)
+    {
+        if (image.size() < sizeof(IMAGE_DOS_HEADER))
+            return std::nullopt;
+
+        const auto* dosHeader = reinterpret_cast<const IMAGE_DOS_HEADER*>(image.data());
+        if (dosHeader->e_magic != IMAGE_DOS_SIGNATURE || dosHeader->e_lfanew < 0 ||
+            static_cast<std::size_t>(dosHeader->e_lfanew) + sizeof(IMAGE_NT_HEADERS) > image.size())
+            return std::nullopt;
+
+        const auto* ntHeaders = reinterpret_cast<const IMAGE_NT_HEADERS*>(image.data() + dosHeader->e_lfanew);
+        if (ntHeaders->Signature != IMAGE_NT_SIGNATURE)
+            return std::nullopt;
+
+        // 64-bit FNV-1a
+        std::uint64_t hash = 0xcbf29ce484222325;
+        HashBytes(hash, &ntHeaders->FileHeader.TimeDateStamp, sizeof(ntHeaders->FileHeader.TimeDateStamp));
+        HashBytes(hash, &ntHeaders->OptionalHeader.SizeOfImage, sizeof(ntHeaders->OptionalHeader.SizeOfImage));
+
+        const auto* section = IMAGE_FIRST_SECTION(ntHeaders);
+        for (WORD i = 0; i < ntHeaders->FileHeader.NumberOfSections; i++, section++)
+        {
+            if ((section->Characteristics & IMAGE_SCN_CNT_CODE) == 0)
+                continue;
+
+            const std::size_t start = section->VirtualAddress;
+            const std::size_t end = std::min<std::size_t>(start + section->Misc.VirtualSize, image.size());
+            if (end <= start + CODE_SAMPLE_SIZE)
+                continue;
+
+            const auto stride = (end - start - CODE_SAMPLE_SIZE) / CODE_SAMPLE_COUNT;
+            for (std::size_t sample = 0; sample < CODE_SAMPLE_COUNT; sample++)
+                HashBytes(hash, image.data() + start + sample * stride, CODE_SAMPLE_SIZE);
+        }
+
+        return std::format("{:016x}", hash);
+    }
+
+    ModuleOffsets Load(const std::string& moduleIdentity)
+    {
+        using json = nlohmann::json;
+
+        ModuleOffsets offsets;
+
+        std::ifstream cacheFile(GetCachePath());
+        if (!cacheFile.is_open())
+            return offsets;
+
+        try
+        {
+            json rootNode = json::parse(cacheFile);
+            for (const auto& moduleObject : rootNode.at(NODE_MODULES))
+            {
+                if (moduleObject.at(NODE_IDENTITY).get<std::string>() != moduleIdentity)
+                    continue;
+
+                for (const auto& [signature, offset] : moduleObject.at(NODE_OFFSETS).items())
+                    offsets[signature] = offset.get<std::uint32_t>();
+            }
+        }
+        catch (std::exception& e)
+        {
+            LOG_WARN("Ignoring signature cache: {}", e.what());
+            offsets.clear();
+        }
+
+        return offsets;
+    }
+
+    void Store(const std::unordered_map<std::string, ModuleOffsets>& modules)
+    {
+        using json = nlohmann::json;
+
+        json moduleArray = json::array();
+        for (const auto& [identity, offsets] : modules)
+        {
+            json moduleObject;
+            moduleObject[NODE_IDENTITY] = identity;
+            moduleObject[NODE_OFFSETS] = offsets;
+            moduleArray.push_back(moduleObject);
+        }
+
+        json rootNode;
+        rootNode[NODE_MODULES] = moduleArray;
+
+        std::error_code error;
+        std::filesystem::create_directories(GetCachePath().parent_path(), error);
+
+        std::ofstream cacheFile(GetCachePath());
+        if (!cacheFile.is_open())
+        {
+            LOG_WARN("Failed to write signature cache {}", GetCachePath().string());
+            return;
+        }
+        cacheFile << rootNode.dump();
+    }
+}  // namespace IWXMVM::SignatureCache
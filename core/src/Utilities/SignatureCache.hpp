@@ -0,0 +1,17 @@
+#pragma once
+
+namespace IWXMVM::SignatureCache
+{
+    // Signature string -> offset of its match from the start of the module
+    using ModuleOffsets = std::unordered_map<std::string, std::uint32_t>;
+
+    // Identifies a module build by its PE timestamp, image size and a sample of its code section, so a patched or
+    // updated binary gets a different identity. Returns nothing if the image has no valid PE headers.
+    std::optional<std::string> GetModuleIdentity(std::span<const std::uint8_t> image);
+
+    // Returns the offsets found the last time the module with this identity was scanned
+    ModuleOffsets Load(const std::string& moduleIdentity);
+
+    // Replaces the cache with the offsets of the given modules, modules that are no longer loaded are dropped
+    void Store(const std::unordered_map<std::string, ModuleOffsets>& modules);
+}  // namespace IWXMVM::SignatureCache
@@ -0,0 +1,139 @@
+#include "StdInclude.hpp"
+#include "Signatures.hpp"
+
+#include "SignatureCache.hpp"
+
+namespace IWXMVM::Signatures
+{
+    std::optional<std::span<const std::uint8_t>> GetModuleImage(HMODULE handle)
+    {
+        MODULEINFO moduleInfo{};
+        if (!::GetModuleInformation(::GetCurrentProcess(), handle, &moduleInfo, sizeof(moduleInfo)) ||
+            !moduleInfo.lpBaseOfDll)
+            return std::nullopt;
+
+        return std::span{reinterpret_cast<const std::uint8_t*>(moduleInfo.lpBaseOfDll), moduleInfo.SizeOfImage};
+    }
+
+    std::optional<std::uintptr_t> ResolveSignatureAddress(const PendingSignature& signature, std::uintptr_t match,
+                                                          std::string& error)
+    {
+        const auto address = static_cast<std::uintptr_t>(match + signature.offset);
+        if (!signature.callable)
+            return address;
+
+        try
+        {
+            const auto newAddress = signature.callable(address);
+            if (newAddress != 0)
+                return newAddress;
+
+            error = "Failed to find correct game address (1)";
+        }
+        catch (...)
+        {
+            error = "Failed to find correct game address (2)";
+        }
+        return std::nullopt;
+    }
+
+    void ResolvePendingSignatures()
+    {
+        const auto start = std::chrono::steady_clock::now();
+
+        auto& pendingSignatures = GetPendingSignatures();
+        std::vector<std::string> failedSignatures;
+        std::unordered_map<std::string, SignatureCache::ModuleOffsets> moduleOffsets;
+        std::size_t cachedCount = 0;
+        bool hasScanned = false;
+
+        for (const auto moduleType : {Types::ModuleType::BaseModule, Types::ModuleType::SecondaryModules})
+        {
+            std::vector<PendingSignature*> unresolved;
+            for (auto& signature : pendingSignatures)
+            {
+                if (signature.moduleType == moduleType)
+                    unresolved.push_back(&signature);
+            }
+
+            const auto modules = Mod::GetGameInterface()->GetModuleHandles(moduleType);
+            if (unresolved.empty() || !modules.has_value())
+                continue;
+
+            // modules are searched in order, and a signature is only looked for in the next one if it was not found
+            for (const auto handle : modules.value())
+            {
+                const auto image = GetModuleImage(handle);
+                if (!image.has_value() || unresolved.empty())
+                    break;
+
+                const auto identity = SignatureCache::GetModuleIdentity(image.value());
+                const auto cachedOffsets =
+                    identity.has_value() ? SignatureCache::Load(identity.value()) : SignatureCache::ModuleOffsets{};
+
+                // a cached offset only has to be checked at its own location, only the rest is scanned for
+                std::vector<PatternScanner::Pattern> patterns;
+                std::vector<std::optional<std::size_t>> knownOffsets;
+                for (const auto* signature : unresolved)
+                {
+                    patterns.push_back(signature->pattern);
+                    const auto cachedOffset = cachedOffsets.find(std::string(signature->string));
+                    knownOffsets.push_back(cachedOffset != cachedOffsets.end()
+                                               ? std::optional<std::size_t>(cachedOffset->second)
+                                               : std::nullopt);
+                }
+
+                const auto result = PatternScanner::FindFirstMatches(std::move(patterns), knownOffsets, image.value());
+                const auto& matches = result.matches;
+                cachedCount += result.knownCount;
+                hasScanned |= result.scannedCount > 0;
+
+                std::vector<PendingSignature*> notFound;
+                for (std::size_t i = 0; i < unresolved.size(); i++)
+                {
+                    if (!matches[i].has_value())
+                    {
+                        notFound.push_back(unresolved[i]);
+                        continue;
+                    }
+
+                    if (identity.has_value())
+                    {
+                        moduleOffsets[identity.value()][std::string(unresolved[i]->string)] =
+                            static_cast<std::uint32_t>(matches[i].value());
+                    }
+
+                    std::string error;
+                    const auto match = reinterpret_cast<std::uintptr_t>(image->data()) + matches[i].value();
+                    if (const auto address = ResolveSignatureAddress(*unresolved[i], match, error); address.has_value())
+                        *unresolved[i]->address = address.value();
+                    else
+                        failedSignatures.push_back(std::format("{}, signature:\n\t {}", error, unresolved[i]->string));
+                }
+                unresolved = std::move(notFound);
+            }
+
+            for (const auto* signature : unresolved)
+                failedSignatures.push_back(std::format("Failed to find signature:\n\t {}", signature->string));
+        }
+
+        // a launch that only used cached offsets has nothing new to write
+        if (hasScanned)
+            SignatureCache::Store(moduleOffsets);
+
+        LOG_DEBUG("Resolved {} of {} signatures ({} from cache) in {} ms",
+                  pendingSignatures.size() - failedSignatures.size(), pendingSignatures.size(), cachedCount,
+                  std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start)
+                      .count());
+        pendingSignatures.clear();
+
+        if (!failedSignatures.empty())
+        {
+            std::string message;
+            for (const auto& failedSignature : failedSignatures)
+                message += failedSignature + '\n';
+
+            throw std::runtime_error(message);
+        }
+    }
+}  // namespace IWXMVM::Signatures
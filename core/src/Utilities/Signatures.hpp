@@ -1,6 +1,7 @@
 #pragma once
 #include "StdInclude.hpp"
 #include "Mod.hpp"
+#include "PatternScanner.hpp"
 
 namespace IWXMVM::Signatures
 {
@@ -35,7 +36,7 @@ namespace IWXMVM::Signatures
         };
     }  // namespace Lambdas
 
-    inline constexpr std::uint16_t maskValue = UINT8_MAX + 1;
+    inline constexpr std::uint16_t maskValue = PatternScanner::WILDCARD;
 
     enum struct GameAddressType : std::uint8_t
     {
@@ -152,40 +153,56 @@ namespace IWXMVM::Signatures
         if (bytes.back() == maskValue)
             throw std::runtime_error("Incorrect signature input.");
 
+        // the scanner anchors every signature on a pair of known bytes
+        if (std::adjacent_find(bytes.begin(), bytes.end(), [](auto a, auto b) {
+                return a != maskValue && b != maskValue;
+            }) == bytes.end())
+            throw std::runtime_error("Signature needs two consecutive unmasked bytes.");
+
         return bytes;
     }
 
-    inline std::uintptr_t SignatureScanner(const auto& signature, const auto& moduleHandles)
+    template <std::size_t paddedSize>
+    constexpr auto GetMatchBytes(const auto& bytes)
     {
-        for (const auto handle : moduleHandles)
-        {
-            MODULEINFO process{};
+        std::array<std::uint8_t, paddedSize> matchBytes{};
+        for (std::size_t i = 0; i < bytes.size(); ++i)
+            matchBytes[i] = (bytes[i] == maskValue) ? 0 : static_cast<std::uint8_t>(bytes[i]);
 
-            if (!::GetModuleInformation(::GetCurrentProcess(), handle, &process, sizeof(process)) ||
-                !process.lpBaseOfDll)
-                return 0;
-
-            const std::uintptr_t endOfDll = reinterpret_cast<std::uintptr_t>(process.lpBaseOfDll) + process.SizeOfImage;
+        return matchBytes;
+    }
 
-            for (std::uintptr_t i = reinterpret_cast<std::uintptr_t>(process.lpBaseOfDll); i < endOfDll; ++i)
-            {
-                std::size_t j = signature._frontMaskCount;
+    template <std::size_t paddedSize>
+    constexpr auto GetMatchMask(const auto& bytes)
+    {
+        std::array<std::uint8_t, paddedSize> matchMask{};
+        for (std::size_t i = 0; i < bytes.size(); ++i)
+            matchMask[i] = (bytes[i] == maskValue) ? 0 : UINT8_MAX;
 
-                for (; j < signature._bytes.size(); ++j)
-                {
-                    if (signature._bytes[j] != maskValue &&
-                        signature._bytes[j] != *reinterpret_cast<std::uint8_t*>(i + j))
-                        break;
-                }
+        return matchMask;
+    }
 
-                if (j == signature._bytes.size())
-                    return i + signature._offset;
-            }
-        }
+    struct PendingSignature
+    {
+        PatternScanner::Pattern pattern;
+        std::string_view string;
+        std::intptr_t offset;
+        std::uintptr_t (*callable)(std::uintptr_t);  // nullptr if the signature has no callable
+        Types::ModuleType moduleType;
+        std::uintptr_t* address;
+    };
 
-        return 0;
+    // Signatures register here when constructed and are resolved together by ResolvePendingSignatures
+    inline std::vector<PendingSignature>& GetPendingSignatures()
+    {
+        static std::vector<PendingSignature> pendingSignatures;
+        return pendingSignatures;
     }
 
+    // Finds every pending signature with a single scan per module. Throws a std::runtime_error listing all signatures
+    // that could not be found, rather than just the first one.
+    void ResolvePendingSignatures();
+
     using callable_t = decltype([]() {});
 
     template <std::size_t size, typename Callable = callable_t>
@@ -197,50 +214,25 @@ namespace IWXMVM::Signatures
               _bytes(ConvertStringToBytes<size>(str)),
               _frontMaskCount(GetFrontMaskCount(_bytes)),
               _offset(offset),
-              _callable(callable)
+              _callable(callable),
+              _matchBytes(GetMatchBytes<matchSize>(_bytes)),
+              _matchMask(GetMatchMask<matchSize>(_bytes))
         {
             CheckMaskCountAndOffset(_bytes, _frontMaskCount, _offset, type);
 
             static_assert(size > 0);
         }
 
-        auto Scan(const auto& moduleHandles) const
-        {
-            const std::uintptr_t address = SignatureScanner(*this, moduleHandles);
-
-            if (address == 0)
-                throw std::runtime_error(std::format("Failed to find signature:\n\t {}", _string.data()));
-            else
-            {
-                if constexpr (requires { std::declval<Callable>()(address); })
-                {
-                    try
-                    {
-                        const std::uintptr_t newAddress = _callable(address);
-                        if (newAddress == 0)
-                            throw std::runtime_error(std::format(
-                                "Failed to find correct game address (1), signature:\n\t {}", _string.data()));
-
-                        return newAddress;
-                    }
-                    catch (...)
-                    {
-                        throw std::runtime_error(
-                            std::format("Failed to find correct game address (2), signature:\n\t {}", _string.data()));
-                    }
-
-                    return std::uintptr_t{};
-                }
-                else
-                    return address;
-            }
-        }
-
         std::array<char, size> _string{};
         std::array<std::uint16_t, (size + 2) / 3> _bytes{};
         std::size_t _frontMaskCount{};
         std::intptr_t _offset{};
         Callable _callable;
+
+        // _bytes split into byte and mask vectors for the scanner, built at compile time
+        static constexpr std::size_t matchSize = PatternScanner::GetPaddedSize((size + 2) / 3);
+        std::array<std::uint8_t, matchSize> _matchBytes{};
+        std::array<std::uint8_t, matchSize> _matchMask{};
     };
 
     template <auto intSignature, Types::ModuleType type = Types::ModuleType::BaseModule>
@@ -248,13 +240,27 @@ namespace IWXMVM::Signatures
     {
         constexpr Signature()
         {
-            if (const auto modules = Mod::GetGameInterface()->GetModuleHandles(type); modules.has_value())
-                _address = _signature.Scan(modules.value());
+            if (!Mod::GetGameInterface()->GetModuleHandles(type).has_value())
+                return;
+
+            std::uintptr_t (*callable)(std::uintptr_t) = nullptr;
+            if constexpr (requires { _signature._callable(std::uintptr_t{}); })
+                callable = &ApplyCallable;
+
+            const PatternScanner::Pattern pattern{_signature._matchBytes, _signature._matchMask,
+                                                  _signature._bytes.size()};
+            GetPendingSignatures().push_back(
+                {pattern, _signature._string.data(), _signature._offset, callable, type, &_address});
         }
 
         static constexpr auto _signature = intSignature;
         std::uintptr_t _address{};
 
+        static std::uintptr_t ApplyCallable(std::uintptr_t address)
+        {
+            return _signature._callable(address);
+        }
+
         std::uintptr_t operator()() const
         {
             return GetAddress();
@@ -0,0 +1,130 @@
+#include "StdInclude.hpp"
+#include "BoneCache.hpp"
+
+#include "Events.hpp"
+#include "Functions.hpp"
+
+namespace IWXMVM::IW3::BoneCache
+{
+    struct BoneIndexKey
+    {
+        std::array<const Structures::XModel*, MAX_MODELS> models{};
+        std::size_t numModels = 0;
+        uint16_t boneName = 0;
+
+        bool operator==(const BoneIndexKey&) const = default;
+    };
+
+    struct BoneIndexKeyHash
+    {
+        std::size_t operator()(const BoneIndexKey& key) const
+        {
+            auto hash = std::hash<uint16_t>{}(key.boneName);
+            for (std::size_t i = 0; i < key.numModels; i++)
+                hash = hash * 31 + std::hash<const Structures::XModel*>{}(key.models[i]);
+            return hash;
+        }
+    };
+
+    std::unordered_map<std::string, uint16_t> boneNameHandles;
+    std::unordered_map<BoneIndexKey, int32_t, BoneIndexKeyHash> boneIndices;
+
+    const std::vector<std::string>& GetSupportedBoneNames()
+    {
+        static const std::vector<std::string> supportedBoneNames = {
+            "tag_weapon",
+            "tag_flash",
+            "tag_clip",
+            "tag_brass",
+            "j_head",
+            "j_mainroot",
+            "j_wrist_le",
+            "j_wrist_ri",
+            "j_shoulder_le",
+            "j_shoulder_ri",
+            "j_ankle_le",
+            "j_ankle_ri",
+            "tag_origin",
+        };
+        return supportedBoneNames;
+    }
+
+    uint16_t InternBoneName(const std::string& name)
+    {
+        const auto handle = Functions::SL_GetStringOfSize(name.c_str(), 1, name.size() + 1);
+        boneNameHandles.emplace(name, handle);
+        return handle;
+    }
+
+    uint16_t GetBoneNameHandle(const std::string& name)
+    {
+        if (boneNameHandles.empty())
+        {
+            for (const auto& supportedBoneName : GetSupportedBoneNames())
+                InternBoneName(supportedBoneName);
+        }
+
+        if (auto it = boneNameHandles.find(name); it != boneNameHandles.end())
+            return it->second;
+
+        return InternBoneName(name);
+    }
+
+    int32_t WalkModels(const Structures::DObj_s* dobj, uint16_t boneName)
+    {
+        if (!dobj->models || !dobj->numModels)
+            return -1;
+
+        auto boneIndex = -1;
+
+        auto totalBones = 0;
+        for (int m = 0; m < dobj->numModels; m++)
+        {
+            auto model = dobj->models[m];
+            if (!model || !model->numBones)
+                return -1;
+            for (int b = 0; b < model->numBones; b++)
+            {
+                auto bone = model->boneNames[b];
+                if (bone == boneName)
+                {
+                    boneIndex = totalBones + b;
+                }
+            }
+            totalBones += model->numBones;
+        }
+
+        return boneIndex;
+    }
+
+    int32_t FindBoneIndex(const Structures::DObj_s* dobj, const std::string& name)
+    {
+        const auto boneName = GetBoneNameHandle(name);
+
+        if (!dobj->models || dobj->numModels <= 0 || static_cast<std::size_t>(dobj->numModels) > MAX_MODELS)
+            return WalkModels(dobj, boneName);
+
+        BoneIndexKey key;
+        key.numModels = static_cast<std::size_t>(dobj->numModels);
+        key.boneName = boneName;
+        std::copy_n(dobj->models, key.numModels, key.models.begin());
+
+        if (auto it = boneIndices.find(key); it != boneIndices.end())
+            return it->second;
+
+        const auto boneIndex = WalkModels(dobj, boneName);
+        boneIndices.emplace(key, boneIndex);
+        return boneIndex;
+    }
+
+    void Clear()
+    {
+        boneNameHandles.clear();
+        boneIndices.clear();
+    }
+
+    void Initialize()
+    {
+        Events::RegisterListener(EventType::PostDemoLoad, Clear, std::numeric_limits<std::int32_t>::min());
+    }
+}  // namespace IWXMVM::IW3::BoneCache
@@ -0,0 +1,23 @@
+#pragma once
+#include "Structures.hpp"
+
+namespace IWXMVM::IW3::BoneCache
+{
+    // Models a DObj can be made of, DObjs with more are not cached
+    constexpr std::size_t MAX_MODELS = 32;
+
+    const std::vector<std::string>& GetSupportedBoneNames();
+
+    // Script string of the bone name. The supported bone names are interned together on the first lookup after a
+    // map load, other names the first time they are seen.
+    uint16_t GetBoneNameHandle(const std::string& name);
+
+    // Returns the index of the bone across all of the DObj's models, or -1 if none of them has it. Results are cached
+    // per set of models, so a DObj whose models change is looked up again.
+    int32_t FindBoneIndex(const Structures::DObj_s* dobj, const std::string& name);
+
+    // Forgets all handles and indices, as they may refer to strings and models of the previous map
+    void Clear();
+
+    void Initialize();
+}  // namespace IWXMVM::IW3::BoneCache
@@ -0,0 +1,76 @@
+#include "StdInclude.hpp"
+#include "DemoReader.hpp"
+
+namespace IWXMVM::IW3::Demo
+{
+    static_assert(sizeof(ClientArchive) == 52);
+
+    DemoReader::DemoReader(std::istream& stream) : stream(stream)
+    {
+        const auto start = stream.tellg();
+        stream.seekg(0, std::ios::end);
+        size = static_cast<std::uint64_t>(stream.tellg() - start);
+        stream.seekg(start);
+    }
+
+    bool DemoReader::Read(void* destination, std::size_t count)
+    {
+        stream.read(reinterpret_cast<char*>(destination), static_cast<std::streamsize>(count));
+        offset += static_cast<std::uint64_t>(stream.gcount());
+        return static_cast<std::size_t>(stream.gcount()) == count;
+    }
+
+    bool DemoReader::Skip(std::size_t count)
+    {
+        // seeking past the end does not fail, so truncation has to be detected against the size
+        if (offset + count > size)
+        {
+            stream.seekg(0, std::ios::end);
+            offset = size;
+            return false;
+        }
+
+        stream.seekg(static_cast<std::streamoff>(count), std::ios::cur);
+        offset += count;
+        return true;
+    }
+
+    ReadResult DemoReader::Next(Message& message, bool readPayload)
+    {
+        message.offset = offset;
+        message.data.clear();
+
+        uint8_t type;
+        if (!Read(&type, 1))
+            return ReadResult::EndOfDemo;
+
+        message.type = static_cast<MessageType>(type);
+        switch (message.type)
+        {
+            case MessageType::NetworkPacket:
+            {
+                int32_t messageSize;
+                if (!Read(&message.sequence, 4) || !Read(&messageSize, 4))
+                    return ReadResult::Truncated;
+
+                if (messageSize == -1)
+                    return ReadResult::EndOfDemo;
+                if (messageSize < 4 || static_cast<std::size_t>(messageSize) > MAX_MESSAGE_SIZE)
+                    return ReadResult::InvalidMessageSize;
+
+                if (!readPayload)
+                    return Skip(static_cast<std::size_t>(messageSize)) ? ReadResult::Message : ReadResult::Truncated;
+
+                message.data.resize(static_cast<std::size_t>(messageSize));
+                return Read(message.data.data(), message.data.size()) ? ReadResult::Message : ReadResult::Truncated;
+            }
+            case MessageType::ClientArchive:
+                return Read(&message.archive, sizeof(ClientArchive)) ? ReadResult::Message : ReadResult::Truncated;
+            case MessageType::CoD4XProtocolHeader:
+                message.data.resize(COD4X_PROTOCOL_HEADER_SIZE);
+                return Read(message.data.data(), message.data.size()) ? ReadResult::Message : ReadResult::Truncated;
+            default:
+                return ReadResult::UnknownMessageType;
+        }
+    }
+}  // namespace IWXMVM::IW3::Demo
@@ -0,0 +1,80 @@
+#pragma once
+
+namespace IWXMVM::IW3::Demo
+{
+    enum class MessageType : uint8_t
+    {
+        NetworkPacket = 0,
+        ClientArchive = 1,
+        CoD4XProtocolHeader = 2
+    };
+
+    struct ClientArchive
+    {
+        int archiveIndex;
+        float origin[3];
+        float velocity[3];
+        int movementDir;
+        int bobCycle;
+        int serverTime;
+        float viewAngles[3];
+    };
+
+    constexpr std::size_t COD4X_PROTOCOL_HEADER_SIZE = 16;
+    constexpr std::size_t MAX_MESSAGE_SIZE = 0x20000;
+
+    // The type byte, sequence and size of the packet that ends a demo
+    constexpr std::size_t END_OF_DEMO_SIZE = 9;
+
+    struct Message
+    {
+        MessageType type;
+        std::uint64_t offset;  // Offset of the message type byte in the demo file
+
+        // NetworkPacket: the server message sequence and the message as received, starting with the 4 byte reliable
+        // acknowledge. The rest is Huffman compressed with the game's code table and is not decoded anywhere in the
+        // mod, so gamestates, snapshots and entity states cannot be read from a demo file yet. CoD4XProtocolHeader: the
+        // raw header.
+        int32_t sequence = 0;
+        std::vector<uint8_t> data;
+
+        ClientArchive archive{};
+    };
+
+    enum class ReadResult
+    {
+        Message,
+        EndOfDemo,           // Clean end of file or the -1 sized end-of-demo packet
+        Truncated,           // The file ends in the middle of a message
+        UnknownMessageType,  // Only the type byte was consumed
+        InvalidMessageSize,  // A packet claims a size no message can have, its payload was not consumed
+    };
+
+    // Splits a demo file into its messages. Uses only the standard library, so it can be used without the game.
+    class DemoReader
+    {
+       public:
+        explicit DemoReader(std::istream& stream);
+
+        // Reads the next message. Packet payloads are skipped over instead of read when `readPayload` is false.
+        ReadResult Next(Message& message, bool readPayload = true);
+
+        std::uint64_t GetOffset() const
+        {
+            return offset;
+        }
+
+        std::uint64_t GetSize() const
+        {
+            return size;
+        }
+
+       private:
+        bool Read(void* destination, std::size_t count);
+        bool Skip(std::size_t count);
+
+        std::istream& stream;
+        std::uint64_t offset = 0;
+        std::uint64_t size = 0;
+    };
+}  // namespace IWXMVM::IW3::Demo
@@ -0,0 +1,150 @@
+#include "StdInclude.hpp"
+#include "DemoScanner.hpp"
+
+#include <utility>
+
+namespace IWXMVM::IW3::Demo
+{
+    DemoScan ScanDemo(std::istream& stream)
+    {
+        DemoScan scan;
+        DemoReader reader(stream);
+        Message message;
+
+        while (true)
+        {
+            const auto result = reader.Next(message, false);
+            if (result == ReadResult::EndOfDemo || result == ReadResult::Truncated ||
+                result == ReadResult::InvalidMessageSize)
+                break;
+
+            // the reader only consumed the type byte, so keep going from the next byte like the game would
+            if (result == ReadResult::UnknownMessageType)
+            {
+                scan.unhandledMessageCount++;
+                continue;
+            }
+
+            switch (message.type)
+            {
+                case MessageType::ClientArchive:
+                    if (scan.archives.empty() || message.archive.serverTime > scan.archives.back().serverTime)
+                        scan.archives.emplace_back(message.archive);
+                    break;
+                case MessageType::CoD4XProtocolHeader:
+                    scan.isCoD4X = true;
+                    break;
+                default:
+                    break;
+            }
+        }
+
+        return scan;
+    }
+
+    std::optional<std::pair<uint32_t, uint32_t>> DetermineBounds(const std::vector<ClientArchive>& archives)
+    {
+        if (archives.size() < 2)
+            return std::nullopt;
+
+        uint32_t startTick = 0;
+        uint32_t endTick = 0;
+
+        // some of the first batch of 256 archives are outdated (cod4)
+        for (auto itr = archives.begin(); itr != archives.end(); ++itr)
+        {
+            // don't use server times that are <= 0
+            if (itr->serverTime > 0)
+            {
+                startTick = static_cast<std::uint32_t>(itr->serverTime);
+                break;
+            }
+        }
+
+        for (auto itr = archives.rbegin(); itr != archives.rend(); ++itr)
+        {
+            // don't use server times that are <= demo start tick
+            if (itr->serverTime > static_cast<std::int32_t>(startTick))
+            {
+                endTick = 500 + static_cast<std::uint32_t>(itr->serverTime);
+                break;
+            }
+        }
+
+        if (startTick == 0 || endTick == 0 || endTick - startTick > 3600 * 1000 ||
+            static_cast<std::int32_t>(endTick - startTick) < 1000)
+        {
+            return std::nullopt;
+        }
+
+        return std::make_pair(startTick, endTick);
+    }
+
+    Types::DemoMetadata ReadMetadata(std::istream& stream)
+    {
+        const auto scan = ScanDemo(stream);
+
+        Types::DemoMetadata metadata;
+        metadata.archiveCount = static_cast<uint32_t>(scan.archives.size());
+        metadata.isCoD4X = scan.isCoD4X;
+
+        if (const auto bounds = DetermineBounds(scan.archives); bounds.has_value())
+            std::tie(metadata.startTick, metadata.endTick) = bounds.value();
+
+        return metadata;
+    }
+
+    float GetLength(const float (&vector)[3])
+    {
+        return std::sqrt(vector[0] * vector[0] + vector[1] * vector[1] + vector[2] * vector[2]);
+    }
+
+    float GetDistance(const float (&a)[3], const float (&b)[3])
+    {
+        const float difference[3] = {a[0] - b[0], a[1] - b[1], a[2] - b[2]};
+        return GetLength(difference);
+    }
+
+    std::vector<Types::DemoEvent> FindViewCuts(const std::vector<ClientArchive>& archives)
+    {
+        const auto bounds = DetermineBounds(archives);
+        if (!bounds.has_value())
+            return {};
+
+        const auto [startTick, endTick] = bounds.value();
+
+        // Snapshots and server commands are compressed with a Huffman table that is not available here, so cuts are
+        // derived from the client archives, which follow whatever view was recorded. Any cut in that view shows up as
+        // a jump in position that is further than the player could have moved in the time between two archives.
+        constexpr float MIN_TELEPORT_SPEED = 1000.0f;
+        constexpr float TELEPORT_DISTANCE_MARGIN = 64.0f;
+
+        std::vector<Types::DemoEvent> events;
+        for (std::size_t i = 1; i < archives.size(); i++)
+        {
+            const auto& previous = archives[i - 1];
+            const auto& current = archives[i];
+            if (std::cmp_less_equal(current.serverTime, startTick) ||
+                std::cmp_greater_equal(current.serverTime, endTick))
+            {
+                continue;
+            }
+
+            const auto seconds = static_cast<float>(current.serverTime - previous.serverTime) / 1000.0f;
+            const auto speed =
+                std::max({GetLength(previous.velocity), GetLength(current.velocity), MIN_TELEPORT_SPEED});
+            if (GetDistance(previous.origin, current.origin) > speed * seconds + TELEPORT_DISTANCE_MARGIN)
+            {
+                events.push_back({Types::DemoEventType::ViewCut,
+                                  static_cast<uint32_t>(current.serverTime) - startTick});
+            }
+        }
+
+        return events;
+    }
+
+    std::vector<Types::DemoEvent> ReadEvents(std::istream& stream)
+    {
+        return FindViewCuts(ScanDemo(stream).archives);
+    }
+}  // namespace IWXMVM::IW3::Demo
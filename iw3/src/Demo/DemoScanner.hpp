@@ -0,0 +1,33 @@
+#pragma once
+#include "DemoReader.hpp"
+#include "Types/DemoMetadata.hpp"
+#include "Types/DemoEvent.hpp"
+
+namespace IWXMVM::IW3::Demo
+{
+    struct DemoScan
+    {
+        // Archives with increasing server times, in demo order
+        std::vector<ClientArchive> archives;
+        bool isCoD4X = false;
+        uint32_t unhandledMessageCount = 0;
+    };
+
+    // Reads the client archives of a demo and skips over everything else. Like DemoReader, this only uses the standard
+    // library.
+    DemoScan ScanDemo(std::istream& stream);
+
+    // Returns the [start, end) server time range covered by the archives, or nothing if they are unusable
+    std::optional<std::pair<uint32_t, uint32_t>> DetermineBounds(const std::vector<ClientArchive>& archives);
+
+    // Fills everything in the metadata that is stored in the demo's framing and archives. The file's size and write
+    // time are left to the caller, and so is the map name, which is only sent in the compressed gamestate.
+    Types::DemoMetadata ReadMetadata(std::istream& stream);
+
+    // Finds the moments in which the recorded view jumps further than the player could have moved between two
+    // archives. Ticks are relative to the start of the bounds, in archive order.
+    std::vector<Types::DemoEvent> FindViewCuts(const std::vector<ClientArchive>& archives);
+
+    // Scans the demo and returns all events that can be found without decoding its packets
+    std::vector<Types::DemoEvent> ReadEvents(std::istream& stream);
+}  // namespace IWXMVM::IW3::Demo
@@ -0,0 +1,151 @@
+#include "StdInclude.hpp"
+#include "DemoValidator.hpp"
+
+#include "DemoWriter.hpp"
+
+namespace IWXMVM::IW3::Demo
+{
+    // Recordings start with a dump of the client's archive buffer, some of which is outdated (cod4)
+    constexpr std::size_t ARCHIVE_BUFFER_SIZE = 256;
+
+    std::string_view GetIssueName(IssueType type)
+    {
+        switch (type)
+        {
+            case IssueType::Truncated:
+                return "Truncated";
+            case IssueType::UnknownMessageType:
+                return "Unknown message type";
+            case IssueType::InvalidMessageSize:
+                return "Invalid message size";
+            case IssueType::SequenceNotIncreasing:
+                return "Sequence not increasing";
+            case IssueType::ServerTimeDecreasing:
+                return "Server time decreasing";
+            case IssueType::MissingEndOfDemo:
+                return "Missing end of demo";
+            case IssueType::TrailingData:
+                return "Trailing data";
+            default:
+                return "Unknown";
+        }
+    }
+
+    void AddValidationIssue(ValidationReport& report, IssueType type, std::uint64_t offset, std::string description)
+    {
+        report.issueCount++;
+        if (report.issues.size() < MAX_REPORTED_ISSUES)
+            report.issues.push_back({type, offset, std::move(description)});
+    }
+
+    ValidationReport ValidateDemo(std::istream& stream)
+    {
+        DemoReader reader(stream);
+        Message message;
+        ValidationReport report;
+        report.size = reader.GetSize();
+
+        std::optional<int32_t> lastSequence;
+        std::optional<int32_t> lastServerTime;
+
+        while (true)
+        {
+            const auto result = reader.Next(message, false);
+            if (result == ReadResult::EndOfDemo)
+            {
+                // a clean end of file consumes nothing, the end-of-demo packet consumes its header
+                report.hasEndOfDemo = reader.GetOffset() > message.offset;
+                if (!report.hasEndOfDemo)
+                {
+                    AddValidationIssue(report, IssueType::MissingEndOfDemo, message.offset,
+                                       "the recording was not stopped properly");
+                }
+                else if (reader.GetOffset() < report.size)
+                {
+                    AddValidationIssue(report, IssueType::TrailingData, reader.GetOffset(),
+                                       std::format("{} bytes after the end-of-demo packet",
+                                                   report.size - reader.GetOffset()));
+                }
+                break;
+            }
+
+            if (result == ReadResult::Truncated)
+            {
+                AddValidationIssue(report, IssueType::Truncated, message.offset,
+                                   std::format("message type {} ends at the end of the file after {} bytes",
+                                               static_cast<int32_t>(message.type),
+                                               reader.GetOffset() - message.offset));
+                break;
+            }
+
+            if (result == ReadResult::UnknownMessageType)
+            {
+                AddValidationIssue(report, IssueType::UnknownMessageType, message.offset,
+                                   std::format("message type {}", static_cast<int32_t>(message.type)));
+                break;
+            }
+
+            if (result == ReadResult::InvalidMessageSize)
+            {
+                AddValidationIssue(report, IssueType::InvalidMessageSize, message.offset,
+                                   std::format("packet {} is smaller than its header or larger than {} bytes",
+                                               message.sequence, MAX_MESSAGE_SIZE));
+                break;
+            }
+
+            report.messageCount++;
+            report.validSize = reader.GetOffset();
+
+            switch (message.type)
+            {
+                case MessageType::NetworkPacket:
+                    if (lastSequence.has_value() && message.sequence <= lastSequence.value())
+                    {
+                        AddValidationIssue(report, IssueType::SequenceNotIncreasing, message.offset,
+                                           std::format("sequence {} follows {}", message.sequence,
+                                                       lastSequence.value()));
+                    }
+                    lastSequence = message.sequence;
+                    break;
+                case MessageType::ClientArchive:
+                    report.archiveCount++;
+                    if (report.archiveCount <= ARCHIVE_BUFFER_SIZE || message.archive.serverTime <= 0)
+                        break;
+
+                    if (lastServerTime.has_value() && message.archive.serverTime < lastServerTime.value())
+                    {
+                        AddValidationIssue(report, IssueType::ServerTimeDecreasing, message.offset,
+                                           std::format("archive {} has server time {} after {}",
+                                                       message.archive.archiveIndex, message.archive.serverTime,
+                                                       lastServerTime.value()));
+                    }
+                    lastServerTime = message.archive.serverTime;
+                    break;
+                default:
+                    break;
+            }
+        }
+
+        return report;
+    }
+
+    bool RepairDemo(std::istream& input, std::ostream& output, const ValidationReport& report)
+    {
+        std::vector<char> buffer(1024 * 1024);
+        auto remaining = report.validSize;
+        while (remaining > 0)
+        {
+            const auto count = static_cast<std::size_t>(std::min<std::uint64_t>(remaining, buffer.size()));
+            input.read(buffer.data(), static_cast<std::streamsize>(count));
+            if (static_cast<std::size_t>(input.gcount()) != count)
+                return false;
+
+            output.write(buffer.data(), static_cast<std::streamsize>(count));
+            remaining -= count;
+        }
+
+        DemoWriter(output).WriteEndOfDemo();
+        output.flush();
+        return static_cast<bool>(output);
+    }
+}  // namespace IWXMVM::IW3::Demo
@@ -0,0 +1,67 @@
+#pragma once
+#include "DemoReader.hpp"
+
+namespace IWXMVM::IW3::Demo
+{
+    enum class IssueType
+    {
+        // Framing errors, nothing after these can be trusted
+        Truncated,
+        UnknownMessageType,
+        InvalidMessageSize,
+
+        // The messages are intact but out of order, the game plays them regardless
+        SequenceNotIncreasing,
+        ServerTimeDecreasing,
+
+        MissingEndOfDemo,
+        TrailingData,
+    };
+
+    std::string_view GetIssueName(IssueType type);
+
+    struct Issue
+    {
+        IssueType type;
+        std::uint64_t offset;  // Offset of the message type byte the issue was found at
+        std::string description;
+    };
+
+    struct ValidationReport
+    {
+        std::uint64_t size = 0;
+        std::size_t messageCount = 0;
+        std::size_t archiveCount = 0;
+
+        // End of the last message that was read completely. Everything before it is framed correctly.
+        std::uint64_t validSize = 0;
+        bool hasEndOfDemo = false;
+
+        // Only the first MAX_REPORTED_ISSUES are kept, but all of them are counted
+        std::vector<Issue> issues;
+        std::size_t issueCount = 0;
+
+        bool IsValid() const
+        {
+            return issueCount == 0;
+        }
+
+        // A repaired copy is only worth writing if the demo does not end cleanly and something before the damage
+        // survived. Out of order messages are left alone, the game copes with those.
+        bool IsRepairable() const
+        {
+            return messageCount > 0 && (!hasEndOfDemo || validSize + END_OF_DEMO_SIZE < size);
+        }
+    };
+
+    constexpr std::size_t MAX_REPORTED_ISSUES = 64;
+
+    // Checks the framing of every message, the sanity of packet sizes and that sequences and archive server times do
+    // not go backwards. Reads the demo once from start to end and skips packet payloads, so it is cheap enough to run
+    // over a whole library. Like DemoReader, this only uses the standard library.
+    ValidationReport ValidateDemo(std::istream& stream);
+
+    // Copies the correctly framed part of `input` to `output` and ends it with an end-of-demo packet. Returns false if
+    // the output could not be written.
+    bool RepairDemo(std::istream& input, std::ostream& output, const ValidationReport& report);
+}  // namespace IWXMVM::IW3::Demo
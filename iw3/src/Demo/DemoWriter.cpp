@@ -0,0 +1,92 @@
+#include "StdInclude.hpp"
+#include "DemoWriter.hpp"
+
+namespace IWXMVM::IW3::Demo
+{
+    void DemoWriter::Write(const Message& message)
+    {
+        const auto type = static_cast<uint8_t>(message.type);
+        stream.write(reinterpret_cast<const char*>(&type), sizeof(type));
+
+        switch (message.type)
+        {
+            case MessageType::NetworkPacket:
+            {
+                const auto size = static_cast<int32_t>(message.data.size());
+                stream.write(reinterpret_cast<const char*>(&message.sequence), sizeof(message.sequence));
+                stream.write(reinterpret_cast<const char*>(&size), sizeof(size));
+                stream.write(reinterpret_cast<const char*>(message.data.data()), size);
+                break;
+            }
+            case MessageType::ClientArchive:
+                stream.write(reinterpret_cast<const char*>(&message.archive), sizeof(ClientArchive));
+                break;
+            case MessageType::CoD4XProtocolHeader:
+                stream.write(reinterpret_cast<const char*>(message.data.data()), message.data.size());
+                break;
+        }
+    }
+
+    void DemoWriter::WriteEndOfDemo()
+    {
+        // the game ends recordings with a packet whose sequence and size are both -1
+        const auto type = static_cast<uint8_t>(MessageType::NetworkPacket);
+        const int32_t endMarker = -1;
+        stream.write(reinterpret_cast<const char*>(&type), sizeof(type));
+        stream.write(reinterpret_cast<const char*>(&endMarker), sizeof(endMarker));
+        stream.write(reinterpret_cast<const char*>(&endMarker), sizeof(endMarker));
+    }
+
+    std::optional<TrimResult> TrimDemo(std::istream& input, std::ostream& output, int32_t endServerTime,
+                                       const std::function<void(float)>& onProgress, std::stop_token stopToken)
+    {
+        DemoReader reader(input);
+        DemoWriter writer(output);
+        Message message;
+        TrimResult result;
+
+        while (true)
+        {
+            const auto readResult = reader.Next(message);
+            if (readResult == ReadResult::EndOfDemo || readResult == ReadResult::Truncated ||
+                readResult == ReadResult::InvalidMessageSize)
+                break;
+
+            // the game skips over unknown bytes as well, so dropping them keeps the output equivalent
+            if (readResult == ReadResult::UnknownMessageType)
+            {
+                result.skippedMessageCount++;
+                continue;
+            }
+
+            writer.Write(message);
+            result.messageCount++;
+
+            if (message.type != MessageType::ClientArchive)
+                continue;
+
+            if (stopToken.stop_requested())
+                return std::nullopt;
+
+            if (onProgress && reader.GetSize() > 0)
+                onProgress(static_cast<float>(static_cast<double>(reader.GetOffset()) / reader.GetSize()));
+
+            if (message.archive.serverTime > 0)
+            {
+                result.lastServerTime = std::max(result.lastServerTime, message.archive.serverTime);
+                if (message.archive.serverTime >= endServerTime)
+                    break;
+            }
+        }
+
+        if (result.messageCount == 0)
+            return std::nullopt;
+
+        writer.WriteEndOfDemo();
+        output.flush();
+        if (!output)
+            return std::nullopt;
+
+        return result;
+    }
+}  // namespace IWXMVM::IW3::Demo
@@ -0,0 +1,36 @@
+#pragma once
+#include "DemoReader.hpp"
+
+namespace IWXMVM::IW3::Demo
+{
+    // Writes messages in the framing read by DemoReader
+    class DemoWriter
+    {
+       public:
+        explicit DemoWriter(std::ostream& stream) : stream(stream)
+        {
+        }
+
+        void Write(const Message& message);
+        void WriteEndOfDemo();
+
+       private:
+        std::ostream& stream;
+    };
+
+    struct TrimResult
+    {
+        std::size_t messageCount = 0;
+        std::size_t skippedMessageCount = 0;
+        int32_t lastServerTime = 0;  // Server time of the last client archive that was kept
+    };
+
+    // Copies `input` to `output` up to and including the first client archive at or past `endServerTime`, then ends
+    // the demo. Every snapshot is delta compressed against an earlier one, so only the end of a demo can be cut
+    // without re-encoding. `onProgress` receives the fraction of the input read so far after every client archive.
+    // Returns nothing if the input is not a demo, the output could not be written or a stop was requested, which is
+    // checked after every client archive.
+    std::optional<TrimResult> TrimDemo(std::istream& input, std::ostream& output, int32_t endServerTime,
+                                       const std::function<void(float)>& onProgress = {},
+                                       std::stop_token stopToken = {});
+}  // namespace IWXMVM::IW3::Demo
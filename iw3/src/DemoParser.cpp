@@ -5,6 +5,10 @@
 #include "Events.hpp"
 #include "Structures.hpp"
 #include "Utilities/PathUtils.hpp"
+#include "Utilities/CompressedDemo.hpp"
+#include "Demo/DemoWriter.hpp"
+#include "Demo/DemoScanner.hpp"
+#include "Demo/DemoValidator.hpp"
 
 namespace IWXMVM::IW3::DemoParser
 {
@@ -16,121 +20,142 @@ namespace IWXMVM::IW3::DemoParser
         return std::make_pair(demoStartTick, demoEndTick);
     }
 
-    enum class DemoMessageType : uint8_t
+    void Run()
     {
-        NetworkPacket = 0,
-        ClientArchive = 1,
-        CoD4XProtocolHeader = 2
-    };
+        const auto file = CompressedDemo::OpenDemo(Mod::GetGameInterface()->GetDemoInfo().path);
+        if (!file)
+        {
+            throw std::exception("failed to open demo file");
+        }
 
-    void SkipBytes(std::ifstream& file, const int size)
-    {
-        auto pFilestream = file.tellg();
-        pFilestream += size;
+        const auto scan = Demo::ScanDemo(*file);
+        if (scan.unhandledMessageCount > 0)
+            LOG_DEBUG("Encountered {0} unhandled demo messages", scan.unhandledMessageCount);
 
-        file.seekg(pFilestream, std::ios::beg);
-    }
+        demoStartTick = 0;
+        demoEndTick = 0;
 
-    void ReadDemoArchives(std::ifstream& file, std::vector<clientArchiveData_t>& archives)
-    {
-        clientArchiveData_t archive;
-        file.read(reinterpret_cast<char*>(&archive), sizeof(clientArchiveData_t));
+        if (scan.archives.size() >= 2)
+        {
+            const auto bounds = Demo::DetermineBounds(scan.archives);
+            if (bounds.has_value())
+            {
+                std::tie(demoStartTick, demoEndTick) = bounds.value();
+                LOG_DEBUG("Determined demo bounds as {0} and {1}", demoStartTick, demoEndTick);
+            }
+            else
+            {
+                LOG_ERROR("Could not determine demo length due to invalid archives. Cannot render timeline.");
+            }
 
-        if (archives.empty() || archive.serverTime > archives.back().serverTime)
+            Events::Invoke<EventType::OnDemoBoundsDetermined>();
+        }
+        else
         {
-            archives.emplace_back(archive);
+            LOG_ERROR("Could not determine demo length due to lack of client archives (found {0})",
+                      scan.archives.size());
         }
     }
 
-    void Run()
+    std::optional<Types::DemoMetadata> ReadMetadata(const std::filesystem::path& path)
     {
-        std::ifstream file(Mod::GetGameInterface()->GetDemoInfo().path, std::ios::binary);
-        if (!file.is_open())
+        std::error_code error;
+        const auto fileSize = std::filesystem::file_size(path, error);
+        if (error)
+            return std::nullopt;
+        const auto lastWriteTime = std::filesystem::last_write_time(path, error);
+        if (error)
+            return std::nullopt;
+
+        const auto file = CompressedDemo::OpenDemo(path);
+        if (!file)
+            return std::nullopt;
+
+        auto metadata = Demo::ReadMetadata(*file);
+        metadata.fileSize = fileSize;
+        metadata.lastWriteTime = lastWriteTime.time_since_epoch().count();
+        return metadata;
+    }
+
+    std::vector<Types::DemoEvent> ReadEvents(const std::filesystem::path& path)
+    {
+        const auto file = CompressedDemo::OpenDemo(path);
+        if (!file)
+            return {};
+
+        return Demo::ReadEvents(*file);
+    }
+
+    bool WriteTrimmedDemo(const std::filesystem::path& inputPath, const std::filesystem::path& outputPath,
+                          int32_t endServerTime, const std::function<void(float)>& onProgress,
+                          std::stop_token stopToken)
+    {
+        const auto input = CompressedDemo::OpenDemo(inputPath);
+        std::ofstream output(outputPath, std::ios::binary | std::ios::trunc);
+        if (!input || !output.is_open())
         {
-            throw std::exception("failed to open demo file");
+            LOG_ERROR("Failed to open {} for trimming into {}", inputPath.string(), outputPath.string());
+            return false;
         }
 
-        std::vector<clientArchiveData_t> archives;
-
-        while (true)
+        const auto result = Demo::TrimDemo(*input, output, endServerTime, onProgress, stopToken);
+        if (!result.has_value())
         {
-            char messageType;
-            file.read(&messageType, 1);
+            output.close();
+            std::error_code error;
+            std::filesystem::remove(outputPath, error);
+
+            if (stopToken.stop_requested())
+                LOG_INFO("Cancelled writing trimmed demo {}", outputPath.string());
+            else
+                LOG_ERROR("Failed to write trimmed demo {}", outputPath.string());
+            return false;
+        }
 
-            if (file.eof())
-                break;
+        LOG_INFO("Wrote {} messages up to server time {} to {}", result->messageCount, result->lastServerTime,
+                 outputPath.string());
+        return true;
+    }
 
-            switch (messageType)
-            {
-                case (uint8_t)DemoMessageType::NetworkPacket:
-                {
-                    int messageSize = -2;
-
-                    SkipBytes(file, 4);
-                    file.read(reinterpret_cast<char*>(&messageSize), 4);
-                    SkipBytes(file, 4);
-
-                    if (file.eof() || messageSize == -1)
-                    {
-                        break;
-                    }
-
-                    SkipBytes(file, messageSize - 4);
-                    continue;
-                }
-                case (uint8_t)DemoMessageType::ClientArchive:
-                    ReadDemoArchives(file, archives);
-                    continue;
-                case (uint8_t)DemoMessageType::CoD4XProtocolHeader:
-                    SkipBytes(file, 16);
-                    continue;
-                default:
-                    LOG_DEBUG("Encountered unhandled demo message type {0}", messageType);
-                    break;
-            }
+    bool CheckIntegrity(const std::filesystem::path& path, bool repair)
+    {
+        auto input = CompressedDemo::OpenDemo(path);
+        if (!input)
+        {
+            LOG_ERROR("Failed to open {} for validation", path.string());
+            return false;
         }
 
-        demoStartTick = 0;
-        demoEndTick = 0;
-
-        if (archives.size() >= 2)
+        const auto report = Demo::ValidateDemo(*input);
+        if (report.IsValid())
         {
-            // some of the first batch of 256 archives are outdated (cod4)
-            for (auto itr = archives.begin(); itr != archives.end(); ++itr)
-            {
-                // don't use server times that are <= 0
-                if (itr->serverTime > 0)
-                {
-                    demoStartTick = static_cast<std::uint32_t>(itr->serverTime);
-                    break;
-                }
-            }
+            LOG_INFO("{} is intact ({} messages, {} archives)", path.filename().string(), report.messageCount,
+                     report.archiveCount);
+            return true;
+        }
 
-            for (auto itr = archives.rbegin(); itr != archives.rend(); ++itr)
-            {
-                // don't use server times that are <= demo start tick
-                if (itr->serverTime > static_cast<std::int32_t>(demoStartTick))
-                {
-                    demoEndTick = 500 + static_cast<std::uint32_t>(itr->serverTime);
-                    break;
-                }
-            }
+        LOG_WARN("{} has {} issues, {} of {} bytes are intact", path.filename().string(), report.issueCount,
+                 report.validSize, report.size);
+        for (const auto& issue : report.issues)
+            LOG_WARN("  {} at offset {}: {}", Demo::GetIssueName(issue.type), issue.offset, issue.description);
 
-            LOG_DEBUG("Determined demo bounds as {0} and {1}", demoStartTick, demoEndTick);
+        if (!repair || !report.IsRepairable())
+            return false;
 
-            if (demoStartTick == 0 || demoEndTick == 0 || demoEndTick - demoStartTick > 3600 * 1000 ||
-                static_cast<std::int32_t>(demoEndTick - demoStartTick) < 1000)
-            {
-                demoStartTick = demoEndTick = 0;
-                LOG_ERROR("Could not determine demo length due to invalid archives. Cannot render timeline.");
-            }
+        // the damaged demo is kept, and repaired demos are always written uncompressed
+        auto outputPath = CompressedDemo::HasCompressedExtension(path) ? path.parent_path() / path.stem() : path;
+        outputPath.replace_extension(std::format(".repaired{}", Mod::GetGameInterface()->GetDemoExtension()));
 
-            Events::Invoke(EventType::OnDemoBoundsDetermined);
-        }
-        else
+        input = CompressedDemo::OpenDemo(path);
+        std::ofstream output(outputPath, std::ios::binary | std::ios::trunc);
+        if (!input || !output.is_open() || !Demo::RepairDemo(*input, output, report))
         {
-            LOG_ERROR("Could not determine demo length due to lack of client archives (found {0})",
-                      archives.size());
+            LOG_ERROR("Failed to write repaired demo {}", outputPath.string());
+            return false;
         }
+
+        LOG_INFO("Wrote the intact {} messages of {} to {}", report.messageCount, path.filename().string(),
+                 outputPath.string());
+        return false;
     }
-}  // namespace IWXMVM::IW3::DemoParser
+}  // namespace IWXMVM::IW3::DemoParser
\ No newline at end of file
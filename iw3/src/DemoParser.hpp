@@ -1,19 +1,28 @@
 #pragma once
+#include "Types/DemoMetadata.hpp"
+#include "Types/DemoEvent.hpp"
 
 namespace IWXMVM::IW3::DemoParser
 {
-    struct clientArchiveData_t
-    {
-        int archiveIndex;
-        float origin[3];
-        float velocity[3];
-        int movementDir;
-        int bobCycle;
-        int serverTime;
-        float viewAngles[3];
-    };
-
     void Run();
 
     std::pair<int32_t, int32_t> GetDemoTickRange();
+
+    // Opens a demo file, compressed or not, and reads its metadata with Demo::ReadMetadata. Safe to call from any
+    // thread.
+    std::optional<Types::DemoMetadata> ReadMetadata(const std::filesystem::path& path);
+
+    // Opens a demo file and finds its events with Demo::ReadEvents. Like ReadMetadata, this is safe to call from any
+    // thread.
+    std::vector<Types::DemoEvent> ReadEvents(const std::filesystem::path& path);
+
+    // Writes the demo at `inputPath` up to the server time `endServerTime` to `outputPath`, or removes the output if
+    // a stop was requested. Safe to call from any thread.
+    bool WriteTrimmedDemo(const std::filesystem::path& inputPath, const std::filesystem::path& outputPath,
+                          int32_t endServerTime, const std::function<void(float)>& onProgress,
+                          std::stop_token stopToken);
+
+    // Validates the demo at `path` and logs every issue with its offset. If `repair` is set and the demo is damaged,
+    // the intact part is written next to it as "<name>.repaired.dm_1". Safe to call from any thread.
+    bool CheckIntegrity(const std::filesystem::path& path, bool repair);
 }  // namespace IWXMVM::IW3::DemoParser
\ No newline at end of file
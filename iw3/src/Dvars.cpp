@@ -0,0 +1,57 @@
+#include "StdInclude.hpp"
+#include "Dvars.hpp"
+
+namespace IWXMVM::IW3::Dvars
+{
+    Dvar<bool> cl_ingame("cl_ingame");
+    Dvar<bool> raw_input("raw_input");
+    Dvar<bool> sv_cheats("sv_cheats");
+    Dvar<const char*> fs_basepath("fs_basepath");
+    Dvar<float> con_gamemsgwindow0msgtime("con_gamemsgwindow0msgtime");
+    Dvar<std::int32_t> con_gamemsgwindow0linecount("con_gamemsgwindow0linecount");
+
+    // Camera
+    Dvar<float> cg_fov("cg_fov");
+    Dvar<bool> cg_thirdperson("cg_thirdperson");
+    Dvar<float> r_lodBiasRigid("r_lodBiasRigid");
+    Dvar<float> r_lodBiasSkinned("r_lodBiasSkinned");
+
+    // Sun
+    Dvar<glm::vec3> r_lightTweakSunDirection("r_lightTweakSunDirection");
+    Dvar<std::uint32_t> r_lightTweakSunColor("r_lightTweakSunColor");
+    Dvar<float> r_lightTweakSunLight("r_lightTweakSunLight");
+
+    // Depth of field
+    Dvar<bool> r_dof_tweak("r_dof_tweak");
+    Dvar<bool> r_dof_enable("r_dof_enable");
+    Dvar<float> r_dof_farBlur("r_dof_farBlur");
+    Dvar<float> r_dof_farStart("r_dof_farStart");
+    Dvar<float> r_dof_farEnd("r_dof_farEnd");
+    Dvar<float> r_dof_nearBlur("r_dof_nearBlur");
+    Dvar<float> r_dof_nearStart("r_dof_nearStart");
+    Dvar<float> r_dof_nearEnd("r_dof_nearEnd");
+    Dvar<float> r_dof_bias("r_dof_bias");
+
+    // Filmtweaks
+    Dvar<bool> r_filmUseTweaks("r_filmUseTweaks");
+    Dvar<bool> r_filmTweakEnable("r_filmTweakEnable");
+    Dvar<float> r_filmTweakBrightness("r_filmTweakBrightness");
+    Dvar<float> r_filmTweakContrast("r_filmTweakContrast");
+    Dvar<float> r_filmTweakDesaturation("r_filmTweakDesaturation");
+    Dvar<glm::vec3> r_filmTweakLightTint("r_filmTweakLightTint");
+    Dvar<glm::vec3> r_filmTweakDarkTint("r_filmTweakDarkTint");
+    Dvar<bool> r_filmTweakInvert("r_filmTweakInvert");
+
+    // HUD
+    Dvar<bool> cg_draw2D("cg_draw2D");
+    Dvar<bool> cg_drawShellshock("cg_drawShellshock");
+    Dvar<bool> ui_hud_hardcore("ui_hud_hardcore");
+    Dvar<bool> ui_drawCrosshair("ui_drawCrosshair");
+    Dvar<const char*> ui_hud_obituaries("ui_hud_obituaries");
+    Dvar<const char*> g_TeamColor_Allies("g_TeamColor_Allies");
+    Dvar<const char*> g_TeamColor_Axis("g_TeamColor_Axis");
+    Dvar<float> cg_centertime("cg_centertime");
+    Dvar<float> cg_overheadranksize("cg_overheadranksize");
+    Dvar<float> cg_overheadnamessize("cg_overheadnamessize");
+    Dvar<float> cg_overheadiconsize("cg_overheadiconsize");
+}  // namespace IWXMVM::IW3::Dvars
@@ -0,0 +1,59 @@
+#pragma once
+#include "Utilities/DvarRegistry.hpp"
+
+namespace IWXMVM::IW3::Dvars
+{
+    using DvarRegistry::Dvar;
+
+    extern Dvar<bool> cl_ingame;
+    extern Dvar<bool> raw_input;
+    extern Dvar<bool> sv_cheats;
+    extern Dvar<const char*> fs_basepath;
+    extern Dvar<float> con_gamemsgwindow0msgtime;
+    extern Dvar<std::int32_t> con_gamemsgwindow0linecount;
+
+    // Camera
+    extern Dvar<float> cg_fov;
+    extern Dvar<bool> cg_thirdperson;
+    extern Dvar<float> r_lodBiasRigid;
+    extern Dvar<float> r_lodBiasSkinned;
+
+    // Sun
+    extern Dvar<glm::vec3> r_lightTweakSunDirection;
+    extern Dvar<std::uint32_t> r_lightTweakSunColor;
+    extern Dvar<float> r_lightTweakSunLight;
+
+    // Depth of field
+    extern Dvar<bool> r_dof_tweak;
+    extern Dvar<bool> r_dof_enable;
+    extern Dvar<float> r_dof_farBlur;
+    extern Dvar<float> r_dof_farStart;
+    extern Dvar<float> r_dof_farEnd;
+    extern Dvar<float> r_dof_nearBlur;
+    extern Dvar<float> r_dof_nearStart;
+    extern Dvar<float> r_dof_nearEnd;
+    extern Dvar<float> r_dof_bias;
+
+    // Filmtweaks
+    extern Dvar<bool> r_filmUseTweaks;
+    extern Dvar<bool> r_filmTweakEnable;
+    extern Dvar<float> r_filmTweakBrightness;
+    extern Dvar<float> r_filmTweakContrast;
+    extern Dvar<float> r_filmTweakDesaturation;
+    extern Dvar<glm::vec3> r_filmTweakLightTint;
+    extern Dvar<glm::vec3> r_filmTweakDarkTint;
+    extern Dvar<bool> r_filmTweakInvert;
+
+    // HUD
+    extern Dvar<bool> cg_draw2D;
+    extern Dvar<bool> cg_drawShellshock;
+    extern Dvar<bool> ui_hud_hardcore;
+    extern Dvar<bool> ui_drawCrosshair;
+    extern Dvar<const char*> ui_hud_obituaries;
+    extern Dvar<const char*> g_TeamColor_Allies;
+    extern Dvar<const char*> g_TeamColor_Axis;
+    extern Dvar<float> cg_centertime;
+    extern Dvar<float> cg_overheadranksize;
+    extern Dvar<float> cg_overheadnamessize;
+    extern Dvar<float> cg_overheadiconsize;
+}  // namespace IWXMVM::IW3::Dvars
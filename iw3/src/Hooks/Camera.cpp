@@ -6,6 +6,7 @@
 #include "../Structures.hpp"
 #include "../Functions.hpp"
 #include "../Addresses.hpp"
+#include "../Dvars.hpp"
 #include "Mod.hpp"
 
 namespace IWXMVM::IW3::Hooks::Camera
@@ -144,13 +145,12 @@ namespace IWXMVM::IW3::Hooks::Camera
         auto& camera = Components::CameraManager::Get().GetActiveCamera();
         auto isFreeCamera = camera->IsModControlledCameraMode();
 
-        Functions::FindDvar("cg_thirdperson")->current.enabled =
-            (camera->GetMode() == Components::Camera::Mode::ThirdPerson || isFreeCamera) ? 1 : 0;
-        Functions::FindDvar("cg_draw2d")->current.enabled = (isFreeCamera) ? 0 : 1;
-        Functions::FindDvar("cg_drawShellshock")->current.enabled = (isFreeCamera) ? 0 : 1;
+        Dvars::cg_thirdperson.Set(camera->GetMode() == Components::Camera::Mode::ThirdPerson || isFreeCamera);
+        Dvars::cg_draw2D.Set(!isFreeCamera);
+        Dvars::cg_drawShellshock.Set(!isFreeCamera);
 
-        constexpr int32_t LODBIAS = -40000;
-        Functions::FindDvar("r_lodBiasRigid")->current.value = LODBIAS;
-        Functions::FindDvar("r_lodBiasSkinned")->current.value = LODBIAS;
+        constexpr float LODBIAS = -40000;
+        Dvars::r_lodBiasRigid.Set(LODBIAS);
+        Dvars::r_lodBiasSkinned.Set(LODBIAS);
     }
 }  // namespace IWXMVM::IW3::Hooks::Camera
@@ -144,7 +144,7 @@ namespace IWXMVM::IW3::Hooks::Commands
 
         reinterpret_cast<void (*)()>(oldFunction)();
 
-        Events::Invoke(EventType::PostDemoLoad);
+        Events::Invoke<EventType::PostDemoLoad>();
     }
 
     std::vector<FunctionStorage> CmdHooks{{"demo", FunctionStorage::CommandType::ServerCommand, CL_PlayDemo_Hook}};
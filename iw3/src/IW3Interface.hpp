@@ -7,12 +7,16 @@
 #include "Hooks.hpp"
 #include "Events.hpp"
 #include "DemoParser.hpp"
+#include "BoneCache.hpp"
+#include "Dvars.hpp"
 #include "Hooks/Camera.hpp"
 #include "Hooks/Playback.hpp"
 #include "Hooks/HUD.hpp"
 #include "Addresses.hpp"
 #include "Patches.hpp"
 #include "Components/Rewinding.hpp"
+#include "Utilities/CompressedDemo.hpp"
+#include "Utilities/DemoTempCache.hpp"
 
 #include "glm/vec3.hpp"
 #include "glm/gtc/type_ptr.hpp"
@@ -77,11 +81,7 @@ namespace IWXMVM::IW3
         {
             // disable raw_input because it messes with our IN_Frame patch
             // on cod4x
-            auto raw_input = Functions::FindDvar("raw_input");
-            if (raw_input)
-            {
-                raw_input->current.enabled = false;
-            }
+            Dvars::raw_input.Set(false);
         }
 
         void SetupEventListeners() final
@@ -89,16 +89,17 @@ namespace IWXMVM::IW3
             DisableRawInput();
 
             Events::RegisterListener(EventType::PostDemoLoad, DemoParser::Run);
+            BoneCache::Initialize();
 
             Events::RegisterListener(EventType::OnCameraChanged, Hooks::Camera::OnCameraChanged);
 
             Events::RegisterListener(EventType::PostDemoLoad, [&]() { 
-                Functions::FindDvar("sv_cheats")->current.enabled = true; 
+                Dvars::sv_cheats.Set(true);
                 DisableRawInput();
                     
                 // ensure these are set to their defaults, so our killfeed toggle works properly
-                Functions::FindDvar("con_gamemsgwindow0msgtime")->current.value = 5;
-                Functions::FindDvar("con_gamemsgwindow0linecount")->current.integer = 4;
+                Dvars::con_gamemsgwindow0msgtime.Set(5);
+                Dvars::con_gamemsgwindow0linecount.Set(4);
             });
         }
 
@@ -122,7 +123,7 @@ namespace IWXMVM::IW3
 
         Types::GameState GetGameState() final
         {
-            if (!Functions::FindDvar("cl_ingame")->current.enabled)
+            if (!Dvars::cl_ingame.Get())
                 return Types::GameState::MainMenu;
 
             if (Structures::GetClientConnection()->demoplaying)
@@ -143,11 +144,13 @@ namespace IWXMVM::IW3
 
             try
             {
+                // constructing the addresses only registers their signatures, they are all scanned for at once
                 GetGameAddresses();
+                IWXMVM::Signatures::ResolvePendingSignatures();
             }
             catch (std::exception& ex)
             {
-                LOG_ERROR("Failed to find required signature: {}", ex.what());
+                LOG_ERROR("Failed to find required signatures:\n{}", ex.what());
                 if (isRunningIW3xo)
                 {
                     MessageBoxA(NULL,
@@ -216,14 +219,18 @@ namespace IWXMVM::IW3
         Types::DemoInfo GetDemoInfo() final
         {
             demoInfo.name = Structures::GetClientStatic()->servername;
+            // demos played from the temp cache are stored as IWXTMP/<content hash>/<file name>
             demoInfo.name = demoInfo.name.starts_with(DEMO_TEMP_DIRECTORY)
-                                ? demoInfo.name.substr(strlen(DEMO_TEMP_DIRECTORY) + 1)
+                                ? std::filesystem::path(demoInfo.name).filename().string()
                                 : demoInfo.name;
 
             std::string str = static_cast<std::string>(Structures::GetClientStatic()->servername);
             str += (str.ends_with(".dm_1")) ? "" : ".dm_1";
             demoInfo.path = Functions::GetFilePath(std::move(str));
 
+            // "maps/mp/<map>.d3dbsp"
+            demoInfo.mapName = std::filesystem::path(Structures::GetClientActive()->mapname).stem().string();
+
             auto [demoStartTick, demoEndTick] = DemoParser::GetDemoTickRange();
 
             const auto serverTime = Structures::GetClientActive()->serverTime;
@@ -232,6 +239,7 @@ namespace IWXMVM::IW3
                 demoInfo.gameTick = serverTime - demoStartTick;
             }
             demoInfo.endTick = demoEndTick - demoStartTick;
+            demoInfo.startServerTime = demoStartTick;
 
             return demoInfo;
         }
@@ -241,12 +249,34 @@ namespace IWXMVM::IW3
             return {".dm_1"};
         }
 
+        std::optional<Types::DemoMetadata> ReadDemoMetadata(const std::filesystem::path& demoPath) final
+        {
+            return DemoParser::ReadMetadata(demoPath);
+        }
+
+        std::vector<Types::DemoEvent> ReadDemoEvents(const std::filesystem::path& demoPath) final
+        {
+            return DemoParser::ReadEvents(demoPath);
+        }
+
+        bool WriteTrimmedDemo(const std::filesystem::path& demoPath, const std::filesystem::path& outputPath,
+                              int32_t endServerTime, const std::function<void(float)>& onProgress,
+                              std::stop_token stopToken) final
+        {
+            return DemoParser::WriteTrimmedDemo(demoPath, outputPath, endServerTime, onProgress, stopToken);
+        }
+
+        bool CheckDemoIntegrity(const std::filesystem::path& demoPath, bool repair) final
+        {
+            return DemoParser::CheckIntegrity(demoPath, repair);
+        }
+
         void PlayDemo(std::filesystem::path demoPath) final
         {
-            Events::Invoke(EventType::PreDemoLoad);
+            Events::Invoke<EventType::PreDemoLoad>();
             
             const auto demoDirectory =
-                std::filesystem::path(GetDvar("fs_basepath")->value->string) / "players" / "demos";
+                std::filesystem::path(Dvars::fs_basepath.Get("")) / "players" / "demos";
 
             try
             {
@@ -260,8 +290,12 @@ namespace IWXMVM::IW3
                     std::filesystem::create_directories(tempDemoDirectory);
 
                 // an inline sanitation, should remove all invalid characters for IW3.
+                // compressed demos are cached under the game's extension, they are decompressed when read
+                const auto fileName = CompressedDemo::HasCompressedExtension(demoPath) ? demoPath.stem().string()
+                                                                                        : demoPath.filename().string();
+
                 std::string sanitizedFileName;
-                for (char c : demoPath.filename().string())
+                for (char c : fileName)
                 {
                     if (std::isalnum(static_cast<unsigned char>(c)) || c == '_' || c == '-' || c == '.')
                     {
@@ -269,14 +303,10 @@ namespace IWXMVM::IW3
                     }
                 }
 
-                const auto targetPath = tempDemoDirectory / sanitizedFileName;
-                if (std::filesystem::exists(targetPath) && std::filesystem::is_regular_file(targetPath))
-                    std::filesystem::remove(targetPath);
+                const auto targetPath = DemoTempCache::Prepare(demoPath, tempDemoDirectory, sanitizedFileName);
+                const auto relativePath = std::filesystem::relative(targetPath, demoDirectory).generic_string();
 
-                std::filesystem::copy(demoPath, targetPath);
-
-                Functions::Cbuf_AddText(
-                    std::format(R"(demo "{0}/{1}")", DEMO_TEMP_DIRECTORY, targetPath.filename().string()));
+                Functions::Cbuf_AddText(std::format(R"(demo "{0}")", relativePath));
             }
             catch (std::filesystem::filesystem_error& e)
             {
@@ -309,31 +339,24 @@ namespace IWXMVM::IW3
             Types::Dvar dvar;
             dvar.name = iw3Dvar->name;
             dvar.value = (Types::Dvar::Value*)&iw3Dvar->current;
+            dvar.modified = &iw3Dvar->modified;
 
             return dvar;
         }
 
         void SetFov(float fov) final
         {
-            Functions::FindDvar("cg_fov")->current.value = fov;
+            Dvars::cg_fov.Set(fov);
         }
 
         Types::Sun GetSun() final
         {
-            const auto& r_lightTweakSunDirection = Functions::FindDvar("r_lightTweakSunDirection");
-            const auto& r_lightTweakSunColor = Functions::FindDvar("r_lightTweakSunColor");
-            const auto& r_lightTweakSunLight = Functions::FindDvar("r_lightTweakSunLight");
-
-            auto unpackedColor = glm::unpackUint4x8(r_lightTweakSunColor->current.integer);
+            auto unpackedColor = glm::unpackUint4x8(Dvars::r_lightTweakSunColor.Get());
 
             Types::Sun sun;
             sun.color = glm::vec3(unpackedColor.x / 255.0f, unpackedColor.y / 255.0f, unpackedColor.z / 255.0f);
-            sun.direction = glm::vec3(
-                r_lightTweakSunDirection->current.vector[0], 
-                r_lightTweakSunDirection->current.vector[1],
-                r_lightTweakSunDirection->current.vector[2]
-            );
-            sun.brightness = Functions::FindDvar("r_lightTweakSunLight")->current.value;
+            sun.direction = Dvars::r_lightTweakSunDirection.Get();
+            sun.brightness = Dvars::r_lightTweakSunLight.Get();
             return sun;
         }
 
@@ -341,15 +364,14 @@ namespace IWXMVM::IW3
         {
             Types::DoF dof = 
             {
-                Functions::FindDvar("r_dof_tweak")->current.enabled &&
-                    Functions::FindDvar("r_dof_enable")->current.enabled,
-                Functions::FindDvar("r_dof_farBlur")->current.value,
-                Functions::FindDvar("r_dof_farStart")->current.value,
-                Functions::FindDvar("r_dof_farEnd")->current.value,
-                Functions::FindDvar("r_dof_nearBlur")->current.value,
-                Functions::FindDvar("r_dof_nearStart")->current.value,
-                Functions::FindDvar("r_dof_nearEnd")->current.value,
-                Functions::FindDvar("r_dof_bias")->current.value
+                Dvars::r_dof_tweak.Get() && Dvars::r_dof_enable.Get(),
+                Dvars::r_dof_farBlur.Get(),
+                Dvars::r_dof_farStart.Get(),
+                Dvars::r_dof_farEnd.Get(),
+                Dvars::r_dof_nearBlur.Get(),
+                Dvars::r_dof_nearStart.Get(),
+                Dvars::r_dof_nearEnd.Get(),
+                Dvars::r_dof_bias.Get()
             };
 
             return dof;
@@ -358,14 +380,13 @@ namespace IWXMVM::IW3
         Types::Filmtweaks GetFilmtweaks()
         {
             Types::Filmtweaks filmtweaks = {
-                Functions::FindDvar("r_filmUseTweaks")->current.enabled &&
-                    Functions::FindDvar("r_filmTweakEnable")->current.enabled,
-                Functions::FindDvar("r_filmTweakBrightness")->current.value,
-                Functions::FindDvar("r_filmTweakContrast")->current.value,
-                Functions::FindDvar("r_filmTweakDesaturation")->current.value,
-                glm::make_vec3(Functions::FindDvar("r_filmTweakLightTint")->current.vector),
-                glm::make_vec3(Functions::FindDvar("r_filmTweakDarkTint")->current.vector),
-                Functions::FindDvar("r_filmTweakInvert")->current.enabled
+                Dvars::r_filmUseTweaks.Get() && Dvars::r_filmTweakEnable.Get(),
+                Dvars::r_filmTweakBrightness.Get(),
+                Dvars::r_filmTweakContrast.Get(),
+                Dvars::r_filmTweakDesaturation.Get(),
+                Dvars::r_filmTweakLightTint.Get(),
+                Dvars::r_filmTweakDarkTint.Get(),
+                Dvars::r_filmTweakInvert.Get()
             };
 
             return filmtweaks;
@@ -374,22 +395,22 @@ namespace IWXMVM::IW3
         Types::HudInfo GetHudInfo()
         {
             glm::vec3 teamColorAllies;
-            auto ss = std::stringstream(Functions::FindDvar("g_TeamColor_Allies")->current.string);
+            auto ss = std::stringstream(Dvars::g_TeamColor_Allies.Get(""));
             ss >> teamColorAllies[0] >> teamColorAllies[1] >> teamColorAllies[2];
             
             glm::vec3 teamColorAxis;
-            ss = std::stringstream(Functions::FindDvar("g_TeamColor_Axis")->current.string);
+            ss = std::stringstream(Dvars::g_TeamColor_Axis.Get(""));
             ss >> teamColorAxis[0] >> teamColorAxis[1] >> teamColorAxis[2];
 
             Types::HudInfo hudInfo = {
-                Functions::FindDvar("cg_draw2D")->current.enabled,
-                !Functions::FindDvar("ui_hud_hardcore")->current.enabled,
-                Functions::FindDvar("cg_drawShellshock")->current.enabled,
-                Functions::FindDvar("ui_drawCrosshair")->current.enabled, 
+                Dvars::cg_draw2D.Get(),
+                !Dvars::ui_hud_hardcore.Get(),
+                Dvars::cg_drawShellshock.Get(),
+                Dvars::ui_drawCrosshair.Get(), 
                 Hooks::HUD::showScore,
                 Hooks::HUD::showOtherText, 
                 !Patches::GetGamePatches().CG_DrawPlayerLowHealthOverlay.IsApplied(),
-                Functions::FindDvar("ui_hud_obituaries")->current.string[0] == '1',
+                Dvars::ui_hud_obituaries.Get("1")[0] == '1',
                 teamColorAllies,   
                 teamColorAxis
             };
@@ -397,82 +418,111 @@ namespace IWXMVM::IW3
             return hudInfo;
         }
 
-        void SetSun(Types::Sun sun) final
+        void SetSun(Types::Sun sun, FieldDiff::FieldMask changedFields) final
         {
-            const auto& r_lightTweakSunDirection = Functions::FindDvar("r_lightTweakSunDirection");
-            const auto& r_lightTweakSunColor = Functions::FindDvar("r_lightTweakSunColor");
-            const auto& r_lightTweakSunLight = Functions::FindDvar("r_lightTweakSunLight");
-            auto packedColor = glm::packUint4x8(glm::i8vec4(static_cast<uint8_t>(sun.color.x * 255),
-                                                           static_cast<uint8_t>(sun.color.y * 255),
-                                                           static_cast<uint8_t>(sun.color.z * 255), 1));
-            for (int i = 0; i < 3; ++i)
+            using FieldDiff::IsFieldChanged;
+
+            if (IsFieldChanged<&Types::Sun::direction>(changedFields))
             {
-                r_lightTweakSunDirection->current.vector[i] = sun.direction[i];
+                Dvars::r_lightTweakSunDirection.Set(sun.direction);
+                Dvars::r_lightTweakSunDirection.MarkModified();
             }
-            r_lightTweakSunColor->current.integer = packedColor;
-            r_lightTweakSunLight->current.value = sun.brightness;
 
-            r_lightTweakSunDirection->modified = true;
-            r_lightTweakSunColor->modified = true;
-            r_lightTweakSunLight->modified = true;
+            if (IsFieldChanged<&Types::Sun::color>(changedFields))
+            {
+                auto packedColor = glm::packUint4x8(glm::i8vec4(static_cast<uint8_t>(sun.color.x * 255),
+                                                               static_cast<uint8_t>(sun.color.y * 255),
+                                                               static_cast<uint8_t>(sun.color.z * 255), 1));
+                Dvars::r_lightTweakSunColor.Set(packedColor);
+                Dvars::r_lightTweakSunColor.MarkModified();
+            }
+
+            if (IsFieldChanged<&Types::Sun::brightness>(changedFields))
+            {
+                Dvars::r_lightTweakSunLight.Set(sun.brightness);
+                Dvars::r_lightTweakSunLight.MarkModified();
+            }
         }
 
-        void SetDof(Types::DoF dof) final
+        void SetDof(Types::DoF dof, FieldDiff::FieldMask changedFields) final
         {
-            Functions::FindDvar("r_dof_tweak")->current.enabled = dof.enabled;
-            Functions::FindDvar("r_dof_enable")->current.enabled = dof.enabled;
-            
-            Functions::FindDvar("r_dof_farBlur")->current.value = dof.farBlur;
-            Functions::FindDvar("r_dof_farStart")->current.value = dof.farStart;
-            Functions::FindDvar("r_dof_farEnd")->current.value = dof.farEnd;
-            
-            // hacky workaround because nearblur works weirdly in this game
-            if (dof.nearBlur < 1.3f)
+            using FieldDiff::IsFieldChanged;
+
+            if (IsFieldChanged<&Types::DoF::enabled>(changedFields))
             {
-                dof.nearBlur = 5;
-                dof.nearStart = 0;
-                dof.nearEnd = 0;
+                Dvars::r_dof_tweak.Set(dof.enabled);
+                Dvars::r_dof_enable.Set(dof.enabled);
             }
 
-            Functions::FindDvar("r_dof_nearBlur")->current.value = dof.nearBlur;
-            Functions::FindDvar("r_dof_nearStart")->current.value = dof.nearStart;
-            Functions::FindDvar("r_dof_nearEnd")->current.value = dof.nearEnd;
+            if (IsFieldChanged<&Types::DoF::farBlur>(changedFields))
+                Dvars::r_dof_farBlur.Set(dof.farBlur);
+            if (IsFieldChanged<&Types::DoF::farStart>(changedFields))
+                Dvars::r_dof_farStart.Set(dof.farStart);
+            if (IsFieldChanged<&Types::DoF::farEnd>(changedFields))
+                Dvars::r_dof_farEnd.Set(dof.farEnd);
+
+            // the near values depend on each other through the workaround below, so they are always written together
+            if (IsFieldChanged<&Types::DoF::nearBlur>(changedFields) ||
+                IsFieldChanged<&Types::DoF::nearStart>(changedFields) ||
+                IsFieldChanged<&Types::DoF::nearEnd>(changedFields))
+            {
+                // hacky workaround because nearblur works weirdly in this game
+                if (dof.nearBlur < 1.3f)
+                {
+                    dof.nearBlur = 5;
+                    dof.nearStart = 0;
+                    dof.nearEnd = 0;
+                }
 
-            Functions::FindDvar("r_dof_bias")->current.value = dof.bias;
+                Dvars::r_dof_nearBlur.Set(dof.nearBlur);
+                Dvars::r_dof_nearStart.Set(dof.nearStart);
+                Dvars::r_dof_nearEnd.Set(dof.nearEnd);
+            }
+
+            if (IsFieldChanged<&Types::DoF::bias>(changedFields))
+                Dvars::r_dof_bias.Set(dof.bias);
         }
 
-        void SetFilmtweaks(Types::Filmtweaks filmtweaks) final
+        void SetFilmtweaks(Types::Filmtweaks filmtweaks, FieldDiff::FieldMask changedFields) final
         {
-            Functions::FindDvar("r_filmUseTweaks")->current.enabled = filmtweaks.enabled;
-            Functions::FindDvar("r_filmTweakEnable")->current.enabled = filmtweaks.enabled;
-            Functions::FindDvar("r_filmTweakBrightness")->current.value = filmtweaks.brightness;
-            Functions::FindDvar("r_filmTweakContrast")->current.value = filmtweaks.contrast;
-            Functions::FindDvar("r_filmTweakDesaturation")->current.value = filmtweaks.desaturation;
-            for (int i = 0; i < 3; ++i)
+            using FieldDiff::IsFieldChanged;
+
+            if (IsFieldChanged<&Types::Filmtweaks::enabled>(changedFields))
             {
-                Functions::FindDvar("r_filmTweakLightTint")->current.vector[i] =
-                    glm::value_ptr(filmtweaks.tintLight)[i];
-                Functions::FindDvar("r_filmTweakDarkTint")->current.vector[i] = glm::value_ptr(filmtweaks.tintDark)[i];
+                Dvars::r_filmUseTweaks.Set(filmtweaks.enabled);
+                Dvars::r_filmTweakEnable.Set(filmtweaks.enabled);
             }
-            Functions::FindDvar("r_filmTweakInvert")->current.enabled = filmtweaks.invert;
+
+            if (IsFieldChanged<&Types::Filmtweaks::brightness>(changedFields))
+                Dvars::r_filmTweakBrightness.Set(filmtweaks.brightness);
+            if (IsFieldChanged<&Types::Filmtweaks::contrast>(changedFields))
+                Dvars::r_filmTweakContrast.Set(filmtweaks.contrast);
+            if (IsFieldChanged<&Types::Filmtweaks::desaturation>(changedFields))
+                Dvars::r_filmTweakDesaturation.Set(filmtweaks.desaturation);
+            if (IsFieldChanged<&Types::Filmtweaks::tintLight>(changedFields))
+                Dvars::r_filmTweakLightTint.Set(filmtweaks.tintLight);
+            if (IsFieldChanged<&Types::Filmtweaks::tintDark>(changedFields))
+                Dvars::r_filmTweakDarkTint.Set(filmtweaks.tintDark);
+            if (IsFieldChanged<&Types::Filmtweaks::invert>(changedFields))
+                Dvars::r_filmTweakInvert.Set(filmtweaks.invert);
         }
 
         void SetHudInfo(Types::HudInfo hudInfo) final
         {
-            Functions::FindDvar("con_gamemsgwindow0msgtime")->current.value = 5;
-            Functions::FindDvar("con_gamemsgwindow0linecount")->current.integer = 4;
+            Dvars::con_gamemsgwindow0msgtime.Set(5);
+            Dvars::con_gamemsgwindow0linecount.Set(4);
 
-            Functions::FindDvar("cg_draw2D")->current.enabled = hudInfo.show2DElements;
+            Dvars::cg_draw2D.Set(hudInfo.show2DElements);
 
-            Functions::FindDvar("ui_hud_hardcore")->current.enabled = !hudInfo.showPlayerHUD;
-            Functions::FindDvar("cg_centertime")->current.value = hudInfo.showPlayerHUD ? 5.0f : 0.0f;
-            Functions::FindDvar("cg_overheadranksize")->current.value = hudInfo.showPlayerHUD ? 0.5f : 0;
-            Functions::FindDvar("cg_overheadnamessize")->current.value = hudInfo.showPlayerHUD ? 0.5f : 0;
-            Functions::FindDvar("cg_overheadiconsize")->current.value = hudInfo.showPlayerHUD ? 0.7f : 0;
+            Dvars::ui_hud_hardcore.Set(!hudInfo.showPlayerHUD);
+            Dvars::cg_centertime.Set(hudInfo.showPlayerHUD ? 5.0f : 0.0f);
+            Dvars::cg_overheadranksize.Set(hudInfo.showPlayerHUD ? 0.5f : 0);
+            Dvars::cg_overheadnamessize.Set(hudInfo.showPlayerHUD ? 0.5f : 0);
+            Dvars::cg_overheadiconsize.Set(hudInfo.showPlayerHUD ? 0.7f : 0);
 
-            Functions::FindDvar("cg_drawShellshock")->current.enabled = hudInfo.showShellshock;
-            Functions::FindDvar("ui_hud_obituaries")->current.string = hudInfo.showKillfeed ? "1" : "0";
-            Functions::FindDvar("ui_drawCrosshair")->current.enabled = hudInfo.showCrosshair;
+            Dvars::cg_drawShellshock.Set(hudInfo.showShellshock);
+            Dvars::ui_hud_obituaries.Set(hudInfo.showKillfeed ? "1" : "0");
+            Dvars::ui_drawCrosshair.Set(hudInfo.showCrosshair);
             Hooks::HUD::showScore = hudInfo.showScore;
             Hooks::HUD::showOtherText = hudInfo.showOtherText;
             if (hudInfo.showBloodOverlay)
@@ -500,10 +550,8 @@ namespace IWXMVM::IW3
             Functions::Dvar_SetStringByName("g_TeamColor_Axis", teamColorAxis.str().c_str());
         }
         
-        std::vector<Types::Entity> GetEntities() final
+        void GetEntities(std::span<Types::Entity> entities) final
         {
-            std::vector<Types::Entity> entities;
-            
             auto cg_entities = Structures::GetEntities();
 
             auto ToEntityType = [](char eType) -> Types::EntityType {
@@ -524,48 +572,17 @@ namespace IWXMVM::IW3
                 }
             };
 
-            for (int i = 0; i < 256; i++)
-            {
-                auto entity = cg_entities[i];
-                entities.push_back(
-                    Types::Entity
-                    {
-                        .id = i, 
-                        .type = ToEntityType(entity.pose.eType),
-                        .clientNum = entity.nextState.clientNum,
-                        .isValid = entity.nextValid
-                    }
-                );
-            }
-
-            return entities;
-        }
-
-        auto FindBoneIndex(Structures::DObj_s* dobj, uint16_t boneName)
-        {
-            if (!dobj->models || !dobj->numModels)
-                return -1;
-
-            auto boneIndex = -1;
-
-            auto totalBones = 0;
-            for (int m = 0; m < dobj->numModels; m++)
+            for (int i = 0; i < static_cast<int>(entities.size()); i++)
             {
-                auto model = dobj->models[m];
-                if (!model || !model->numBones)
-                    return -1;
-                for (int b = 0; b < model->numBones; b++)
+                const auto& entity = cg_entities[i];
+                entities[i] = Types::Entity
                 {
-                    auto bone = model->boneNames[b];
-                    if (bone == boneName)
-                    {
-                        boneIndex = totalBones + b;
-                    }
-                }
-                totalBones += model->numBones;
+                    .id = i, 
+                    .type = ToEntityType(entity.pose.eType),
+                    .clientNum = entity.nextState.clientNum,
+                    .isValid = entity.nextValid
+                };
             }
-
-            return boneIndex;
         }
 
         Types::BoneData GetBoneData(int32_t entityId, const std::string& name) final
@@ -578,11 +595,10 @@ namespace IWXMVM::IW3
 
             auto entities = Structures::GetEntities();
             auto entity = &entities[entityId];
-            auto boneName = Functions::SL_GetStringOfSize(name.c_str(), 1, name.size() + 1);
 
             const auto orgTimeStamp = std::exchange(dobj->skel.timeStamp, Structures::GetClientActive()->skelTimeStamp);
 
-            auto boneIndex = FindBoneIndex(dobj, boneName);
+            auto boneIndex = BoneCache::FindBoneIndex(dobj, name);
             if (boneIndex == -1)
             {
                 // LOG_ERROR("Bone {0} was not found in {1} models", boneName, (int)dobj->numModels);
@@ -608,28 +624,11 @@ namespace IWXMVM::IW3
             return boneData;
         }
 
-        constexpr std::vector<std::string> GetSupportedBoneNames()
+        const std::vector<std::string>& GetSupportedBoneNames() final
         {
-            return
-            {
-                "tag_weapon", 
-                "tag_flash",     
-                "tag_clip",      
-                "tag_brass",
-                "j_head",
-                "j_mainroot",
-                "j_wrist_le",
-                "j_wrist_ri",
-                "j_shoulder_le",
-                "j_shoulder_ri",
-                "j_ankle_le",
-                "j_ankle_ri",
-                "tag_origin"
-            };
+            return BoneCache::GetSupportedBoneNames();
         }
 
-
-
         void CL_FirstSnapshot()
         {
             uintptr_t CL_FirstSnapshot = GetGameAddresses().CL_FirstSnapshot();
@@ -0,0 +1,156 @@
+#include "StdInclude.hpp"
+#include "TestFramework.hpp"
+
+#include "Components/ArcLengthTable.hpp"
+
+using namespace IWXMVM;
+
+namespace
+{
+    const Types::KeyframeableProperty cameraProperty(Types::KeyframeablePropertyType::CampathCamera, "Camera",
+                                                     Types::KeyframeValueType::CameraData, -50, 50);
+
+    Types::Keyframe MakeNode(uint32_t tick, glm::vec3 position,
+                             Types::InterpolationMode interpolation = Types::InterpolationMode::Cubic)
+    {
+        Types::Keyframe keyframe(cameraProperty, tick, Types::CameraData{position, glm::vec3(0), 90.0f});
+        keyframe.interpolation = interpolation;
+        return keyframe;
+    }
+
+    MathUtils::KeyframeCurve MakeCurve(const std::vector<Types::Keyframe>& keyframes)
+    {
+        MathUtils::KeyframeCurve curve;
+        curve.Build(cameraProperty, keyframes);
+        return curve;
+    }
+
+    float MeasurePolylineLength(const MathUtils::KeyframeCurve& curve, float startTick, float endTick)
+    {
+        float length = 0.0f;
+        auto previous = curve.Evaluate(startTick).cameraData.position;
+        for (auto tick = startTick + 0.05f; tick <= endTick; tick += 0.05f)
+        {
+            const auto position = curve.Evaluate(tick).cameraData.position;
+            length += glm::distance(position, previous);
+            previous = position;
+        }
+        return length;
+    }
+
+    std::vector<Types::Keyframe> MakeWindingCampath()
+    {
+        std::vector<Types::Keyframe> keyframes;
+        for (uint32_t i = 0; i < 12; i++)
+        {
+            // uneven spacing in both time and distance, so constant speed differs from the timeline
+            const auto tick = i * 100 + (i % 3) * 40;
+            keyframes.push_back(MakeNode(tick, glm::vec3(i * 50.0f, (i % 2) * 200.0f, i * i * 3.0f)));
+        }
+        return keyframes;
+    }
+}  // namespace
+
+TEST_CASE(LinearCampathLengthIsTheDistance)
+{
+    const auto curve = MakeCurve({
+        MakeNode(0, glm::vec3(0, 0, 0), Types::InterpolationMode::Linear),
+        MakeNode(100, glm::vec3(300, 0, 0), Types::InterpolationMode::Linear),
+        MakeNode(1000, glm::vec3(400, 0, 0), Types::InterpolationMode::Linear),
+    });
+
+    Components::ArcLengthTable table;
+    table.Update(curve);
+    CHECK_NEAR(table.GetTotalLength(), 400.0f, 0.1f);
+
+    // half of the length is reached within the first, short segment
+    const auto tick = table.GetConstantSpeedTick(curve, 500.0f);
+    CHECK_NEAR(curve.Evaluate(tick).cameraData.position.x, 200.0f, 0.5f);
+}
+
+TEST_CASE(CubicCampathLengthMatchesPolyline)
+{
+    const auto curve = MakeCurve(MakeWindingCampath());
+
+    Components::ArcLengthTable table;
+    table.Update(curve);
+
+    const auto& keyframes = curve.GetKeyframes();
+    const auto expected = MeasurePolylineLength(curve, keyframes.front().tick, keyframes.back().tick);
+    CHECK_NEAR(table.GetTotalLength(), expected, expected * 0.002f);
+}
+
+TEST_CASE(ConstantSpeedTickMovesAtConstantSpeed)
+{
+    const auto curve = MakeCurve(MakeWindingCampath());
+
+    Components::ArcLengthTable table;
+    table.Update(curve);
+
+    const auto& keyframes = curve.GetKeyframes();
+    const auto startTick = static_cast<float>(keyframes.front().tick);
+    const auto endTick = static_cast<float>(keyframes.back().tick);
+
+    // the distance travelled has to grow linearly with the timeline, however the nodes are spaced
+    for (auto tick = startTick + 50.0f; tick < endTick; tick += 50.0f)
+    {
+        const auto progress = (tick - startTick) / (endTick - startTick);
+        const auto travelled = MeasurePolylineLength(curve, startTick, table.GetConstantSpeedTick(curve, tick));
+        CHECK_NEAR(travelled, progress * table.GetTotalLength(), table.GetTotalLength() * 0.002f);
+    }
+}
+
+TEST_CASE(EditedCampathMatchesAFreshTable)
+{
+    // the natural cubic spline is global, so moving the first node changes the shape of the last segment too
+    auto keyframes = MakeWindingCampath();
+
+    Components::ArcLengthTable editedTable;
+    editedTable.Update(MakeCurve(keyframes));
+
+    keyframes.front().value.cameraData.position += glm::vec3(0, 0, 800);
+    const auto editedCurve = MakeCurve(keyframes);
+    editedTable.Update(editedCurve);
+
+    Components::ArcLengthTable freshTable;
+    freshTable.Update(editedCurve);
+
+    CHECK_EQ(editedTable.GetTotalLength(), freshTable.GetTotalLength());
+    for (float length = 0.0f; length < freshTable.GetTotalLength(); length += 25.0f)
+    {
+        CHECK_EQ(editedTable.GetTickAtLength(editedCurve, length), freshTable.GetTickAtLength(editedCurve, length));
+    }
+}
+
+TEST_CASE(UnchangedCampathIsNotRebuilt)
+{
+    auto keyframes = MakeWindingCampath();
+    const auto curve = MakeCurve(keyframes);
+
+    Components::ArcLengthTable table;
+    table.Update(curve);
+
+    const auto rebuilds = Tests::GetLogCount(Tests::LogLevel::Debug);
+    table.Update(MakeCurve(keyframes));
+    CHECK_EQ(Tests::GetLogCount(Tests::LogLevel::Debug), rebuilds);
+
+    // rotation and fov do not change the path
+    keyframes[3].value.cameraData.rotation.y += 45.0f;
+    keyframes[3].value.cameraData.fov = 60.0f;
+    table.Update(MakeCurve(keyframes));
+    CHECK_EQ(Tests::GetLogCount(Tests::LogLevel::Debug), rebuilds);
+
+    keyframes[3].tick += 1;
+    table.Update(MakeCurve(keyframes));
+    CHECK_EQ(Tests::GetLogCount(Tests::LogLevel::Debug), rebuilds + 1);
+}
+
+TEST_CASE(ShortCampathKeepsTimelineTick)
+{
+    const auto curve = MakeCurve({MakeNode(100, glm::vec3(0))});
+
+    Components::ArcLengthTable table;
+    table.Update(curve);
+    CHECK_EQ(table.GetTotalLength(), 0.0f);
+    CHECK_EQ(table.GetConstantSpeedTick(curve, 250.0f), 250.0f);
+}
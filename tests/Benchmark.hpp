@@ -0,0 +1,49 @@
+#pragma once
+
+// Benchmarks are plain executables, they are built with the tests but not run by ctest
+
+namespace IWXMVM::Tests
+{
+    struct BenchmarkResult
+    {
+        double medianNanoseconds;
+        double minNanoseconds;
+    };
+
+    // Runs `function` in batches of `iterations` calls until `minDuration` has passed, and reports the time per call
+    template <typename Function>
+    BenchmarkResult Benchmark(const char* name, std::size_t iterations, Function&& function,
+                              std::chrono::milliseconds minDuration = std::chrono::milliseconds(500))
+    {
+        using Clock = std::chrono::steady_clock;
+
+        std::vector<double> batches;
+        const auto begin = Clock::now();
+        do
+        {
+            const auto start = Clock::now();
+            for (std::size_t i = 0; i < iterations; i++)
+            {
+                function();
+            }
+            const auto elapsed = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+            batches.push_back(elapsed / static_cast<double>(iterations));
+        } while (Clock::now() - begin < minDuration || batches.size() < 3);
+
+        std::sort(batches.begin(), batches.end());
+        const BenchmarkResult result{batches[batches.size() / 2], batches.front()};
+        std::printf("%-56s %12.1f ns  (min %.1f ns, %zu batches of %zu)\n", name, result.medianNanoseconds,
+                    result.minNanoseconds, batches.size(), iterations);
+        return result;
+    }
+
+    inline const void* volatile benchmarkSink = nullptr;
+
+    // Keeps the compiler from optimizing away a result
+    template <typename T>
+    void DoNotOptimize(const T& value)
+    {
+        benchmarkSink = &value;
+        std::atomic_signal_fence(std::memory_order_seq_cst);
+    }
+}  // namespace IWXMVM::Tests
@@ -0,0 +1,212 @@
+#include "StdInclude.hpp"
+#include "TestFramework.hpp"
+
+#include <random>
+
+#include "Utilities/CompressedDemo.hpp"
+#include "Demo/DemoReader.hpp"
+#include "Demo/DemoWriter.hpp"
+
+using namespace IWXMVM;
+
+namespace
+{
+    // A fresh directory for the demos of one test, removed again when the test ends
+    struct Sandbox
+    {
+        std::filesystem::path root;
+
+        Sandbox()
+        {
+            static int counter = 0;
+            const auto now = std::chrono::steady_clock::now().time_since_epoch().count();
+            root = std::filesystem::temp_directory_path() / std::format("iwxmvm_compressed_demo_{}_{}", now, counter++);
+            std::filesystem::create_directories(root);
+        }
+
+        ~Sandbox()
+        {
+            std::error_code error;
+            std::filesystem::remove_all(root, error);
+        }
+
+        std::filesystem::path Write(const std::string& name, const std::string& content) const
+        {
+            const auto path = root / name;
+            std::ofstream file(path, std::ios::binary | std::ios::trunc);
+            file.write(content.data(), content.size());
+            return path;
+        }
+    };
+
+    // Compressible like a demo, with runs of repeated bytes between random ones
+    std::string MakeContent(std::size_t size)
+    {
+        std::mt19937 random(1234);
+        std::string content;
+        content.reserve(size);
+        while (content.size() < size)
+        {
+            const auto value = static_cast<char>(random());
+            const auto run = random() % 4 == 0 ? random() % 64 : 1;
+            content.append(std::min<std::size_t>(run, size - content.size()), value);
+        }
+        return content;
+    }
+
+    std::string ReadAll(std::istream& stream)
+    {
+        std::ostringstream content;
+        content << stream.rdbuf();
+        return content.str();
+    }
+
+    std::string ReadAt(std::istream& stream, std::uint64_t offset, std::size_t count)
+    {
+        stream.clear();
+        stream.seekg(static_cast<std::streamoff>(offset));
+        std::string data(count, '\0');
+        stream.read(data.data(), static_cast<std::streamsize>(count));
+        data.resize(static_cast<std::size_t>(stream.gcount()));
+        return data;
+    }
+}  // namespace
+
+TEST_CASE(CompressedDemoReadsBackUnchanged)
+{
+    Sandbox sandbox;
+    const auto content = MakeContent(CompressedDemo::FRAME_SIZE * 2 + 12345);
+    const auto raw = sandbox.Write("a.dm_1", content);
+    const auto compressed = sandbox.root / "a.dm_1.xpz";
+    CompressedDemo::Compress(raw, compressed);
+
+    CHECK(std::filesystem::file_size(compressed) < content.size());
+
+    auto stream = CompressedDemo::OpenDemo(compressed);
+    REQUIRE(stream != nullptr);
+    CHECK(ReadAll(*stream) == content);
+}
+
+TEST_CASE(DecompressedDemoMatchesTheOriginal)
+{
+    Sandbox sandbox;
+    const auto content = MakeContent(CompressedDemo::FRAME_SIZE + 1);
+    const auto raw = sandbox.Write("a.dm_1", content);
+    const auto compressed = sandbox.root / "a.dm_1.xpz";
+    const auto decompressed = sandbox.root / "b.dm_1";
+    CompressedDemo::Compress(raw, compressed);
+    CompressedDemo::Decompress(compressed, decompressed);
+
+    std::ifstream file(decompressed, std::ios::binary);
+    CHECK(ReadAll(file) == content);
+}
+
+TEST_CASE(SeeksAcrossFramesReadTheRightBytes)
+{
+    Sandbox sandbox;
+    const auto content = MakeContent(CompressedDemo::FRAME_SIZE * 3 + 100);
+    const auto compressed = sandbox.root / "a.dm_1.xpz";
+    CompressedDemo::Compress(sandbox.Write("a.dm_1", content), compressed);
+
+    auto stream = CompressedDemo::OpenDemo(compressed);
+    REQUIRE(stream != nullptr);
+
+    // backwards, within a frame, across a frame border and up to the end
+    const std::vector<std::uint64_t> offsets = {CompressedDemo::FRAME_SIZE * 2 + 7,
+                                                5,
+                                                CompressedDemo::FRAME_SIZE - 10,
+                                                CompressedDemo::FRAME_SIZE + 3,
+                                                CompressedDemo::FRAME_SIZE + 9,
+                                                content.size() - 64};
+    for (const auto offset : offsets)
+    {
+        CHECK(ReadAt(*stream, offset, 64) == content.substr(offset, 64));
+        CHECK_EQ(static_cast<std::uint64_t>(stream->tellg()), offset + 64);
+    }
+
+    stream->clear();
+    stream->seekg(-10, std::ios::end);
+    CHECK_EQ(static_cast<std::uint64_t>(stream->tellg()), content.size() - 10);
+    stream->seekg(4, std::ios::cur);
+    CHECK_EQ(static_cast<std::uint64_t>(stream->tellg()), content.size() - 6);
+
+    // seeking past the end fails instead of reading garbage
+    stream->seekg(1, std::ios::end);
+    CHECK(stream->fail());
+}
+
+TEST_CASE(RawDemosAreOpenedAsTheyAre)
+{
+    Sandbox sandbox;
+    const auto content = MakeContent(1000);
+    auto stream = CompressedDemo::OpenDemo(sandbox.Write("a.dm_1", content));
+    REQUIRE(stream != nullptr);
+    CHECK(ReadAll(*stream) == content);
+}
+
+TEST_CASE(CorruptCompressedDemosAreRejected)
+{
+    Sandbox sandbox;
+    const auto content = MakeContent(1000);
+    const auto compressed = sandbox.root / "a.dm_1.xpz";
+    CompressedDemo::Compress(sandbox.Write("a.dm_1", content), compressed);
+
+    // cutting off the frame index keeps the magic, so the demo is recognized but cannot be read
+    std::filesystem::resize_file(compressed, std::filesystem::file_size(compressed) - 4);
+    CHECK(CompressedDemo::OpenDemo(compressed) == nullptr);
+}
+
+TEST_CASE(CompressedDemoReadsTheSameMessages)
+{
+    using namespace IWXMVM::IW3::Demo;
+
+    std::ostringstream demo(std::ios::binary);
+    DemoWriter writer(demo);
+    for (int i = 0; i < 20000; i++)
+    {
+        Message packet{};
+        packet.type = MessageType::NetworkPacket;
+        packet.sequence = i;
+        packet.data.assign(40 + i % 200, static_cast<uint8_t>(i));
+        writer.Write(packet);
+
+        Message archive{};
+        archive.type = MessageType::ClientArchive;
+        archive.archive.archiveIndex = i;
+        archive.archive.serverTime = 1000 + i * 50;
+        writer.Write(archive);
+    }
+    writer.WriteEndOfDemo();
+
+    Sandbox sandbox;
+    const auto compressed = sandbox.root / "a.dm_1.xpz";
+    CompressedDemo::Compress(sandbox.Write("a.dm_1", demo.str()), compressed);
+    REQUIRE(std::filesystem::file_size(compressed) < demo.str().size());
+
+    // the reader measures the size by seeking to the end and skips payloads by seeking forward
+    std::istringstream rawStream(demo.str(), std::ios::binary);
+    auto compressedStream = CompressedDemo::OpenDemo(compressed);
+    REQUIRE(compressedStream != nullptr);
+    DemoReader rawReader(rawStream);
+    DemoReader compressedReader(*compressedStream);
+    CHECK_EQ(compressedReader.GetSize(), rawReader.GetSize());
+
+    Message rawMessage;
+    Message compressedMessage;
+    std::size_t messageCount = 0;
+    while (true)
+    {
+        const auto readPayload = messageCount % 3 != 0;
+        const auto rawResult = rawReader.Next(rawMessage, readPayload);
+        const auto compressedResult = compressedReader.Next(compressedMessage, readPayload);
+        REQUIRE(rawResult == compressedResult);
+        if (rawResult != ReadResult::Message)
+            break;
+
+        CHECK_EQ(compressedMessage.offset, rawMessage.offset);
+        CHECK(compressedMessage.data == rawMessage.data);
+        CHECK_EQ(compressedMessage.archive.serverTime, rawMessage.archive.serverTime);
+        messageCount++;
+    }
+    CHECK_EQ(messageCount, std::size_t(40000));
+}
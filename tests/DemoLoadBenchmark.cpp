@@ -0,0 +1,196 @@
+#include "StdInclude.hpp"
+#include "Benchmark.hpp"
+
+#include <random>
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#include "Demo/DemoWriter.hpp"
+#include "Utilities/ReadAheadBuffer.hpp"
+
+#ifdef _WIN32
+#include "Utilities/CompressedDemo.hpp"
+#endif
+
+using namespace IWXMVM;
+using namespace IWXMVM::IW3::Demo;
+
+struct MatchDemo
+{
+    std::filesystem::path path;
+    std::uint64_t firstSnapshotOffset = 0;  // Where rewinding restarts, right after the gamestate
+    std::uint64_t middleOffset = 0;
+};
+
+// Writes a 30 minute match like DemoScannerBenchmark, starting with a gamestate the size of a typical one
+MatchDemo WriteMatchDemo(const std::filesystem::path& directory)
+{
+    MatchDemo demo;
+    demo.path = directory / "match.dm_1";
+
+    std::ofstream file(demo.path, std::ios::binary | std::ios::trunc);
+    DemoWriter writer(file);
+    std::mt19937 random(1337);
+
+    Message gamestate{};
+    gamestate.type = MessageType::NetworkPacket;
+    gamestate.sequence = 1;
+    gamestate.data.resize(20000);
+    writer.Write(gamestate);
+    demo.firstSnapshotOffset = static_cast<std::uint64_t>(file.tellp());
+
+    constexpr int FRAME_COUNT = 30 * 60 * 20;
+    for (int i = 0; i < FRAME_COUNT; i++)
+    {
+        if (i == FRAME_COUNT / 2)
+            demo.middleOffset = static_cast<std::uint64_t>(file.tellp());
+
+        // snapshots are mostly small deltas, which compress well
+        Message packet{};
+        packet.type = MessageType::NetworkPacket;
+        packet.sequence = i + 2;
+        packet.data.resize(400 + random() % 1200);
+        for (std::size_t j = 0; j < packet.data.size(); j += 1 + random() % 8)
+            packet.data[j] = static_cast<uint8_t>(random());
+        writer.Write(packet);
+
+        Message archive{};
+        archive.type = MessageType::ClientArchive;
+        archive.archive.archiveIndex = i;
+        archive.archive.serverTime = 10000 + i * 50;
+        writer.Write(archive);
+    }
+    writer.WriteEndOfDemo();
+    return demo;
+}
+
+// Opens a demo the way Rewinding does, decompressing it if it is compressed
+std::unique_ptr<ReadAheadBuffer> OpenDemo(const std::filesystem::path& path)
+{
+#ifdef _WIN32
+    return std::make_unique<ReadAheadBuffer>(CompressedDemo::OpenDemo(path));
+#else
+    return std::make_unique<ReadAheadBuffer>(std::make_unique<std::ifstream>(path, std::ios::binary));
+#endif
+}
+
+// Reads one message in the small reads the game's FS_Read calls make
+void ReadMessage(ReadAheadBuffer& demo)
+{
+    static std::vector<char> buffer(MAX_MESSAGE_SIZE);
+
+    uint8_t type = 0;
+    demo.Read(&type, 1);
+    if (type == static_cast<uint8_t>(MessageType::ClientArchive))
+    {
+        demo.Read(buffer.data(), sizeof(ClientArchive));
+        return;
+    }
+
+    int32_t sequence = 0;
+    int32_t size = 0;
+    demo.Read(&sequence, sizeof(sequence));
+    demo.Read(&size, sizeof(size));
+    demo.Read(buffer.data(), std::clamp<std::size_t>(size, 0, buffer.size()));
+}
+
+// Evicts the file from the OS cache, so the next read has to go to the disk. Returns false if that is not possible.
+bool DropFromFileCache(const std::filesystem::path& path)
+{
+#if defined(__linux__)
+    const int file = open(path.c_str(), O_RDONLY);
+    if (file < 0)
+        return false;
+    const auto dropped = fdatasync(file) == 0 && posix_fadvise(file, 0, 0, POSIX_FADV_DONTNEED) == 0;
+    close(file);
+    return dropped;
+#elif defined(_WIN32)
+    // opening a file without buffering discards its cached pages
+    const auto file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr,
+                                  OPEN_EXISTING, FILE_FLAG_NO_BUFFERING, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+        return false;
+    CloseHandle(file);
+    return true;
+#else
+    return false;
+#endif
+}
+
+// Like Tests::Benchmark, but evicts the demo from the file cache before every call and only times the call itself
+template <typename Function>
+void BenchmarkCold(const char* name, const std::filesystem::path& path, int runCount, Function&& function)
+{
+    using Clock = std::chrono::steady_clock;
+
+    std::vector<double> runs;
+    for (int i = 0; i < runCount; i++)
+    {
+        DropFromFileCache(path);
+        const auto start = Clock::now();
+        function();
+        runs.push_back(std::chrono::duration<double, std::nano>(Clock::now() - start).count());
+    }
+
+    std::sort(runs.begin(), runs.end());
+    std::printf("%-56s %12.1f ns  (min %.1f ns, %d runs)\n", name, runs[runs.size() / 2], runs.front(), runCount);
+}
+
+void BenchmarkDemo(const MatchDemo& demo)
+{
+    // loading a demo waits for the gamestate, which is the first thing the game reads
+    Tests::Benchmark("Load, warm", 1, [&] {
+        const auto file = OpenDemo(demo.path);
+        ReadMessage(*file);
+    });
+    BenchmarkCold("Load, cold", demo.path, 20, [&] {
+        const auto file = OpenDemo(demo.path);
+        ReadMessage(*file);
+    });
+
+    // every rewind restarts at the first snapshot, which is never in the window read ahead of the current position.
+    // Alternating with the middle of the demo makes every call a seek that discards the window, like a real rewind.
+    const auto file = OpenDemo(demo.path);
+    bool toStart = true;
+    const auto rewind = [&] {
+        file->Seek(toStart ? demo.firstSnapshotOffset : demo.middleOffset);
+        ReadMessage(*file);
+        toStart = !toStart;
+    };
+    Tests::Benchmark("Rewind, warm", 1, rewind);
+    BenchmarkCold("Rewind, cold", demo.path, 20, rewind);
+}
+
+int main(int argc, char** argv)
+{
+    // cold reads are only cold on a disk, pass a directory on one if the temp directory is in memory
+    const auto now = std::chrono::steady_clock::now().time_since_epoch().count();
+    const auto parent = argc > 1 ? std::filesystem::path(argv[1]) : std::filesystem::temp_directory_path();
+    const auto root = parent / std::format("iwxmvm_demo_load_{}", now);
+    std::filesystem::create_directories(root);
+
+    const auto demo = WriteMatchDemo(root);
+    std::printf("Raw 30 minute match, %.1f MB\n",
+                static_cast<double>(std::filesystem::file_size(demo.path)) / (1024 * 1024));
+    if (!DropFromFileCache(demo.path))
+        std::printf("Cannot evict files from the cache on this platform, cold runs are warm\n");
+    BenchmarkDemo(demo);
+
+#ifdef _WIN32
+    // offsets refer to the raw demo, so the same ones work on the compressed copy
+    auto compressed = demo;
+    compressed.path = root / "match.dm_1.xpz";
+    CompressedDemo::Compress(demo.path, compressed.path);
+    std::printf("\nCompressed, %.1f MB\n",
+                static_cast<double>(std::filesystem::file_size(compressed.path)) / (1024 * 1024));
+    BenchmarkDemo(compressed);
+#else
+    std::printf("\nCompressed demos use the Windows compression API and are only benchmarked on Windows\n");
+#endif
+
+    std::filesystem::remove_all(root);
+    return 0;
+}
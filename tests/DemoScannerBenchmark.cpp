@@ -0,0 +1,72 @@
+#include "StdInclude.hpp"
+#include "Benchmark.hpp"
+
+#include <random>
+
+#include "Demo/DemoScanner.hpp"
+#include "Demo/DemoWriter.hpp"
+
+using namespace IWXMVM;
+using namespace IWXMVM::IW3::Demo;
+
+// Writes a demo shaped like a recorded match: a network packet and a client archive for every 50 ms snapshot, with
+// packets of typical snapshot sizes and a respawn every half a minute
+std::filesystem::path WriteMatchDemo(std::chrono::minutes length)
+{
+    const auto now = std::chrono::steady_clock::now().time_since_epoch().count();
+    const auto path = std::filesystem::temp_directory_path() / std::format("iwxmvm_demo_scanner_{}.dm_1", now);
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    DemoWriter writer(file);
+    std::mt19937 random(1337);
+
+    const auto frameCount = static_cast<int>(std::chrono::milliseconds(length).count() / 50);
+    float x = 0.0f;
+    for (int i = 0; i < frameCount; i++)
+    {
+        Message packet{};
+        packet.type = MessageType::NetworkPacket;
+        packet.sequence = i + 1;
+        packet.data.resize(400 + random() % 1200);
+        writer.Write(packet);
+
+        x = (i % 600 == 599) ? static_cast<float>(random() % 8000) : x + 190.0f * 0.05f;
+
+        Message archive{};
+        archive.type = MessageType::ClientArchive;
+        archive.archive.archiveIndex = i;
+        archive.archive.serverTime = 10000 + i * 50;
+        archive.archive.origin[0] = x;
+        archive.archive.velocity[0] = 190.0f;
+        writer.Write(archive);
+    }
+    writer.WriteEndOfDemo();
+    return path;
+}
+
+int main()
+{
+    for (const auto length : {std::chrono::minutes(10), std::chrono::minutes(30)})
+    {
+        const auto path = WriteMatchDemo(length);
+        const auto megabytes = static_cast<double>(std::filesystem::file_size(path)) / (1024 * 1024);
+        std::printf("%s%lld minute match, %.1f MB\n", length == std::chrono::minutes(10) ? "" : "\n",
+                    static_cast<long long>(length.count()), megabytes);
+
+        // both passes read the file like the background jobs do, from disk through an ifstream
+        std::size_t eventCount = 0;
+        const auto events = Tests::Benchmark("Read events", 1, [&] {
+            std::ifstream file(path, std::ios::binary);
+            eventCount = ReadEvents(file).size();
+        });
+        const auto metadata = Tests::Benchmark("Read metadata", 1, [&] {
+            std::ifstream file(path, std::ios::binary);
+            Tests::DoNotOptimize(ReadMetadata(file));
+        });
+
+        std::printf("%zu view cuts, events at %.0f MB/s, metadata at %.0f MB/s\n", eventCount,
+                    megabytes / (events.medianNanoseconds / 1e9), megabytes / (metadata.medianNanoseconds / 1e9));
+        std::filesystem::remove(path);
+    }
+    return 0;
+}
@@ -0,0 +1,213 @@
+#include "StdInclude.hpp"
+#include "TestFramework.hpp"
+
+#include "Demo/DemoScanner.hpp"
+#include "Demo/DemoWriter.hpp"
+
+using namespace IWXMVM::IW3::Demo;
+
+namespace
+{
+    struct DemoBuilder
+    {
+        std::ostringstream stream{std::ios::binary};
+        DemoWriter writer{stream};
+
+        DemoBuilder& Packet(int32_t sequence)
+        {
+            Message message{};
+            message.type = MessageType::NetworkPacket;
+            message.sequence = sequence;
+            message.data.assign(64, static_cast<uint8_t>(sequence));
+            writer.Write(message);
+            return *this;
+        }
+
+        DemoBuilder& Archive(int serverTime, float x = 0.0f, float velocityX = 0.0f)
+        {
+            Message message{};
+            message.type = MessageType::ClientArchive;
+            message.archive.serverTime = serverTime;
+            message.archive.origin[0] = x;
+            message.archive.velocity[0] = velocityX;
+            writer.Write(message);
+            return *this;
+        }
+
+        DemoBuilder& CoD4XHeader()
+        {
+            Message message{};
+            message.type = MessageType::CoD4XProtocolHeader;
+            message.data.assign(COD4X_PROTOCOL_HEADER_SIZE, 0);
+            writer.Write(message);
+            return *this;
+        }
+
+        DemoBuilder& Frames(int count, int firstServerTime = 1000)
+        {
+            for (int i = 0; i < count; i++)
+            {
+                Packet(i + 1);
+                Archive(firstServerTime + i * 50);
+            }
+            return *this;
+        }
+
+        DemoBuilder& Raw(const std::string& bytes)
+        {
+            stream.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+            return *this;
+        }
+
+        std::string Build()
+        {
+            writer.WriteEndOfDemo();
+            return stream.str();
+        }
+    };
+
+    IWXMVM::Types::DemoMetadata Read(const std::string& demo)
+    {
+        std::istringstream stream(demo, std::ios::binary);
+        return ReadMetadata(stream);
+    }
+
+    std::vector<IWXMVM::Types::DemoEvent> ReadDemoEvents(const std::string& demo)
+    {
+        std::istringstream stream(demo, std::ios::binary);
+        return ReadEvents(stream);
+    }
+
+    // Archives of a player running along x at `speed` units per second from server time 1000 on, 50 ms apart
+    DemoBuilder& Run(DemoBuilder& builder, int frames, float speed, float startX = 0.0f, int firstFrame = 0)
+    {
+        for (int i = firstFrame; i < firstFrame + frames; i++)
+        {
+            builder.Packet(i + 1);
+            builder.Archive(1000 + i * 50, startX + speed * static_cast<float>(i - firstFrame) * 0.05f, speed);
+        }
+        return builder;
+    }
+}  // namespace
+
+TEST_CASE(BoundsSpanAllArchivesPlusTheLastFrame)
+{
+    const auto metadata = Read(DemoBuilder().Frames(600).Build());
+
+    CHECK(metadata.HasBounds());
+    CHECK_EQ(metadata.startTick, uint32_t(1000));
+    CHECK_EQ(metadata.endTick, uint32_t(1000 + 599 * 50 + 500));
+    CHECK_EQ(metadata.archiveCount, uint32_t(600));
+    CHECK(!metadata.isCoD4X);
+    CHECK(metadata.mapName.empty());
+}
+
+TEST_CASE(OutdatedArchivesDoNotMoveTheBounds)
+{
+    // the archive buffer dump at the start of a recording holds stale and unset archives
+    DemoBuilder builder;
+    builder.Archive(-50).Archive(0);
+    builder.Frames(300, 5000);
+    builder.Archive(4000);
+
+    std::istringstream stream(builder.Build(), std::ios::binary);
+    const auto scan = ScanDemo(stream);
+    CHECK_EQ(scan.archives.size(), std::size_t(302));
+
+    const auto bounds = DetermineBounds(scan.archives);
+    REQUIRE(bounds.has_value());
+    CHECK_EQ(bounds->first, uint32_t(5000));
+    CHECK_EQ(bounds->second, uint32_t(5000 + 299 * 50 + 500));
+}
+
+TEST_CASE(ShortOrEmptyDemosHaveNoBounds)
+{
+    CHECK(!Read(DemoBuilder().Build()).HasBounds());
+    CHECK(!Read(DemoBuilder().Frames(1).Build()).HasBounds());
+
+    // shorter than a second
+    const auto metadata = Read(DemoBuilder().Frames(5).Build());
+    CHECK(!metadata.HasBounds());
+    CHECK_EQ(metadata.archiveCount, uint32_t(5));
+}
+
+TEST_CASE(CoD4XDemosAreRecognized)
+{
+    CHECK(Read(DemoBuilder().CoD4XHeader().Frames(100).Build()).isCoD4X);
+}
+
+TEST_CASE(UnknownMessagesAreSkipped)
+{
+    const auto demo = DemoBuilder().Frames(100).Raw(std::string(1, char(9))).Frames(100, 6000).Build();
+
+    std::istringstream stream(demo, std::ios::binary);
+    const auto scan = ScanDemo(stream);
+    CHECK_EQ(scan.unhandledMessageCount, uint32_t(1));
+    CHECK_EQ(scan.archives.size(), std::size_t(200));
+}
+
+TEST_CASE(TruncatedDemosKeepTheirIntactArchives)
+{
+    auto demo = DemoBuilder().Frames(100).Build();
+    demo.resize(demo.size() - 20);
+
+    const auto metadata = Read(demo);
+    CHECK(metadata.HasBounds());
+    CHECK_EQ(metadata.archiveCount, uint32_t(99));
+}
+
+TEST_CASE(RunningIsNoViewCut)
+{
+    DemoBuilder builder;
+    CHECK(ReadDemoEvents(Run(builder, 600, 190.0f).Build()).empty());
+}
+
+TEST_CASE(FastMovementIsNoViewCut)
+{
+    // a player launched far faster than running speed still moves no further than their velocity allows
+    DemoBuilder builder;
+    CHECK(ReadDemoEvents(Run(builder, 600, 5000.0f).Build()).empty());
+}
+
+TEST_CASE(TeleportsAreViewCuts)
+{
+    DemoBuilder builder;
+    Run(builder, 300, 190.0f);
+    Run(builder, 300, 190.0f, 5000.0f, 300);
+    Run(builder, 300, 190.0f, -3000.0f, 600);
+    const auto events = ReadDemoEvents(builder.Build());
+
+    REQUIRE(events.size() == 2);
+    CHECK(events[0].type == IWXMVM::Types::DemoEventType::ViewCut);
+    CHECK_EQ(events[0].tick, uint32_t(300 * 50));
+    CHECK_EQ(events[1].tick, uint32_t(600 * 50));
+}
+
+TEST_CASE(SmallJumpsWithinTheMarginAreNoViewCuts)
+{
+    // 1000 units per second minimum speed over 50 ms plus the margin
+    DemoBuilder builder;
+    Run(builder, 300, 0.0f);
+    Run(builder, 300, 0.0f, 50.0f + 64.0f - 1.0f, 300);
+    Run(builder, 300, 0.0f, 2 * (50.0f + 64.0f), 600);
+    const auto events = ReadDemoEvents(builder.Build());
+
+    REQUIRE(events.size() == 1);
+    CHECK_EQ(events[0].tick, uint32_t(600 * 50));
+}
+
+TEST_CASE(ArchiveBufferDumpHasNoViewCuts)
+{
+    // the stale archives at the start of a recording are all over the map
+    DemoBuilder builder;
+    for (int i = 0; i < 50; i++)
+        builder.Archive(-1000 + i * 10, static_cast<float>(i % 2) * 10000.0f);
+    CHECK(ReadDemoEvents(Run(builder, 300, 190.0f).Build()).empty());
+}
+
+TEST_CASE(DemosWithoutBoundsHaveNoEvents)
+{
+    DemoBuilder builder;
+    builder.Archive(1000, 0.0f).Archive(1050, 10000.0f);
+    CHECK(ReadDemoEvents(builder.Build()).empty());
+}
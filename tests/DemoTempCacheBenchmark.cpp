@@ -0,0 +1,67 @@
+#include "StdInclude.hpp"
+#include "Benchmark.hpp"
+
+#include "Utilities/DemoTempCache.hpp"
+
+using namespace IWXMVM;
+
+std::filesystem::path WriteDemo(const std::filesystem::path& directory, const std::string& name, std::size_t size)
+{
+    const auto path = directory / name;
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    std::string content(size, '\0');
+    for (std::size_t i = 0; i < size; i++)
+        content[i] = static_cast<char>(i * 31 + name.size());
+    file.write(content.data(), content.size());
+    return path;
+}
+
+int main()
+{
+    const auto now = std::chrono::steady_clock::now().time_since_epoch().count();
+    const auto root = std::filesystem::temp_directory_path() / std::format("iwxmvm_demo_temp_cache_{}", now);
+    const auto demos = root / "demos";
+    const auto temp = root / "temp";
+    std::filesystem::create_directories(demos);
+    std::filesystem::create_directories(temp);
+
+    constexpr std::size_t DEMO_SIZE = 32 * 1024 * 1024;
+    const auto demo = WriteDemo(demos, "match.dm_1", DEMO_SIZE);
+
+    // other demos that were played before, so the index is not trivially small
+    for (int i = 0; i < 100; i++)
+    {
+        const auto name = std::format("old{}.dm_1", i);
+        DemoTempCache::Prepare(WriteDemo(demos, name, 4096), temp, name);
+    }
+
+    std::printf("%zu MB demo, 100 other cached demos\n", DEMO_SIZE / (1024 * 1024));
+
+    // every load copied the demo into the temp directory before it was cached
+    Tests::Benchmark("Copy on every load", 1, [&] {
+        std::filesystem::copy_file(demo, root / "copy.dm_1", std::filesystem::copy_options::overwrite_existing);
+    });
+
+    // the first load of a demo hashes it and links it into the cache
+    const auto emptyTemp = root / "empty";
+    Tests::Benchmark("First load", 1, [&] {
+        std::filesystem::remove_all(emptyTemp);
+        std::filesystem::create_directories(emptyTemp);
+        Tests::DoNotOptimize(DemoTempCache::Prepare(demo, emptyTemp, "match.dm_1"));
+    });
+
+    DemoTempCache::Prepare(demo, temp, "match.dm_1");
+
+    // reloading an unchanged demo, e.g. after a crash or to start over, only checks the index
+    Tests::Benchmark("Repeated load", 1,
+                     [&] { Tests::DoNotOptimize(DemoTempCache::Prepare(demo, temp, "match.dm_1")); });
+
+    // a touched but unchanged demo is hashed again, but not linked or copied
+    Tests::Benchmark("Repeated load, source touched", 1, [&] {
+        std::filesystem::last_write_time(demo, std::filesystem::file_time_type::clock::now());
+        Tests::DoNotOptimize(DemoTempCache::Prepare(demo, temp, "match.dm_1"));
+    });
+
+    std::filesystem::remove_all(root);
+    return 0;
+}
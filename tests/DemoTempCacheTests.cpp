@@ -0,0 +1,188 @@
+#include "StdInclude.hpp"
+#include "TestFramework.hpp"
+
+#include "nlohmann/json.hpp"
+
+#include "Utilities/DemoTempCache.hpp"
+
+using namespace IWXMVM;
+
+namespace
+{
+    // A fresh directory with a 'demos' folder standing in for the game's demo directory and a 'temp' folder for the
+    // cache, removed again when the test ends
+    struct Sandbox
+    {
+        std::filesystem::path root;
+        std::filesystem::path demos;
+        std::filesystem::path temp;
+
+        Sandbox()
+        {
+            static int counter = 0;
+            const auto now = std::chrono::steady_clock::now().time_since_epoch().count();
+            root = std::filesystem::temp_directory_path() / std::format("iwxmvm_demo_temp_cache_{}_{}", now, counter++);
+            demos = root / "demos";
+            temp = root / "temp";
+            std::filesystem::create_directories(demos);
+            std::filesystem::create_directories(temp);
+        }
+
+        ~Sandbox()
+        {
+            std::error_code error;
+            std::filesystem::remove_all(root, error);
+        }
+
+        std::filesystem::path WriteDemo(const std::string& name, std::size_t size, char fill)
+        {
+            const auto path = demos / name;
+            std::ofstream file(path, std::ios::binary | std::ios::trunc);
+            const std::string content(size, fill);
+            file.write(content.data(), content.size());
+            return path;
+        }
+
+        // Turns every cached hardlink into a copy, like on filesystems that do not support hardlinks
+        void ConvertLinksToCopies() const
+        {
+            const auto indexPath = temp / "index.json";
+            auto index = nlohmann::json::parse(std::ifstream(indexPath));
+            for (auto& entry : index.at("entries"))
+            {
+                if (!entry.at("isHardLink").get<bool>())
+                    continue;
+
+                const auto cachedPath =
+                    temp / entry.at("hash").get<std::string>() / entry.at("fileName").get<std::string>();
+                const auto copyPath = cachedPath.string() + ".copy";
+                const auto lastWriteTime = std::filesystem::last_write_time(cachedPath);
+                std::filesystem::copy_file(cachedPath, copyPath);
+                std::filesystem::rename(copyPath, cachedPath);
+                std::filesystem::last_write_time(cachedPath, lastWriteTime);
+                entry["isHardLink"] = false;
+            }
+            std::ofstream(indexPath) << index.dump();
+        }
+
+        std::size_t CountCachedDemos() const
+        {
+            std::size_t count = 0;
+            for (const auto& entry : std::filesystem::directory_iterator(temp))
+                count += entry.is_directory() ? 1 : 0;
+            return count;
+        }
+    };
+}  // namespace
+
+TEST_CASE(UnchangedDemoIsReused)
+{
+    Sandbox sandbox;
+    const auto demo = sandbox.WriteDemo("a.dm_1", 1000, 'a');
+
+    const auto first = DemoTempCache::Prepare(demo, sandbox.temp, "a.dm_1");
+    const auto second = DemoTempCache::Prepare(demo, sandbox.temp, "a.dm_1");
+    CHECK(first == second);
+    CHECK(std::filesystem::exists(first));
+    CHECK_EQ(sandbox.CountCachedDemos(), std::size_t(1));
+}
+
+TEST_CASE(DemosAreHardlinkedWherePossible)
+{
+    Sandbox sandbox;
+    const auto demo = sandbox.WriteDemo("a.dm_1", 1000, 'a');
+
+    const auto cached = DemoTempCache::Prepare(demo, sandbox.temp, "a.dm_1");
+    CHECK(std::filesystem::equivalent(demo, cached));
+    CHECK_EQ(std::filesystem::hard_link_count(demo), std::uintmax_t(2));
+}
+
+TEST_CASE(HardlinksDoNotCountWhileTheirSourceExists)
+{
+    Sandbox sandbox;
+    const auto a = sandbox.WriteDemo("a.dm_1", 1000, 'a');
+    const auto b = sandbox.WriteDemo("b.dm_1", 1000, 'b');
+
+    // both demos together exceed the limit, but neither takes up space in the cache
+    DemoTempCache::Prepare(a, sandbox.temp, "a.dm_1", 1500);
+    DemoTempCache::Prepare(b, sandbox.temp, "b.dm_1", 1500);
+    CHECK_EQ(sandbox.CountCachedDemos(), std::size_t(2));
+}
+
+TEST_CASE(HardlinksWhoseSourceWasDeletedAreDropped)
+{
+    Sandbox sandbox;
+    const auto a = sandbox.WriteDemo("a.dm_1", 1000, 'a');
+    const auto b = sandbox.WriteDemo("b.dm_1", 1000, 'b');
+
+    const auto cachedA = DemoTempCache::Prepare(a, sandbox.temp, "a.dm_1");
+    std::filesystem::remove(a);
+
+    // the cache now holds the only copy of 'a', which must not stay around forever
+    DemoTempCache::Prepare(b, sandbox.temp, "b.dm_1");
+    CHECK(!std::filesystem::exists(cachedA));
+    CHECK_EQ(sandbox.CountCachedDemos(), std::size_t(1));
+}
+
+TEST_CASE(HardlinksWhoseSourceWasReplacedAreDropped)
+{
+    Sandbox sandbox;
+    const auto a = sandbox.WriteDemo("a.dm_1", 1000, 'a');
+    const auto b = sandbox.WriteDemo("b.dm_1", 1000, 'b');
+
+    const auto cachedA = DemoTempCache::Prepare(a, sandbox.temp, "a.dm_1");
+
+    // saving to a new file and renaming it over the old one breaks the link
+    const auto replacement = sandbox.WriteDemo("a.tmp", 1000, 'c');
+    std::filesystem::rename(replacement, a);
+
+    DemoTempCache::Prepare(b, sandbox.temp, "b.dm_1");
+    CHECK(!std::filesystem::exists(cachedA));
+}
+
+TEST_CASE(LeastRecentlyUsedCopiesAreEvicted)
+{
+    Sandbox sandbox;
+    const auto a = sandbox.WriteDemo("a.dm_1", 1000, 'a');
+    const auto b = sandbox.WriteDemo("b.dm_1", 1000, 'b');
+    const auto c = sandbox.WriteDemo("c.dm_1", 1000, 'c');
+
+    const auto cachedA = DemoTempCache::Prepare(a, sandbox.temp, "a.dm_1");
+    const auto cachedB = DemoTempCache::Prepare(b, sandbox.temp, "b.dm_1");
+    sandbox.ConvertLinksToCopies();
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    DemoTempCache::Prepare(a, sandbox.temp, "a.dm_1");
+
+    // 'c' is linked and free, 'a' was used more recently than 'b' and only one copy fits
+    const auto cachedC = DemoTempCache::Prepare(c, sandbox.temp, "c.dm_1", 1500);
+    CHECK(std::filesystem::exists(cachedC));
+    CHECK(std::filesystem::exists(cachedA));
+    CHECK(!std::filesystem::exists(cachedB));
+}
+
+TEST_CASE(HardlinkHoldingTheLastCopyCounts)
+{
+    Sandbox sandbox;
+    const auto a = sandbox.WriteDemo("a.dm_1", 1000, 'a');
+    const auto b = sandbox.WriteDemo("b.dm_1", 1000, 'b');
+    const auto c = sandbox.WriteDemo("c.dm_1", 1000, 'c');
+
+    const auto cachedA = DemoTempCache::Prepare(a, sandbox.temp, "a.dm_1");
+    const auto cachedB = DemoTempCache::Prepare(b, sandbox.temp, "b.dm_1");
+    sandbox.ConvertLinksToCopies();
+
+    // the same demo from another directory is found by its content, but is no longer linked to anything
+    const auto cachedC = DemoTempCache::Prepare(c, sandbox.temp, "c.dm_1");
+    std::filesystem::create_directories(sandbox.demos / "moved");
+    std::filesystem::copy_file(c, sandbox.demos / "moved" / "c.dm_1");
+    std::filesystem::remove(c);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    CHECK(DemoTempCache::Prepare(sandbox.demos / "moved" / "c.dm_1", sandbox.temp, "c.dm_1", 2500) == cachedC);
+    CHECK_EQ(std::filesystem::hard_link_count(cachedC), std::uintmax_t(1));
+
+    // with 'c' counted, the three demos take up 3000 bytes and the least recently used one has to go
+    CHECK(std::filesystem::exists(cachedB));
+    CHECK(!std::filesystem::exists(cachedA));
+}
@@ -0,0 +1,228 @@
+#include "StdInclude.hpp"
+#include "TestFramework.hpp"
+
+#include "Demo/DemoValidator.hpp"
+#include "Demo/DemoWriter.hpp"
+
+using namespace IWXMVM::IW3::Demo;
+
+namespace
+{
+    // Builds demos message by message, remembering where each one starts
+    struct DemoBuilder
+    {
+        std::ostringstream stream{std::ios::binary};
+        DemoWriter writer{stream};
+        std::vector<std::uint64_t> offsets;
+
+        DemoBuilder& Packet(int32_t sequence, std::size_t size = 32)
+        {
+            Message message{};
+            message.type = MessageType::NetworkPacket;
+            message.sequence = sequence;
+            message.data.assign(size, static_cast<uint8_t>(sequence));
+            return Add(message);
+        }
+
+        DemoBuilder& Archive(int serverTime)
+        {
+            Message message{};
+            message.type = MessageType::ClientArchive;
+            message.archive.archiveIndex = static_cast<int>(offsets.size());
+            message.archive.serverTime = serverTime;
+            return Add(message);
+        }
+
+        // A demo past the archive buffer dump at its start, so archive server times are checked
+        DemoBuilder& Frames(int count, int32_t firstSequence = 1, int firstServerTime = 1000)
+        {
+            for (int i = 0; i < count; i++)
+            {
+                Packet(firstSequence + i);
+                Archive(firstServerTime + i * 50);
+            }
+            return *this;
+        }
+
+        DemoBuilder& Raw(const std::string& bytes)
+        {
+            stream.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+            return *this;
+        }
+
+        DemoBuilder& End()
+        {
+            writer.WriteEndOfDemo();
+            return *this;
+        }
+
+        std::string Build() const
+        {
+            return stream.str();
+        }
+
+       private:
+        DemoBuilder& Add(const Message& message)
+        {
+            offsets.push_back(static_cast<std::uint64_t>(stream.tellp()));
+            writer.Write(message);
+            return *this;
+        }
+    };
+
+    ValidationReport Validate(const std::string& demo)
+    {
+        std::istringstream stream(demo, std::ios::binary);
+        return ValidateDemo(stream);
+    }
+
+    std::string Repair(const std::string& demo, const ValidationReport& report)
+    {
+        std::istringstream input(demo, std::ios::binary);
+        std::ostringstream output(std::ios::binary);
+        REQUIRE(RepairDemo(input, output, report));
+        return output.str();
+    }
+
+    bool HasIssue(const ValidationReport& report, IssueType type, std::uint64_t offset)
+    {
+        return std::any_of(report.issues.begin(), report.issues.end(),
+                           [&](const Issue& issue) { return issue.type == type && issue.offset == offset; });
+    }
+}  // namespace
+
+TEST_CASE(IntactDemoIsValid)
+{
+    const auto demo = DemoBuilder().Frames(300).End().Build();
+    const auto report = Validate(demo);
+
+    CHECK(report.IsValid());
+    CHECK(!report.IsRepairable());
+    CHECK(report.hasEndOfDemo);
+    CHECK_EQ(report.messageCount, std::size_t(600));
+    CHECK_EQ(report.archiveCount, std::size_t(300));
+    CHECK_EQ(report.size, std::uint64_t(demo.size()));
+    CHECK_EQ(report.validSize + END_OF_DEMO_SIZE, report.size);
+}
+
+TEST_CASE(UnfinishedRecordingIsRepairedWithAnEnd)
+{
+    const auto demo = DemoBuilder().Frames(10).Build();
+    const auto report = Validate(demo);
+
+    CHECK(!report.IsValid());
+    CHECK(report.IsRepairable());
+    CHECK(HasIssue(report, IssueType::MissingEndOfDemo, demo.size()));
+
+    const auto repaired = Repair(demo, report);
+    CHECK(repaired == DemoBuilder().Frames(10).End().Build());
+    CHECK(Validate(repaired).IsValid());
+}
+
+TEST_CASE(TruncatedMessageIsCutOff)
+{
+    DemoBuilder builder;
+    builder.Frames(10);
+    const auto lastPacketOffset = static_cast<std::uint64_t>(builder.stream.tellp());
+    auto demo = builder.Packet(11, 100).Build();
+    demo.resize(demo.size() - 30);
+
+    const auto report = Validate(demo);
+    CHECK(HasIssue(report, IssueType::Truncated, lastPacketOffset));
+    CHECK_EQ(report.validSize, lastPacketOffset);
+    CHECK_EQ(report.messageCount, std::size_t(20));
+    REQUIRE(report.IsRepairable());
+
+    const auto repairedReport = Validate(Repair(demo, report));
+    CHECK(repairedReport.IsValid());
+    CHECK_EQ(repairedReport.messageCount, std::size_t(20));
+}
+
+TEST_CASE(UnknownMessageTypeStopsValidation)
+{
+    DemoBuilder builder;
+    builder.Frames(5);
+    const auto garbageOffset = static_cast<std::uint64_t>(builder.stream.tellp());
+    const auto demo = builder.Raw(std::string(1, char(9))).Frames(5, 6).End().Build();
+
+    const auto report = Validate(demo);
+    CHECK(HasIssue(report, IssueType::UnknownMessageType, garbageOffset));
+    CHECK_EQ(report.issueCount, std::size_t(1));
+    CHECK_EQ(report.validSize, garbageOffset);
+    CHECK(report.IsRepairable());
+}
+
+TEST_CASE(InvalidPacketSizeStopsValidation)
+{
+    DemoBuilder builder;
+    builder.Frames(2);
+    const auto packetOffset = static_cast<std::uint64_t>(builder.stream.tellp());
+
+    // a packet header claiming more than any message can hold
+    std::string header(9, '\0');
+    header[0] = static_cast<char>(MessageType::NetworkPacket);
+    const auto size = static_cast<int32_t>(MAX_MESSAGE_SIZE + 1);
+    std::memcpy(header.data() + 5, &size, sizeof(size));
+    const auto demo = builder.Raw(header).Build();
+
+    const auto report = Validate(demo);
+    CHECK(HasIssue(report, IssueType::InvalidMessageSize, packetOffset));
+    CHECK_EQ(report.validSize, packetOffset);
+}
+
+TEST_CASE(OutOfOrderMessagesAreReportedButNotRepaired)
+{
+    DemoBuilder builder;
+    builder.Frames(300);
+    builder.Packet(5);
+    const auto packetOffset = builder.offsets.back();
+    builder.Archive(500);
+    const auto archiveOffset = builder.offsets.back();
+    const auto demo = builder.End().Build();
+
+    const auto report = Validate(demo);
+    CHECK(HasIssue(report, IssueType::SequenceNotIncreasing, packetOffset));
+    CHECK(HasIssue(report, IssueType::ServerTimeDecreasing, archiveOffset));
+    CHECK_EQ(report.issueCount, std::size_t(2));
+    CHECK(!report.IsRepairable());
+}
+
+TEST_CASE(ArchiveBufferDumpIsNotCheckedForOrder)
+{
+    // the first archives of a recording are the client's archive buffer, in no particular order
+    DemoBuilder builder;
+    for (int i = 0; i < 100; i++)
+        builder.Archive(10000 - i * 50);
+    const auto demo = builder.Frames(10).End().Build();
+
+    CHECK(Validate(demo).IsValid());
+}
+
+TEST_CASE(TrailingDataIsReportedAndCut)
+{
+    const auto intact = DemoBuilder().Frames(5).End().Build();
+    const auto demo = DemoBuilder().Frames(5).End().Raw("garbage").Build();
+
+    const auto report = Validate(demo);
+    CHECK(HasIssue(report, IssueType::TrailingData, intact.size()));
+    REQUIRE(report.IsRepairable());
+    CHECK(Repair(demo, report) == intact);
+}
+
+TEST_CASE(NothingToRepairWithoutAnIntactMessage)
+{
+    const auto report = Validate(std::string(1, char(9)));
+    CHECK(HasIssue(report, IssueType::UnknownMessageType, 0));
+    CHECK(!report.IsRepairable());
+}
+
+TEST_CASE(OnlyTheFirstIssuesAreKept)
+{
+    DemoBuilder builder;
+    for (int i = 0; i < 100; i++)
+        builder.Packet(1);
+    const auto report = Validate(builder.End().Build());
+
+    CHECK_EQ(report.issueCount, std::size_t(99));
+    CHECK_EQ(report.issues.size(), MAX_REPORTED_ISSUES);
+}
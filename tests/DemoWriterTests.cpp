@@ -0,0 +1,221 @@
+#include "StdInclude.hpp"
+#include "TestFramework.hpp"
+
+#include "Demo/DemoReader.hpp"
+#include "Demo/DemoWriter.hpp"
+
+using namespace IWXMVM::IW3::Demo;
+
+namespace
+{
+    Message MakePacket(int32_t sequence, std::size_t size)
+    {
+        Message message{};
+        message.type = MessageType::NetworkPacket;
+        message.sequence = sequence;
+        for (std::size_t i = 0; i < size; i++)
+            message.data.push_back(static_cast<uint8_t>(sequence * 31 + i));
+        return message;
+    }
+
+    Message MakeArchive(int archiveIndex, int serverTime)
+    {
+        Message message{};
+        message.type = MessageType::ClientArchive;
+        message.archive.archiveIndex = archiveIndex;
+        message.archive.serverTime = serverTime;
+        message.archive.origin[0] = archiveIndex * 1.5f;
+        message.archive.viewAngles[1] = archiveIndex * -0.25f;
+        return message;
+    }
+
+    Message MakeProtocolHeader()
+    {
+        Message message{};
+        message.type = MessageType::CoD4XProtocolHeader;
+        for (std::size_t i = 0; i < COD4X_PROTOCOL_HEADER_SIZE; i++)
+            message.data.push_back(static_cast<uint8_t>(0xA0 + i));
+        return message;
+    }
+
+    // A CoD4X demo with one snapshot and one client archive per frame, 50ms apart starting at `startServerTime`
+    std::vector<Message> MakeDemoMessages(int frameCount, int startServerTime)
+    {
+        std::vector<Message> messages = {MakeProtocolHeader()};
+        for (int i = 0; i < frameCount; i++)
+        {
+            messages.push_back(MakePacket(i + 1, 20 + (i * 7) % 100));
+            messages.push_back(MakeArchive(i, startServerTime + i * 50));
+        }
+        return messages;
+    }
+
+    std::string WriteDemo(const std::vector<Message>& messages, bool endDemo = true)
+    {
+        std::ostringstream stream(std::ios::binary);
+        DemoWriter writer(stream);
+        for (const auto& message : messages)
+            writer.Write(message);
+        if (endDemo)
+            writer.WriteEndOfDemo();
+        return stream.str();
+    }
+
+    std::vector<Message> ReadDemo(const std::string& demo, ReadResult& endResult)
+    {
+        std::istringstream stream(demo, std::ios::binary);
+        DemoReader reader(stream);
+
+        std::vector<Message> messages;
+        Message message;
+        while ((endResult = reader.Next(message)) == ReadResult::Message)
+            messages.push_back(message);
+        return messages;
+    }
+
+    bool AreEqual(const Message& a, const Message& b)
+    {
+        if (a.type != b.type)
+            return false;
+        if (a.type == MessageType::ClientArchive)
+            return std::memcmp(&a.archive, &b.archive, sizeof(ClientArchive)) == 0;
+        return a.sequence == b.sequence && a.data == b.data;
+    }
+}  // namespace
+
+TEST_CASE(WrittenMessagesReadBackUnchanged)
+{
+    const auto messages = MakeDemoMessages(20, 1000);
+    const auto demo = WriteDemo(messages);
+
+    ReadResult endResult;
+    const auto readMessages = ReadDemo(demo, endResult);
+    CHECK_EQ(endResult, ReadResult::EndOfDemo);
+    REQUIRE(readMessages.size() == messages.size());
+    for (std::size_t i = 0; i < messages.size(); i++)
+        CHECK(AreEqual(readMessages[i], messages[i]));
+
+    // offsets point at the type byte of each message
+    CHECK_EQ(readMessages[0].offset, std::uint64_t(0));
+    CHECK_EQ(readMessages[1].offset, std::uint64_t(1 + COD4X_PROTOCOL_HEADER_SIZE));
+}
+
+TEST_CASE(TrimmedDemoEndsAtTheFirstArchivePastTheEnd)
+{
+    const auto messages = MakeDemoMessages(20, 1000);
+    std::istringstream input(WriteDemo(messages), std::ios::binary);
+    std::ostringstream output(std::ios::binary);
+
+    // 1230 lies between the archives at 1200 and 1250
+    const auto result = TrimDemo(input, output, 1230);
+    REQUIRE(result.has_value());
+    CHECK_EQ(result->lastServerTime, 1250);
+    CHECK_EQ(result->skippedMessageCount, std::size_t(0));
+
+    ReadResult endResult;
+    const auto trimmed = ReadDemo(output.str(), endResult);
+    CHECK_EQ(endResult, ReadResult::EndOfDemo);
+    REQUIRE(trimmed.size() == result->messageCount);
+
+    // everything up to the archive at 1250 is kept as is, so the start of the demo still decodes
+    REQUIRE(trimmed.size() == 1 + 6 * 2);
+    for (std::size_t i = 0; i < trimmed.size(); i++)
+        CHECK(AreEqual(trimmed[i], messages[i]));
+    CHECK_EQ(trimmed.back().archive.serverTime, 1250);
+
+    // the end-of-demo packet follows right after
+    CHECK_EQ(output.str().size(), WriteDemo({messages.begin(), messages.begin() + trimmed.size()}).size());
+}
+
+TEST_CASE(TrimmingPastTheEndCopiesTheWholeDemo)
+{
+    const auto messages = MakeDemoMessages(10, 1000);
+    const auto demo = WriteDemo(messages);
+    std::istringstream input(demo, std::ios::binary);
+    std::ostringstream output(std::ios::binary);
+
+    const auto result = TrimDemo(input, output, 100000);
+    REQUIRE(result.has_value());
+    CHECK_EQ(result->messageCount, messages.size());
+    CHECK_EQ(result->lastServerTime, 1450);
+    CHECK(output.str() == demo);
+}
+
+TEST_CASE(TruncatedDemoIsTrimmedToItsLastCompleteMessage)
+{
+    const auto messages = MakeDemoMessages(10, 1000);
+    auto demo = WriteDemo(messages, false);
+    demo.resize(demo.size() - 10);
+
+    std::istringstream input(demo, std::ios::binary);
+    std::ostringstream output(std::ios::binary);
+    const auto result = TrimDemo(input, output, 100000);
+    REQUIRE(result.has_value());
+    CHECK_EQ(result->messageCount, messages.size() - 1);
+
+    // the cut off archive is dropped and the output is a complete demo again
+    ReadResult endResult;
+    const auto trimmed = ReadDemo(output.str(), endResult);
+    CHECK_EQ(endResult, ReadResult::EndOfDemo);
+    CHECK_EQ(trimmed.size(), messages.size() - 1);
+}
+
+TEST_CASE(UnknownMessagesAreDroppedWhenTrimming)
+{
+    const auto messages = MakeDemoMessages(4, 1000);
+    auto demo = WriteDemo(messages);
+    demo.insert(demo.begin() + 1 + COD4X_PROTOCOL_HEADER_SIZE, char(7));
+
+    std::istringstream input(demo, std::ios::binary);
+    std::ostringstream output(std::ios::binary);
+    const auto result = TrimDemo(input, output, 100000);
+    REQUIRE(result.has_value());
+    CHECK_EQ(result->skippedMessageCount, std::size_t(1));
+    CHECK(output.str() == WriteDemo(messages));
+}
+
+TEST_CASE(EmptyInputIsNotADemo)
+{
+    std::istringstream input(std::string(), std::ios::binary);
+    std::ostringstream output(std::ios::binary);
+    CHECK(!TrimDemo(input, output, 1000).has_value());
+}
+
+TEST_CASE(TrimProgressIsMonotonic)
+{
+    const auto messages = MakeDemoMessages(50, 1000);
+    std::istringstream input(WriteDemo(messages), std::ios::binary);
+    std::ostringstream output(std::ios::binary);
+
+    std::vector<float> progress;
+    TrimDemo(input, output, 100000, [&](float value) { progress.push_back(value); });
+
+    REQUIRE(progress.size() == 50);
+    CHECK(std::is_sorted(progress.begin(), progress.end()));
+    CHECK(progress.front() > 0.0f);
+    CHECK(progress.back() <= 1.0f);
+
+    // only the end-of-demo packet is left after the last archive
+    CHECK(progress.back() > 0.99f);
+}
+
+TEST_CASE(TrimStopsWhenRequested)
+{
+    const auto messages = MakeDemoMessages(50, 1000);
+    std::istringstream input(WriteDemo(messages), std::ios::binary);
+    std::ostringstream output(std::ios::binary);
+
+    // request the stop from within the progress callback, after the tenth client archive
+    std::stop_source stopSource;
+    int archiveCount = 0;
+    const auto result = TrimDemo(
+        input, output, 100000,
+        [&](float) {
+            if (++archiveCount == 10)
+                stopSource.request_stop();
+        },
+        stopSource.get_token());
+
+    CHECK(!result.has_value());
+    CHECK_EQ(archiveCount, 10);
+}
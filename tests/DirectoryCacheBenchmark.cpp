@@ -0,0 +1,83 @@
+#include "StdInclude.hpp"
+#include "Benchmark.hpp"
+
+#include "Utilities/DirectoryCache.hpp"
+
+using namespace IWXMVM;
+
+// Lays out `directoryCount` folders of `filesPerDirectory` files two levels deep, like demos sorted by event and
+// match. Every tenth file is not a demo.
+std::filesystem::path MakeTree(std::size_t directoryCount, std::size_t filesPerDirectory)
+{
+    const auto now = std::chrono::steady_clock::now().time_since_epoch().count();
+    const auto root = std::filesystem::temp_directory_path() / std::format("iwxmvm_directory_cache_{}", now);
+
+    constexpr std::size_t MATCHES_PER_EVENT = 25;
+    for (std::size_t i = 0; i < directoryCount; i++)
+    {
+        const auto directory =
+            root / std::format("event {}", i / MATCHES_PER_EVENT) / std::format("match {}", i % MATCHES_PER_EVENT);
+        std::filesystem::create_directories(directory);
+        for (std::size_t j = 0; j < filesPerDirectory; j++)
+            std::ofstream(directory / std::format("demo{}{}", j, j % 10 == 9 ? ".txt" : ".dm_1"));
+    }
+    return root;
+}
+
+DirectoryCache MakeCache()
+{
+    return DirectoryCache([](const std::filesystem::path& file) { return file.extension() == ".dm_1"; },
+                          [](const std::filesystem::path& file) { return file.stem().native(); });
+}
+
+// Walks the tree the way the demo loader's search does and returns the number of demos found
+std::size_t Walk(DirectoryCache& cache, const std::filesystem::path& root)
+{
+    std::size_t demoCount = 0;
+    const std::function<void(const std::filesystem::path&)> walkDirectory = [&](const std::filesystem::path& path) {
+        const auto& listing = cache.List(path);
+        demoCount += listing.files.size();
+
+        // the listing is only valid until the next call
+        const auto subdirectories = listing.subdirectories;
+        for (const auto& subdirectory : subdirectories)
+            walkDirectory(subdirectory);
+    };
+
+    cache.BeginWalk();
+    walkDirectory(root);
+    cache.EndWalk();
+    return demoCount;
+}
+
+int main()
+{
+    constexpr std::size_t DIRECTORY_COUNT = 500;
+    constexpr std::size_t FILES_PER_DIRECTORY = 100;
+
+    const auto root = MakeTree(DIRECTORY_COUNT, FILES_PER_DIRECTORY);
+    std::printf("%zu files in %zu directories\n", DIRECTORY_COUNT * FILES_PER_DIRECTORY, DIRECTORY_COUNT);
+
+    // a fresh cache reads and sorts every directory, like every rescan did before listings were cached
+    Tests::Benchmark("Cold scan", 1, [&] {
+        auto cache = MakeCache();
+        Tests::DoNotOptimize(Walk(cache, root));
+    });
+
+    auto cache = MakeCache();
+    const auto demoCount = Walk(cache, root);
+    std::printf("Found %zu demos, cached %zu listings\n", demoCount, cache.GetCachedCount());
+
+    Tests::Benchmark("Rescan, nothing changed", 1, [&] { Tests::DoNotOptimize(Walk(cache, root)); });
+
+    // only the directory the demo was recorded into is read again
+    const auto changedDirectory = root / "event 3" / "match 7";
+    std::size_t recordedCount = 0;
+    Tests::Benchmark("Rescan, one demo recorded", 1, [&] {
+        std::ofstream(changedDirectory / std::format("recorded{}.dm_1", recordedCount++));
+        Tests::DoNotOptimize(Walk(cache, root));
+    });
+
+    std::filesystem::remove_all(root);
+    return 0;
+}
@@ -0,0 +1,148 @@
+#include "StdInclude.hpp"
+#include "Benchmark.hpp"
+
+#include "Mod.hpp"
+#include "Events.hpp"
+#include "Components/EntityTable.hpp"
+
+using namespace IWXMVM;
+namespace EntityTable = IWXMVM::Components::EntityTable;
+
+// The size of IW3's centity_s, with the members GetEntities reads at their offsets
+struct FakeCentity
+{
+    std::array<std::uint8_t, 0x2> pad0;
+    char eType;
+    std::array<std::uint8_t, 0xE5> pad1;
+    std::int32_t clientNum;
+    std::array<std::uint8_t, 0xEC> pad2;
+    bool nextValid;
+    std::array<std::uint8_t, 0x3> pad3;
+};
+static_assert(sizeof(FakeCentity) == 0x1DC);
+
+// Converts the fake cg_entities like IW3Interface::GetEntities converts the game's
+class FakeGameInterface : public GameInterface
+{
+   public:
+    std::array<FakeCentity, Types::MAX_ENTITIES> cg_entities{};
+
+    void SetSun(Types::Sun, FieldDiff::FieldMask) override
+    {
+    }
+
+    void SetDof(Types::DoF, FieldDiff::FieldMask) override
+    {
+    }
+
+    void SetFilmtweaks(Types::Filmtweaks, FieldDiff::FieldMask) override
+    {
+    }
+
+    void GetEntities(std::span<Types::Entity> entities) override
+    {
+        for (int i = 0; i < static_cast<int>(entities.size()); i++)
+        {
+            const auto& entity = cg_entities[i];
+            entities[i] = Types::Entity{.id = i,
+                                        .type = ToEntityType(entity.eType),
+                                        .clientNum = entity.clientNum,
+                                        .isValid = entity.nextValid};
+        }
+    }
+
+    // What GetEntities did before the entity table: a new vector on every call
+    std::vector<Types::Entity> GetEntityVector()
+    {
+        std::vector<Types::Entity> entities(Types::MAX_ENTITIES);
+        GetEntities(entities);
+        return entities;
+    }
+
+   private:
+    static Types::EntityType ToEntityType(char eType)
+    {
+        switch (eType)
+        {
+            case 1:
+                return Types::EntityType::Player;
+            case 2:
+                return Types::EntityType::Corpse;
+            case 3:
+                return Types::EntityType::Item;
+            case 4:
+                return Types::EntityType::Missile;
+            case 12:
+                return Types::EntityType::Helicopter;
+            default:
+                return Types::EntityType::Unsupported;
+        }
+    }
+};
+
+// A full server: 18 players, a few corpses and items, and a grenade that is thrown and explodes every other frame
+void FillEntities(FakeGameInterface& game)
+{
+    for (int i = 0; i < 18; i++)
+        game.cg_entities[i] = {.eType = 1, .clientNum = i, .nextValid = true};
+    for (int i = 18; i < 24; i++)
+        game.cg_entities[i] = {.eType = 2, .clientNum = i - 18, .nextValid = true};
+    for (int i = 24; i < 40; i++)
+        game.cg_entities[i] = {.eType = 3, .nextValid = true};
+}
+
+void AdvanceFrame(FakeGameInterface& game, bool hasChanges)
+{
+    static bool isGrenadeThrown = false;
+    if (hasChanges)
+    {
+        isGrenadeThrown = !isGrenadeThrown;
+        game.cg_entities[100] = {.eType = static_cast<char>(isGrenadeThrown ? 4 : 0), .nextValid = isGrenadeThrown};
+    }
+}
+
+int main()
+{
+    FakeGameInterface game;
+    FillEntities(game);
+    Mod::Initialize(&game);
+    EntityTable::Initialize();
+
+    // every reader does what BoneCamera does each frame: look up its entity and search the corpses
+    for (const bool hasChanges : {false, true})
+    {
+        for (const int readerCount : {1, 3, 10})
+        {
+            std::printf("\n%d reader%s per frame, %s\n", readerCount, readerCount == 1 ? "" : "s",
+                        hasChanges ? "an entity changes every frame" : "no entity changes");
+
+            Tests::Benchmark("Vector per call (previous GetEntities)", 1000, [&] {
+                AdvanceFrame(game, hasChanges);
+                for (int reader = 0; reader < readerCount; reader++)
+                {
+                    const auto entities = game.GetEntityVector();
+                    Tests::DoNotOptimize(entities[reader]);
+                    for (const auto& entity : entities)
+                    {
+                        if (entity.type == Types::EntityType::Corpse)
+                            Tests::DoNotOptimize(entity);
+                    }
+                }
+            });
+
+            Tests::Benchmark("Entity table", 1000, [&] {
+                AdvanceFrame(game, hasChanges);
+                for (int reader = 0; reader < readerCount; reader++)
+                {
+                    Tests::DoNotOptimize(EntityTable::GetEntity(reader));
+                    for (const auto* corpse : EntityTable::GetEntitiesOfType(Types::EntityType::Corpse))
+                        Tests::DoNotOptimize(*corpse);
+                }
+                Events::Invoke<EventType::OnFrame>();
+            });
+        }
+    }
+
+    std::printf("\n%llu refreshes\n", static_cast<unsigned long long>(EntityTable::GetRefreshCount()));
+    return 0;
+}
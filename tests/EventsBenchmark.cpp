@@ -0,0 +1,66 @@
+#include "StdInclude.hpp"
+#include "Benchmark.hpp"
+
+#include "Events.hpp"
+
+using namespace IWXMVM;
+
+// The event bus before listeners were ordered by priority: a map from event type to the listeners in registration
+// order, looked up on every invocation
+std::map<EventType, std::vector<std::function<void()>>> mapListeners;
+
+void InvokeMapListeners(EventType eventType)
+{
+    for (const auto& function : mapListeners[eventType])
+    {
+        function();
+    }
+}
+
+// About as many listeners as the mod registers for OnFrame, each doing next to nothing so dispatch is all that is
+// measured
+constexpr std::size_t LISTENER_COUNT = 12;
+std::uint64_t counter = 0;
+
+int main()
+{
+    std::vector<Events::ListenerHandle> frameListeners;
+    for (std::size_t i = 0; i < LISTENER_COUNT; i++)
+    {
+        // a few listeners on the other events as well, so the lookup is not trivially the only entry
+        for (const auto eventType : {EventType::OnFrame, EventType::PostDemoLoad})
+        {
+            const auto priority = static_cast<int32_t>(i % 3) - 1;
+            const auto handle = Events::RegisterListener(eventType, [] { counter++; }, priority);
+            if (eventType == EventType::OnFrame)
+                frameListeners.push_back(handle);
+            mapListeners[eventType].push_back([] { counter++; });
+        }
+    }
+
+    std::printf("%zu listeners per invocation\n", LISTENER_COUNT);
+    Tests::Benchmark("Map of vectors (previous bus)", 100000, [] { InvokeMapListeners(EventType::OnFrame); });
+    Tests::Benchmark("Array by event type", 100000, [] { Events::Invoke<EventType::OnFrame>(); });
+
+    Events::SetProfilingEnabled(true);
+    Tests::Benchmark("Array by event type, listeners profiled", 100000, [] { Events::Invoke<EventType::OnFrame>(); });
+    Events::SetProfilingEnabled(false);
+
+    // the same listeners reading the frame's payload, as FrameState does
+    for (const auto handle : frameListeners)
+        Events::UnregisterListener(handle);
+    for (std::size_t i = 0; i < LISTENER_COUNT; i++)
+    {
+        Events::RegisterListener<EventType::OnFrame>(
+            [](const Events::Payload<EventType::OnFrame>& frame) { counter += frame.tick; },
+            static_cast<int32_t>(i % 3) - 1);
+    }
+
+    std::uint32_t tick = 0;
+    Tests::Benchmark("Array by event type, payload listeners", 100000, [&] {
+        Events::Invoke<EventType::OnFrame>({.frameIndex = tick, .deltaTime = 0.016f, .tick = tick++});
+    });
+
+    Tests::DoNotOptimize(counter);
+    return 0;
+}
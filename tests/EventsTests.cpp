@@ -0,0 +1,307 @@
+#include "StdInclude.hpp"
+#include "TestFramework.hpp"
+
+#include "Events.hpp"
+
+using namespace IWXMVM;
+
+namespace
+{
+    // Listeners of earlier tests are not all removed again, so every test registers its own and they only record
+    // while their test runs
+    int currentTest = 0;
+    std::vector<std::string> calls;
+
+    void StartTest(int test)
+    {
+        currentTest = test;
+        calls.clear();
+    }
+
+    void Listen(int test, EventType eventType, std::string name, int32_t priority = Events::DEFAULT_PRIORITY)
+    {
+        Events::RegisterListener(
+            eventType,
+            [test, name = std::move(name)] {
+                if (currentTest == test)
+                    calls.push_back(name);
+            },
+            priority);
+    }
+
+    std::vector<std::string> Expect(std::initializer_list<const char*> names)
+    {
+        return std::vector<std::string>(names.begin(), names.end());
+    }
+}  // namespace
+
+TEST_CASE(ListenersRunByPriorityThenRegistrationOrder)
+{
+    StartTest(1);
+    Listen(1, EventType::OnFrame, "default");
+    Listen(1, EventType::OnFrame, "late", std::numeric_limits<int32_t>::max());
+    Listen(1, EventType::OnFrame, "early", std::numeric_limits<int32_t>::min());
+    Listen(1, EventType::OnFrame, "second default");
+    Listen(1, EventType::OnFrame, "before default", Events::DEFAULT_PRIORITY - 1);
+
+    Events::Invoke<EventType::OnFrame>();
+    CHECK(calls == Expect({"early", "before default", "default", "second default", "late"}));
+}
+
+TEST_CASE(OnlyListenersOfTheInvokedEventRun)
+{
+    StartTest(2);
+    Listen(2, EventType::PreDemoLoad, "pre");
+    Listen(2, EventType::PostDemoLoad, "post");
+
+    Events::Invoke<EventType::PostDemoLoad>();
+    Events::Invoke<EventType::OnCameraChanged>();
+    CHECK(calls == Expect({"post"}));
+}
+
+TEST_CASE(ListenersRegisteredDuringInvokeRunFromTheNextInvoke)
+{
+    StartTest(3);
+    bool hasRegistered = false;
+    Events::RegisterListener(EventType::PreDemoLoad, [&] {
+        if (currentTest != 3 || hasRegistered)
+            return;
+
+        hasRegistered = true;
+        calls.push_back("registering");
+        // would run in this invocation if it were inserted right away, as it sorts behind this listener
+        Listen(3, EventType::PreDemoLoad, "registered", std::numeric_limits<int32_t>::max());
+    });
+
+    Events::Invoke<EventType::PreDemoLoad>();
+    CHECK(calls == Expect({"registering"}));
+
+    calls.clear();
+    Events::Invoke<EventType::PreDemoLoad>();
+    CHECK(calls == Expect({"registered"}));
+}
+
+TEST_CASE(NestedInvokeRunsEveryListenerAgain)
+{
+    StartTest(4);
+    int depth = 0;
+    Events::RegisterListener(EventType::OnDemoBoundsDetermined, [&] {
+        if (currentTest != 4)
+            return;
+
+        calls.push_back(std::format("first {}", depth));
+        if (depth++ == 0)
+        {
+            Listen(4, EventType::OnDemoBoundsDetermined, "registered");
+            Events::Invoke<EventType::OnDemoBoundsDetermined>();
+        }
+    });
+    Listen(4, EventType::OnDemoBoundsDetermined, "second");
+
+    // the listener registered by the nested invocation waits for the outer one to return as well
+    Events::Invoke<EventType::OnDemoBoundsDetermined>();
+    CHECK(calls == Expect({"first 0", "first 1", "second", "second"}));
+
+    calls.clear();
+    Events::Invoke<EventType::OnDemoBoundsDetermined>();
+    CHECK(calls == Expect({"first 2", "second", "registered"}));
+}
+
+TEST_CASE(ExceptionsLeaveTheEventUsable)
+{
+    StartTest(5);
+    bool shouldThrow = true;
+    Events::RegisterListener(EventType::OnRenderGameView, [&] {
+        if (currentTest != 5)
+            return;
+
+        calls.push_back("throwing");
+        Listen(5, EventType::OnRenderGameView, "registered");
+        if (shouldThrow)
+            throw std::runtime_error("listener failed");
+    });
+    Listen(5, EventType::OnRenderGameView, "after");
+
+    bool hasThrown = false;
+    try
+    {
+        Events::Invoke<EventType::OnRenderGameView>();
+    }
+    catch (const std::runtime_error&)
+    {
+        hasThrown = true;
+    }
+    CHECK(hasThrown);
+    CHECK(calls == Expect({"throwing"}));
+
+    // the listener registered before the exception is added all the same
+    shouldThrow = false;
+    calls.clear();
+    Events::Invoke<EventType::OnRenderGameView>();
+    CHECK(calls == Expect({"throwing", "after", "registered"}));
+}
+
+TEST_CASE(ListenersAreOnlyTimedWhileProfiling)
+{
+    StartTest(6);
+    const auto sleep = [] { std::this_thread::sleep_for(std::chrono::milliseconds(1)); };
+    const auto line = std::source_location::current().line() + 1;
+    const auto handle = Events::RegisterListener(EventType::OnCameraChanged, sleep, 7);
+
+    const auto findStats = [&] {
+        const auto name = std::format("EventsTests.cpp:{}", line);
+        for (const auto& stats : Events::GetListenerStats())
+        {
+            if (stats.name == name)
+                return std::optional(stats);
+        }
+        return std::optional<Events::ListenerStats>();
+    };
+
+    Events::Invoke<EventType::OnCameraChanged>();
+    auto stats = findStats();
+    REQUIRE(stats.has_value());
+    CHECK(stats->eventType == EventType::OnCameraChanged);
+    CHECK_EQ(stats->priority, 7);
+    CHECK_EQ(stats->callCount, std::uint64_t(0));
+
+    Events::SetProfilingEnabled(true);
+    CHECK(Events::IsProfilingEnabled());
+    Events::Invoke<EventType::OnCameraChanged>();
+    Events::Invoke<EventType::OnCameraChanged>();
+    Events::SetProfilingEnabled(false);
+    Events::Invoke<EventType::OnCameraChanged>();
+
+    stats = findStats();
+    REQUIRE(stats.has_value());
+    CHECK_EQ(stats->callCount, std::uint64_t(2));
+    CHECK(stats->lastDuration >= std::chrono::milliseconds(1));
+    CHECK(stats->totalDuration >= stats->lastDuration + std::chrono::milliseconds(1));
+
+    // removed listeners are not reported
+    Events::UnregisterListener(handle);
+    CHECK(!findStats().has_value());
+}
+
+TEST_CASE(PayloadListenersReceiveThePayload)
+{
+    StartTest(7);
+    std::vector<Events::Payload<EventType::OnFrame>> frames;
+    Events::RegisterListener<EventType::OnFrame>([&](const Events::Payload<EventType::OnFrame>& frame) {
+        if (currentTest == 7)
+            frames.push_back(frame);
+    });
+
+    // listeners with and without a payload share one order
+    Listen(7, EventType::OnFrame, "without payload", Events::DEFAULT_PRIORITY - 1);
+    Events::RegisterListener<EventType::OnFrame>(
+        [&](const Events::Payload<EventType::OnFrame>& frame) {
+            if (currentTest == 7)
+                calls.push_back(std::format("tick {}", frame.tick));
+        },
+        Events::DEFAULT_PRIORITY + 1);
+
+    Events::Invoke<EventType::OnFrame>({.frameIndex = 41, .deltaTime = 0.25f, .tick = 1000});
+    Events::Invoke<EventType::OnFrame>({.frameIndex = 42, .deltaTime = 0.5f, .tick = 1050});
+
+    REQUIRE(frames.size() == 2);
+    CHECK_EQ(frames[0].frameIndex, std::uint64_t(41));
+    CHECK_EQ(frames[0].deltaTime, 0.25f);
+    CHECK_EQ(frames[0].tick, std::uint32_t(1000));
+    CHECK_EQ(frames[1].frameIndex, std::uint64_t(42));
+    CHECK_EQ(frames[1].tick, std::uint32_t(1050));
+    CHECK(calls == Expect({"without payload", "tick 1000", "without payload", "tick 1050"}));
+}
+
+TEST_CASE(UnregisteredListenersAreNotCalledAgain)
+{
+    StartTest(8);
+    const auto first = Events::RegisterListener(EventType::PostDemoLoad, [] {
+        if (currentTest == 8)
+            calls.push_back("first");
+    });
+    Listen(8, EventType::PostDemoLoad, "second");
+
+    Events::Invoke<EventType::PostDemoLoad>();
+    CHECK(calls == Expect({"first", "second"}));
+
+    calls.clear();
+    Events::UnregisterListener(first);
+    Events::Invoke<EventType::PostDemoLoad>();
+    CHECK(calls == Expect({"second"}));
+
+    // a second unregistration of the same handle does nothing
+    calls.clear();
+    Events::UnregisterListener(first);
+    Events::Invoke<EventType::PostDemoLoad>();
+    CHECK(calls == Expect({"second"}));
+}
+
+TEST_CASE(ListenersCanUnregisterDuringInvoke)
+{
+    StartTest(9);
+    Events::ListenerHandle self{};
+    Events::ListenerHandle later{};
+    self = Events::RegisterListener(EventType::OnDemoBoundsDetermined, [&] {
+        if (currentTest != 9)
+            return;
+
+        // removes itself and a listener that has not run yet in this invocation
+        calls.push_back("once");
+        Events::UnregisterListener(self);
+        Events::UnregisterListener(later);
+    });
+    Listen(9, EventType::OnDemoBoundsDetermined, "kept");
+    later = Events::RegisterListener(EventType::OnDemoBoundsDetermined, [] {
+        if (currentTest == 9)
+            calls.push_back("removed");
+    });
+
+    Events::Invoke<EventType::OnDemoBoundsDetermined>();
+    CHECK(calls == Expect({"once", "kept"}));
+
+    calls.clear();
+    Events::Invoke<EventType::OnDemoBoundsDetermined>();
+    CHECK(calls == Expect({"kept"}));
+}
+
+TEST_CASE(ListenersRegisteredAndUnregisteredDuringInvokeNeverRun)
+{
+    StartTest(10);
+    bool hasRegistered = false;
+    Events::RegisterListener(EventType::PreDemoLoad, [&] {
+        if (currentTest != 10 || hasRegistered)
+            return;
+
+        hasRegistered = true;
+        const auto handle = Events::RegisterListener(EventType::PreDemoLoad, [] {
+            if (currentTest == 10)
+                calls.push_back("pending");
+        });
+        Events::UnregisterListener(handle);
+    });
+
+    Events::Invoke<EventType::PreDemoLoad>();
+    Events::Invoke<EventType::PreDemoLoad>();
+    CHECK(calls.empty());
+}
+
+TEST_CASE(HandlesOnlyRemoveTheirOwnListener)
+{
+    StartTest(11);
+    const auto onCameraChanged = Events::RegisterListener(EventType::OnCameraChanged, [] {});
+    Listen(11, EventType::OnRenderGameView, "first");
+    const auto second = Events::RegisterListener(EventType::OnRenderGameView, [] {
+        if (currentTest == 11)
+            calls.push_back("second");
+    });
+    Listen(11, EventType::OnRenderGameView, "third");
+
+    CHECK(onCameraChanged.eventType == EventType::OnCameraChanged);
+    CHECK(onCameraChanged.id != second.id);
+
+    Events::UnregisterListener(onCameraChanged);
+    Events::UnregisterListener(second);
+    Events::Invoke<EventType::OnRenderGameView>();
+    CHECK(calls == Expect({"first", "third"}));
+}
@@ -0,0 +1,332 @@
+#include "StdInclude.hpp"
+#include "TestFramework.hpp"
+
+#include "Mod.hpp"
+#include "Components/VisualApplier.hpp"
+
+using namespace IWXMVM;
+using namespace IWXMVM::FieldDiff;
+namespace VisualApplier = IWXMVM::Components::VisualApplier;
+
+namespace
+{
+    template <typename T>
+    struct SetCall
+    {
+        T value;
+        FieldMask changedFields;
+    };
+
+    // Records what the applier writes, and keeps the fields it was told to write like the game's dvars would
+    class MockGameInterface : public GameInterface
+    {
+       public:
+        std::vector<SetCall<Types::Sun>> sunCalls;
+        std::vector<SetCall<Types::DoF>> dofCalls;
+        std::vector<SetCall<Types::Filmtweaks>> filmtweaksCalls;
+        Types::Sun gameSun{};
+
+        void SetSun(Types::Sun sun, FieldMask changedFields) override
+        {
+            sunCalls.push_back({sun, changedFields});
+            CopyFields(gameSun, sun, changedFields);
+        }
+
+        void SetDof(Types::DoF dof, FieldMask changedFields) override
+        {
+            dofCalls.push_back({dof, changedFields});
+        }
+
+        void SetFilmtweaks(Types::Filmtweaks filmtweaks, FieldMask changedFields) override
+        {
+            filmtweaksCalls.push_back({filmtweaks, changedFields});
+        }
+
+        void GetEntities(std::span<Types::Entity>) override
+        {
+        }
+    };
+
+    // A fresh mock for every test, with the applier forgetting the previous test's visuals
+    struct MockGame
+    {
+        MockGameInterface gameInterface;
+
+        MockGame()
+        {
+            Mod::Initialize(&gameInterface);
+            VisualApplier::Reset();
+        }
+
+        ~MockGame()
+        {
+            Mod::Initialize(nullptr);
+        }
+    };
+
+    Types::Sun MakeSun()
+    {
+        return {.color = {1.0f, 0.9f, 0.8f}, .direction = {0.0f, 0.5f, -1.0f}, .brightness = 2.0f};
+    }
+
+    Types::DoF MakeDof()
+    {
+        return {.enabled = true,
+                .farBlur = 1.5f,
+                .farStart = 100.0f,
+                .farEnd = 1000.0f,
+                .nearBlur = 4.0f,
+                .nearStart = 0.0f,
+                .nearEnd = 10.0f,
+                .bias = 0.5f};
+    }
+
+    Types::Filmtweaks MakeFilmtweaks()
+    {
+        return {.enabled = true,
+                .brightness = 0.1f,
+                .contrast = 1.4f,
+                .desaturation = 0.2f,
+                .tintLight = {1.0f, 1.0f, 1.0f},
+                .tintDark = {0.7f, 0.85f, 1.0f},
+                .invert = false};
+    }
+}  // namespace
+
+TEST_CASE(FieldBitsFollowTheMemberOrder)
+{
+    CHECK_EQ(GetFieldBit<&Types::Sun::color>(), FieldMask(1));
+    CHECK_EQ(GetFieldBit<&Types::Sun::direction>(), FieldMask(2));
+    CHECK_EQ(GetFieldBit<&Types::Sun::brightness>(), FieldMask(4));
+    CHECK_EQ(GetFieldBit<&Types::DoF::bias>(), FieldMask(1) << 7);
+    CHECK_EQ(GetFieldBit<&Types::Filmtweaks::invert>(), FieldMask(1) << 6);
+
+    // members of the same type are told apart by their address, not just their type
+    CHECK(GetFieldBit<&Types::DoF::farBlur>() != GetFieldBit<&Types::DoF::farStart>());
+    CHECK(GetFieldBit<&Types::Filmtweaks::tintLight>() != GetFieldBit<&Types::Filmtweaks::tintDark>());
+}
+
+TEST_CASE(FloatChangesWithinTheEpsilonAreIgnored)
+{
+    CHECK(!IsValueChanged(1.0f, 1.0f));
+    CHECK(!IsValueChanged(1.0f, 1.0f + EPSILON * 0.5f));
+    CHECK(!IsValueChanged(1.0f, 1.0f - EPSILON * 0.5f));
+    CHECK(IsValueChanged(1.0f, 1.0f + EPSILON * 2.0f));
+    CHECK(IsValueChanged(1.0f, 1.0f - EPSILON * 2.0f));
+
+    // a vector changed if any of its components did
+    CHECK(!IsValueChanged(glm::vec3(1.0f), glm::vec3(1.0f + EPSILON * 0.5f)));
+    CHECK(IsValueChanged(glm::vec3(1.0f), glm::vec3(1.0f, 1.0f, 1.0f + EPSILON * 2.0f)));
+    CHECK(IsValueChanged(glm::vec3(1.0f), glm::vec3(1.0f - EPSILON * 2.0f, 1.0f, 1.0f)));
+
+    // everything else is compared exactly
+    CHECK(IsValueChanged(false, true));
+    CHECK(IsValueChanged(1, 2));
+    CHECK(!IsValueChanged(3, 3));
+}
+
+TEST_CASE(ChangedFieldsAreFlagged)
+{
+    const auto previous = MakeDof();
+    CHECK_EQ(GetChangedFields(previous, previous), FieldMask(0));
+
+    auto current = previous;
+    current.enabled = false;
+    current.nearEnd += 1.0f;
+    current.bias += EPSILON * 0.5f;
+
+    const auto changedFields = GetChangedFields(previous, current);
+    CHECK_EQ(changedFields, GetFieldBit<&Types::DoF::enabled>() | GetFieldBit<&Types::DoF::nearEnd>());
+    CHECK(IsFieldChanged<&Types::DoF::enabled>(changedFields));
+    CHECK(IsFieldChanged<&Types::DoF::nearEnd>(changedFields));
+    CHECK(!IsFieldChanged<&Types::DoF::bias>(changedFields));
+    CHECK(!IsFieldChanged<&Types::DoF::farBlur>(changedFields));
+}
+
+TEST_CASE(OnlyMaskedFieldsAreCopied)
+{
+    auto destination = MakeFilmtweaks();
+    auto source = destination;
+    source.contrast = 2.0f;
+    source.tintDark = {0.0f, 0.0f, 0.0f};
+    source.invert = true;
+
+    CopyFields(destination, source,
+               GetFieldBit<&Types::Filmtweaks::contrast>() | GetFieldBit<&Types::Filmtweaks::invert>());
+    CHECK_EQ(destination.contrast, 2.0f);
+    CHECK(destination.invert);
+    CHECK(destination.tintDark == MakeFilmtweaks().tintDark);
+
+    CopyFields(destination, source, 0);
+    CHECK(destination.tintDark == MakeFilmtweaks().tintDark);
+    CopyFields(destination, source, ALL_FIELDS);
+    CHECK(destination.tintDark == source.tintDark);
+}
+
+TEST_CASE(CopyingOnlyChangedFieldsLetsDriftAddUp)
+{
+    // the applied copy only takes the fields that were written, so steps below the epsilon are compared against the
+    // last written value rather than the previous step, and eventually count as a change
+    const auto start = MakeSun();
+    auto applied = start;
+    auto current = start;
+
+    std::size_t changeCount = 0;
+    for (int step = 1; step <= 100; step++)
+    {
+        current.brightness = start.brightness + step * EPSILON * 0.3f;
+        const auto changedFields = GetChangedFields(applied, current);
+        if (changedFields != 0)
+        {
+            CHECK_EQ(changedFields, GetFieldBit<&Types::Sun::brightness>());
+            CopyFields(applied, current, changedFields);
+            changeCount++;
+        }
+        CHECK(std::abs(applied.brightness - current.brightness) <= EPSILON);
+    }
+
+    // 100 steps of 0.3 epsilons drift by 30 epsilons, written about every fourth step
+    CHECK(changeCount >= 20 && changeCount <= 30);
+}
+
+TEST_CASE(FirstApplyWritesEveryField)
+{
+    MockGame game;
+    VisualApplier::SetSun(MakeSun());
+    VisualApplier::SetDof(MakeDof());
+    VisualApplier::SetFilmtweaks(MakeFilmtweaks());
+    VisualApplier::Apply();
+
+    REQUIRE(game.gameInterface.sunCalls.size() == 1);
+    REQUIRE(game.gameInterface.dofCalls.size() == 1);
+    REQUIRE(game.gameInterface.filmtweaksCalls.size() == 1);
+    CHECK_EQ(game.gameInterface.sunCalls[0].changedFields, ALL_FIELDS);
+    CHECK_EQ(game.gameInterface.dofCalls[0].changedFields, ALL_FIELDS);
+    CHECK_EQ(game.gameInterface.filmtweaksCalls[0].changedFields, ALL_FIELDS);
+    CHECK_EQ(game.gameInterface.dofCalls[0].value.farEnd, 1000.0f);
+}
+
+TEST_CASE(UnchangedVisualsAreNotWritten)
+{
+    MockGame game;
+    for (int frame = 0; frame < 10; frame++)
+    {
+        VisualApplier::SetSun(MakeSun());
+        VisualApplier::Apply();
+    }
+
+    // nothing queued, nothing written
+    VisualApplier::Apply();
+
+    CHECK_EQ(game.gameInterface.sunCalls.size(), std::size_t(1));
+    CHECK(game.gameInterface.dofCalls.empty());
+    CHECK(game.gameInterface.filmtweaksCalls.empty());
+}
+
+TEST_CASE(OnlyChangedFieldsAreWritten)
+{
+    MockGame game;
+    VisualApplier::SetFilmtweaks(MakeFilmtweaks());
+    VisualApplier::Apply();
+
+    auto filmtweaks = MakeFilmtweaks();
+    filmtweaks.desaturation = 0.9f;
+    filmtweaks.tintLight.y = 0.5f;
+    filmtweaks.contrast += EPSILON * 0.5f;
+    VisualApplier::SetFilmtweaks(filmtweaks);
+    VisualApplier::Apply();
+
+    REQUIRE(game.gameInterface.filmtweaksCalls.size() == 2);
+    CHECK_EQ(game.gameInterface.filmtweaksCalls[1].changedFields,
+             GetFieldBit<&Types::Filmtweaks::desaturation>() | GetFieldBit<&Types::Filmtweaks::tintLight>());
+    CHECK_EQ(game.gameInterface.filmtweaksCalls[1].value.desaturation, 0.9f);
+}
+
+TEST_CASE(OnlyTheLastQueuedVisualsOfAFrameAreWritten)
+{
+    MockGame game;
+    VisualApplier::SetDof(MakeDof());
+    VisualApplier::Apply();
+
+    // e.g. the keyframe editor and the visuals menu both setting the DoF in one frame
+    for (int i = 1; i <= 5; i++)
+    {
+        auto dof = MakeDof();
+        dof.farBlur = static_cast<float>(i);
+        VisualApplier::SetDof(dof);
+    }
+    VisualApplier::Apply();
+
+    REQUIRE(game.gameInterface.dofCalls.size() == 2);
+    CHECK_EQ(game.gameInterface.dofCalls[1].changedFields, GetFieldBit<&Types::DoF::farBlur>());
+    CHECK_EQ(game.gameInterface.dofCalls[1].value.farBlur, 5.0f);
+}
+
+TEST_CASE(SlowChangesReachTheGame)
+{
+    MockGame game;
+    const auto start = MakeSun();
+    VisualApplier::SetSun(start);
+    VisualApplier::Apply();
+
+    // a keyframed fade that moves less than the epsilon per frame
+    auto sun = start;
+    for (int frame = 1; frame <= 100; frame++)
+    {
+        sun.brightness = start.brightness + frame * EPSILON * 0.3f;
+        sun.direction.x = start.direction.x - frame * EPSILON * 0.3f;
+        VisualApplier::SetSun(sun);
+        VisualApplier::Apply();
+        CHECK(std::abs(game.gameInterface.gameSun.brightness - sun.brightness) <= EPSILON);
+        CHECK(std::abs(game.gameInterface.gameSun.direction.x - sun.direction.x) <= EPSILON);
+    }
+
+    const auto& calls = game.gameInterface.sunCalls;
+    CHECK(calls.size() > 20 && calls.size() < 40);
+    for (std::size_t i = 1; i < calls.size(); i++)
+        CHECK_EQ(calls[i].changedFields & GetFieldBit<&Types::Sun::color>(), FieldMask(0));
+}
+
+TEST_CASE(ResynchronizeWritesEveryFieldAgain)
+{
+    MockGame game;
+    VisualApplier::SetSun(MakeSun());
+    VisualApplier::SetDof(MakeDof());
+    VisualApplier::Apply();
+
+    // vid_restart dropped the dvars, the same visuals have to be written in full
+    VisualApplier::Resynchronize();
+    VisualApplier::Apply();
+
+    REQUIRE(game.gameInterface.sunCalls.size() == 2);
+    REQUIRE(game.gameInterface.dofCalls.size() == 2);
+    CHECK_EQ(game.gameInterface.sunCalls[1].changedFields, ALL_FIELDS);
+    CHECK_EQ(game.gameInterface.dofCalls[1].changedFields, ALL_FIELDS);
+    CHECK(game.gameInterface.filmtweaksCalls.empty());
+
+    // visuals queued before the resynchronization win over the ones applied before it
+    auto sun = MakeSun();
+    sun.brightness = 5.0f;
+    VisualApplier::SetSun(sun);
+    VisualApplier::Resynchronize();
+    VisualApplier::Apply();
+
+    REQUIRE(game.gameInterface.sunCalls.size() == 3);
+    CHECK_EQ(game.gameInterface.sunCalls[2].changedFields, ALL_FIELDS);
+    CHECK_EQ(game.gameInterface.sunCalls[2].value.brightness, 5.0f);
+}
+
+TEST_CASE(ResetForgetsTheAppliedVisuals)
+{
+    MockGame game;
+    VisualApplier::SetSun(MakeSun());
+    VisualApplier::Apply();
+
+    // a new map resets the game's visuals, so the same values have to be written in full
+    VisualApplier::Reset();
+    VisualApplier::SetSun(MakeSun());
+    VisualApplier::Apply();
+
+    REQUIRE(game.gameInterface.sunCalls.size() == 2);
+    CHECK_EQ(game.gameInterface.sunCalls[1].changedFields, ALL_FIELDS);
+}
@@ -0,0 +1,61 @@
+#include "StdInclude.hpp"
+#include "Benchmark.hpp"
+
+#include <random>
+
+#include "Utilities/FuzzySearchIndex.hpp"
+
+using namespace IWXMVM;
+
+// Demo names the way they pile up in a library: recorded by the game, renamed by hand, or named after a clip
+std::vector<std::string> MakeDemoNames(std::size_t count)
+{
+    constexpr std::array words = {"crash",   "backlot", "crossfire", "district", "overgrown", "strike",  "vacant",
+                                  "bloc",    "pipeline", "shipment", "showdown", "wetwork",   "killcam", "ace",
+                                  "clutch",  "frag",     "movie",    "edit",     "final",     "round",   "scrim",
+                                  "match",   "pov",      "sniper",   "deagle",   "ak47",      "m40a3",   "r700"};
+
+    std::mt19937 random(1337);
+    std::vector<std::string> names;
+    names.reserve(count);
+    for (std::size_t i = 0; i < count; i++)
+    {
+        switch (random() % 3)
+        {
+            case 0:
+                names.push_back(std::format("demo{:04}", random() % 10000));
+                break;
+            case 1:
+                names.push_back(std::format("mp_{}_{}_{}", words[random() % words.size()],
+                                            words[random() % words.size()], random() % 100));
+                break;
+            default:
+                names.push_back(std::format("{} {} {} {}", words[random() % words.size()],
+                                            words[random() % words.size()], words[random() % words.size()],
+                                            random() % 1000));
+                break;
+        }
+    }
+    return names;
+}
+
+int main()
+{
+    for (const std::size_t count : {1000, 10000, 50000, 100000})
+    {
+        const auto names = MakeDemoNames(count);
+
+        std::printf("%s%zu demos\n", count == 1000 ? "" : "\n", count);
+        FuzzySearchIndex index;
+        Tests::Benchmark("Build", 1, [&] { index.Build(names); });
+
+        // typing a query issues one search per keystroke, short prefixes included
+        for (const auto* query : {"c", "cr", "cra", "crash", "crsah", "mp_crash", "crash ace", "sniper final 12",
+                                  "xyzzy"})
+        {
+            Tests::Benchmark(std::format("Query \"{}\"", query).c_str(), 1,
+                             [&] { Tests::DoNotOptimize(index.Query(query)); });
+        }
+    }
+    return 0;
+}
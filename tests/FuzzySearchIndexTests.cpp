@@ -0,0 +1,226 @@
+#include "StdInclude.hpp"
+#include "TestFramework.hpp"
+
+#include <random>
+#include <set>
+
+#include "Utilities/FuzzySearchIndex.hpp"
+
+using namespace IWXMVM;
+
+namespace
+{
+    FuzzySearchIndex MakeIndex(const std::vector<std::string>& documents)
+    {
+        FuzzySearchIndex index;
+        index.Build(documents);
+        return index;
+    }
+
+    std::vector<uint32_t> GetDocuments(const std::vector<FuzzySearchIndex::Match>& matches)
+    {
+        std::vector<uint32_t> documents;
+        for (const auto& match : matches)
+            documents.push_back(match.document);
+        return documents;
+    }
+
+    std::string ToLower(std::string_view text)
+    {
+        std::string lower(text);
+        for (auto& c : lower)
+            c = (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+        return lower;
+    }
+
+    // Straightforward implementation of the documented scoring, checked against the index for every document
+    std::vector<FuzzySearchIndex::Match> ReferenceQuery(const std::vector<std::string>& documents,
+                                                        std::string_view query)
+    {
+        std::vector<std::string> words;
+        std::string word;
+        for (const auto c : ToLower(query) + " ")
+        {
+            if (c != ' ')
+            {
+                word.push_back(c);
+            }
+            else if (!word.empty())
+            {
+                words.push_back(std::move(word));
+                word.clear();
+            }
+        }
+
+        auto Trigrams = [](std::string_view text) {
+            std::set<std::string_view> trigrams;
+            for (std::size_t i = 0; i + 3 <= text.length(); i++)
+                trigrams.insert(text.substr(i, 3));
+            return trigrams;
+        };
+
+        std::vector<FuzzySearchIndex::Match> matches;
+        if (words.empty())
+            return matches;
+
+        for (uint32_t d = 0; d < documents.size(); d++)
+        {
+            const auto document = ToLower(documents[d]);
+            float total = 0.0f;
+            bool isMatch = true;
+            for (const auto& w : words)
+            {
+                float score = 0.0f;
+                if (const auto position = document.find(w); position != std::string::npos)
+                {
+                    const bool atWordStart =
+                        position == 0 || !std::isalnum(static_cast<uint8_t>(document[position - 1]));
+                    score = atWordStart ? 2.0f : 1.5f;
+                }
+                else if (w.length() >= 3)
+                {
+                    const auto wordTrigrams = Trigrams(w);
+                    const auto documentTrigrams = Trigrams(document);
+                    std::size_t shared = 0;
+                    for (const auto& trigram : wordTrigrams)
+                        shared += documentTrigrams.contains(trigram) ? 1 : 0;
+
+                    const auto fraction = static_cast<float>(shared) / wordTrigrams.size();
+                    score = fraction >= FuzzySearchIndex::FUZZY_MATCH_THRESHOLD ? fraction : 0.0f;
+                }
+
+                if (score <= 0.0f)
+                {
+                    isMatch = false;
+                    break;
+                }
+                total += score;
+            }
+
+            if (isMatch)
+                matches.push_back({d, total});
+        }
+        return matches;
+    }
+
+    std::string RandomText(std::mt19937& random, std::size_t maxLength, std::string_view alphabet)
+    {
+        std::string text(random() % (maxLength + 1), ' ');
+        for (auto& c : text)
+            c = alphabet[random() % alphabet.length()];
+        return text;
+    }
+}  // namespace
+
+TEST_CASE(EmptyQueryMatchesNothing)
+{
+    const auto index = MakeIndex({"crash", "backlot"});
+    CHECK(index.Query("").empty());
+    CHECK(index.Query("   ").empty());
+}
+
+TEST_CASE(IndexThatWasNeverBuiltMatchesNothing)
+{
+    const FuzzySearchIndex index;
+    CHECK(index.Query("c").empty());
+    CHECK(index.Query("crash").empty());
+}
+
+TEST_CASE(MatchesAreReturnedInIndexOrder)
+{
+    const auto index = MakeIndex({"mp_crash final", "crash", "overgrown", "crashed"});
+    const auto documents = GetDocuments(index.Query("crash"));
+    CHECK(documents == std::vector<uint32_t>({0, 1, 3}));
+}
+
+TEST_CASE(WordStartMatchesScoreHigherThanInnerMatches)
+{
+    const auto index = MakeIndex({"mp_crash", "megacrash", "crash"});
+    const auto matches = index.Query("crash");
+    REQUIRE(matches.size() == 3);
+    CHECK_EQ(matches[0].score, 2.0f);
+    CHECK_EQ(matches[1].score, 1.5f);
+    CHECK_EQ(matches[2].score, 2.0f);
+}
+
+TEST_CASE(QueriesIgnoreCase)
+{
+    const auto index = MakeIndex({"MP_Crash Final"});
+    CHECK_EQ(index.Query("crash FINAL").size(), std::size_t(1));
+}
+
+TEST_CASE(EveryWordHasToMatch)
+{
+    const auto index = MakeIndex({"crash final", "crash", "final"});
+    const auto matches = index.Query("final crash");
+    CHECK(GetDocuments(matches) == std::vector<uint32_t>({0}));
+    CHECK_EQ(matches.front().score, 4.0f);
+}
+
+TEST_CASE(LongWordsTolerateTypos)
+{
+    const auto index = MakeIndex({"backlot", "bloc"});
+
+    // 5 of the 6 trigrams of "backlott" are in "backlot"
+    const auto matches = index.Query("backlott");
+    REQUIRE(matches.size() == 1);
+    CHECK_EQ(matches[0].document, 0u);
+    CHECK_NEAR(matches[0].score, 5.0f / 6.0f, 1e-6);
+
+    CHECK(index.Query("xacklozz").empty());
+}
+
+TEST_CASE(ShortWordsOnlyMatchExactly)
+{
+    const auto index = MakeIndex({"ak47", "m40a3", "r700"});
+    CHECK(GetDocuments(index.Query("a")) == std::vector<uint32_t>({0, 1}));
+    CHECK(GetDocuments(index.Query("47")) == std::vector<uint32_t>({0}));
+    CHECK(GetDocuments(index.Query("0")) == std::vector<uint32_t>({1, 2}));
+    CHECK(index.Query("z").empty());
+    CHECK(index.Query("4a").empty());
+}
+
+TEST_CASE(NonAsciiBytesAreMatchedAsIs)
+{
+    const auto index = MakeIndex({"m\xC3\xBCller frag", "muller"});
+    CHECK(GetDocuments(index.Query("\xC3\xBC")) == std::vector<uint32_t>({0}));
+    CHECK(GetDocuments(index.Query("m\xC3\xBCller")) == std::vector<uint32_t>({0}));
+}
+
+TEST_CASE(RebuildingReplacesTheDocuments)
+{
+    auto index = MakeIndex({"crash", "backlot"});
+    index.Build({"strike"});
+    CHECK_EQ(index.GetDocumentCount(), std::size_t(1));
+    CHECK(index.Query("crash").empty());
+    CHECK_EQ(index.Query("strike").size(), std::size_t(1));
+}
+
+TEST_CASE(RandomQueriesMatchTheReference)
+{
+    // a small alphabet makes shared n-grams, repeated characters and near misses common
+    constexpr std::string_view ALPHABET = "abcAB_ 1";
+
+    std::mt19937 random(42);
+    for (int round = 0; round < 200; round++)
+    {
+        std::vector<std::string> documents(1 + random() % 60);
+        for (auto& document : documents)
+            document = RandomText(random, 16, ALPHABET);
+
+        const auto index = MakeIndex(documents);
+        for (int q = 0; q < 50; q++)
+        {
+            const auto query = RandomText(random, 10, ALPHABET);
+            const auto expected = ReferenceQuery(documents, query);
+            const auto actual = index.Query(query);
+
+            REQUIRE(actual.size() == expected.size());
+            for (std::size_t i = 0; i < actual.size(); i++)
+            {
+                CHECK_EQ(actual[i].document, expected[i].document);
+                CHECK_NEAR(actual[i].score, expected[i].score, 1e-5);
+            }
+        }
+    }
+}
@@ -0,0 +1,332 @@
+#include "StdInclude.hpp"
+#include "Benchmark.hpp"
+
+#include <execution>
+
+#include "Components/ArcLengthTable.hpp"
+#include "Utilities/KeyframeCurve.hpp"
+#include "Utilities/QuaternionSpline.hpp"
+
+using namespace IWXMVM;
+
+const Types::KeyframeableProperty floatProperty(Types::KeyframeablePropertyType::SunLightBrightness, "Float",
+                                                Types::KeyframeValueType::FloatingPoint, 0, 1);
+const Types::KeyframeableProperty vectorProperty(Types::KeyframeablePropertyType::SunLightColor, "Vector",
+                                                 Types::KeyframeValueType::Vector3, 0, 1);
+const Types::KeyframeableProperty cameraProperty(Types::KeyframeablePropertyType::CampathCamera, "Camera",
+                                                 Types::KeyframeValueType::CameraData, -50, 50);
+
+constexpr uint32_t TICKS_PER_KEYFRAME = 100;
+
+std::vector<Types::Keyframe> MakeTrack(const Types::KeyframeableProperty& property, std::size_t count,
+                                       std::optional<Types::InterpolationMode> interpolation)
+{
+    std::vector<Types::Keyframe> keyframes;
+    for (std::size_t i = 0; i < count; i++)
+    {
+        const auto x = static_cast<float>(i);
+        Types::KeyframeValue value;
+        for (uint32_t v = 0; v < static_cast<uint32_t>(property.GetValueCount()); v++)
+        {
+            value.SetByIndex(v, std::sin(x * 0.37f + v) * 100.0f);
+        }
+
+        auto& keyframe = keyframes.emplace_back(property, static_cast<uint32_t>(i * TICKS_PER_KEYFRAME), value);
+
+        // without a fixed mode, cycle through all of them to measure the mix a real track has
+        keyframe.interpolation = interpolation.value_or(static_cast<Types::InterpolationMode>(
+            i % static_cast<std::size_t>(Types::InterpolationMode::Count)));
+    }
+    return keyframes;
+}
+
+// Evaluates the curve once per rendered frame at 1000 fps of a 20 tick per second demo, i.e. at every 1/50th tick
+void BenchmarkEvaluation(const char* name, const MathUtils::KeyframeCurve& curve)
+{
+    const auto endTick = static_cast<float>(curve.GetKeyframes().back().tick);
+    float tick = 0.0f;
+    Tests::Benchmark(name, 10000, [&] {
+        Tests::DoNotOptimize(curve.Evaluate(tick));
+        tick += 0.02f;
+        if (tick > endTick)
+            tick = 0.0f;
+    });
+}
+
+void BenchmarkInterpolationModes()
+{
+    std::printf("Evaluation per interpolation mode (256 keyframes)\n");
+    for (const auto* property : {&floatProperty, &vectorProperty, &cameraProperty})
+    {
+        for (std::size_t mode = 0; mode <= static_cast<std::size_t>(Types::InterpolationMode::Count); mode++)
+        {
+            const auto isMixed = mode == static_cast<std::size_t>(Types::InterpolationMode::Count);
+            const auto interpolation = isMixed ? std::nullopt
+                                               : std::optional(static_cast<Types::InterpolationMode>(mode));
+
+            MathUtils::KeyframeCurve curve;
+            curve.Build(*property, MakeTrack(*property, 256, interpolation));
+
+            const auto name = std::string(magic_enum::enum_name(property->valueType)) + " " +
+                              (isMixed ? "Mixed" : std::string(magic_enum::enum_name(interpolation.value())));
+            BenchmarkEvaluation(name.c_str(), curve);
+        }
+    }
+}
+
+void BenchmarkTrackLength()
+{
+    std::printf("\nCubic campath evaluation and build by track length\n");
+    for (const std::size_t count : {16, 256, 4096, 65536})
+    {
+        const auto keyframes = MakeTrack(cameraProperty, count, Types::InterpolationMode::Cubic);
+
+        MathUtils::KeyframeCurve curve;
+        curve.Build(cameraProperty, keyframes);
+        BenchmarkEvaluation(("Evaluate " + std::to_string(count) + " keyframes").c_str(), curve);
+
+        Tests::Benchmark(("Build " + std::to_string(count) + " keyframes").c_str(), 1, [&] {
+            MathUtils::KeyframeCurve rebuilt;
+            rebuilt.Build(cameraProperty, keyframes);
+            Tests::DoNotOptimize(rebuilt);
+        });
+    }
+}
+
+// The table is rebuilt whenever a campath node moves, so this is what dragging a node costs per frame
+void BenchmarkArcLengthTable()
+{
+    std::printf("\nArc length table build by node count\n");
+    for (const std::size_t count : {4, 16, 64, 256, 1024, 4096})
+    {
+        MathUtils::KeyframeCurve curve;
+        curve.Build(cameraProperty, MakeTrack(cameraProperty, count, Types::InterpolationMode::Cubic));
+
+        Tests::Benchmark(("Build table for " + std::to_string(count) + " nodes").c_str(), 1, [&] {
+            Components::ArcLengthTable table;
+            table.Update(curve);
+            Tests::DoNotOptimize(table);
+        });
+    }
+}
+
+// The spline every value index was interpolated with before curves were built once per track, kept as it was to
+// compare against: the spline is solved again for every evaluation and limited to 256 nodes.
+float InterpolatePreviousCubicSpline(const std::vector<Types::Keyframe>& keyframes, uint32_t valueIndex, float tick)
+{
+    const size_t n = keyframes.size();
+    if (n < 2)
+        throw std::invalid_argument("Not enough keyframes to interpolate");
+
+    constexpr int32_t MAX_NODES = 256;
+    if (keyframes.size() > MAX_NODES)
+        return keyframes.back().value.GetByIndex(valueIndex);
+
+    float ticks[MAX_NODES];
+    float values[MAX_NODES];
+    for (size_t i = 0; i < n; i++)
+    {
+        ticks[i] = static_cast<float>(keyframes[i].tick);
+        values[i] = keyframes[i].value.GetByIndex(valueIndex);
+    }
+
+    float y2[MAX_NODES];  // second derivatives
+    float u[MAX_NODES];
+
+    y2[0] = -0.5f;
+    u[0] = (3.0f / (ticks[1] - ticks[0])) * ((values[1] - values[0]) / (ticks[1] - ticks[0]));
+
+    for (size_t i = 1; i <= n - 2; i++)
+    {
+        auto sig = (ticks[i] - ticks[i - 1]) / (ticks[i + 1] - ticks[i - 1]);
+        auto p = sig * y2[i - 1] + 2.0f;
+        y2[i] = (sig - 1.0f) / p;
+        u[i] = (values[i + 1] - values[i]) / (ticks[i + 1] - ticks[i]) -
+               (values[i] - values[i - 1]) / (ticks[i] - ticks[i - 1]);
+        u[i] = (6.0f * u[i] / (ticks[i + 1] - ticks[i - 1]) - sig * u[i - 1]) / p;
+    }
+
+    auto qn = 0.5f;
+    auto un = (3.0f / (ticks[n - 1] - ticks[n - 2])) *
+              (0.0f - (values[n - 1] - values[n - 2]) / (ticks[n - 1] - ticks[n - 2]));
+
+    y2[n - 1] = (un - qn * u[n - 2]) / (qn * y2[n - 2] + 1.0f);
+
+    for (int k = static_cast<int>(n) - 2; k >= 0; k--)
+        y2[k] = y2[k] * y2[k + 1] + u[k];
+
+    int klo = 0;
+    int khi = static_cast<int>(n) - 1;
+    while (khi - klo > 1)
+    {
+        int k = (khi + klo) >> 1;
+        if (ticks[k] > tick)
+            khi = k;
+        else
+            klo = k;
+    }
+    auto h = ticks[khi] - ticks[klo];
+    auto a = (ticks[khi] - tick) / h;
+    auto b = (tick - ticks[klo]) / h;
+    return a * values[klo] + b * values[khi] + ((a * a * a - a) * y2[klo] + (b * b * b - b) * y2[khi]) * (h * h) / 6.0f;
+}
+
+// Interpolation as it was before curves: linear below 4 keyframes, otherwise a spline per value index
+Types::KeyframeValue InterpolatePrevious(const Types::KeyframeableProperty& property,
+                                         const std::vector<Types::Keyframe>& keyframes, float tick)
+{
+    if (keyframes.size() < 4)
+    {
+        const auto segment = std::upper_bound(keyframes.begin() + 1, keyframes.end() - 1, tick,
+                                              [](float t, const Types::Keyframe& k) { return t < k.tick; }) - 1;
+        const auto t = (tick - segment->tick) / static_cast<float>((segment + 1)->tick - segment->tick);
+        Types::KeyframeValue value = segment->value;
+        for (uint32_t v = 0; v < static_cast<uint32_t>(property.GetValueCount()); v++)
+            value.SetByIndex(v, glm::mix(segment->value.GetByIndex(v), (segment + 1)->value.GetByIndex(v), t));
+        return value;
+    }
+
+    Types::KeyframeValue value = keyframes.front().value;
+    for (uint32_t v = 0; v < static_cast<uint32_t>(property.GetValueCount()); v++)
+        value.SetByIndex(v, InterpolatePreviousCubicSpline(keyframes, v, tick));
+    return value;
+}
+
+// The curves must not be slower than what they replaced on the tracks the previous path supported
+void BenchmarkAgainstPreviousPath()
+{
+    std::printf("\nCubic evaluation, previous path against the curve\n");
+    for (const auto* property : {&floatProperty, &vectorProperty, &cameraProperty})
+    {
+        for (const std::size_t count : {3, 16, 64, 256})
+        {
+            const auto keyframes = MakeTrack(*property, count, Types::InterpolationMode::Cubic);
+            const auto endTick = static_cast<float>(keyframes.back().tick);
+            const auto name =
+                std::string(magic_enum::enum_name(property->valueType)) + ", " + std::to_string(count) + " keyframes";
+
+            float tick = 0.0f;
+            Tests::Benchmark((name + " (previous)").c_str(), 1000, [&] {
+                Tests::DoNotOptimize(InterpolatePrevious(*property, keyframes, tick));
+                tick += 0.02f;
+                if (tick > endTick)
+                    tick = 0.0f;
+            });
+
+            MathUtils::KeyframeCurve curve;
+            curve.Build(*property, keyframes);
+            BenchmarkEvaluation((name + " (curve)").c_str(), curve);
+        }
+    }
+}
+
+// Campath rotation used to be splined as three independent euler angles, now it is a squad through quaternions
+void BenchmarkRotation()
+{
+    std::printf("\nCubic campath rotation, euler angle splines against the quaternion spline\n");
+    for (const std::size_t count : {16, 64, 256})
+    {
+        const auto keyframes = MakeTrack(cameraProperty, count, Types::InterpolationMode::Cubic);
+        const auto endTick = static_cast<float>(keyframes.back().tick);
+
+        float tick = 0.0f;
+        auto NextTick = [&] {
+            tick += 0.02f;
+            if (tick > endTick)
+                tick = 0.0f;
+        };
+
+        Tests::Benchmark(("Euler splines, " + std::to_string(count) + " keyframes (previous)").c_str(), 1000, [&] {
+            Tests::DoNotOptimize(glm::vec3(InterpolatePreviousCubicSpline(keyframes, 3, tick),
+                                           InterpolatePreviousCubicSpline(keyframes, 4, tick),
+                                           InterpolatePreviousCubicSpline(keyframes, 5, tick)));
+            NextTick();
+        });
+
+        MathUtils::QuaternionSpline spline;
+        spline.Build(keyframes);
+        tick = 0.0f;
+        Tests::Benchmark(("Quaternion spline, " + std::to_string(count) + " keyframes").c_str(), 10000, [&] {
+            Tests::DoNotOptimize(spline.Evaluate(tick, true));
+            NextTick();
+        });
+
+        Tests::Benchmark(("Quaternion spline build, " + std::to_string(count) + " keyframes").c_str(), 100, [&] {
+            MathUtils::QuaternionSpline rebuilt;
+            rebuilt.Build(keyframes);
+            Tests::DoNotOptimize(rebuilt);
+        });
+    }
+}
+
+Types::KeyframeValueType GetValueType(Types::KeyframeablePropertyType type)
+{
+    switch (type)
+    {
+        case Types::KeyframeablePropertyType::CampathCamera:
+            return Types::KeyframeValueType::CameraData;
+        case Types::KeyframeablePropertyType::SunLightColor:
+        case Types::KeyframeablePropertyType::SunLightDirection:
+        case Types::KeyframeablePropertyType::FilmtweakTintLight:
+        case Types::KeyframeablePropertyType::FilmtweakTintDark:
+            return Types::KeyframeValueType::Vector3;
+        default:
+            return Types::KeyframeValueType::FloatingPoint;
+    }
+}
+
+// Same work FrameState::Update does per frame once every property is keyframed
+void BenchmarkAllProperties()
+{
+    constexpr auto PROPERTY_COUNT = magic_enum::enum_count<Types::KeyframeablePropertyType>();
+
+    std::printf("\nEvaluation of all %zu properties per frame\n", PROPERTY_COUNT);
+    for (const std::size_t count : {16, 64, 256, 4096})
+    {
+        std::vector<Types::KeyframeableProperty> properties;
+        for (auto type : magic_enum::enum_values<Types::KeyframeablePropertyType>())
+        {
+            properties.emplace_back(type, magic_enum::enum_name(type), GetValueType(type), 0, 1);
+        }
+
+        std::array<MathUtils::KeyframeCurve, PROPERTY_COUNT> curves;
+        for (std::size_t i = 0; i < PROPERTY_COUNT; i++)
+        {
+            curves[i].Build(properties[i], MakeTrack(properties[i], count, std::nullopt));
+        }
+
+        std::array<std::size_t, PROPERTY_COUNT> indices;
+        std::iota(indices.begin(), indices.end(), 0);
+
+        std::array<Types::KeyframeValue, PROPERTY_COUNT> values{};
+        const auto endTick = static_cast<float>(curves[0].GetKeyframes().back().tick);
+        float tick = 0.0f;
+        auto Evaluate = [&](std::size_t i) { values[i] = curves[i].Evaluate(tick); };
+        auto NextTick = [&] {
+            Tests::DoNotOptimize(values);
+            tick += 0.02f;
+            if (tick > endTick)
+                tick = 0.0f;
+        };
+
+        Tests::Benchmark((std::to_string(count) + " keyframes each, serial").c_str(), 1000, [&] {
+            std::for_each(indices.begin(), indices.end(), Evaluate);
+            NextTick();
+        });
+        Tests::Benchmark((std::to_string(count) + " keyframes each, parallel").c_str(), 100, [&] {
+            std::for_each(std::execution::par, indices.begin(), indices.end(), Evaluate);
+            NextTick();
+        });
+    }
+}
+
+int main()
+{
+    BenchmarkInterpolationModes();
+    BenchmarkTrackLength();
+    BenchmarkArcLengthTable();
+    BenchmarkRotation();
+    BenchmarkAgainstPreviousPath();
+    BenchmarkAllProperties();
+    return 0;
+}
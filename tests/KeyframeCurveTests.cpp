@@ -0,0 +1,274 @@
+#include "StdInclude.hpp"
+#include "TestFramework.hpp"
+
+#include "Utilities/CubicSpline.hpp"
+#include "Utilities/KeyframeCurve.hpp"
+#include "Utilities/QuaternionSpline.hpp"
+
+using namespace IWXMVM;
+
+namespace
+{
+    const Types::KeyframeableProperty floatProperty(Types::KeyframeablePropertyType::SunLightBrightness, "Float",
+                                                    Types::KeyframeValueType::FloatingPoint, 0, 1);
+    const Types::KeyframeableProperty vectorProperty(Types::KeyframeablePropertyType::SunLightColor, "Vector",
+                                                     Types::KeyframeValueType::Vector3, 0, 1);
+    const Types::KeyframeableProperty cameraProperty(Types::KeyframeablePropertyType::CampathCamera, "Camera",
+                                                     Types::KeyframeValueType::CameraData, -50, 50);
+
+    Types::Keyframe MakeCameraKeyframe(uint32_t tick, glm::vec3 position, glm::vec3 rotation, float fov = 90.0f)
+    {
+        return Types::Keyframe(cameraProperty, tick, Types::CameraData{position, rotation, fov});
+    }
+
+    // Shortest angular distance between two euler angles in degrees
+    float AngleDistance(float a, float b)
+    {
+        return std::abs(std::remainder(a - b, 360.0f));
+    }
+
+    float RotationDistance(glm::vec3 a, glm::vec3 b)
+    {
+        const auto dot = std::abs(glm::dot(MathUtils::QuaternionFromAngles(a), MathUtils::QuaternionFromAngles(b)));
+        return glm::degrees(2.0f * std::acos(std::min(dot, 1.0f)));
+    }
+}  // namespace
+
+TEST_CASE(CubicSplinePassesThroughItsNodes)
+{
+    std::vector<Types::Keyframe> keyframes;
+    for (uint32_t i = 0; i < 10; i++)
+    {
+        keyframes.emplace_back(floatProperty, i * 100, std::sin(i * 0.7f) * 50.0f);
+    }
+
+    MathUtils::CubicSpline spline;
+    spline.Build(keyframes, 0);
+    for (const auto& keyframe : keyframes)
+    {
+        CHECK_NEAR(spline.Evaluate(static_cast<float>(keyframe.tick)), keyframe.value.floatingPoint, 1e-3);
+    }
+
+    // clamped outside of the nodes
+    CHECK_NEAR(spline.Evaluate(-50.0f), keyframes.front().value.floatingPoint, 1e-6);
+    CHECK_NEAR(spline.Evaluate(5000.0f), keyframes.back().value.floatingPoint, 1e-6);
+}
+
+TEST_CASE(CubicSplineHasNoNodeLimit)
+{
+    // the previous implementation gave up above 256 nodes and returned the last value everywhere
+    std::vector<Types::Keyframe> keyframes;
+    for (uint32_t i = 0; i < 2000; i++)
+    {
+        keyframes.emplace_back(floatProperty, i * 10, static_cast<float>(i));
+    }
+
+    MathUtils::CubicSpline spline;
+    spline.Build(keyframes, 0);
+    CHECK_NEAR(spline.Evaluate(10005.0f), 1000.5f, 1e-2);
+    CHECK_NEAR(spline.Evaluate(15055.0f), 1505.5f, 1e-2);
+
+    // the ends are clamped to zero slope, so they only have to stay between their nodes
+    CHECK(spline.Evaluate(5.0f) > 0.0f && spline.Evaluate(5.0f) < 1.0f);
+    CHECK(spline.Evaluate(19985.0f) > 1998.0f && spline.Evaluate(19985.0f) < 1999.0f);
+}
+
+TEST_CASE(CubicSplineSegmentMatchesSearch)
+{
+    std::vector<Types::Keyframe> keyframes;
+    for (uint32_t i = 0; i < 50; i++)
+    {
+        keyframes.emplace_back(floatProperty, i * i * 3, std::cos(i * 0.3f));
+    }
+
+    MathUtils::CubicSpline spline;
+    spline.Build(keyframes, 0);
+    for (std::size_t i = 0; i + 1 < keyframes.size(); i++)
+    {
+        const auto tick = (keyframes[i].tick + keyframes[i + 1].tick) * 0.5f;
+        CHECK_NEAR(spline.EvaluateSegment(i, tick), spline.Evaluate(tick), 1e-6);
+    }
+}
+
+TEST_CASE(EmptyCurveReturnsDefaultValue)
+{
+    MathUtils::KeyframeCurve curve;
+    curve.Build(vectorProperty, {});
+    CHECK(curve.IsEmpty());
+    CHECK(curve.Evaluate(100.0f).vector3 == glm::vec3(0.0f));
+}
+
+TEST_CASE(CurveSortsItsKeyframes)
+{
+    std::vector<Types::Keyframe> keyframes = {
+        Types::Keyframe(floatProperty, 200, 2.0f),
+        Types::Keyframe(floatProperty, 0, 0.0f),
+        Types::Keyframe(floatProperty, 100, 1.0f),
+    };
+    for (auto& keyframe : keyframes)
+    {
+        keyframe.interpolation = Types::InterpolationMode::Linear;
+    }
+
+    MathUtils::KeyframeCurve curve;
+    curve.Build(floatProperty, keyframes);
+    CHECK_NEAR(curve.Evaluate(50.0f).floatingPoint, 0.5f, 1e-6);
+    CHECK_NEAR(curve.Evaluate(150.0f).floatingPoint, 1.5f, 1e-6);
+}
+
+TEST_CASE(CurveUsesTheModeOfEachSegment)
+{
+    std::vector<Types::Keyframe> keyframes;
+    for (uint32_t i = 0; i < 5; i++)
+    {
+        keyframes.emplace_back(floatProperty, i * 100, static_cast<float>(i % 2));
+    }
+    keyframes[0].interpolation = Types::InterpolationMode::Step;
+    keyframes[1].interpolation = Types::InterpolationMode::Linear;
+    keyframes[2].interpolation = Types::InterpolationMode::EaseInOut;
+    keyframes[3].interpolation = Types::InterpolationMode::Bezier;
+
+    MathUtils::KeyframeCurve curve;
+    curve.Build(floatProperty, keyframes);
+
+    CHECK_NEAR(curve.Evaluate(50.0f).floatingPoint, 0.0f, 1e-6);    // step holds the first value
+    CHECK_NEAR(curve.Evaluate(125.0f).floatingPoint, 0.75f, 1e-6);  // linear from 1 to 0
+    CHECK_NEAR(curve.Evaluate(225.0f).floatingPoint, 0.15625f, 1e-5);
+    CHECK_NEAR(curve.Evaluate(250.0f).floatingPoint, 0.5f, 1e-5);  // ease in out is symmetric
+    CHECK(curve.Evaluate(350.0f).floatingPoint > 0.0f);
+    CHECK(curve.Evaluate(350.0f).floatingPoint < 1.0f);
+}
+
+TEST_CASE(CubicFallsBackToLinearOnShortTracks)
+{
+    const std::vector<Types::Keyframe> keyframes = {
+        Types::Keyframe(floatProperty, 0, 0.0f),
+        Types::Keyframe(floatProperty, 100, 10.0f),
+        Types::Keyframe(floatProperty, 200, 0.0f),
+    };
+
+    MathUtils::KeyframeCurve curve;
+    curve.Build(floatProperty, keyframes);
+    CHECK_NEAR(curve.Evaluate(50.0f).floatingPoint, 5.0f, 1e-5);
+    CHECK_NEAR(curve.Evaluate(150.0f).floatingPoint, 5.0f, 1e-5);
+}
+
+TEST_CASE(CubicCurveMatchesSpline)
+{
+    std::vector<Types::Keyframe> keyframes;
+    for (uint32_t i = 0; i < 300; i++)
+    {
+        keyframes.emplace_back(vectorProperty, i * 50, glm::vec3(std::sin(i * 0.1f), i * 0.5f, std::cos(i * 0.2f)));
+    }
+
+    MathUtils::KeyframeCurve curve;
+    curve.Build(vectorProperty, keyframes);
+
+    for (uint32_t axis = 0; axis < 3; axis++)
+    {
+        MathUtils::CubicSpline spline;
+        spline.Build(keyframes, axis);
+        for (float tick = 0.0f; tick < 300 * 50; tick += 37.0f)
+        {
+            CHECK_NEAR(curve.Evaluate(tick).vector3[axis], spline.Evaluate(tick), 1e-5);
+        }
+    }
+}
+
+TEST_CASE(CampathRotationHitsItsNodes)
+{
+    std::vector<Types::Keyframe> keyframes;
+    for (uint32_t i = 0; i < 8; i++)
+    {
+        keyframes.push_back(
+            MakeCameraKeyframe(i * 100, glm::vec3(i * 10.0f, 0, 0), glm::vec3(i * 5.0f - 20.0f, i * 40.0f, 0)));
+    }
+
+    MathUtils::KeyframeCurve curve;
+    curve.Build(cameraProperty, keyframes);
+    for (const auto& keyframe : keyframes)
+    {
+        const auto value = curve.Evaluate(static_cast<float>(keyframe.tick)).cameraData;
+        // acos is only accurate to a few hundredths of a degree close to 1
+        CHECK(RotationDistance(value.rotation, keyframe.value.cameraData.rotation) < 0.1f);
+        CHECK_NEAR(value.position.x, keyframe.value.cameraData.position.x, 1e-3);
+    }
+}
+
+TEST_CASE(CampathRotationDoesNotFlipAcrossTheYawSeam)
+{
+    // yaw keyframed as 170 -> -170 has to turn 20 degrees through 180, not 340 degrees back through 0
+    for (const auto cubic : {false, true})
+    {
+        std::vector<Types::Keyframe> keyframes = {
+            MakeCameraKeyframe(0, glm::vec3(0), glm::vec3(0, 150, 0)),
+            MakeCameraKeyframe(100, glm::vec3(0), glm::vec3(0, 170, 0)),
+            MakeCameraKeyframe(200, glm::vec3(0), glm::vec3(0, -170, 0)),
+            MakeCameraKeyframe(300, glm::vec3(0), glm::vec3(0, -150, 0)),
+        };
+        for (auto& keyframe : keyframes)
+        {
+            keyframe.interpolation = cubic ? Types::InterpolationMode::Cubic : Types::InterpolationMode::Linear;
+        }
+
+        MathUtils::KeyframeCurve curve;
+        curve.Build(cameraProperty, keyframes);
+
+        const auto middle = curve.Evaluate(150.0f).cameraData.rotation;
+        CHECK(AngleDistance(middle.y, 180.0f) < 1.0f);
+
+        auto previous = curve.Evaluate(0.0f).cameraData.rotation;
+        for (float tick = 1.0f; tick <= 300.0f; tick += 1.0f)
+        {
+            const auto rotation = curve.Evaluate(tick).cameraData.rotation;
+            CHECK(RotationDistance(rotation, previous) < 2.0f);
+            for (int32_t axis = 0; axis < 3; axis++)
+            {
+                // the keyframed yaw itself wraps, so the euler angles may only wrap by whole turns in between
+                CHECK(AngleDistance(rotation[axis], previous[axis]) < 2.0f);
+            }
+            previous = rotation;
+        }
+    }
+}
+
+TEST_CASE(CampathRotationStaysContinuousOverManyTurns)
+{
+    // keyframed yaw keeps increasing, e.g. an orbit around a player, and crosses +-180 several times
+    std::vector<Types::Keyframe> keyframes;
+    for (uint32_t i = 0; i < 40; i++)
+    {
+        keyframes.push_back(MakeCameraKeyframe(i * 50, glm::vec3(0), glm::vec3(10.0f, i * 45.0f - 180.0f, 0)));
+    }
+
+    MathUtils::KeyframeCurve curve;
+    curve.Build(cameraProperty, keyframes);
+
+    auto previous = curve.Evaluate(0.0f).cameraData.rotation;
+    for (float tick = 0.5f; tick <= 39 * 50; tick += 0.5f)
+    {
+        const auto rotation = curve.Evaluate(tick).cameraData.rotation;
+        CHECK(rotation.y >= previous.y - 0.01f);
+        CHECK(rotation.y - previous.y < 2.0f);
+        previous = rotation;
+    }
+    CHECK_NEAR(previous.y, keyframes.back().value.cameraData.rotation.y, 1e-3);
+}
+
+TEST_CASE(QuaternionAnglesRoundTrip)
+{
+    for (float pitch = -80.0f; pitch <= 80.0f; pitch += 20.0f)
+    {
+        for (float yaw = -170.0f; yaw <= 170.0f; yaw += 34.0f)
+        {
+            for (float roll = -60.0f; roll <= 60.0f; roll += 30.0f)
+            {
+                const glm::vec3 angles(pitch, yaw, roll);
+                const auto result = MathUtils::AnglesFromQuaternion(MathUtils::QuaternionFromAngles(angles));
+                CHECK(AngleDistance(result.x, pitch) < 0.01f);
+                CHECK(AngleDistance(result.y, yaw) < 0.01f);
+                CHECK(AngleDistance(result.z, roll) < 0.01f);
+            }
+        }
+    }
+}
@@ -0,0 +1,175 @@
+#include "StdInclude.hpp"
+#include "TestFramework.hpp"
+
+#include <random>
+
+#include "Utilities/KeyframeCurve.hpp"
+#include "Utilities/KeyframeSimplification.hpp"
+
+using namespace IWXMVM;
+
+namespace
+{
+    const Types::KeyframeableProperty floatProperty(Types::KeyframeablePropertyType::SunLightBrightness, "Float",
+                                                    Types::KeyframeValueType::FloatingPoint, 0, 1);
+    const Types::KeyframeableProperty cameraProperty(Types::KeyframeablePropertyType::CampathCamera, "Camera",
+                                                     Types::KeyframeValueType::CameraData, -50, 50);
+
+    // Largest deviation of the simplified curve from the original one at the points the simplifier guarantees,
+    // every original keyframe and halfway between neighbouring ones, per value index
+    std::vector<float> MeasureErrors(const Types::KeyframeableProperty& property,
+                                     const std::vector<Types::Keyframe>& original,
+                                     const std::vector<Types::Keyframe>& simplified)
+    {
+        MathUtils::KeyframeCurve originalCurve;
+        originalCurve.Build(property, original);
+        MathUtils::KeyframeCurve simplifiedCurve;
+        simplifiedCurve.Build(property, simplified);
+
+        std::vector<float> errors(property.GetValueCount(), 0.0f);
+        auto Measure = [&](float tick) {
+            const auto expected = originalCurve.Evaluate(tick);
+            const auto actual = simplifiedCurve.Evaluate(tick);
+            for (uint32_t i = 0; i < errors.size(); i++)
+            {
+                errors[i] = std::max(errors[i], std::abs(actual.GetByIndex(i) - expected.GetByIndex(i)));
+            }
+        };
+
+        for (std::size_t i = 0; i < original.size(); i++)
+        {
+            Measure(static_cast<float>(original[i].tick));
+            if (i + 1 < original.size())
+                Measure((original[i].tick + original[i + 1].tick) * 0.5f);
+        }
+        return errors;
+    }
+
+    std::vector<Types::Keyframe> MakeSmoothTrack(std::size_t count)
+    {
+        std::vector<Types::Keyframe> keyframes;
+        for (std::size_t i = 0; i < count; i++)
+        {
+            const auto x = static_cast<float>(i) / count;
+            keyframes.emplace_back(floatProperty, static_cast<uint32_t>(i * 4), std::sin(x * 6.0f) + 0.3f * x);
+        }
+        return keyframes;
+    }
+}  // namespace
+
+TEST_CASE(SimplifiedTrackStaysWithinTolerance)
+{
+    // more than the 256 nodes the cubic spline used to be limited to
+    const auto keyframes = MakeSmoothTrack(1000);
+    const std::vector<float> tolerances = {0.01f};
+
+    std::vector<float> maxErrors;
+    const auto simplified = MathUtils::SimplifyKeyframes(floatProperty, keyframes, tolerances, maxErrors);
+
+    CHECK(simplified.size() < keyframes.size() / 10);
+    CHECK_EQ(simplified.front().id, keyframes.front().id);
+    CHECK_EQ(simplified.back().id, keyframes.back().id);
+
+    const auto errors = MeasureErrors(floatProperty, keyframes, simplified);
+    CHECK(errors[0] <= tolerances[0]);
+    CHECK_NEAR(maxErrors[0], errors[0], 1e-6);
+}
+
+TEST_CASE(SimplifiedCampathStaysWithinTolerance)
+{
+    std::vector<Types::Keyframe> keyframes;
+    for (uint32_t i = 0; i < 400; i++)
+    {
+        const auto t = i * 0.02f;
+        const Types::CameraData cameraData{glm::vec3(std::cos(t) * 500.0f, std::sin(t) * 500.0f, 100.0f + t * 10.0f),
+                                           glm::vec3(10.0f, glm::degrees(t) * 0.5f - 90.0f, std::sin(t * 3.0f) * 5.0f),
+                                           80.0f + std::sin(t) * 5.0f};
+        keyframes.emplace_back(cameraProperty, i * 10, cameraData);
+    }
+
+    const std::vector<float> tolerances = {1.0f, 1.0f, 1.0f, 0.5f, 0.5f, 0.5f, 0.1f};
+    std::vector<float> maxErrors;
+    const auto simplified = MathUtils::SimplifyKeyframes(cameraProperty, keyframes, tolerances, maxErrors);
+
+    CHECK(simplified.size() < keyframes.size() / 4);
+
+    const auto errors = MeasureErrors(cameraProperty, keyframes, simplified);
+    for (std::size_t i = 0; i < tolerances.size(); i++)
+    {
+        CHECK(errors[i] <= tolerances[i]);
+    }
+}
+
+TEST_CASE(IrregularlySpacedTracksStayWithinTolerance)
+{
+    // clustered and sparse keyframes side by side, where the keyframe that fixes an error can be several keyframes
+    // away from where the error shows
+    std::mt19937 random(26);
+    std::size_t simplifiedCount = 0;
+    std::size_t originalCount = 0;
+    for (int track = 0; track < 3000; track++)
+    {
+        std::vector<Types::Keyframe> keyframes;
+        uint32_t tick = 0;
+        const auto count = 3 + random() % 30;
+        for (uint32_t i = 0; i < count; i++)
+        {
+            tick += random() % 4 == 0 ? 1 + random() % 500 : 1 + random() % 5;
+            auto& keyframe = keyframes.emplace_back(floatProperty, tick,
+                                                    std::uniform_real_distribution<float>(-1.0f, 1.0f)(random));
+            if (random() % 5 == 0)
+                keyframe.interpolation = Types::InterpolationMode::Linear;
+        }
+
+        const std::vector<float> tolerances = {std::uniform_real_distribution<float>(0.01f, 0.5f)(random)};
+        std::vector<float> maxErrors;
+        const auto simplified = MathUtils::SimplifyKeyframes(floatProperty, keyframes, tolerances, maxErrors);
+
+        const auto errors = MeasureErrors(floatProperty, keyframes, simplified);
+        CHECK(errors[0] <= tolerances[0]);
+        CHECK(maxErrors[0] <= tolerances[0]);
+        simplifiedCount += simplified.size();
+        originalCount += keyframes.size();
+    }
+
+    // random values leave little to remove, but some tracks still have to shrink
+    CHECK(simplifiedCount < originalCount);
+}
+
+TEST_CASE(ZeroToleranceKeepsEveryKeyframeOfANoisyTrack)
+{
+    std::vector<Types::Keyframe> keyframes;
+    for (uint32_t i = 0; i < 50; i++)
+    {
+        keyframes.emplace_back(floatProperty, i * 7, static_cast<float>((i * 7919) % 13));
+    }
+
+    std::vector<float> maxErrors;
+    const auto simplified = MathUtils::SimplifyKeyframes(floatProperty, keyframes, {0.0f}, maxErrors);
+    CHECK_EQ(simplified.size(), keyframes.size());
+    CHECK_EQ(maxErrors[0], 0.0f);
+}
+
+TEST_CASE(LinearTrackSimplifiesToItsEnds)
+{
+    std::vector<Types::Keyframe> keyframes;
+    for (uint32_t i = 0; i < 100; i++)
+    {
+        auto& keyframe = keyframes.emplace_back(floatProperty, i * 10, i * 0.5f);
+        keyframe.interpolation = Types::InterpolationMode::Linear;
+    }
+
+    std::vector<float> maxErrors;
+    const auto simplified = MathUtils::SimplifyKeyframes(floatProperty, keyframes, {0.001f}, maxErrors);
+    CHECK_EQ(simplified.size(), std::size_t(2));
+    CHECK(maxErrors[0] <= 0.001f);
+}
+
+TEST_CASE(ShortTracksAreReturnedUnchanged)
+{
+    const auto keyframes = MakeSmoothTrack(2);
+    std::vector<float> maxErrors;
+    const auto simplified = MathUtils::SimplifyKeyframes(floatProperty, keyframes, {1.0f}, maxErrors);
+    CHECK_EQ(simplified.size(), std::size_t(2));
+    CHECK_EQ(maxErrors.size(), std::size_t(1));
+}
@@ -0,0 +1,41 @@
+#pragma once
+#include "Types/Sun.hpp"
+#include "Types/Dof.hpp"
+#include "Types/Filmtweaks.hpp"
+#include "Types/Entity.hpp"
+
+// Stands in for core's Mod.hpp, which is found first as this directory comes first in the include path. The
+// components built here only reach the game through the GameInterface, so this one declares just the functions they
+// call, with the same signatures, for the tests to implement with a mock.
+
+namespace IWXMVM
+{
+    class GameInterface
+    {
+       public:
+        virtual ~GameInterface() = default;
+
+        virtual void SetSun(Types::Sun, FieldDiff::FieldMask changedFields = FieldDiff::ALL_FIELDS) = 0;
+        virtual void SetDof(Types::DoF, FieldDiff::FieldMask changedFields = FieldDiff::ALL_FIELDS) = 0;
+        virtual void SetFilmtweaks(Types::Filmtweaks, FieldDiff::FieldMask changedFields = FieldDiff::ALL_FIELDS) = 0;
+
+        virtual void GetEntities(std::span<Types::Entity> entities) = 0;
+    };
+
+    class Mod
+    {
+       public:
+        static void Initialize(GameInterface* gameInterface)
+        {
+            internalGameInterface = gameInterface;
+        }
+
+        static GameInterface* GetGameInterface()
+        {
+            return internalGameInterface;
+        }
+
+       private:
+        static inline GameInterface* internalGameInterface = nullptr;
+    };
+}  // namespace IWXMVM
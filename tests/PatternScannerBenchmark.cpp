@@ -0,0 +1,131 @@
+#include "StdInclude.hpp"
+#include "Benchmark.hpp"
+
+#include <random>
+
+#include "Utilities/PatternScanner.hpp"
+
+using namespace IWXMVM;
+
+// A synthetic module image with a byte distribution like x86 code: a few opcodes, register encodings and zero bytes
+// make up most of it, so anchors and near misses are about as common as in the game's executable
+std::vector<std::uint8_t> MakeImage(std::size_t size, std::mt19937& random)
+{
+    constexpr std::array<std::uint8_t, 16> COMMON_BYTES = {0x00, 0xFF, 0x8B, 0x89, 0xE8, 0x83, 0xC4, 0x04,
+                                                           0x45, 0x08, 0x0C, 0x50, 0x55, 0xEC, 0x24, 0xC3};
+
+    std::vector<std::uint8_t> image(size);
+    for (auto& byte : image)
+        byte = random() % 2 == 0 ? COMMON_BYTES[random() % COMMON_BYTES.size()] : static_cast<std::uint8_t>(random());
+    return image;
+}
+
+// Signatures are copied from the image, with a 4 byte operand masked out like an address in a real signature. The
+// first byte is always known.
+struct BenchmarkPattern
+{
+    std::vector<std::uint8_t> bytes;
+    std::vector<std::uint8_t> mask;
+    std::size_t size;
+
+    PatternScanner::Pattern Get() const
+    {
+        return {bytes, mask, size};
+    }
+};
+
+std::vector<BenchmarkPattern> MakePatterns(std::size_t count, std::span<const std::uint8_t> image, std::mt19937& random)
+{
+    std::vector<BenchmarkPattern> patterns;
+    for (std::size_t i = 0; i < count; i++)
+    {
+        BenchmarkPattern pattern;
+        pattern.size = 12 + random() % 24;
+        pattern.bytes.assign(PatternScanner::GetPaddedSize(pattern.size), 0);
+        pattern.mask.assign(pattern.bytes.size(), 0);
+
+        const auto offset = random() % (image.size() - pattern.size);
+        for (std::size_t j = 0; j < pattern.size; j++)
+        {
+            pattern.bytes[j] = image[offset + j];
+            pattern.mask[j] = UINT8_MAX;
+        }
+
+        const auto wildcardStart = 2 + random() % (pattern.size - 6);
+        for (std::size_t j = wildcardStart; j < wildcardStart + 4; j++)
+        {
+            pattern.bytes[j] = 0;
+            pattern.mask[j] = 0;
+        }
+
+        patterns.push_back(std::move(pattern));
+    }
+    return patterns;
+}
+
+// What resolving the signatures one at a time costs: a pass over the image per signature, checking the first byte
+// before comparing the rest
+std::vector<std::optional<std::size_t>> FindEachPattern(const std::vector<BenchmarkPattern>& patterns,
+                                                        std::span<const std::uint8_t> image)
+{
+    std::vector<std::optional<std::size_t>> matches(patterns.size());
+    for (std::size_t i = 0; i < patterns.size(); i++)
+    {
+        const auto& pattern = patterns[i];
+        const auto pass = pattern.Get();
+        for (std::size_t offset = 0; offset + pattern.size <= image.size(); offset++)
+        {
+            if (image[offset] == pattern.bytes[0] && PatternScanner::MatchesAt(pass, image, offset))
+            {
+                matches[i] = offset;
+                break;
+            }
+        }
+    }
+    return matches;
+}
+
+int main()
+{
+    std::mt19937 random(1337);
+    const auto image = MakeImage(10 * 1024 * 1024, random);
+    std::printf("%zu MB image\n", image.size() / (1024 * 1024));
+
+    for (const std::size_t count : {1, 16, 150})
+    {
+        const auto benchmarkPatterns = MakePatterns(count, image, random);
+        std::vector<PatternScanner::Pattern> patterns;
+        for (const auto& pattern : benchmarkPatterns)
+            patterns.push_back(pattern.Get());
+
+        std::printf("\n%zu patterns\n", count);
+        Tests::Benchmark("Build scanner", 1, [&] { Tests::DoNotOptimize(PatternScanner(patterns, image)); });
+
+        const PatternScanner scanner(patterns, image);
+        const auto matches = scanner.FindFirstMatches(image);
+        if (matches != FindEachPattern(benchmarkPatterns, image))
+            std::printf("Single pass and per pattern scans disagree!\n");
+
+        Tests::Benchmark("Single pass", 1, [&] { Tests::DoNotOptimize(scanner.FindFirstMatches(image)); });
+        Tests::Benchmark(
+            "Pass per pattern", 1, [&] { Tests::DoNotOptimize(FindEachPattern(benchmarkPatterns, image)); },
+            std::chrono::milliseconds(0));
+
+        // launches with the signature cache: building the scanner and scanning is what resolving costs without it
+        const std::vector<std::optional<std::size_t>> noOffsets(count);
+        std::vector<std::optional<std::size_t>> staleOffsets;
+        for (const auto& match : matches)
+            staleOffsets.push_back(match.has_value() ? std::optional<std::size_t>(match.value() + 1) : std::nullopt);
+
+        Tests::Benchmark("Nothing cached", 1, [&] {
+            Tests::DoNotOptimize(PatternScanner::FindFirstMatches(patterns, noOffsets, image));
+        });
+        Tests::Benchmark("Everything cached", 1, [&] {
+            Tests::DoNotOptimize(PatternScanner::FindFirstMatches(patterns, matches, image));
+        });
+        Tests::Benchmark("Everything cached for another build", 1, [&] {
+            Tests::DoNotOptimize(PatternScanner::FindFirstMatches(patterns, staleOffsets, image));
+        });
+    }
+    return 0;
+}
@@ -0,0 +1,450 @@
+#include "StdInclude.hpp"
+#include "TestFramework.hpp"
+
+#include <random>
+
+#include "Utilities/PatternScanner.hpp"
+
+using namespace IWXMVM;
+
+namespace
+{
+    constexpr auto WILDCARD = PatternScanner::WILDCARD;
+
+    // Owns the padded byte and mask arrays a PatternScanner::Pattern points into, like a Signature does
+    struct TestPattern
+    {
+        std::vector<std::uint16_t> values;
+        std::vector<std::uint8_t> bytes;
+        std::vector<std::uint8_t> mask;
+
+        explicit TestPattern(std::vector<std::uint16_t> patternValues) : values(std::move(patternValues))
+        {
+            bytes.assign(PatternScanner::GetPaddedSize(values.size()), 0);
+            mask.assign(bytes.size(), 0);
+            for (std::size_t i = 0; i < values.size(); i++)
+            {
+                bytes[i] = values[i] == WILDCARD ? 0 : static_cast<std::uint8_t>(values[i]);
+                mask[i] = values[i] == WILDCARD ? 0 : UINT8_MAX;
+            }
+        }
+
+        PatternScanner::Pattern Get() const
+        {
+            return {bytes, mask, values.size()};
+        }
+
+        void WriteTo(std::vector<std::uint8_t>& image, std::size_t offset, std::uint8_t wildcardFill) const
+        {
+            for (std::size_t i = 0; i < values.size(); i++)
+                image[offset + i] = values[i] == WILDCARD ? wildcardFill : static_cast<std::uint8_t>(values[i]);
+        }
+    };
+
+    bool ReferenceMatchesAt(const TestPattern& pattern, std::span<const std::uint8_t> image, std::size_t offset)
+    {
+        if (offset + pattern.values.size() > image.size())
+            return false;
+
+        for (std::size_t i = 0; i < pattern.values.size(); i++)
+        {
+            if (pattern.values[i] != WILDCARD && pattern.values[i] != image[offset + i])
+                return false;
+        }
+        return true;
+    }
+
+    std::optional<std::size_t> ReferenceFindFirst(const TestPattern& pattern, std::span<const std::uint8_t> image)
+    {
+        for (std::size_t offset = 0; offset + pattern.values.size() <= image.size(); offset++)
+        {
+            if (ReferenceMatchesAt(pattern, image, offset))
+                return offset;
+        }
+        return std::nullopt;
+    }
+
+    // Bytes from a small alphabet, so random patterns and near misses of them are common
+    std::vector<std::uint8_t> MakeImage(std::size_t size, std::mt19937& random, std::uint32_t alphabetSize = 256)
+    {
+        std::vector<std::uint8_t> image(size);
+        for (auto& byte : image)
+            byte = static_cast<std::uint8_t>(random() % alphabetSize);
+        return image;
+    }
+
+    // Random bytes with some wildcards, always with two consecutive known bytes
+    TestPattern MakePattern(std::size_t size, std::mt19937& random, std::uint32_t alphabetSize = 256)
+    {
+        std::vector<std::uint16_t> values(size);
+        for (auto& value : values)
+            value = random() % 4 == 0 ? WILDCARD : static_cast<std::uint16_t>(random() % alphabetSize);
+
+        const auto anchor = random() % (size - 1);
+        values[anchor] = static_cast<std::uint16_t>(random() % alphabetSize);
+        values[anchor + 1] = static_cast<std::uint16_t>(random() % alphabetSize);
+        return TestPattern(std::move(values));
+    }
+
+    std::vector<std::optional<std::size_t>> FindFirstMatches(const std::vector<TestPattern>& testPatterns,
+                                                             std::span<const std::uint8_t> image)
+    {
+        std::vector<PatternScanner::Pattern> patterns;
+        for (const auto& pattern : testPatterns)
+            patterns.push_back(pattern.Get());
+        return PatternScanner(std::move(patterns), image).FindFirstMatches(image);
+    }
+
+    void CheckMatchesReference(const std::vector<TestPattern>& patterns, std::span<const std::uint8_t> image)
+    {
+        const auto matches = FindFirstMatches(patterns, image);
+        REQUIRE(matches.size() == patterns.size());
+        for (std::size_t i = 0; i < patterns.size(); i++)
+        {
+            const auto expected = ReferenceFindFirst(patterns[i], image);
+            CHECK_EQ(matches[i].has_value(), expected.has_value());
+            if (matches[i].has_value() && expected.has_value())
+                CHECK_EQ(matches[i].value(), expected.value());
+        }
+    }
+}  // namespace
+
+TEST_CASE(FindsPlantedPatternsInOnePass)
+{
+    std::mt19937 random(1);
+    auto image = MakeImage(100000, random);
+
+    std::vector<TestPattern> patterns;
+    std::vector<std::size_t> offsets;
+    for (int i = 0; i < 50; i++)
+    {
+        patterns.push_back(MakePattern(8 + random() % 40, random));
+        offsets.push_back(random() % (image.size() - 64));
+        patterns.back().WriteTo(image, offsets.back(), static_cast<std::uint8_t>(random()));
+    }
+
+    // later plants may overwrite earlier ones, so compare against the reference rather than the planted offsets
+    CheckMatchesReference(patterns, image);
+    const auto matches = FindFirstMatches(patterns, image);
+    CHECK(matches.back().has_value() && matches.back().value() <= offsets.back());
+}
+
+TEST_CASE(MissingPatternsAreNotFound)
+{
+    std::mt19937 random(2);
+    const auto image = MakeImage(10000, random, 128);
+
+    // bytes the image does not contain
+    const TestPattern pattern({0xF0, 0xF1, WILDCARD, 0xF2});
+    const auto matches = FindFirstMatches({pattern}, image);
+    CHECK(!matches[0].has_value());
+}
+
+TEST_CASE(FirstOfSeveralOccurrencesWins)
+{
+    std::mt19937 random(3);
+    auto image = MakeImage(50000, random, 128);
+
+    const TestPattern pattern({0xC0, WILDCARD, 0xC1, 0xC2, WILDCARD, WILDCARD, 0xC3});
+    for (const std::size_t offset : {40000, 123, 9000})
+        pattern.WriteTo(image, offset, static_cast<std::uint8_t>(offset));
+
+    const auto matches = FindFirstMatches({pattern}, image);
+    REQUIRE(matches[0].has_value());
+    CHECK_EQ(matches[0].value(), std::size_t(123));
+}
+
+TEST_CASE(PatternsSharingAnAnchorAreAllVerified)
+{
+    std::mt19937 random(4);
+    auto image = MakeImage(20000, random, 128);
+
+    // the same rare pair starts all of them, only the bytes after it tell them apart
+    const TestPattern a({0xE0, 0xE1, 0x01, 0x02});
+    const TestPattern b({0xE0, 0xE1, 0x03, WILDCARD, 0x04});
+    const TestPattern c({0xE0, 0xE1, 0x05});
+    const TestPattern missing({0xE0, 0xE1, 0x06});
+    a.WriteTo(image, 5000, 0);
+    b.WriteTo(image, 1000, 0x77);
+    c.WriteTo(image, 15000, 0);
+
+    const auto matches = FindFirstMatches({a, b, c, missing}, image);
+    CHECK(matches[0] == std::optional<std::size_t>(5000));
+    CHECK(matches[1] == std::optional<std::size_t>(1000));
+    CHECK(matches[2] == std::optional<std::size_t>(15000));
+    CHECK(!matches[3].has_value());
+}
+
+TEST_CASE(PatternsAtTheEdgesOfTheImageAreFound)
+{
+    std::mt19937 random(5);
+    auto image = MakeImage(1000, random, 128);
+
+    // the anchor of the second one is its last pair, right at the end of the image
+    const TestPattern first({0xD0, 0xD1, WILDCARD, 0xD2});
+    const TestPattern last({0xD3, WILDCARD, WILDCARD, 0xD4, 0xD5});
+    first.WriteTo(image, 0, 0);
+    last.WriteTo(image, image.size() - 5, 0);
+
+    const auto matches = FindFirstMatches({first, last}, image);
+    CHECK(matches[0] == std::optional<std::size_t>(0));
+    CHECK(matches[1] == std::optional<std::size_t>(image.size() - 5));
+}
+
+TEST_CASE(PatternWithoutAnAnchorIsRejected)
+{
+    const std::vector<std::uint8_t> image(100, 0);
+    const TestPattern pattern({0x10, WILDCARD, 0x11, WILDCARD, 0x12});
+
+    bool threw = false;
+    try
+    {
+        PatternScanner({pattern.Get()}, image);
+    }
+    catch (const std::invalid_argument&)
+    {
+        threw = true;
+    }
+    CHECK(threw);
+}
+
+TEST_CASE(RandomPatternsMatchTheReference)
+{
+    std::mt19937 random(6);
+    for (int round = 0; round < 20; round++)
+    {
+        // a tiny alphabet gives many partial matches and repeated occurrences
+        const auto alphabetSize = 2 + random() % 6;
+        auto image = MakeImage(2000 + random() % 20000, random, alphabetSize);
+
+        std::vector<TestPattern> patterns;
+        for (int i = 0; i < 30; i++)
+            patterns.push_back(MakePattern(2 + random() % 12, random, alphabetSize));
+
+        CheckMatchesReference(patterns, image);
+    }
+}
+
+TEST_CASE(MatcherAgreesWithTheReferenceEverywhere)
+{
+    // every pattern size around the vector size, at every offset of a small image including ones where the pattern
+    // or its padding runs past the end
+    std::mt19937 random(7);
+    for (std::size_t size = 1; size <= PatternScanner::VECTOR_SIZE * 3 + 1; size++)
+    {
+        for (int round = 0; round < 20; round++)
+        {
+            const auto alphabetSize = 2 + random() % 3;
+            const auto image = MakeImage(size + random() % 40, random, alphabetSize);
+
+            std::vector<std::uint16_t> values(size);
+            for (auto& value : values)
+                value = random() % 3 == 0 ? WILDCARD : static_cast<std::uint16_t>(random() % alphabetSize);
+            const TestPattern pattern(std::move(values));
+
+            for (std::size_t offset = 0; offset <= image.size() + 1; offset++)
+            {
+                CHECK_EQ(PatternScanner::MatchesAt(pattern.Get(), image, offset),
+                         ReferenceMatchesAt(pattern, image, offset));
+            }
+        }
+    }
+}
+
+TEST_CASE(EveryKnownByteIsCompared)
+{
+    std::mt19937 random(8);
+    for (std::size_t size = 2; size <= 70; size++)
+    {
+        const auto pattern = MakePattern(size, random);
+        auto image = MakeImage(size + 32, random);
+        const auto offset = random() % 32;
+        pattern.WriteTo(image, offset, static_cast<std::uint8_t>(random()));
+        REQUIRE(PatternScanner::MatchesAt(pattern.Get(), image, offset));
+
+        // changing a known byte breaks the match, whatever position of the vector it is in, a wildcard never does
+        for (std::size_t i = 0; i < size; i++)
+        {
+            for (const std::uint8_t flip : {0x01, 0x80, 0xFF})
+            {
+                image[offset + i] ^= flip;
+                CHECK_EQ(PatternScanner::MatchesAt(pattern.Get(), image, offset), pattern.values[i] == WILDCARD);
+                image[offset + i] ^= flip;
+            }
+        }
+    }
+}
+
+TEST_CASE(PatternEndingAtTheEndOfTheImageMatches)
+{
+    // the padding of the last vector would be read past the end of the image, so it has to be compared bytewise
+    std::mt19937 random(9);
+    for (std::size_t size = 2; size <= PatternScanner::VECTOR_SIZE * 2; size++)
+    {
+        const auto pattern = MakePattern(size, random);
+        std::vector<std::uint8_t> image(size);
+        pattern.WriteTo(image, 0, 0x5A);
+
+        CHECK(PatternScanner::MatchesAt(pattern.Get(), image, 0));
+        CHECK(!PatternScanner::MatchesAt(pattern.Get(), std::span(image).first(size - 1), 0));
+    }
+}
+
+TEST_CASE(MatchesAcrossChunkBordersAreFound)
+{
+    constexpr auto CHUNK_SIZE = PatternScanner::CHUNK_SIZE;
+    std::mt19937 random(10);
+    auto image = MakeImage(CHUNK_SIZE * 3 + 100, random, 128);
+
+    // anchors are the last pair, the first pair and the middle pair respectively
+    const TestPattern anchorAfterBorder({0x90, WILDCARD, 0x91, WILDCARD, WILDCARD, 0xA0, 0xA1});
+    const TestPattern anchorBeforeBorder({0xA2, 0xA3, WILDCARD, 0x92, WILDCARD, 0x93});
+    const TestPattern anchorOnBorder({0x94, WILDCARD, 0xA4, 0xA5, WILDCARD, 0x95});
+
+    // starts in the first chunk, but its anchor is in the second
+    anchorAfterBorder.WriteTo(image, CHUNK_SIZE - 3, 0);
+    // anchored in the second chunk, ends in the third
+    anchorBeforeBorder.WriteTo(image, CHUNK_SIZE * 2 - 2, 0);
+    // the anchor pair itself is split between the third and fourth chunk
+    anchorOnBorder.WriteTo(image, CHUNK_SIZE * 3 - 3, 0);
+
+    const auto matches = FindFirstMatches({anchorAfterBorder, anchorBeforeBorder, anchorOnBorder}, image);
+    CHECK(matches[0] == std::optional<std::size_t>(CHUNK_SIZE - 3));
+    CHECK(matches[1] == std::optional<std::size_t>(CHUNK_SIZE * 2 - 2));
+    CHECK(matches[2] == std::optional<std::size_t>(CHUNK_SIZE * 3 - 3));
+}
+
+TEST_CASE(LowestMatchWinsAcrossChunks)
+{
+    constexpr auto CHUNK_SIZE = PatternScanner::CHUNK_SIZE;
+    std::mt19937 random(11);
+    auto image = MakeImage(CHUNK_SIZE * 6, random, 128);
+
+    // found in a later chunk first when the chunks run in parallel, the one just before the border still wins
+    const TestPattern pattern({0xB0, 0xB1, WILDCARD, 0xB2, 0xB3});
+    for (const auto offset : {CHUNK_SIZE * 5 + 10, CHUNK_SIZE * 3, CHUNK_SIZE * 2 - 4, CHUNK_SIZE * 4 - 1})
+        pattern.WriteTo(image, offset, 0x33);
+
+    for (int i = 0; i < 10; i++)
+    {
+        const auto matches = FindFirstMatches({pattern}, image);
+        CHECK(matches[0] == std::optional<std::size_t>(CHUNK_SIZE * 2 - 4));
+    }
+}
+
+TEST_CASE(RandomMatchesAroundChunkBordersMatchTheReference)
+{
+    constexpr auto CHUNK_SIZE = PatternScanner::CHUNK_SIZE;
+    std::mt19937 random(12);
+
+    // image sizes that end exactly on, just after and well within a chunk
+    for (const auto imageSize : {CHUNK_SIZE * 4, CHUNK_SIZE * 4 + 1, CHUNK_SIZE * 4 + 1000})
+    {
+        auto image = MakeImage(imageSize, random);
+
+        std::vector<TestPattern> patterns;
+        for (int i = 0; i < 60; i++)
+        {
+            const auto size = 2 + random() % 40;
+            patterns.push_back(MakePattern(size, random));
+
+            // every border, including the end of the image
+            const auto border = CHUNK_SIZE * (1 + random() % 4);
+            const auto offset = std::min(border - std::min<std::size_t>(border, random() % (size + 2)),
+                                         imageSize - size);
+            patterns.back().WriteTo(image, offset, static_cast<std::uint8_t>(random()));
+        }
+
+        CheckMatchesReference(patterns, image);
+    }
+}
+
+// Known offsets are how cached signature offsets are checked on launch, see SignatureCache
+namespace
+{
+    // An image with planted patterns and their first matches, like a module whose offsets were cached before
+    struct CachedImage
+    {
+        std::vector<std::uint8_t> image;
+        std::vector<TestPattern> patterns;
+        std::vector<std::optional<std::size_t>> firstMatches;
+
+        explicit CachedImage(std::uint32_t seed)
+        {
+            std::mt19937 random(seed);
+            image = MakeImage(200000, random);
+            for (int i = 0; i < 40; i++)
+            {
+                patterns.push_back(MakePattern(12 + random() % 24, random));
+                patterns.back().WriteTo(image, random() % (image.size() - 64), static_cast<std::uint8_t>(random()));
+            }
+            firstMatches = FindFirstMatches(patterns, image);
+        }
+
+        PatternScanner::KnownOffsetMatches Find(std::span<const std::optional<std::size_t>> knownOffsets) const
+        {
+            std::vector<PatternScanner::Pattern> scannerPatterns;
+            for (const auto& pattern : patterns)
+                scannerPatterns.push_back(pattern.Get());
+            return PatternScanner::FindFirstMatches(std::move(scannerPatterns), knownOffsets, image);
+        }
+    };
+}  // namespace
+
+TEST_CASE(MatchingKnownOffsetsAreNotScannedFor)
+{
+    const CachedImage cached(20);
+
+    const auto result = cached.Find(cached.firstMatches);
+    CHECK(result.matches == cached.firstMatches);
+    CHECK_EQ(result.knownCount, cached.patterns.size());
+    CHECK_EQ(result.scannedCount, std::size_t(0));
+}
+
+TEST_CASE(PatternsWithoutKnownOffsetsAreScannedFor)
+{
+    const CachedImage cached(21);
+
+    // a module that was never cached, or signatures added since
+    std::vector<std::optional<std::size_t>> knownOffsets = cached.firstMatches;
+    for (std::size_t i = 0; i < knownOffsets.size(); i += 3)
+        knownOffsets[i].reset();
+
+    const auto result = cached.Find(knownOffsets);
+    CHECK(result.matches == cached.firstMatches);
+    CHECK_EQ(result.scannedCount, (cached.patterns.size() + 2) / 3);
+    CHECK_EQ(result.knownCount, cached.patterns.size() - result.scannedCount);
+}
+
+TEST_CASE(StaleKnownOffsetsFallBackToAScan)
+{
+    const CachedImage cached(22);
+
+    // offsets from another build of the module: moved by a few bytes, past the end of the image or at a near miss
+    std::vector<std::optional<std::size_t>> knownOffsets = cached.firstMatches;
+    knownOffsets[0] = knownOffsets[0].value() + 3;
+    knownOffsets[1] = cached.image.size() - 1;
+    knownOffsets[2] = std::numeric_limits<std::size_t>::max();
+
+    auto nearMiss = cached;
+    const auto& values = nearMiss.patterns[3].values;
+    const auto knownByte = std::find_if(values.begin(), values.end(), [](auto value) { return value != WILDCARD; });
+    const auto changedByte = nearMiss.firstMatches[3].value() + (knownByte - values.begin());
+    nearMiss.image[changedByte] = static_cast<std::uint8_t>(nearMiss.image[changedByte] ^ 0xFF);
+
+    const auto result = cached.Find(knownOffsets);
+    CHECK(result.matches == cached.firstMatches);
+    CHECK_EQ(result.scannedCount, std::size_t(3));
+
+    // every stale offset is verified with MatchesAt, so the result is the scan's whatever the known offsets said
+    const auto nearMissResult = nearMiss.Find(cached.firstMatches);
+    CHECK(nearMissResult.matches == FindFirstMatches(nearMiss.patterns, nearMiss.image));
+    CHECK(nearMissResult.scannedCount >= 1);
+}
+
+TEST_CASE(KnownOffsetsMustMatchThePatterns)
+{
+    const CachedImage cached(23);
+    const std::vector<std::optional<std::size_t>> knownOffsets(cached.patterns.size() - 1);
+    CHECK_THROWS_AS(cached.Find(knownOffsets), std::invalid_argument);
+}
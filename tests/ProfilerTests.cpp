@@ -0,0 +1,258 @@
+#include "StdInclude.hpp"
+#include "TestFramework.hpp"
+
+#include <set>
+
+#include "nlohmann/json.hpp"
+
+#include "Utilities/Profiler.hpp"
+
+using namespace IWXMVM;
+
+namespace
+{
+    // The profiler records into global per thread buffers, so every test records on fresh threads and only looks at
+    // the zones that started after it did
+    template <typename Function>
+    void RunOnThread(Function&& function)
+    {
+        std::thread(std::forward<Function>(function)).join();
+    }
+
+    void Spin(std::chrono::microseconds duration)
+    {
+        const auto end = std::chrono::steady_clock::now() + duration;
+        while (std::chrono::steady_clock::now() < end)
+        {
+        }
+    }
+
+    void RecordNestedZones()
+    {
+        PROFILE_ZONE("Outer");
+        Spin(std::chrono::microseconds(50));
+        {
+            PROFILE_ZONE("Inner");
+            Spin(std::chrono::microseconds(50));
+            {
+                PROFILE_ZONE("Innermost");
+                Spin(std::chrono::microseconds(50));
+            }
+        }
+        {
+            PROFILE_ZONE("Inner");
+            Spin(std::chrono::microseconds(50));
+        }
+    }
+
+    std::vector<Profiler::Zone> CollectZonesSince(std::uint64_t start)
+    {
+        return Profiler::CollectZones(start, std::numeric_limits<std::uint64_t>::max());
+    }
+
+    bool Contains(const Profiler::Zone& parent, const Profiler::Zone& child)
+    {
+        return child.start >= parent.start && child.end <= parent.end;
+    }
+}  // namespace
+
+TEST_CASE(NestedZonesAreCollectedParentFirst)
+{
+    const auto start = Profiler::GetTimestamp();
+    RunOnThread(RecordNestedZones);
+
+    const auto zones = CollectZonesSince(start);
+    REQUIRE(zones.size() == 4);
+
+    // ordered by start, so every zone follows the zone it is nested in
+    CHECK(std::string_view(zones[0].name) == "Outer");
+    CHECK(std::string_view(zones[1].name) == "Inner");
+    CHECK(std::string_view(zones[2].name) == "Innermost");
+    CHECK(std::string_view(zones[3].name) == "Inner");
+    CHECK_EQ(zones[0].depth, 0u);
+    CHECK_EQ(zones[1].depth, 1u);
+    CHECK_EQ(zones[2].depth, 2u);
+    CHECK_EQ(zones[3].depth, 1u);
+
+    CHECK(Contains(zones[0], zones[1]) && Contains(zones[1], zones[2]) && Contains(zones[0], zones[3]));
+    CHECK(zones[1].end <= zones[3].start);
+    for (const auto& zone : zones)
+        CHECK_EQ(zone.threadId, zones[0].threadId);
+}
+
+TEST_CASE(ZonesAreCollectedByStartTime)
+{
+    std::uint64_t middle = 0;
+    const auto start = Profiler::GetTimestamp();
+    RunOnThread([&] {
+        {
+            PROFILE_ZONE("Before");
+        }
+        middle = Profiler::GetTimestamp();
+        {
+            PROFILE_ZONE("After");
+        }
+    });
+
+    const auto before = Profiler::CollectZones(start, middle);
+    const auto after = CollectZonesSince(middle);
+    REQUIRE(before.size() == 1 && after.size() == 1);
+    CHECK(std::string_view(before[0].name) == "Before");
+    CHECK(std::string_view(after[0].name) == "After");
+}
+
+TEST_CASE(NothingIsRecordedWhileRecordingIsOff)
+{
+    const auto start = Profiler::GetTimestamp();
+    Profiler::SetRecording(false);
+    RunOnThread(RecordNestedZones);
+    Profiler::SetRecording(true);
+
+    CHECK(CollectZonesSince(start).empty());
+}
+
+TEST_CASE(ThreadsAreRecordedSeparately)
+{
+    const auto start = Profiler::GetTimestamp();
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 4; i++)
+        threads.emplace_back(RecordNestedZones);
+    for (auto& thread : threads)
+        thread.join();
+
+    const auto zones = CollectZonesSince(start);
+    REQUIRE(zones.size() == 16);
+
+    // grouped by thread, each with its own nesting
+    std::set<std::uint32_t> threadIds;
+    for (std::size_t i = 0; i < zones.size(); i += 4)
+    {
+        threadIds.insert(zones[i].threadId);
+        CHECK(std::string_view(zones[i].name) == "Outer");
+        CHECK_EQ(zones[i].depth, 0u);
+        for (std::size_t j = i + 1; j < i + 4; j++)
+        {
+            CHECK_EQ(zones[j].threadId, zones[i].threadId);
+            CHECK(Contains(zones[i], zones[j]));
+        }
+    }
+    CHECK_EQ(threadIds.size(), std::size_t(4));
+}
+
+TEST_CASE(OldestZonesOfABusyThreadAreOverwritten)
+{
+    const auto start = Profiler::GetTimestamp();
+    RunOnThread([] {
+        for (std::size_t i = 0; i < Profiler::ZONE_BUFFER_SIZE + 100; i++)
+        {
+            PROFILE_ZONE("Busy");
+        }
+    });
+
+    const auto zones = CollectZonesSince(start);
+    CHECK_EQ(zones.size(), Profiler::ZONE_BUFFER_SIZE);
+    CHECK(std::is_sorted(zones.begin(), zones.end(),
+                         [](const Profiler::Zone& a, const Profiler::Zone& b) { return a.start < b.start; }));
+}
+
+TEST_CASE(StatsAreSummedByName)
+{
+    // equal names at different addresses, like the same literal in two translation units
+    static const char firstName[] = "Shared";
+    static const char secondName[] = "Shared";
+    const std::vector<Profiler::Zone> zones = {
+        {firstName, 0, 100, 0, 1},
+        {secondName, 200, 500, 0, 1},
+        {"Other", 100, 150, 0, 2},
+        {"Long", 0, 1000, 0, 2},
+    };
+
+    const auto stats = Profiler::GetZoneStats(zones);
+    REQUIRE(stats.size() == 3);
+    CHECK(stats[0].name == "Long");
+    CHECK(stats[1].name == "Shared");
+    CHECK_EQ(stats[1].callCount, std::uint64_t(2));
+    CHECK_EQ(stats[1].totalDuration, std::uint64_t(400));
+    CHECK_EQ(stats[1].maxDuration, std::uint64_t(300));
+    CHECK(stats[2].name == "Other");
+}
+
+TEST_CASE(FramesSpanFromOneMarkToTheNext)
+{
+    for (std::size_t i = 0; i < Profiler::FRAME_HISTORY_SIZE + 10; i++)
+    {
+        Profiler::MarkFrame();
+        Spin(std::chrono::microseconds(5));
+    }
+
+    // one frame less than the history holds, as the newest mark has no end yet
+    const auto frames = Profiler::GetFrames();
+    REQUIRE(frames.size() == Profiler::FRAME_HISTORY_SIZE - 1);
+    for (std::size_t i = 0; i < frames.size(); i++)
+    {
+        CHECK(frames[i].start < frames[i].end);
+        if (i > 0)
+            CHECK_EQ(frames[i].start, frames[i - 1].end);
+    }
+}
+
+TEST_CASE(ChromeTraceHasACompleteEventPerZone)
+{
+    const auto start = Profiler::GetTimestamp();
+    RunOnThread(RecordNestedZones);
+    const auto zones = CollectZonesSince(start);
+    REQUIRE(zones.size() == 4);
+
+    std::stringstream stream;
+    Profiler::ExportChromeTrace(stream);
+    const auto trace = nlohmann::json::parse(stream);
+
+    CHECK(trace.at("displayTimeUnit").get<std::string>() == "ms");
+    const auto& events = trace.at("traceEvents");
+    REQUIRE(events.is_array());
+
+    // earlier tests recorded on other threads, so only the events of this test's thread are compared
+    std::vector<nlohmann::json> threadEvents;
+    bool hasThreadName = false;
+    for (const auto& event : events)
+    {
+        REQUIRE(event.contains("ph") && event.contains("pid") && event.contains("tid") && event.contains("name"));
+        if (event.at("tid").get<std::uint32_t>() != zones[0].threadId)
+            continue;
+
+        if (event.at("ph") == "M")
+        {
+            hasThreadName = event.at("name") == "thread_name" && event.at("args").contains("name");
+            continue;
+        }
+
+        CHECK(event.at("ph") == "X");
+        CHECK(event.at("ts").get<double>() >= 0.0);
+        CHECK(event.at("dur").get<double>() >= 0.0);
+        threadEvents.push_back(event);
+    }
+    CHECK(hasThreadName);
+    REQUIRE(threadEvents.size() == zones.size());
+
+    // timestamps are microseconds relative to the earliest zone, so differences carry over exactly
+    for (std::size_t i = 0; i < zones.size(); i++)
+    {
+        CHECK(threadEvents[i].at("name").get<std::string>() == zones[i].name);
+        CHECK_NEAR(threadEvents[i].at("dur").get<double>(), (zones[i].end - zones[i].start) / 1000.0, 1e-3);
+        CHECK_NEAR(threadEvents[i].at("ts").get<double>() - threadEvents[0].at("ts").get<double>(),
+                   (zones[i].start - zones[0].start) / 1000.0, 1e-3);
+    }
+}
+
+TEST_CASE(ChromeTraceIsWrittenToAFile)
+{
+    const auto path = std::filesystem::temp_directory_path() /
+                      std::format("iwxmvm_profiler_{}.json", Profiler::GetTimestamp());
+    REQUIRE(Profiler::ExportChromeTrace(path));
+
+    const auto trace = nlohmann::json::parse(std::ifstream(path));
+    CHECK(trace.at("traceEvents").is_array());
+    std::filesystem::remove(path);
+
+    CHECK(!Profiler::ExportChromeTrace(std::filesystem::path("/nonexistent/directory/trace.json")));
+}
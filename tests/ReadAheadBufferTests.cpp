@@ -0,0 +1,258 @@
+#include "StdInclude.hpp"
+#include "TestFramework.hpp"
+
+#include <random>
+
+#include "Utilities/ReadAheadBuffer.hpp"
+
+using namespace IWXMVM;
+
+namespace
+{
+    // Lets a test slow the source down, or hold its reads back entirely to see what is served from memory
+    struct SourceControl
+    {
+        std::mutex mutex;
+        std::condition_variable readAllowed;
+        std::size_t allowedReadCount = std::numeric_limits<std::size_t>::max();
+        std::size_t readCount = 0;
+        std::chrono::microseconds delay{0};
+
+        void Allow(std::size_t count)
+        {
+            {
+                std::lock_guard lock(mutex);
+                allowedReadCount = count;
+            }
+            readAllowed.notify_all();
+        }
+
+        std::size_t GetReadCount()
+        {
+            std::lock_guard lock(mutex);
+            return readCount;
+        }
+    };
+
+    // A source like a slow disk: every read of a chunk waits for its turn and then takes `delay`
+    class SlowSource : public std::streambuf
+    {
+       public:
+        SlowSource(std::string content, std::shared_ptr<SourceControl> control)
+            : content(std::move(content)), control(std::move(control))
+        {
+        }
+
+       protected:
+        std::streamsize xsgetn(char* destination, std::streamsize count) override
+        {
+            std::chrono::microseconds delay;
+            {
+                std::unique_lock lock(control->mutex);
+                control->readAllowed.wait(lock, [&] { return control->readCount < control->allowedReadCount; });
+                control->readCount++;
+                delay = control->delay;
+            }
+            std::this_thread::sleep_for(delay);
+
+            const auto readCount = std::min<std::streamsize>(count, content.size() - position);
+            std::memcpy(destination, content.data() + position, static_cast<std::size_t>(readCount));
+            position += static_cast<std::size_t>(readCount);
+            return readCount;
+        }
+
+        int_type underflow() override
+        {
+            return position < content.size() ? traits_type::to_int_type(content[position]) : traits_type::eof();
+        }
+
+        pos_type seekoff(off_type offset, std::ios_base::seekdir direction, std::ios_base::openmode mode) override
+        {
+            const auto base = direction == std::ios_base::beg   ? 0
+                              : direction == std::ios_base::cur ? static_cast<off_type>(position)
+                                                                : static_cast<off_type>(content.size());
+            return seekpos(pos_type(base + offset), mode);
+        }
+
+        pos_type seekpos(pos_type target, std::ios_base::openmode) override
+        {
+            if (static_cast<off_type>(target) < 0 || static_cast<std::size_t>(target) > content.size())
+                return pos_type(off_type(-1));
+
+            position = static_cast<std::size_t>(target);
+            return target;
+        }
+
+       private:
+        std::string content;
+        std::size_t position = 0;
+        std::shared_ptr<SourceControl> control;
+    };
+
+    class SlowStream : public std::istream
+    {
+       public:
+        SlowStream(std::string content, std::shared_ptr<SourceControl> control)
+            : std::istream(nullptr), buffer(std::move(content), std::move(control))
+        {
+            rdbuf(&buffer);
+        }
+
+       private:
+        SlowSource buffer;
+    };
+
+    std::string MakeContent(std::size_t size)
+    {
+        std::mt19937 random(42);
+        std::string content(size, '\0');
+        for (auto& c : content)
+            c = static_cast<char>(random());
+        return content;
+    }
+
+    std::string Read(ReadAheadBuffer& buffer, std::size_t count)
+    {
+        std::string data(count, '\0');
+        data.resize(buffer.Read(data.data(), count));
+        return data;
+    }
+
+    constexpr auto CHUNK_SIZE = ReadAheadBuffer::CHUNK_SIZE;
+}  // namespace
+
+TEST_CASE(SequentialReadsMatchTheSource)
+{
+    // several times the capacity, so the window wraps around the ring many times
+    const auto content = MakeContent(CHUNK_SIZE * 13 + 777);
+    auto control = std::make_shared<SourceControl>();
+    ReadAheadBuffer buffer(std::make_unique<SlowStream>(content, control), CHUNK_SIZE * 3);
+    CHECK_EQ(buffer.GetSize(), std::uint64_t(content.size()));
+
+    std::mt19937 random(7);
+    std::string readContent;
+    while (readContent.size() < content.size())
+    {
+        const auto data = Read(buffer, 1 + random() % (CHUNK_SIZE / 2));
+        REQUIRE(!data.empty());
+        readContent += data;
+    }
+    CHECK(readContent == content);
+    CHECK_EQ(buffer.GetPosition(), std::uint64_t(content.size()));
+
+    // reads at the end return nothing instead of blocking
+    CHECK(Read(buffer, 10).empty());
+}
+
+TEST_CASE(ReadsAtTheEndAreShort)
+{
+    const auto content = MakeContent(CHUNK_SIZE + 100);
+    auto control = std::make_shared<SourceControl>();
+    ReadAheadBuffer buffer(std::make_unique<SlowStream>(content, control), CHUNK_SIZE * 2);
+
+    buffer.Seek(content.size() - 40);
+    CHECK(Read(buffer, 100) == content.substr(content.size() - 40));
+}
+
+TEST_CASE(SeeksReadTheSameBytesAsTheSource)
+{
+    const auto content = MakeContent(CHUNK_SIZE * 10);
+    auto control = std::make_shared<SourceControl>();
+    ReadAheadBuffer buffer(std::make_unique<SlowStream>(content, control), CHUNK_SIZE * 4);
+
+    std::mt19937 random(3);
+    for (int i = 0; i < 300; i++)
+    {
+        // mostly short skips within the window like the demo reader's, with backward and far jumps in between
+        std::uint64_t position = buffer.GetPosition();
+        switch (random() % 4)
+        {
+            case 0:
+                position = random() % content.size();
+                break;
+            case 1:
+                position = position >= 5000 ? position - 5000 : 0;
+                break;
+            default:
+                position = std::min<std::uint64_t>(position + random() % 20000, content.size());
+                break;
+        }
+
+        buffer.Seek(position);
+        CHECK_EQ(buffer.GetPosition(), position);
+
+        const auto count = 1 + random() % 30000;
+        CHECK(Read(buffer, count) == content.substr(position, count));
+    }
+}
+
+TEST_CASE(BufferedBytesAreServedWhileTheSourceIsBlocked)
+{
+    const auto content = MakeContent(CHUNK_SIZE * 8);
+    auto control = std::make_shared<SourceControl>();
+    control->allowedReadCount = 3;
+    ReadAheadBuffer buffer(std::make_unique<SlowStream>(content, control), CHUNK_SIZE * 4);
+
+    // the worker reads three chunks ahead and then blocks in the source, the reader gets those three from memory
+    CHECK(Read(buffer, CHUNK_SIZE * 3) == content.substr(0, CHUNK_SIZE * 3));
+    CHECK_EQ(control->GetReadCount(), std::size_t(3));
+
+    control->Allow(std::numeric_limits<std::size_t>::max());
+    CHECK(Read(buffer, CHUNK_SIZE) == content.substr(CHUNK_SIZE * 3, CHUNK_SIZE));
+}
+
+TEST_CASE(SeekDuringASlowReadDropsTheStaleChunk)
+{
+    const auto content = MakeContent(CHUNK_SIZE * 8);
+    auto control = std::make_shared<SourceControl>();
+    control->allowedReadCount = 1;
+    ReadAheadBuffer buffer(std::make_unique<SlowStream>(content, control), CHUNK_SIZE * 2);
+
+    CHECK(Read(buffer, 100) == content.substr(0, 100));
+
+    // wait for the worker to block in the source on its second chunk, then move far away from it
+    while (control->GetReadCount() < 1)
+        std::this_thread::yield();
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    buffer.Seek(CHUNK_SIZE * 5 + 3);
+    control->Allow(std::numeric_limits<std::size_t>::max());
+
+    CHECK(Read(buffer, CHUNK_SIZE) == content.substr(CHUNK_SIZE * 5 + 3, CHUNK_SIZE));
+}
+
+TEST_CASE(SlowSourceIsReadAheadOfTheReader)
+{
+    const auto content = MakeContent(CHUNK_SIZE * 8);
+    auto control = std::make_shared<SourceControl>();
+    control->delay = std::chrono::milliseconds(10);
+    ReadAheadBuffer buffer(std::make_unique<SlowStream>(content, control), CHUNK_SIZE * 8);
+
+    // a reader that takes as long per chunk as the disk: with read-ahead both run at the same time
+    const auto start = std::chrono::steady_clock::now();
+    std::string readContent;
+    for (int i = 0; i < 8; i++)
+    {
+        readContent += Read(buffer, CHUNK_SIZE);
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+
+    CHECK(readContent == content);
+
+    // reading and processing one after another would take at least 160ms, overlapped it takes about 90ms
+    CHECK(elapsed < std::chrono::milliseconds(150));
+}
+
+TEST_CASE(DestroyingTheBufferStopsTheWorker)
+{
+    const auto content = MakeContent(CHUNK_SIZE * 8);
+    auto control = std::make_shared<SourceControl>();
+    {
+        // the ring fills up and the worker waits for space when the buffer goes away
+        ReadAheadBuffer buffer(std::make_unique<SlowStream>(content, control), CHUNK_SIZE * 2);
+        CHECK(Read(buffer, 10) == content.substr(0, 10));
+        while (control->GetReadCount() < 2)
+            std::this_thread::yield();
+    }
+    CHECK(control->GetReadCount() <= 3);
+}
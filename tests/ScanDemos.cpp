@@ -0,0 +1,66 @@
+#include "StdInclude.hpp"
+
+#include "Demo/DemoScanner.hpp"
+
+// Reads the metadata of every demo in a directory tree the way the demo library does, e.g. to check what a library
+// will show or how long reading it takes:
+//   ScanDemos <directory>...
+// Prints the duration, archive count and protocol of each demo and the total time taken. Compressed demos are skipped,
+// as decompressing them needs Windows. Map names are not shown, the mod only learns them by playing a demo.
+
+using namespace IWXMVM::IW3::Demo;
+
+int main(int argc, char** argv)
+{
+    if (argc < 2)
+    {
+        std::fprintf(stderr, "usage: %s <directory>...\n", argv[0]);
+        return 2;
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    std::size_t demoCount = 0;
+    std::size_t unreadableCount = 0;
+    std::uintmax_t totalSize = 0;
+
+    for (int i = 1; i < argc; i++)
+    {
+        std::error_code error;
+        for (std::filesystem::recursive_directory_iterator it(argv[i], error), end; !error && it != end;
+             it.increment(error))
+        {
+            if (!it->is_regular_file(error) || it->path().extension() != ".dm_1")
+                continue;
+
+            std::ifstream input(it->path(), std::ios::binary);
+            if (!input.is_open())
+            {
+                std::printf("%s: failed to open\n", it->path().string().c_str());
+                unreadableCount++;
+                continue;
+            }
+
+            const auto metadata = ReadMetadata(input);
+            const auto seconds = metadata.GetDuration() / 1000;
+            std::printf("%s: %s, %u archives%s\n", it->path().string().c_str(),
+                        metadata.HasBounds() ? std::format("{}:{:02}", seconds / 60, seconds % 60).c_str()
+                                             : "no bounds",
+                        metadata.archiveCount, metadata.isCoD4X ? ", CoD4X" : "");
+
+            demoCount++;
+            totalSize += it->file_size(error);
+        }
+
+        if (error)
+        {
+            std::fprintf(stderr, "%s: %s\n", argv[i], error.message().c_str());
+            unreadableCount++;
+        }
+    }
+
+    const auto milliseconds =
+        std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    std::printf("Read %zu demos (%.1f MB) in %.1f ms\n", demoCount, static_cast<double>(totalSize) / (1024 * 1024),
+                milliseconds);
+    return unreadableCount == 0 ? 0 : 1;
+}
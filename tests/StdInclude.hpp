@@ -0,0 +1,246 @@
+#pragma once
+
+// Stands in for core/src/StdInclude.hpp when units are built outside of the game: only the standard library and the
+// header-only dependencies, no Direct3D, ImGui or spdlog. Windows headers are only included on Windows, for the
+// tests of units that wrap Windows APIs.
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <Windows.h>
+#endif
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cinttypes>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cwctype>
+#include <deque>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <istream>
+#include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <optional>
+#include <span>
+#include <sstream>
+#include <stack>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <unordered_map>
+#include <unordered_set>
+#include <variant>
+#include <vector>
+#include <chrono>
+#include <thread>
+
+#if __has_include(<format>)
+#include <format>
+#endif
+
+#if !defined(__cpp_lib_format)
+// Minimal replacement for std::format on standard libraries that do not ship it yet. Supports the subset the tested
+// units use: automatic and explicit argument indices, fill, alignment, sign, zero padding, width, precision and the
+// d, x, X, f, e, g and s presentation types.
+namespace std
+{
+    namespace FormatFallback
+    {
+        struct Spec
+        {
+            char fill = ' ';
+            char align = 0;
+            bool plus = false;
+            bool zero = false;
+            int width = 0;
+            int precision = -1;
+            char type = 0;
+        };
+
+        inline Spec ParseSpec(string_view text)
+        {
+            Spec spec;
+            std::size_t i = 0;
+            auto isAlign = [](char c) { return c == '<' || c == '>' || c == '^'; };
+            if (text.size() >= 2 && isAlign(text[1]))
+            {
+                spec.fill = text[0];
+                spec.align = text[1];
+                i = 2;
+            }
+            else if (!text.empty() && isAlign(text[0]))
+            {
+                spec.align = text[0];
+                i = 1;
+            }
+            if (i < text.size() && text[i] == '+')
+            {
+                spec.plus = true;
+                i++;
+            }
+            if (i < text.size() && text[i] == '0')
+            {
+                spec.zero = true;
+                i++;
+            }
+            while (i < text.size() && text[i] >= '0' && text[i] <= '9')
+                spec.width = spec.width * 10 + (text[i++] - '0');
+            if (i < text.size() && text[i] == '.')
+            {
+                spec.precision = 0;
+                i++;
+                while (i < text.size() && text[i] >= '0' && text[i] <= '9')
+                    spec.precision = spec.precision * 10 + (text[i++] - '0');
+            }
+            if (i < text.size())
+                spec.type = text[i];
+            return spec;
+        }
+
+        inline string Pad(string value, const Spec& spec, bool isNumber)
+        {
+            if (static_cast<int>(value.size()) >= spec.width)
+                return value;
+
+            const auto padding = static_cast<std::size_t>(spec.width) - value.size();
+            if (spec.zero && !spec.align && isNumber)
+            {
+                const auto signLength = (!value.empty() && (value[0] == '-' || value[0] == '+')) ? 1 : 0;
+                return value.insert(signLength, padding, '0');
+            }
+
+            const auto align = spec.align ? spec.align : (isNumber ? '>' : '<');
+            if (align == '>')
+                return string(padding, spec.fill) + value;
+            if (align == '^')
+                return string(padding / 2, spec.fill) + value + string(padding - padding / 2, spec.fill);
+            return value + string(padding, spec.fill);
+        }
+
+        template <typename T>
+        string FormatValue(const T& value, const Spec& spec)
+        {
+            using Type = decay_t<T>;
+            char buffer[128];
+            if constexpr (is_same_v<Type, bool>)
+            {
+                return Pad(value ? "true" : "false", spec, false);
+            }
+            else if constexpr (is_same_v<Type, char>)
+            {
+                return Pad(string(1, value), spec, false);
+            }
+            else if constexpr (is_integral_v<Type> || is_enum_v<Type>)
+            {
+                const auto number = static_cast<long long>(value);
+                const auto unsignedNumber = static_cast<unsigned long long>(value);
+                if (spec.type == 'x')
+                    snprintf(buffer, sizeof(buffer), "%llx", unsignedNumber);
+                else if (spec.type == 'X')
+                    snprintf(buffer, sizeof(buffer), "%llX", unsignedNumber);
+                else if (is_unsigned_v<Type>)
+                    snprintf(buffer, sizeof(buffer), spec.plus ? "+%llu" : "%llu", unsignedNumber);
+                else
+                    snprintf(buffer, sizeof(buffer), spec.plus ? "%+lld" : "%lld", number);
+                return Pad(buffer, spec, true);
+            }
+            else if constexpr (is_floating_point_v<Type>)
+            {
+                const auto format = string(spec.plus ? "%+.*" : "%.*") + (spec.type ? spec.type : 'g');
+                if (spec.type || spec.precision >= 0)
+                {
+                    snprintf(buffer, sizeof(buffer), format.c_str(), spec.precision >= 0 ? spec.precision : 6,
+                             static_cast<double>(value));
+                    return Pad(buffer, spec, true);
+                }
+
+                // shortest representation that reads back the same, like std::format
+                for (int precision = 1; precision <= 17; precision++)
+                {
+                    snprintf(buffer, sizeof(buffer), format.c_str(), precision, static_cast<double>(value));
+                    if (static_cast<Type>(strtod(buffer, nullptr)) == value)
+                        break;
+                }
+                return Pad(buffer, spec, true);
+            }
+            else if constexpr (is_pointer_v<Type> && !is_same_v<Type, const char*> && !is_same_v<Type, char*>)
+            {
+                snprintf(buffer, sizeof(buffer), "0x%" PRIxPTR, reinterpret_cast<uintptr_t>(value));
+                return Pad(buffer, spec, false);
+            }
+            else
+            {
+                string text{string_view(value)};
+                if (spec.precision >= 0 && static_cast<std::size_t>(spec.precision) < text.size())
+                    text.resize(spec.precision);
+                return Pad(text, spec, false);
+            }
+        }
+    }  // namespace FormatFallback
+
+    template <typename... Args>
+    string format(string_view text, const Args&... args)
+    {
+        const auto argumentCount = sizeof...(Args);
+        function<string(const FormatFallback::Spec&)> formatters[argumentCount + 1] = {
+            [&args](const FormatFallback::Spec& spec) { return FormatFallback::FormatValue(args, spec); }...};
+
+        string result;
+        std::size_t nextArgument = 0;
+        for (std::size_t i = 0; i < text.size(); i++)
+        {
+            const auto c = text[i];
+            if ((c == '{' || c == '}') && i + 1 < text.size() && text[i + 1] == c)
+            {
+                result += c;
+                i++;
+                continue;
+            }
+            if (c != '{')
+            {
+                result += c;
+                continue;
+            }
+
+            const auto close = text.find('}', i);
+            if (close == string_view::npos)
+                throw runtime_error("unterminated format field");
+
+            const auto field = text.substr(i + 1, close - i - 1);
+            const auto colon = field.find(':');
+            const auto index = field.substr(0, colon);
+            const auto argument = index.empty() ? nextArgument++ : static_cast<std::size_t>(stoul(string(index)));
+            if (argument >= argumentCount)
+                throw runtime_error("format argument index out of range");
+
+            result += formatters[argument](FormatFallback::ParseSpec(
+                colon == string_view::npos ? string_view() : field.substr(colon + 1)));
+            i = close;
+        }
+        return result;
+    }
+}  // namespace std
+#endif
+
+#include "TestLog.hpp"
+
+#if __has_include("glm/glm.hpp")
+#include "glm/glm.hpp"
+#include "glm/gtc/quaternion.hpp"
+#include "glm/gtc/type_ptr.hpp"
+#endif
+
+#if __has_include("magic_enum/magic_enum.hpp")
+#include "magic_enum/magic_enum.hpp"
+#endif
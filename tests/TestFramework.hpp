@@ -0,0 +1,149 @@
+#pragma once
+
+// Minimal test registry, so the tests build with nothing but a C++20 compiler. A test is a function defined with
+// TEST_CASE; a failed CHECK marks it as failed and keeps going, a failed REQUIRE stops it.
+
+namespace IWXMVM::Tests
+{
+    struct TestCase
+    {
+        const char* name;
+        void (*function)();
+    };
+
+    inline std::vector<TestCase>& GetTestCases()
+    {
+        static std::vector<TestCase> testCases;
+        return testCases;
+    }
+
+    inline bool RegisterTest(const char* name, void (*function)())
+    {
+        GetTestCases().push_back({name, function});
+        return true;
+    }
+
+    inline std::uint64_t failedCheckCount = 0;
+
+    struct RequireFailed
+    {
+    };
+
+    inline void ReportFailure(const char* file, int line, const std::string& message)
+    {
+        failedCheckCount++;
+        std::fprintf(stderr, "%s:%d: check failed: %s\n", file, line, message.c_str());
+    }
+
+    template <typename T>
+    std::string Describe(const T& value)
+    {
+        if constexpr (std::is_same_v<T, bool>)
+            return value ? "true" : "false";
+        else if constexpr (std::is_arithmetic_v<T>)
+            return std::to_string(value);
+        else if constexpr (std::is_enum_v<T>)
+            return std::to_string(static_cast<std::int64_t>(value));
+        else if constexpr (std::is_convertible_v<const T&, std::string_view>)
+            return "\"" + std::string(std::string_view(value)) + "\"";
+        else
+            return "<value>";
+    }
+
+    // Runs the tests whose name contains the first command line argument, or all of them
+    inline int RunTests(int argc, char** argv)
+    {
+        const std::string_view filter = argc > 1 ? argv[1] : "";
+
+        std::size_t failedTestCount = 0;
+        std::size_t ranTestCount = 0;
+        for (const auto& testCase : GetTestCases())
+        {
+            if (std::string_view(testCase.name).find(filter) == std::string_view::npos)
+                continue;
+
+            const auto failedBefore = failedCheckCount;
+            try
+            {
+                testCase.function();
+            }
+            catch (const RequireFailed&)
+            {
+            }
+            catch (const std::exception& e)
+            {
+                ReportFailure(testCase.name, 0, std::string("unexpected exception: ") + e.what());
+            }
+
+            ranTestCount++;
+            const auto passed = failedCheckCount == failedBefore;
+            failedTestCount += passed ? 0 : 1;
+            std::fprintf(stderr, "%s %s\n", passed ? "[pass]" : "[FAIL]", testCase.name);
+        }
+
+        std::fprintf(stderr, "%zu of %zu tests passed\n", ranTestCount - failedTestCount, ranTestCount);
+        return failedTestCount == 0 && ranTestCount > 0 ? 0 : 1;
+    }
+}  // namespace IWXMVM::Tests
+
+#define TEST_CASE(name)                                                                              \
+    static void name();                                                                              \
+    static const bool name##IsRegistered = IWXMVM::Tests::RegisterTest(#name, name);                 \
+    static void name()
+
+#define CHECK(condition)                                                                             \
+    do                                                                                               \
+    {                                                                                                \
+        if (!(condition))                                                                            \
+            IWXMVM::Tests::ReportFailure(__FILE__, __LINE__, #condition);                            \
+    } while (false)
+
+#define REQUIRE(condition)                                                                           \
+    do                                                                                               \
+    {                                                                                                \
+        if (!(condition))                                                                            \
+        {                                                                                            \
+            IWXMVM::Tests::ReportFailure(__FILE__, __LINE__, #condition);                            \
+            throw IWXMVM::Tests::RequireFailed{};                                                    \
+        }                                                                                            \
+    } while (false)
+
+#define CHECK_EQ(actual, expected)                                                                   \
+    do                                                                                               \
+    {                                                                                                \
+        const auto& checkActual = (actual);                                                          \
+        const auto& checkExpected = (expected);                                                      \
+        if (!(checkActual == checkExpected))                                                         \
+            IWXMVM::Tests::ReportFailure(__FILE__, __LINE__,                                         \
+                                         std::string(#actual " == " #expected " (") +                \
+                                             IWXMVM::Tests::Describe(checkActual) + " vs " +         \
+                                             IWXMVM::Tests::Describe(checkExpected) + ")");          \
+    } while (false)
+
+#define CHECK_NEAR(actual, expected, tolerance)                                                      \
+    do                                                                                               \
+    {                                                                                                \
+        const auto checkActual = static_cast<double>(actual);                                        \
+        const auto checkExpected = static_cast<double>(expected);                                    \
+        if (!(std::abs(checkActual - checkExpected) <= static_cast<double>(tolerance)))              \
+            IWXMVM::Tests::ReportFailure(__FILE__, __LINE__,                                         \
+                                         std::string(#actual " ~= " #expected " (") +                \
+                                             std::to_string(checkActual) + " vs " +                  \
+                                             std::to_string(checkExpected) + ")");                   \
+    } while (false)
+
+#define CHECK_THROWS_AS(expression, exceptionType)                                                   \
+    do                                                                                               \
+    {                                                                                                \
+        bool checkThrew = false;                                                                     \
+        try                                                                                          \
+        {                                                                                            \
+            (void)(expression);                                                                      \
+        }                                                                                            \
+        catch (const exceptionType&)                                                                 \
+        {                                                                                            \
+            checkThrew = true;                                                                       \
+        }                                                                                            \
+        if (!checkThrew)                                                                             \
+            IWXMVM::Tests::ReportFailure(__FILE__, __LINE__, #expression " throws " #exceptionType); \
+    } while (false)
@@ -0,0 +1,48 @@
+#pragma once
+
+// Replaces the spdlog backed LOG_* macros of core/src/Logger.hpp. Messages go to stderr, and are counted per level so
+// tests can check that a unit warned about a problem.
+
+namespace IWXMVM::Tests
+{
+    enum class LogLevel
+    {
+        Debug,
+        Info,
+        Warn,
+        Error,
+        Critical,
+        Count
+    };
+
+    inline std::array<std::atomic<std::uint64_t>, static_cast<std::size_t>(LogLevel::Count)> logCounts{};
+    inline bool isLogVerbose = std::getenv("IWXMVM_TESTS_VERBOSE") != nullptr;
+
+    inline std::uint64_t GetLogCount(LogLevel level)
+    {
+        return logCounts[static_cast<std::size_t>(level)].load();
+    }
+
+    template <typename... Args>
+    void Log(LogLevel level, std::string_view format, const Args&... args)
+    {
+        logCounts[static_cast<std::size_t>(level)]++;
+        if (isLogVerbose || level >= LogLevel::Warn)
+        {
+            constexpr std::array<std::string_view, static_cast<std::size_t>(LogLevel::Count)> NAMES = {
+                "debug", "info", "warn", "error", "critical"};
+#if defined(__cpp_lib_format)
+            const auto message = std::vformat(format, std::make_format_args(args...));
+#else
+            const auto message = std::format(format, args...);
+#endif
+            std::fprintf(stderr, "[%s] %s\n", NAMES[static_cast<std::size_t>(level)].data(), message.c_str());
+        }
+    }
+}  // namespace IWXMVM::Tests
+
+#define LOG_DEBUG(...) IWXMVM::Tests::Log(IWXMVM::Tests::LogLevel::Debug, __VA_ARGS__)
+#define LOG_INFO(...) IWXMVM::Tests::Log(IWXMVM::Tests::LogLevel::Info, __VA_ARGS__)
+#define LOG_WARN(...) IWXMVM::Tests::Log(IWXMVM::Tests::LogLevel::Warn, __VA_ARGS__)
+#define LOG_ERROR(...) IWXMVM::Tests::Log(IWXMVM::Tests::LogLevel::Error, __VA_ARGS__)
+#define LOG_CRITICAL(...) IWXMVM::Tests::Log(IWXMVM::Tests::LogLevel::Critical, __VA_ARGS__)
@@ -0,0 +1,7 @@
+#include "StdInclude.hpp"
+#include "TestFramework.hpp"
+
+int main(int argc, char** argv)
+{
+    return IWXMVM::Tests::RunTests(argc, argv);
+}
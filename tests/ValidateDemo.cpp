@@ -0,0 +1,79 @@
+#include "StdInclude.hpp"
+
+#include "Demo/DemoValidator.hpp"
+
+// Checks demos outside of the game, e.g. a whole library in a script:
+//   ValidateDemo [--repair] <demo>...
+// Prints every issue with its offset and exits with 1 if any demo is damaged. With --repair, the intact part of every
+// repairable demo is written next to it, like the mod's integrity check does. Compressed demos are not supported, as
+// decompressing them needs Windows.
+
+using namespace IWXMVM::IW3::Demo;
+
+bool CheckDemo(const std::filesystem::path& path, bool repair)
+{
+    std::ifstream input(path, std::ios::binary);
+    if (!input.is_open())
+    {
+        std::printf("%s: failed to open\n", path.string().c_str());
+        return false;
+    }
+
+    const auto report = ValidateDemo(input);
+    if (report.IsValid())
+    {
+        std::printf("%s: intact (%zu messages, %zu archives)\n", path.string().c_str(), report.messageCount,
+                    report.archiveCount);
+        return true;
+    }
+
+    std::printf("%s: %zu issues, %" PRIu64 " of %" PRIu64 " bytes are intact\n", path.string().c_str(),
+                report.issueCount, report.validSize, report.size);
+    for (const auto& issue : report.issues)
+    {
+        std::printf("  %s at offset %" PRIu64 ": %s\n", GetIssueName(issue.type).data(), issue.offset,
+                    issue.description.c_str());
+    }
+
+    if (!repair || !report.IsRepairable())
+        return false;
+
+    auto outputPath = path;
+    outputPath.replace_extension(".repaired" + path.extension().string());
+
+    input.clear();
+    input.seekg(0, std::ios::beg);
+    std::ofstream output(outputPath, std::ios::binary | std::ios::trunc);
+    if (!output.is_open() || !RepairDemo(input, output, report))
+    {
+        std::printf("  failed to write %s\n", outputPath.string().c_str());
+        return false;
+    }
+
+    std::printf("  wrote the intact %zu messages to %s\n", report.messageCount, outputPath.string().c_str());
+    return false;
+}
+
+int main(int argc, char** argv)
+{
+    bool repair = false;
+    std::vector<std::filesystem::path> paths;
+    for (int i = 1; i < argc; i++)
+    {
+        if (std::string_view(argv[i]) == "--repair")
+            repair = true;
+        else
+            paths.emplace_back(argv[i]);
+    }
+
+    if (paths.empty())
+    {
+        std::fprintf(stderr, "usage: %s [--repair] <demo>...\n", argv[0]);
+        return 2;
+    }
+
+    bool allIntact = true;
+    for (const auto& path : paths)
+        allIntact &= CheckDemo(path, repair);
+    return allIntact ? 0 : 1;
+}